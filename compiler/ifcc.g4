@@ -9,7 +9,7 @@ variableType:   TINT
 beginBlock : '{' ;
 endBlock : '}' ;
 
-prog : (funcDeclare)* mainDeclare (funcDeclare)*;
+prog : (funcDeclare)* (mainDeclare (funcDeclare)*)?;
 
 funcDeclare : FTYPE=('void'|'int'|'char') VAR '(' ( (variableType VAR (',' variableType VAR)*)? | (TVOID)? ) ')' beginBlock body endBlock (';')? ;
 
@@ -9,6 +9,7 @@
 //---- Implementation of class <CodeGenVisitor> (file CodeGenVisitor.cpp) -----/
 
 #include "CodeGenVisitor.h"
+#include "IR/Target.h"
 
 using namespace std;
 
@@ -45,26 +46,69 @@ CodeGenVisitor::~CodeGenVisitor()
 // Visit the program node
 antlrcpp::Any CodeGenVisitor::visitProg(ifccParser::ProgContext *ctx) 
 {
-	int n = ctx->funcDeclare().size();
+	return visitPrograms({ctx}, {""});
+}
 
-	// Visit all function declaration headers
-	for (int i = 0; i < n; i++) 
-    {
-		visitFuncDeclareHeader(ctx->funcDeclare(i));
+// Visit the programs of several source files as one program
+antlrcpp::Any CodeGenVisitor::visitPrograms(vector<ifccParser::ProgContext*> programs, vector<string> sourceFiles)
+{
+	// Visit all function declaration headers (a function may be called from any file)
+	for (size_t f = 0; f < programs.size(); f++) 
+	{
+		enterSourceFile(f, programs.size() > 1 ? sourceFiles[f] : "");
+
+		for (ifccParser::FuncDeclareContext * funcDeclare : programs[f]->funcDeclare()) 
+		{
+			visitFuncDeclareHeader(funcDeclare);
+		}
 	}
 
-	// Visit all function declarations
-	for (int i = 0; i < n; i++) 
-    {
-		visitFuncDeclareBody(ctx->funcDeclare(i));
+	bool hasMain = false;
+
+	for (size_t f = 0; f < programs.size(); f++) 
+	{
+		enterSourceFile(f, programs.size() > 1 ? sourceFiles[f] : "");
+
+		// Visit all function declarations
+		for (ifccParser::FuncDeclareContext * funcDeclare : programs[f]->funcDeclare()) 
+		{
+			visitFuncDeclareBody(funcDeclare);
+		}
+
+		// Visit the main function (only one file may define it)
+		if (programs[f]->mainDeclare() && hasMain) 
+		{
+			string message = "Function 'main' has already been declared";
+			errorHandler.signal(ERROR, message, programs[f]->mainDeclare()->getStart()->getLine());
+		}
+		else if (programs[f]->mainDeclare()) 
+		{
+			hasMain = true;
+			visit(programs[f]->mainDeclare());
+		}
 	}
 
-	// Visit the main function
-	visit(ctx->mainDeclare());
+	// The checks of the whole program name no file
+	enterSourceFile(0, "");
+
+	if (!hasMain && !separateCompilation && !globalSymbolTable->hasFunction("main")) // A standalone program must define its entry point (unless known from another part of the document)
+	{
+		string message = "No 'main' function defined";
+		errorHandler.signal(ERROR, message, -1);
+		return 1;
+	}
 
 	return 0;
 }
 
+// Make the following declarations come from a source file
+void CodeGenVisitor::enterSourceFile(int index, string name)
+{
+	currentSource = index;
+	errorHandler.setSourceFile(name);
+	cfg.setCurrentSourceFile(index + 1);
+}
+
 // Visit the main function declaration
 antlrcpp::Any CodeGenVisitor::visitMainDeclare(ifccParser::MainDeclareContext *ctx) 
 {
@@ -78,7 +122,9 @@ antlrcpp::Any CodeGenVisitor::visitMainDeclare(ifccParser::MainDeclareContext *c
 	visit(ctx->beginBlock());
 	SymbolTable * newSymbolTable = symbolTablesStack.top();
 
-	// Create the prologue instructions
+	// Create the prologue instructions in a fresh entry block
+	cfg.setCurrentLine(ctx->getStart()->getLine());
+	cfg.createFunctionBB("main");
 	cfg.getCurrentBB()->addInstruction(IRInstr::prologue, {"main"}, newSymbolTable);
 
 	// Create the body instructions
@@ -100,7 +146,7 @@ antlrcpp::Any CodeGenVisitor::visitMainDeclare(ifccParser::MainDeclareContext *c
 antlrcpp::Any CodeGenVisitor::visitMainDeclareHeaderNoReturn(ifccParser::MainDeclareHeaderNoReturnContext *ctx)
 {
     // Create the main function in the global symbol table
-    globalSymbolTable->addFunction("main", "int", 0, {}, {}, ctx->getStart()->getLine());
+    globalSymbolTable->addFunction("main", TYPE_INT, 0, {}, {}, ctx->getStart()->getLine());
 
     // Generate a warning message for missing return type
     string message =  "No return type specified for the main function: defaults to 'int'";
@@ -113,7 +159,7 @@ antlrcpp::Any CodeGenVisitor::visitMainDeclareHeaderNoReturn(ifccParser::MainDec
 antlrcpp::Any CodeGenVisitor::visitMainDeclareHeaderWithReturn(ifccParser::MainDeclareHeaderWithReturnContext *ctx) 
 {
     // Create the main function in the global symbol table with the specified return type
-    globalSymbolTable->addFunction("main", ctx->FTYPE->getText(), 0, {}, {}, ctx->getStart()->getLine());
+    globalSymbolTable->addFunction("main", typeFromName(ctx->FTYPE->getText()), 0, {}, {}, ctx->getStart()->getLine());
     return 0;
 }
 
@@ -130,26 +176,27 @@ antlrcpp::Any CodeGenVisitor::visitFuncDeclareHeader(ifccParser::FuncDeclareCont
 	string functionName = ctx->VAR(0)->getText();
 
 	// Fetch the return type
-	string returnType = ctx->FTYPE->getText();
+	Type returnType = typeFromName(ctx->FTYPE->getText());
 
 	// Fetch the parameter names and types
-	vector<string> parametersTypes = {};
+	vector<Type> parametersTypes = {};
 	vector<string> parametersNames = {};
 	int nbParameters = ctx->VAR().size()-1;
 
-	string paramName, paramType;
+	string paramName;
+	Type paramType;
 
 	// Iterate through the parameters
 	for(int i = 0; i < nbParameters; i++) 
     {
 		paramName = ctx->VAR(1+i)->getText();
-		paramType = ctx->variableType(i)->getText();
+		paramType = typeFromName(ctx->variableType(i)->getText());
 		parametersTypes.push_back(paramType);
 		parametersNames.push_back(paramName);
 	}
 
 	// Adjust the number of parameters if the function is declared as 'void'
-	if (ctx->TVOID().size() == 2 && returnType == "void" || ctx->TVOID().size() == 1 && returnType != "void")
+	if (ctx->TVOID().size() == 2 && returnType == TYPE_VOID || ctx->TVOID().size() == 1 && returnType != TYPE_VOID)
     {
 		nbParameters = -1;
 	}
@@ -164,6 +211,7 @@ antlrcpp::Any CodeGenVisitor::visitFuncDeclareHeader(ifccParser::FuncDeclareCont
 
 	// Create the function in symbol table
 	globalSymbolTable->addFunction(functionName, returnType, nbParameters, parametersTypes, parametersNames, ctx->getStart()->getLine());
+	functionSources[functionName] = currentSource;
 
 	return 0;
 }
@@ -188,16 +236,17 @@ antlrcpp::Any CodeGenVisitor::visitFuncDeclareBody(ifccParser::FuncDeclareContex
 		newSymbolTable->addVariable("°" + function->parameterNames[i], function->parameterTypes[i], ctx->getStart()->getLine());
 	}
 
-	// Create the prologue instructions
+	// Create the prologue instructions in a fresh entry block
+	cfg.setCurrentLine(ctx->getStart()->getLine());
+	cfg.createFunctionBB(functionName);
 	cfg.getCurrentBB()->addInstruction(IRInstr::prologue, {functionName}, newSymbolTable); 
 	
-	int paramStackOffset = 16; // The size of the return adress stored on the stack when calling the function
-	
 	// Create instructions that loads register into variable
     for(int i = function->nbParameters-1 ; i >= 0 ; i--) 
     {
+		// The caller pushes the last arguments first: the 7th one is just above the return address (16 bytes with the saved %rbp)
+		int paramStackOffset = 16 + 8 * max(i - TARGET_PARAM_REGISTERS, 0);
 		cfg.getCurrentBB()->addInstruction(IRInstr::rparam, {function->parameterNames[i], to_string(i), to_string(paramStackOffset)}, newSymbolTable);
-		paramStackOffset += 8;
 	}
 
 	// Create the body instructions
@@ -215,6 +264,18 @@ antlrcpp::Any CodeGenVisitor::visitFuncDeclareBody(ifccParser::FuncDeclareContex
 	return 0;
 }
 
+// Visit a sequence of statements
+antlrcpp::Any CodeGenVisitor::visitBody(ifccParser::BodyContext *ctx) 
+{
+	// The instructions of the first statement come from its line (used by the line tables)
+	if (ctx->getStart() != nullptr)
+	{
+		cfg.setCurrentLine(ctx->getStart()->getLine());
+	}
+
+	return visitChildren(ctx);
+}
+
 // Visit the beginning of a block
 antlrcpp::Any CodeGenVisitor::visitBeginBlock(ifccParser::BeginBlockContext *ctx) 
 {
@@ -245,6 +306,9 @@ antlrcpp::Any CodeGenVisitor::visitEndBlock(ifccParser::EndBlockContext *ctx)
 	SymbolTable * symbolTable = symbolTablesStack.top();
 	BasicBlock * currentBB = cfg.getCurrentBB();
 
+	// The jumps closing the block come from the line of the brace
+	cfg.setCurrentLine(ctx->getStart()->getLine());
+
 	// Add conditional jump instruction if there is a false exit
 	if (currentBB->getExitFalse()) 
     {
@@ -274,7 +338,7 @@ antlrcpp::Any CodeGenVisitor::visitVarDeclare(ifccParser::VarDeclareContext *ctx
 	int nbVariable = ctx->VAR().size();
 
 	// Fetch the type
-	string varType = ctx->variableType()->getText();
+	Type varType = typeFromName(ctx->variableType()->getText());
 	string variableName;
 
 	// Iterate through each variable to declare
@@ -313,7 +377,7 @@ antlrcpp::Any CodeGenVisitor::visitVarDeclareAndAffect(ifccParser::VarDeclareAnd
 
 	// Fetch the variable
 	string variableName = ctx->VAR()->getText();
-	string varType = ctx->variableType()->getText();
+	Type varType = typeFromName(ctx->variableType()->getText());
 
 	// Check for errors
 	if (symbolTable->hasVariable(variableName) == 1) 
@@ -340,7 +404,7 @@ antlrcpp::Any CodeGenVisitor::visitVarDeclareAndAffect(ifccParser::VarDeclareAnd
 	varStruct * result = visit(ctx->exprInstruction());
 
 	// Check for void errors
-	if (result->variableType == "void") 
+	if (result->variableType == TYPE_VOID) 
 	{
 		string message =  "Cannot perform operations on void";
 		errorHandler.signal(ERROR, message, ctx->getStart()->getLine());
@@ -350,8 +414,17 @@ antlrcpp::Any CodeGenVisitor::visitVarDeclareAndAffect(ifccParser::VarDeclareAnd
 	// Reset the stack pointer and temp variable counter after having evaluated the expression
 	symbolTable->setStackPointer(currStackPointer);
 
-	// Add ASM instructions to save expression in the variable 
-	cfg.getCurrentBB()->addInstruction(IRInstr::aff, {result->variableName, variableName}, symbolTable);
+	// Add ASM instructions to save expression in the variable (a constant is loaded into it)
+	if (constantTemporaries.count(result->variableName) > 0)
+	{
+		int value = SymbolTable::getCast(varType, readConstant(result));
+		removeConstantLoad(result);
+		cfg.getCurrentBB()->addInstruction(IRInstr::ldconst, {typeName(varType), to_string(value), variableName}, symbolTable);
+	}
+	else
+	{
+		cfg.getCurrentBB()->addInstruction(IRInstr::aff, {result->variableName, variableName}, symbolTable);
+	}
 	
 	return 0;
 }
@@ -383,15 +456,24 @@ antlrcpp::Any CodeGenVisitor::visitAffectExpr(ifccParser::AffectExprContext *ctx
 	symbolTable->setStackPointer(currStackPointer);
 
 	// Check for void errors
-	if (tmp->variableType == "void") 
+	if (tmp->variableType == TYPE_VOID) 
 	{
 		string message =  "Cannot perform operations on void";
 		errorHandler.signal(ERROR, message, ctx->getStart()->getLine());
 		return &SymbolTable::stupidVarStruct;
 	}
 
-	// Add ASM instructions to save expression in the variable 
-	cfg.getCurrentBB()->addInstruction(IRInstr::aff, {tmp->variableName, variableName}, symbolTable);
+	// Add ASM instructions to save expression in the variable (a constant is loaded into it)
+	if (constantTemporaries.count(tmp->variableName) > 0)
+	{
+		Type variableType = symbolTable->getVariable(variableName, true)->variableType;
+		int value = SymbolTable::getCast(variableType, readConstant(tmp));
+		cfg.getCurrentBB()->addInstruction(IRInstr::ldconst, {typeName(variableType), to_string(value), variableName}, symbolTable);
+	}
+	else
+	{
+		cfg.getCurrentBB()->addInstruction(IRInstr::aff, {tmp->variableName, variableName}, symbolTable);
+	}
 
 	return tmp;
 }
@@ -492,15 +574,18 @@ antlrcpp::Any CodeGenVisitor::visitConstExpr(ifccParser::ConstExprContext *ctx)
 	// Add the constant instructions to the intermediate representation (IR)
 	if (constStr[0] == '\'') // If it's a character constant
     {
-		tmp = createTmpVariable(ctx, "char");
-		cfg.getCurrentBB()->addInstruction(IRInstr::ldconst, {"char", to_string(constValue), tmp->variableName}, symbolTable);
+		tmp = createTmpVariable(ctx, TYPE_CHAR);
+		cfg.getCurrentBB()->addInstruction(IRInstr::ldconst, {typeName(TYPE_CHAR), to_string(constValue), tmp->variableName}, symbolTable);
 	} 
     else // If it's an integer constant
     {
-		tmp = createTmpVariable(ctx, "int");
-		cfg.getCurrentBB()->addInstruction(IRInstr::ldconst, {"int", to_string(constValue), tmp->variableName}, symbolTable);
+		tmp = createTmpVariable(ctx, TYPE_INT);
+		cfg.getCurrentBB()->addInstruction(IRInstr::ldconst, {typeName(TYPE_INT), to_string(constValue), tmp->variableName}, symbolTable);
 	}
 
+	// Remember the constant for the operations on it
+	constantTemporaries[tmp->variableName] = constValue;
+
 	// Return the temporary variable
 	return tmp;
 }
@@ -539,6 +624,16 @@ antlrcpp::Any CodeGenVisitor::visitFuncExpr(ifccParser::FuncExprContext *ctx)
 	// Fetch function name
 	string funcName = ctx->VAR()->getText();
 
+	// Functions of other translation units are implicitly declared as returning int
+	if (!globalSymbolTable->hasFunction(funcName) && separateCompilation) 
+	{
+		int nbArguments = ctx->expr().size();
+		globalSymbolTable->addFunction(funcName, TYPE_INT, nbArguments, vector<Type>(nbArguments, TYPE_INT), vector<string>(nbArguments, ""), ctx->getStart()->getLine());
+
+		string message =  "Implicit declaration of function '" + funcName + "'";
+		errorHandler.signal(WARNING, message, ctx->getStart()->getLine());
+	}
+
 	// Check if the function is declared 
 	if (!globalSymbolTable->hasFunction(funcName)) 
 	{
@@ -550,8 +645,10 @@ antlrcpp::Any CodeGenVisitor::visitFuncExpr(ifccParser::FuncExprContext *ctx)
 	// Get function information
 	funcStruct* func = globalSymbolTable->getFunction(funcName);
 
-	// Check if it's an implicit declaration
-	if (func->functionLine > ctx->getStart()->getLine()) 
+	// Check if it's an implicit declaration (the lines of two source files cannot be compared)
+	bool sameSource = functionSources.count(funcName) == 0 || functionSources[funcName] == currentSource;
+
+	if (sameSource && func->functionLine > ctx->getStart()->getLine()) 
 	{
 		string message =  "Function '" + funcName + "' might be declared implicitely";
 		errorHandler.signal(WARNING, message, ctx->getStart()->getLine());
@@ -620,7 +717,7 @@ antlrcpp::Any CodeGenVisitor::visitUnaryExpr(ifccParser::UnaryExprContext *ctx)
 	varStruct * tmp = createTmpVariable(ctx);
 	
 	// Check for void errors
-	if (variable->variableType == "void") 
+	if (variable->variableType == TYPE_VOID) 
 	{
 		// Signal an error if attempting to perform operations on void
 		string message =  "Cannot perform operations on void";
@@ -633,6 +730,12 @@ antlrcpp::Any CodeGenVisitor::visitUnaryExpr(ifccParser::UnaryExprContext *ctx)
 	// Get the operator
 	char op = ctx->UNARY->getText()[0];
 
+	// An operation on a constant is computed now
+	if (foldConstants(op == '!' ? IRInstr::op_not : IRInstr::op_minus, variable, nullptr, tmp))
+	{
+		return tmp;
+	}
+
 	// Apply the unary operator
 	switch(op) 
 	{
@@ -669,7 +772,7 @@ antlrcpp::Any CodeGenVisitor::visitAddSubExpr(ifccParser::AddSubExprContext *ctx
     varStruct * tmp = createTmpVariable(ctx);
 
     // Check for errors
-    if (variable1->variableType == "void" || variable2->variableType == "void") 
+    if (variable1->variableType == TYPE_VOID || variable2->variableType == TYPE_VOID) 
     {
         // Signal an error if attempting to perform operations on void
         string message =  "Cannot perform operations on void";
@@ -688,6 +791,12 @@ antlrcpp::Any CodeGenVisitor::visitAddSubExpr(ifccParser::AddSubExprContext *ctx
     // Get the operator
     char op = ctx->OP2->getText()[0];
 
+    // An operation on constants is computed now
+    if (foldConstants(op == '+' ? IRInstr::op_add : IRInstr::op_sub, variable1, variable2, tmp))
+    {
+        return tmp;
+    }
+
     // Apply the operator
     switch (op) 
     {
@@ -724,7 +833,7 @@ antlrcpp::Any CodeGenVisitor::visitMulDivModExpr(ifccParser::MulDivModExprContex
 	varStruct * tmp = createTmpVariable(ctx);
 
 	// Check for errors
-    if (variable1->variableType == "void" || variable2->variableType == "void") 
+    if (variable1->variableType == TYPE_VOID || variable2->variableType == TYPE_VOID) 
     {
         // Signal an error if attempting to perform operations on void
         string message =  "Cannot perform operations on void";
@@ -742,6 +851,12 @@ antlrcpp::Any CodeGenVisitor::visitMulDivModExpr(ifccParser::MulDivModExprContex
 
 	// Get the operator
 	char op = ctx->OP1->getText()[0];
+
+	// An operation on constants is computed now (a division by zero is left to the runtime)
+	if (foldConstants(op == '*' ? IRInstr::op_mul : op == '/' ? IRInstr::op_div : IRInstr::op_mod, variable1, variable2, tmp))
+	{
+		return tmp;
+	}
 	
 	// Apply the operators
 	switch (op) 
@@ -786,7 +901,7 @@ antlrcpp::Any CodeGenVisitor::visitCmpEqualityExpr(ifccParser::CmpEqualityExprCo
 	varStruct * tmp = createTmpVariable(ctx);
 
 	// Check for errors
-    if (variable1->variableType == "void" || variable2->variableType == "void") 
+    if (variable1->variableType == TYPE_VOID || variable2->variableType == TYPE_VOID) 
     {
         // Signal an error if attempting to perform operations on void
         string message =  "Cannot perform operations on void";
@@ -805,6 +920,12 @@ antlrcpp::Any CodeGenVisitor::visitCmpEqualityExpr(ifccParser::CmpEqualityExprCo
 	// Get the comparison operator
 	char op = ctx->EQ->getText()[0];
 
+	// A comparison of constants is computed now
+	if (foldConstants(op == '=' ? IRInstr::cmp_eq : IRInstr::cmp_neq, variable1, variable2, tmp))
+	{
+		return tmp;
+	}
+
 	// Apply the operators
 	switch (op) 
 	{
@@ -841,7 +962,7 @@ antlrcpp::Any CodeGenVisitor::visitCmpLessOrGreaterExpr(ifccParser::CmpLessOrGre
 	varStruct * tmp = createTmpVariable(ctx);
 
 	// Check for errors
-    if (variable1->variableType == "void" || variable2->variableType == "void") 
+    if (variable1->variableType == TYPE_VOID || variable2->variableType == TYPE_VOID) 
     {
         // Signal an error if attempting to perform operations on void
         string message =  "Cannot perform operations on void";
@@ -860,6 +981,12 @@ antlrcpp::Any CodeGenVisitor::visitCmpLessOrGreaterExpr(ifccParser::CmpLessOrGre
 	// Get the operator ('<' for less than, '>' for greater than)
 	char op = ctx->CMP->getText()[0];
 
+	// A comparison of constants is computed now
+	if (foldConstants(op == '<' ? IRInstr::cmp_lt : IRInstr::cmp_gt, variable1, variable2, tmp))
+	{
+		return tmp;
+	}
+
 	// Apply the operators
 	switch (op) 
 	{
@@ -896,7 +1023,7 @@ antlrcpp::Any CodeGenVisitor::visitCmpEqualityLessGreaterExpr(ifccParser::CmpEqu
 	varStruct* tmp = createTmpVariable(ctx);
 
 	// Check for errors
-    if (variable1->variableType == "void" || variable2->variableType == "void") 
+    if (variable1->variableType == TYPE_VOID || variable2->variableType == TYPE_VOID) 
     {
         // Signal an error if attempting to perform operations on void
         string message =  "Cannot perform operations on void";
@@ -915,6 +1042,12 @@ antlrcpp::Any CodeGenVisitor::visitCmpEqualityLessGreaterExpr(ifccParser::CmpEqu
 	// Get the operator
 	char op = ctx->EQLG->getText()[0];
 
+	// A comparison of constants is computed now
+	if (foldConstants(op == '<' ? IRInstr::cmp_eqlt : IRInstr::cmp_eqgt, variable1, variable2, tmp))
+	{
+		return tmp;
+	}
+
 	// Apply the operators
 	switch (op) 
 	{
@@ -951,7 +1084,7 @@ antlrcpp::Any CodeGenVisitor::visitAndExpr(ifccParser::AndExprContext *ctx)
 	varStruct* tmp = createTmpVariable(ctx);
 
 	// Check for errors related to void type
-    if (variable1->variableType == "void" || variable2->variableType == "void") 
+    if (variable1->variableType == TYPE_VOID || variable2->variableType == TYPE_VOID) 
     {
         // Signal an error if attempting to perform operations on void
         string message =  "Cannot perform operations on void";
@@ -967,6 +1100,12 @@ antlrcpp::Any CodeGenVisitor::visitAndExpr(ifccParser::AndExprContext *ctx)
         return &SymbolTable::stupidVarStruct;
     }
 
+	// An operation on constants is computed now
+	if (foldConstants(IRInstr::op_and, variable1, variable2, tmp))
+	{
+		return tmp;
+	}
+
 	// Apply the operator and generate the corresponding IR instruction
 	cfg.getCurrentBB()->addInstruction(IRInstr::op_and, {variable1->variableName, variable2->variableName, tmp->variableName}, symbolTable);
 	
@@ -988,7 +1127,7 @@ antlrcpp::Any CodeGenVisitor::visitOrExpr(ifccParser::OrExprContext *ctx)
 	varStruct* tmp = createTmpVariable(ctx);
 
 	// Check for errors
-	if (variable1->variableType == "void" || variable2->variableType == "void") 
+	if (variable1->variableType == TYPE_VOID || variable2->variableType == TYPE_VOID) 
 	{
         // Signal an error if attempting to perform operations on void
         string message =  "Cannot perform operations on void";
@@ -1004,6 +1143,12 @@ antlrcpp::Any CodeGenVisitor::visitOrExpr(ifccParser::OrExprContext *ctx)
         return &SymbolTable::stupidVarStruct;
     }
 	
+	// An operation on constants is computed now
+	if (foldConstants(IRInstr::op_or, variable1, variable2, tmp))
+	{
+		return tmp;
+	}
+
 	// Apply the operator and generate the corresponding IR instruction
     cfg.getCurrentBB()->addInstruction(IRInstr::op_or, {variable1->variableName, variable2->variableName, tmp->variableName}, symbolTable);
     
@@ -1025,7 +1170,7 @@ antlrcpp::Any CodeGenVisitor::visitXorExpr(ifccParser::XorExprContext *ctx)
 	varStruct* tmp = createTmpVariable(ctx);
 
 	// Check for errors
-	if (variable1->variableType == "void" || variable2->variableType == "void") 
+	if (variable1->variableType == TYPE_VOID || variable2->variableType == TYPE_VOID) 
     {
         // Signal an error if attempting to perform operations on void
         string message =  "Cannot perform operations on void";
@@ -1041,6 +1186,12 @@ antlrcpp::Any CodeGenVisitor::visitXorExpr(ifccParser::XorExprContext *ctx)
         return &SymbolTable::stupidVarStruct;
     }
 	
+	// An operation on constants is computed now
+	if (foldConstants(IRInstr::op_xor, variable1, variable2, tmp))
+	{
+		return tmp;
+	}
+
 	// Apply the operator and generate the corresponding IR instruction
 	cfg.getCurrentBB()->addInstruction(IRInstr::op_xor, {variable1->variableName, variable2->variableName, tmp->variableName}, symbolTable);
 	
@@ -1270,8 +1421,16 @@ antlrcpp::Any CodeGenVisitor::visitPmmdEqual(ifccParser::PmmdEqualContext *ctx)
     // Get the symbol table from the top of the symbol tables stack
     SymbolTable* symbolTable = symbolTablesStack.top();
 
+	// Check for errors
+	if (!symbolTable->hasVariable(leftExpr) && !symbolTable->hasParameter(leftExpr))
+	{
+		string message = "Variable '" + leftExpr + "' has not been declared";
+		errorHandler.signal(ERROR, message, ctx->getStart()->getLine());
+		return &SymbolTable::stupidVarStruct;
+	}
+
 	// Generate instructions based on the operator
-    if (op == "+=") 
+    if (op == "+=")
 	{
         cfg.getCurrentBB()->addInstruction(IRInstr::op_plus_equal, {leftExpr, rightExpr->variableName}, symbolTable);
     } 
@@ -1311,11 +1470,10 @@ antlrcpp::Any CodeGenVisitor::visitExpReturnStatement(ifccParser::ExpReturnState
 	varStruct * result = visit(ctx->exprInstruction());
 	
 	// Retrieve the function return type
-	string funcParent = ctx->parent->parent->getText();
-	string returnType = funcParent.substr(0, 4); // if it's void, it's the 4th first letter
+	Type returnType = globalSymbolTable->getFunction(currentFunction)->returnType;
 
 	// Verify if returnType == void
-	if (returnType == "void" && result->variableType != "void")
+	if (returnType == TYPE_VOID && result->variableType != TYPE_VOID)
     {
 		// Generate a warning message for empty return return value in a void function
 		string message =  "'return' with a value, in function returning void '" + currentFunction + "'";
@@ -1323,7 +1481,7 @@ antlrcpp::Any CodeGenVisitor::visitExpReturnStatement(ifccParser::ExpReturnState
 	}
 
 	// Check for errors
-    if (result->variableType == "void") 
+    if (result->variableType == TYPE_VOID) 
     {
         // Signal an error if attempting to return a void expression
         string message =  "Cannot perform operations on void";
@@ -1343,8 +1501,17 @@ antlrcpp::Any CodeGenVisitor::visitExpReturnStatement(ifccParser::ExpReturnState
 	// Reset the stack pointer and temp variable counter after evaluating the expression
     symbolTable->setStackPointer(currStackPointer);
     
-    // Add actual return instructions with the result of the expression
-    cfg.getCurrentBB()->addInstruction(IRInstr::ret, {result->variableName}, symbolTable);
+    // Add actual return instructions with the result of the expression (a constant is returned as an immediate)
+    if (constantTemporaries.count(result->variableName) > 0)
+    {
+        int value = readConstant(result);
+        removeConstantLoad(result);
+        cfg.getCurrentBB()->addInstruction(IRInstr::ret, {"$" + to_string(value)}, symbolTable);
+    }
+    else
+    {
+        cfg.getCurrentBB()->addInstruction(IRInstr::ret, {result->variableName}, symbolTable);
+    }
 
     return 0;
 }
@@ -1361,7 +1528,7 @@ antlrcpp::Any CodeGenVisitor::visitEmptyReturnStatement(ifccParser::EmptyReturnS
 	// Check for warnings if the function has a non-void return type
 	funcStruct * function = globalSymbolTable->getFunction(currentFunction);
 	
-    if (function->returnType != "void") 
+    if (function->returnType != TYPE_VOID) 
     {
 		// Generate a warning message for empty return in a non-void function
 		string message =  "Use of empty 'return;' in non-void function '" + currentFunction + "'";
@@ -1395,11 +1562,14 @@ void CodeGenVisitor::returnDefault(antlr4::ParserRuleContext *ctx)
 	// Set the returned flag to true
 	symbolTable->setReturned(true);
 
+	// The implicit return belongs to the end of the function
+	cfg.setCurrentLine(ctx->getStop()->getLine());
+
 	// Retrieve function information
 	funcStruct * function = globalSymbolTable->getFunction(currentFunction);
 	
 	// Check for warnings if the function has a non-void return type
-    if (function->returnType != "void") 
+    if (function->returnType != TYPE_VOID) 
     {
 		// Generate a warning message for missing return in a non-void function
 		string message =  "No 'return' found in non-void function '" + currentFunction + "'";
@@ -1407,7 +1577,7 @@ void CodeGenVisitor::returnDefault(antlr4::ParserRuleContext *ctx)
 	}
 
 	// Determine if the default return value should be 41 or 37 (EXIT_SUCCESS) based on the main function
-    bool returnExitSuccess = currentFunction == "main" && function->returnType == "void";
+    bool returnExitSuccess = currentFunction == "main" && function->returnType == TYPE_VOID;
 
 	char* wsl_env = getenv("WSLENV");
 
@@ -1424,7 +1594,7 @@ void CodeGenVisitor::returnDefault(antlr4::ParserRuleContext *ctx)
 }
 
 // Create a temporary variable. 
-varStruct* CodeGenVisitor::createTmpVariable(antlr4::ParserRuleContext * ctx, string variableType) 
+varStruct* CodeGenVisitor::createTmpVariable(antlr4::ParserRuleContext * ctx, Type variableType) 
 {
 	// Get the symbol table from the top of the symbol tables stack
 	SymbolTable * symbolTable = symbolTablesStack.top();
@@ -1432,10 +1602,9 @@ varStruct* CodeGenVisitor::createTmpVariable(antlr4::ParserRuleContext * ctx, st
 	// Increment the temporary variable counter and generate a unique variable name
 	tmpVariableCounter++;
 	string newVariable = "!tmp" + to_string(tmpVariableCounter);
-	string newVariableType = variableType;
 	
 	// Add the new temporary variable to the symbol table
-    symbolTable->addVariable(newVariable, newVariableType, ctx->getStart()->getLine());
+    symbolTable->addVariable(newVariable, variableType, ctx->getStart()->getLine());
 	
 	// Mark the temporary variable as used
 	symbolTable->getVariable(newVariable)->isUsed = true;
@@ -1444,20 +1613,93 @@ varStruct* CodeGenVisitor::createTmpVariable(antlr4::ParserRuleContext * ctx, st
 	return symbolTable->getVariable(newVariable);
 }
 
+// Compute an operation on constant temporaries at lowering, into the result
+bool CodeGenVisitor::foldConstants(IRInstr::Operation op, varStruct* variable1, varStruct* variable2, varStruct* result)
+{
+	// Every operand must be a constant (a unary operation has no second operand)
+	bool isConstant1 = constantTemporaries.count(variable1->variableName) > 0;
+	bool isConstant2 = variable2 == nullptr || constantTemporaries.count(variable2->variableName) > 0;
+
+	if (!isConstant1 || !isConstant2)
+	{
+		return false;
+	}
+
+	// Compute the value as the generated code would (a division by zero traps at runtime)
+	int value1 = constantTemporaries[variable1->variableName];
+	int value2 = (variable2 == nullptr) ? 0 : constantTemporaries[variable2->variableName];
+	Type type2 = (variable2 == nullptr) ? TYPE_INT : variable2->variableType;
+	int value;
+
+	if (!IRInstr::evaluate(op, variable1->variableType, value1, type2, value2, value))
+	{
+		return false;
+	}
+
+	// The loads of the operands are replaced by the load of the result
+	removeConstantLoad(variable1);
+
+	if (variable2 != nullptr)
+	{
+		removeConstantLoad(variable2);
+	}
+
+	value = SymbolTable::getCast(result->variableType, value);
+	cfg.getCurrentBB()->addInstruction(IRInstr::ldconst, {typeName(result->variableType), to_string(value), result->variableName}, symbolTablesStack.top());
+	constantTemporaries[result->variableName] = value;
+
+	return true;
+}
+
+// Get the value of a constant temporary read on 32 bits (a char is zero-extended, like its loads)
+int CodeGenVisitor::readConstant(varStruct* constant)
+{
+	int value = constantTemporaries[constant->variableName];
+
+	return (constant->variableType == TYPE_CHAR) ? (unsigned char) value : value;
+}
+
+// Remove the load of a constant temporary replaced by its value
+void CodeGenVisitor::removeConstantLoad(varStruct* constant)
+{
+	// The load is among the last instructions of the current block: the constant was just computed
+	BasicBlock * bb = cfg.getCurrentBB();
+	list<IRInstr*> instructions = bb->getInstructionList();
+
+	for (list<IRInstr*>::reverse_iterator it = instructions.rbegin(); it != instructions.rend(); ++it)
+	{
+		if ((*it)->getOp() == IRInstr::ldconst && (*it)->getParameters().at(2) == constant->variableName)
+		{
+			delete *it;
+			instructions.erase(next(it).base());
+			break;
+		}
+	}
+
+	bb->setInstructionList(instructions);
+	constantTemporaries.erase(constant->variableName);
+}
+
 // Getter for the global symbol table
 SymbolTable* CodeGenVisitor::getGlobalSymbolTable() 
 {
 	return this->globalSymbolTable;
 }
 
+// Setter for the separate compilation mode
+void CodeGenVisitor::setSeparateCompilation(bool enabled) 
+{
+	this->separateCompilation = enabled;
+}
+
 // Add the 'putchar' function symbol to the global symbol table
 void CodeGenVisitor::addSymbolPutchar() 
 {
-    globalSymbolTable->addFunction("putchar", "int", 1, {"int"}, {"c"}, 0);
+    globalSymbolTable->addFunction("putchar", TYPE_INT, 1, {TYPE_INT}, {"c"}, 0);
 }
 
 // Add the 'getchar' function symbol to the global symbol table
 void CodeGenVisitor::addSymbolGetchar() 
 {
-    globalSymbolTable->addFunction("getchar", "int", -1, {}, {}, 0);
+    globalSymbolTable->addFunction("getchar", TYPE_INT, -1, {}, {}, 0);
 }
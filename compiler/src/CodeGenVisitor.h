@@ -39,12 +39,14 @@ class  CodeGenVisitor : public ifccBaseVisitor
                 
                 // Linearising functions
 	        antlrcpp::Any visitProg(ifccParser::ProgContext *ctx);
+                antlrcpp::Any visitPrograms(vector<ifccParser::ProgContext*> programs, vector<string> sourceFiles);
 		antlrcpp::Any visitMainDeclare(ifccParser::MainDeclareContext *ctx);
 		antlrcpp::Any visitMainDeclareHeaderWithReturn(ifccParser::MainDeclareHeaderWithReturnContext *ctx);
 		antlrcpp::Any visitMainDeclareHeaderNoReturn(ifccParser::MainDeclareHeaderNoReturnContext *ctx);
                 antlrcpp::Any visitFuncDeclare(ifccParser::FuncDeclareContext *ctx); 
 		antlrcpp::Any visitFuncDeclareHeader(ifccParser::FuncDeclareContext *ctx);
                 antlrcpp::Any visitFuncDeclareBody(ifccParser::FuncDeclareContext *ctx);
+                antlrcpp::Any visitBody(ifccParser::BodyContext *ctx);
                 antlrcpp::Any visitBeginBlock(ifccParser::BeginBlockContext *ctx);
                 antlrcpp::Any visitEndBlock(ifccParser::EndBlockContext *ctx);
                 antlrcpp::Any visitEmptyReturnStatement(ifccParser::EmptyReturnStatementContext *ctx);
@@ -73,13 +75,28 @@ class  CodeGenVisitor : public ifccBaseVisitor
                 // Getter for the global symbol table
                 SymbolTable* getGlobalSymbolTable();
 
+                // Setter for the separate compilation mode (translation unit of a multi-file program)
+                void setSeparateCompilation(bool enabled);
+
         protected:
                 
                 // Method for handling default return behavior
                 void returnDefault(antlr4::ParserRuleContext *ctx);
                 
+                // Make the following declarations come from a source file (named in the diagnostics if not empty)
+                void enterSourceFile(int index, string name);
+
                 // Method for creating temporary variables
-                varStruct* createTmpVariable(antlr4::ParserRuleContext *ctx, string varType="int");
+                varStruct* createTmpVariable(antlr4::ParserRuleContext *ctx, Type varType = TYPE_INT);
+
+                // Method for computing an operation on constant temporaries at lowering (false if an operand is not constant or the operation traps)
+                bool foldConstants(IRInstr::Operation op, varStruct* variable1, varStruct* variable2, varStruct* result);
+
+                // Method for getting the value of a constant temporary read on 32 bits (by an assignment or a return)
+                int readConstant(varStruct* constant);
+
+                // Method for removing the load of a constant temporary replaced by its value
+                void removeConstantLoad(varStruct* constant);
 
                 ErrorHandler& errorHandler;             // Reference to the error handler
                 CFG& cfg;                               // Reference to the control flow graph
@@ -88,6 +105,10 @@ class  CodeGenVisitor : public ifccBaseVisitor
                 stack<SymbolTable*> symbolTableGarbage; // Stack to hold symbol tables that can be deleted
                 string currentFunction = "";            // Name of the current function being processed
                 SymbolTable* globalSymbolTable;         // Pointer to the global symbol table
+                bool separateCompilation = false;       // Whether main is optional and external functions are allowed
+                int currentSource = 0;                  // Index of the source file being visited
+                unordered_map<string, int> functionSources;     // Index of the source file declaring every function
+                unordered_map<string, int> constantTemporaries; // Value of every temporary loaded with a constant
 
 	private:
 
@@ -0,0 +1,464 @@
+/*************************************************************************
+                          PLD Compilateur: Driver
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <Driver> (file Driver.cpp) -----/
+
+#include "Driver.h"
+
+#include <sstream>
+#include <cstdlib>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <ext/stdio_filebuf.h>
+
+// Include ANTLR4 headers
+#include "antlr4-runtime.h"
+#include "../generated/ifccLexer.h"
+#include "../generated/ifccParser.h"
+#include "../generated/ifccBaseVisitor.h"
+
+// Include custom headers
+#include "CodeGenVisitor.h"
+#include "IR/CFG.h"
+#include "IR/Interpreter.h"
+#include "IR/CostModel.h"
+#include "IR/WholeProgram.h"
+#include "IR/Optimizer.h"
+#include "IR/Peephole.h"
+#include "JIT.h"
+
+using namespace antlr4;
+using namespace std;
+
+// Structure to keep the parse of a source file alive while its tree is visited
+struct parsedFileStruct
+{
+	unique_ptr<ANTLRInputStream> input;		// Preprocessed text
+	unique_ptr<ifccLexer> lexer;			// Lexer of the text
+	unique_ptr<CommonTokenStream> tokens;	// Tokens of the text
+	unique_ptr<ifccParser> parser;			// Parser owning the tree
+	ifccParser::AxiomContext * tree;		// Parse tree
+};
+
+// Constructor
+Driver::Driver()
+{
+}
+
+// Setter for the separate compilation mode
+void Driver::setSeparateCompilation(bool enabled)
+{
+	this->separateCompilation = enabled;
+}
+
+// Setter for the whole program mode
+void Driver::setWholeProgram(bool enabled)
+{
+	this->wholeProgram = enabled;
+}
+
+// Setter for the optimizations of the functions
+void Driver::setOptimization(bool enabled)
+{
+	this->optimization = enabled;
+}
+
+// Setter for the motion of the loop invariants
+void Driver::setLoopInvariantCodeMotion(bool enabled)
+{
+	this->loopInvariantCodeMotion = enabled;
+}
+
+// Setter for the statistics of the optimizations
+void Driver::setStatistics(bool enabled)
+{
+	this->statistics = enabled;
+}
+
+// Setter for the debug information
+void Driver::setDebugInfo(bool enabled)
+{
+	this->debugInfo = enabled;
+}
+
+// Add a directory searched by #include
+void Driver::addIncludePath(string path)
+{
+	preprocessor.addIncludePath(path);
+}
+
+// Define a macro for every source file
+void Driver::defineMacro(string definition)
+{
+	preprocessor.defineMacro(definition);
+}
+
+// Compile a source file and write the generated assembly to o
+bool Driver::compile(string sourceFile, ostream& o)
+{
+	return compileProgram({sourceFile}, o);
+}
+
+// Compile source files as one program and write the generated assembly to o
+bool Driver::compileProgram(vector<string> sourceFiles, ostream& o)
+{
+	// Every function is optimized right before its code is generated (flushed to o function by function)
+	return buildIR(sourceFiles, true, [&o](CFG& cfg)
+	{
+		cfg.generateASM(o);
+		o.flush();
+
+		return o.good();
+	});
+}
+
+// Compile a source file and execute its IR with the interpreter
+int Driver::interpret(string sourceFile, vector<string> arguments, bool profile)
+{
+	int status = 1;
+
+	buildIR({sourceFile}, false, [&](CFG& cfg)
+	{
+		Interpreter interpreter(&cfg);
+
+		if (!interpreter.isValid())
+		{
+			return false;
+		}
+
+		// The program sees its source file as argv[0]
+		arguments.insert(arguments.begin(), sourceFile);
+		status = interpreter.run(arguments);
+
+		if (profile)
+		{
+			interpreter.printProfile(cerr);
+		}
+
+		return true;
+	});
+
+	return status;
+}
+
+// Compile a source file and write the static cost and stack usage of its functions to o
+bool Driver::costReport(string sourceFile, ostream& o)
+{
+	return buildIR({sourceFile}, false, [&o](CFG& cfg)
+	{
+		CostModel costModel(&cfg);
+		costModel.printReport(o);
+
+		return o.good();
+	});
+}
+
+// Parse source files, build and check the IR of their program, then hand the CFG to the back end
+bool Driver::buildIR(vector<string> sourceFiles, bool pipelined, function<bool(CFG&)> backEnd)
+{
+	ErrorHandler errorHandler;
+	vector<parsedFileStruct> files(sourceFiles.size());
+	vector<ifccParser::ProgContext*> programs;
+
+	for (size_t i = 0; i < sourceFiles.size(); i++)
+	{
+		parsedFileStruct& file = files[i];
+		string content;
+
+		// Expand the directives (the lines of the source file are kept)
+		if (!preprocessor.process(sourceFiles[i], content, errorHandler))
+		{
+			return false;
+		}
+
+		// Parse and construct tree
+		file.input.reset(new ANTLRInputStream(content));
+
+		// Create lexer and token stream
+		file.lexer.reset(new ifccLexer(file.input.get()));
+		file.tokens.reset(new CommonTokenStream(file.lexer.get()));
+		file.tokens->fill();
+
+		// Check the syntax by parsing
+		file.parser.reset(new ifccParser(file.tokens.get()));
+		file.tree = file.parser->axiom();
+
+		// Check for syntax errors
+		if (file.parser->getNumberOfSyntaxErrors() != 0)
+		{
+			cerr << "ERROR: syntax error during parsing" << endl;
+			return false;
+		}
+
+		programs.push_back(file.tree->prog());
+	}
+
+	// Create a Control Flow Graph (CFG)
+	CFG cfg;
+
+	if (debugInfo)
+	{
+		cfg.setDebugInfo(sourceFiles);
+	}
+
+	// Visit the parse trees and generate intermediate representation (IR) code
+	CodeGenVisitor v(errorHandler, cfg);
+	v.setSeparateCompilation(separateCompilation);
+	v.visitPrograms(programs, sourceFiles);
+
+	// Perform static analysis on functions (those of a translation unit may be called from the others)
+	if (!separateCompilation)
+	{
+		v.getGlobalSymbolTable()->checkUsedFunctions(errorHandler);
+	}
+
+	// Check for errors
+	if (errorHandler.hasError())
+	{
+		return false;
+	}
+
+	// Optimize the program as a whole, before choosing the standard functions to generate
+	// (the optimizer owns the variables of the inlined bodies, so it lives until the back end ran)
+	WholeProgram program(&cfg, v.getGlobalSymbolTable());
+
+	if (wholeProgram)
+	{
+		program.optimize();
+	}
+
+	// Optimize every function (the optimizer owns the symbol tables of the optimized functions)
+	Optimizer optimizer(&cfg);
+	optimizer.setLoopInvariantCodeMotion(loopInvariantCodeMotion);
+
+	if (optimization && pipelined)
+	{
+		// The functions are optimized one at a time by the code generation, the previous ones are already written
+		optimizer.prepare();
+		cfg.setOptimizer(&optimizer);
+	}
+	else if (optimization)
+	{
+		optimizer.optimize();
+	}
+
+	// Place standard functions in the code if needed
+	cfg.initStandardFunctions(v.getGlobalSymbolTable());
+
+	// Rewrite the assembly of every function while it is generated
+	Peephole peephole;
+
+	if (optimization)
+	{
+		cfg.setPeephole(&peephole);
+	}
+
+	bool succeeded = backEnd(cfg);
+
+	if (statistics)
+	{
+		peephole.printStatistics(cerr);
+	}
+
+	return succeeded;
+}
+
+// Compile, assemble and link the source files into an executable
+int Driver::buildExecutable(vector<string> sourceFiles, string outputFile)
+{
+	// A dead assembler must be reported as an error, not kill the compiler
+	signal(SIGPIPE, SIG_IGN);
+
+	// Directory holding the object files until they are linked
+	char directoryTemplate[] = "/tmp/ifcc-XXXXXX";
+
+	if (mkdtemp(directoryTemplate) == nullptr)
+	{
+		cerr << "error: cannot create a temporary directory" << endl;
+		return 1;
+	}
+
+	string objectDirectory = directoryTemplate;
+	vector<string> objectFiles;
+	vector<pid_t> assemblers;
+	bool success = true;
+
+	// Every file is a translation unit, unless the files form one program
+	vector<vector<string>> units;
+
+	for (string sourceFile : sourceFiles)
+	{
+		if (wholeProgram && !units.empty())
+		{
+			units.back().push_back(sourceFile);
+		}
+		else
+		{
+			units.push_back({sourceFile});
+		}
+	}
+
+	for (size_t i = 0; i < units.size() && success; i++)
+	{
+		string objectFile = objectDirectory + "/" + to_string(i) + ".o";
+		int inputFd;
+
+		// The assembler starts while the file is still being parsed
+		pid_t assembler = spawnAssembler(objectFile, inputFd);
+
+		if (assembler < 0)
+		{
+			success = false;
+			break;
+		}
+
+		// Stream the assembly into the pipe
+		__gnu_cxx::stdio_filebuf<char> pipeBuffer(inputFd, ios::out);
+		ostream pipe(&pipeBuffer);
+		success = compileProgram(units[i], pipe);
+
+		// Closing the pipe lets the assembler finish in the background
+		pipeBuffer.close();
+
+		if (!success)
+		{
+			kill(assembler, SIGTERM);
+		}
+
+		assemblers.push_back(assembler);
+		objectFiles.push_back(objectFile);
+	}
+
+	// Wait for all the assemblers running in parallel
+	for (pid_t assembler : assemblers)
+	{
+		bool assembled = waitFor(assembler);
+		success = success && assembled;
+	}
+
+	// Link the objects together
+	if (success)
+	{
+		success = link(objectFiles, outputFile);
+	}
+
+	// Remove the intermediate files
+	for (string objectFile : objectFiles)
+	{
+		unlink(objectFile.c_str());
+	}
+
+	rmdir(objectDirectory.c_str());
+
+	return success ? 0 : 1;
+}
+
+// Compile a source file in memory and run its main with the arguments (JIT)
+int Driver::run(string sourceFile, vector<string> arguments)
+{
+	stringstream assembly;
+
+	if (!compile(sourceFile, assembly))
+	{
+		return 1;
+	}
+
+	JIT jit;
+
+	if (!jit.assemble(assembly.str()))
+	{
+		return 1;
+	}
+
+	// The program sees its source file as argv[0]
+	arguments.insert(arguments.begin(), sourceFile);
+
+	return jit.run(arguments);
+}
+
+// Spawn an assembler producing objectFile from what is written on inputFd
+pid_t Driver::spawnAssembler(string objectFile, int& inputFd)
+{
+	int fds[2];
+
+	if (pipe2(fds, O_CLOEXEC) < 0)
+	{
+		cerr << "error: cannot create a pipe to the assembler" << endl;
+		return -1;
+	}
+
+	pid_t pid = fork();
+
+	if (pid < 0)
+	{
+		cerr << "error: cannot start the assembler" << endl;
+		close(fds[0]);
+		close(fds[1]);
+		return -1;
+	}
+
+	if (pid == 0) // Assembler process: reads the assembly on its standard input
+	{
+		dup2(fds[0], STDIN_FILENO);
+		execlp("as", "as", "--64", "-o", objectFile.c_str(), (char *) nullptr);
+		cerr << "error: cannot execute as" << endl;
+		_exit(127);
+	}
+
+	close(fds[0]);
+	inputFd = fds[1];
+
+	return pid;
+}
+
+// Link the object files into an executable
+bool Driver::link(vector<string> objectFiles, string outputFile)
+{
+	vector<string> arguments = {"gcc", "-o", outputFile};
+	arguments.insert(arguments.end(), objectFiles.begin(), objectFiles.end());
+
+	pid_t pid = fork();
+
+	if (pid < 0)
+	{
+		cerr << "error: cannot start the linker" << endl;
+		return false;
+	}
+
+	if (pid == 0) // Linker process
+	{
+		vector<char *> argv;
+
+		for (string& argument : arguments)
+		{
+			argv.push_back(&argument[0]);
+		}
+
+		argv.push_back(nullptr);
+		execvp(argv[0], argv.data());
+		cerr << "error: cannot execute gcc" << endl;
+		_exit(127);
+	}
+
+	return waitFor(pid);
+}
+
+// Wait for a child process and return whether it succeeded
+bool Driver::waitFor(pid_t pid)
+{
+	int status;
+
+	if (waitpid(pid, &status, 0) < 0)
+	{
+		return false;
+	}
+
+	return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
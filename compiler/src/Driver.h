@@ -0,0 +1,121 @@
+/*************************************************************************
+                          PLD Compilateur: Driver
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <Driver> (file Driver.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <iostream>
+#include <string>
+#include <vector>
+#include <functional>
+#include <sys/types.h>
+#include "Preprocessor.h"
+
+using namespace std;
+
+class CFG;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <Driver> :
+//
+// The Driver runs the whole compilation pipeline of a source file
+// (preprocessing, parsing, IR generation, static checks, assembly
+// generation). Its preprocessor, and so the cache of the included files,
+// is shared by all the files it compiles.
+// In whole program mode, all the files are parsed into one CFG, so that
+// the functions main cannot reach are removed and the small functions
+// are inlined whatever their file; they give a single assembly output.
+// In executable mode, the assembly of every function is streamed through
+// a pipe into a spawned assembler while the following functions are
+// still being optimized and generated; the assemblers of the different
+// files run in parallel and the objects are linked once they have all
+// finished.
+// In run mode, the assembly is encoded in memory by the JIT and main is
+// called directly. In interpreter mode, the IR itself is executed.
+// The cost report estimates the generated code without running it.
+// Unless disabled (-O0), every function is optimized once the IR is
+// checked (right before its code is generated when the back end writes
+// assembly), and the assembly of every function goes through the
+// peephole optimizer.
+//
+//------------------------------------------------------------------------
+
+class Driver
+{
+	public:
+
+		// Constructor
+		Driver();
+
+		// Compile a source file and write the generated assembly to o
+		bool compile(string sourceFile, ostream& o);
+
+		// Compile source files as one program and write the generated assembly to o
+		bool compileProgram(vector<string> sourceFiles, ostream& o);
+
+		// Compile, assemble and link the source files into an executable
+		int buildExecutable(vector<string> sourceFiles, string outputFile);
+
+		// Compile a source file in memory and run its main with the arguments (JIT)
+		int run(string sourceFile, vector<string> arguments);
+
+		// Compile a source file and execute its IR with the interpreter
+		int interpret(string sourceFile, vector<string> arguments, bool profile);
+
+		// Compile a source file and write the static cost and stack usage of its functions to o
+		bool costReport(string sourceFile, ostream& o);
+
+		// Setter for the separate compilation mode (the files are parts of one program)
+		void setSeparateCompilation(bool enabled);
+
+		// Setter for the whole program mode (the files form one program, optimized as a whole)
+		void setWholeProgram(bool enabled);
+
+		// Setter for the optimizations of the functions (SSA form, packed stack frames)
+		void setOptimization(bool enabled);
+
+		// Setter for the motion of the loop invariants out of the loops (-O2, see LoopInvariantCodeMotion)
+		void setLoopInvariantCodeMotion(bool enabled);
+
+		// Setter for the statistics of the optimizations (number of rewrites, written to cerr)
+		void setStatistics(bool enabled);
+
+		// Setter for the debug information (line tables of the generated code)
+		void setDebugInfo(bool enabled);
+
+		// Add a directory searched by #include (-I)
+		void addIncludePath(string path);
+
+		// Define a macro for every source file (-D)
+		void defineMacro(string definition);
+
+	protected:
+
+		// Parse source files, build and check the IR of their program, then hand the CFG to the back end
+		// (pipelined: the back end only generates the assembly, every function is optimized right before its code)
+		bool buildIR(vector<string> sourceFiles, bool pipelined, function<bool(CFG&)> backEnd);
+
+		// Spawn an assembler producing objectFile from what is written on inputFd
+		pid_t spawnAssembler(string objectFile, int& inputFd);
+
+		// Link the object files into an executable
+		bool link(vector<string> objectFiles, string outputFile);
+
+		// Wait for a child process and return whether it succeeded
+		bool waitFor(pid_t pid);
+
+		bool separateCompilation = false;	// Whether main is optional and external functions are allowed
+		bool wholeProgram = false;			// Whether the files form one program (unreachable functions removed, calls inlined)
+		bool optimization = true;			// Whether the functions are optimized (-O1)
+		bool loopInvariantCodeMotion = false;	// Whether the loop invariants move out of the loops (-O2)
+		bool debugInfo = false;				// Whether the assembly maps the instructions to source lines
+		bool statistics = false;			// Whether the number of rewrites of the optimizations is written
+		Preprocessor preprocessor;			// Preprocessor of the source files (keeps the included files)
+};
@@ -33,8 +33,15 @@ void ErrorHandler::signal(int severity, string message, int lineNumber)
 		}
 	}
 
-	// Generate and print error message
-	generateErrorMessage(severity, message, lineNumber);
+	// Keep the diagnostic, or generate and print error message
+	if (recording)
+	{
+		diagnostics.push_back({severity, message, lineNumber});
+	}
+	else
+	{
+		generateErrorMessage(severity, message, lineNumber);
+	}
 }
 
 // Generate error message based on severity
@@ -43,6 +50,12 @@ void ErrorHandler::generateErrorMessage(int severity, string message, int lineNu
 	// Output error type
     cerr << errorValues[severity];
 
+	// Output the source file if the program has several ones
+	if (!sourceFile.empty())
+	{
+		cerr << " in " << sourceFile;
+	}
+
 	// Output line number if provided
 	if (lineNumber >= 0) 
 	{
@@ -63,4 +76,22 @@ bool ErrorHandler::hasError()
 bool ErrorHandler::hasWarning() 
 {
 	return warning;
-}
\ No newline at end of file
+}
+
+// Setter for the recording mode
+void ErrorHandler::setRecording(bool enabled)
+{
+	recording = enabled;
+}
+
+// Getter for the recorded diagnostics
+vector<diagnosticStruct>& ErrorHandler::getDiagnostics()
+{
+	return diagnostics;
+}
+
+// Setter for the source file named in the messages
+void ErrorHandler::setSourceFile(string file)
+{
+	sourceFile = file;
+}
@@ -12,12 +12,21 @@
 //--------------------------------------------------- Called interfaces
 #include <iostream>
 #include <string>
+#include <vector>
 
 using namespace std;
 
 //------------------------------------------------------------------ Types
 enum errorType {ERROR, WARNING}; // Enumeration for error types
 
+// Structure to represent a recorded error or warning
+struct diagnosticStruct
+{
+	int severity;		// ERROR or WARNING
+	string message;		// Text of the diagnostic
+	int lineNumber;		// Line of the diagnostic (-1 if none)
+};
+
 //------------------------------------------------------------------------
 //
 // Goal of class <ErrorHandler> :
@@ -38,6 +47,15 @@ class ErrorHandler
         
         // Check if there are any warnings
         bool hasWarning();
+
+        // Setter for the recording mode (the diagnostics are kept instead of printed)
+        void setRecording(bool enabled);
+
+        // Getter for the recorded diagnostics
+        vector<diagnosticStruct>& getDiagnostics();
+
+        // Setter for the source file named in the messages (none if empty)
+        void setSourceFile(string file);
         
     protected:
 
@@ -47,6 +65,13 @@ class ErrorHandler
         // Flags to indicate presence of error or warning
         bool error = false;
         bool warning = false;
+
+        // Recorded diagnostics (recording mode)
+        bool recording = false;
+        vector<diagnosticStruct> diagnostics;
+
+        // Source file of the diagnostics (programs of several files)
+        string sourceFile = "";
         
         // Generate error message based on severity
         void generateErrorMessage(int severity, string message, int lineNumber); 
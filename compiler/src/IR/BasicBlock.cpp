@@ -9,6 +9,7 @@
 //---- Implementation of class <BasicBlock> (file BasicBlock.cpp) -----/
 
 #include "BasicBlock.h"
+#include "CFG.h"
 
 using namespace std;
 
@@ -27,18 +28,33 @@ void BasicBlock::addInstruction(IRInstr::Operation op, vector<string> parameters
 {
 	// Create a new instruction and add it to the instruction list
 	IRInstr * instruction = new IRInstr(this, op, parameters, sT);
+	instruction->setLine(cfg->getCurrentLine());
 	instructionList.push_back(instruction);
 }
 
 // Generates Assembly code for the basic block
 void BasicBlock::generateASM(ostream &o) 
 {
-	// Write the label of the basic block
+	// Write the label of the basic block (padded to 16 bytes if at most 10 bytes are needed)
+	if (aligned)
+	{
+		o << "\t.p2align 4,,10" << endl;
+	}
+
 	o << label << ":" << endl;
 
 	// Generate Assembly code for each instruction in the instruction list
+	int lastLine = 0;
+
 	for (IRInstr * i : instructionList) 
 	{
+		// Map the instructions to their source line (again at every label, as it can be jumped to)
+		if (cfg->hasDebugInfo() && i->getLine() > 0 && i->getLine() != lastLine)
+		{
+			lastLine = i->getLine();
+			o << "\t.loc\t " << sourceFile << " " << lastLine << endl;
+		}
+
 		i->generateASM(o);
 	}
 }
@@ -7,6 +7,7 @@
 *************************************************************************/
 
 //------ Interface of class <BasicBlock> (file BasicBlock.h) -------/
+#pragma once
 
 //--------------------------------------------------- Called interfaces
 #include <vector>
@@ -39,7 +40,7 @@ class BasicBlock
 	public:
 
 		// Constructor.
-		BasicBlock(CFG * cfg, string label) : cfg(cfg), label(label) {};
+		BasicBlock(CFG * cfg, string label, string functionName) : cfg(cfg), label(label), functionName(functionName) {};
 		
 		// Destructor.
 		~BasicBlock();
@@ -80,6 +81,42 @@ class BasicBlock
 			return instructionList; 
 		};
 
+		// Get the number of instructions in this basic block (without copying the list).
+		size_t getNbInstructions()
+		{
+			return instructionList.size();
+		};
+
+		// Get the last instruction of this basic block, its terminator (nullptr if the block is empty).
+		IRInstr* getLastInstruction()
+		{
+			return instructionList.empty() ? nullptr : instructionList.back();
+		};
+
+		// Replace the list of instructions (the removed ones must be deleted by the caller).
+		void setInstructionList(list<IRInstr*> instructions)
+		{
+			instructionList = instructions;
+		};
+
+		// Get the number of the source file of the instructions (line tables).
+		int getSourceFile()
+		{
+			return sourceFile;
+		};
+
+		// Set the number of the source file of the instructions.
+		void setSourceFile(int file)
+		{
+			sourceFile = file;
+		};
+
+		// Set whether the label of the basic block is aligned (the first block of a loop).
+		void setAligned(bool a)
+		{
+			aligned = a;
+		};
+
 		// Get the CFG containing this basic block.
 		CFG* getCFG() 
 		{ 
@@ -89,6 +126,12 @@ class BasicBlock
 		// Get the label of this basic block.
 		string getLabel();
 
+		// Get the name of the function this basic block belongs to.
+		string getFunctionName() 
+		{ 
+			return functionName; 
+		};
+
 	protected:
 
 		BasicBlock* exit_true = nullptr;   	// Pointer to the true exit of this bloc
@@ -97,4 +140,7 @@ class BasicBlock
 		CFG* cfg; 							// Pointer to the CFG containing this basic block
 		list<IRInstr*> instructionList;		// List of instructions in this basic block
 		string testVariableName;			// Name of the test variable associated with this basic block
+		string functionName;				// Name of the function this basic block belongs to
+		int sourceFile = 1;					// Number of the source file of the instructions (line tables)
+		bool aligned = false;				// Whether the label is aligned on 16 bytes
 };
\ No newline at end of file
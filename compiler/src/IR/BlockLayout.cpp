@@ -0,0 +1,230 @@
+/*************************************************************************
+                          PLD Compilateur: BlockLayout
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <BlockLayout> (file BlockLayout.cpp) -----/
+
+#include "BlockLayout.h"
+#include <cmath>
+#include <algorithm>
+#include <set>
+
+using namespace std;
+
+// Probability that a conditional jump stays in its loop (Ball and Larus)
+static const double LOOP_BRANCH_PROBABILITY = 0.88;
+
+// Probability that a conditional jump does not take the way to a return (Ball and Larus)
+static const double RETURN_BRANCH_PROBABILITY = 0.72;
+
+// Constructor
+BlockLayout::BlockLayout(CFG * cfg, string functionName) : cfg(cfg), functionName(functionName), blocks(cfg->getFunctionBlocks(functionName))
+{
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		indexes[blocks[i]] = i;
+	}
+}
+
+// Order the blocks of the function
+void BlockLayout::run()
+{
+	// A block falling through to the next one must stay before it
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		if (instructions.empty() || !instructions.back()->isTerminator())
+		{
+			return;
+		}
+	}
+
+	DominatorTree tree(blocks);
+	LoopNest nest(tree);
+	loops = nest.getLoops();
+	findReturnPaths(tree);
+
+	// The edges, from the heaviest one (a jump to the next block in the CFG first, then in the order of the CFG)
+	vector<layoutEdgeStruct> edges;
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (BasicBlock * successor : tree.getSuccessors(bb))
+		{
+			double frequency = pow(LOOP_ITERATIONS, nest.getLoopDepth(bb));
+			edges.push_back({bb, successor, frequency * probability(bb, successor, tree)});
+		}
+	}
+
+	stable_sort(edges.begin(), edges.end(), [this](const layoutEdgeStruct& a, const layoutEdgeStruct& b)
+	{
+		bool isNextA = indexes[a.to] == indexes[a.from] + 1;
+		bool isNextB = indexes[b.to] == indexes[b.from] + 1;
+		return a.weight != b.weight ? a.weight > b.weight : isNextA > isNextB;
+	});
+
+	// Every block starts alone in its chain, an edge joins the chain ending with its origin to the chain starting with its target
+	vector<vector<BasicBlock*>> chains;
+	unordered_map<BasicBlock*, int> chainOf;
+
+	for (BasicBlock * bb : blocks)
+	{
+		chainOf[bb] = chains.size();
+		chains.push_back({bb});
+	}
+
+	for (layoutEdgeStruct& edge : edges)
+	{
+		int from = chainOf[edge.from];
+		int to = chainOf[edge.to];
+		bool isJoined = from != to && chains[from].back() == edge.from && chains[to].front() == edge.to && edge.to != blocks.front();
+
+		if (isJoined)
+		{
+			for (BasicBlock * bb : chains[to])
+			{
+				chains[from].push_back(bb);
+				chainOf[bb] = from;
+			}
+
+			chains[to].clear();
+		}
+	}
+
+	// The chain of the entry comes first, then the chain the placed blocks jump to the most (the first in the order of the CFG if none):
+	// the chains left are kept sorted by the weight of the jumps from the placed blocks, then by the position of their first block
+	vector<BasicBlock*> layout;
+	vector<bool> placed(chains.size(), false);
+	vector<double> connections(chains.size(), 0.0);
+	set<pair<double, int>> candidates;
+	unordered_map<BasicBlock*, vector<layoutEdgeStruct*>> exits;
+
+	for (layoutEdgeStruct& edge : edges)
+	{
+		exits[edge.from].push_back(&edge);
+	}
+
+	for (vector<BasicBlock*>& chain : chains)
+	{
+		if (!chain.empty())
+		{
+			candidates.insert({0.0, indexes[chain.front()]});
+		}
+	}
+
+	int nextChain = chainOf[blocks.front()];
+
+	while (nextChain >= 0)
+	{
+		layout.insert(layout.end(), chains[nextChain].begin(), chains[nextChain].end());
+		placed[nextChain] = true;
+		candidates.erase({-connections[nextChain], indexes[chains[nextChain].front()]});
+
+		for (BasicBlock * bb : chains[nextChain])
+		{
+			for (layoutEdgeStruct * edge : exits[bb])
+			{
+				int to = chainOf[edge->to];
+
+				if (!placed[to])
+				{
+					candidates.erase({-connections[to], indexes[chains[to].front()]});
+					connections[to] += edge->weight;
+					candidates.insert({-connections[to], indexes[chains[to].front()]});
+				}
+			}
+		}
+
+		nextChain = candidates.empty() ? -1 : chainOf[blocks[candidates.begin()->second]];
+	}
+
+	cfg->setFunctionBlocks(functionName, layout);
+
+	// The first block of every loop is aligned (the entry already is)
+	unordered_map<BasicBlock*, int> positions;
+
+	for (size_t i = 0; i < layout.size(); i++)
+	{
+		positions[layout[i]] = i;
+		layout[i]->setAligned(false);
+	}
+
+	for (loopStruct& loop : loops)
+	{
+		BasicBlock * first = *min_element(loop.blocks.begin(), loop.blocks.end(), [&positions](BasicBlock * a, BasicBlock * b) { return positions[a] < positions[b]; });
+
+		if (first != layout.front())
+		{
+			first->setAligned(true);
+		}
+	}
+}
+
+// Find the blocks only jumping to a return
+void BlockLayout::findReturnPaths(DominatorTree& tree)
+{
+	bool changed = true;
+
+	while (changed)
+	{
+		changed = false;
+
+		for (BasicBlock * bb : blocks)
+		{
+			IRInstr * terminator = bb->getInstructionList().back();
+			bool isReturnPath = terminator->getOp() == IRInstr::ret
+				|| (terminator->getOp() == IRInstr::absolute_jump && returnPaths.count(tree.getSuccessors(bb).front()) > 0);
+
+			if (isReturnPath && returnPaths.insert(bb).second)
+			{
+				changed = true;
+			}
+		}
+	}
+}
+
+// Probability that a block jumps to one of its successors
+double BlockLayout::probability(BasicBlock * bb, BasicBlock * successor, DominatorTree& tree)
+{
+	vector<BasicBlock*>& successors = tree.getSuccessors(bb);
+
+	if (successors.size() != 2)
+	{
+		return 1.0;
+	}
+
+	BasicBlock * other = successors[0] == successor ? successors[1] : successors[0];
+
+	// A jump leaving a loop is unlikely
+	if (isLoopExit(bb, successor) != isLoopExit(bb, other))
+	{
+		return isLoopExit(bb, successor) ? 1 - LOOP_BRANCH_PROBABILITY : LOOP_BRANCH_PROBABILITY;
+	}
+
+	// A jump to a return is unlikely
+	if (returnPaths.count(successor) != returnPaths.count(other))
+	{
+		return returnPaths.count(successor) > 0 ? 1 - RETURN_BRANCH_PROBABILITY : RETURN_BRANCH_PROBABILITY;
+	}
+
+	return 0.5;
+}
+
+// Whether an edge leaves a loop containing its origin
+bool BlockLayout::isLoopExit(BasicBlock * from, BasicBlock * to)
+{
+	for (loopStruct& loop : loops)
+	{
+		if (loop.blocks.count(from) > 0 && loop.blocks.count(to) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,86 @@
+/*************************************************************************
+                          PLD Compilateur: BlockLayout
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <BlockLayout> (file BlockLayout.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "CFG.h"
+#include "DominatorTree.h"
+#include "LoopNest.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Structure to represent an edge of the control flow, weighted by how often it is estimated to be taken
+struct layoutEdgeStruct
+{
+	BasicBlock * from;		// Block ending with the jump
+	BasicBlock * to;		// Block jumped to
+	double weight;			// Estimated number of times the edge is taken (per call of the function)
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <BlockLayout> :
+//
+// The BlockLayout orders the blocks of a function so that the jumps
+// most likely taken are to the next block: the peephole then removes
+// them (or inverts the condition of a conditional jump so that its
+// other exit is jumped to). No profile is known, so the frequencies are
+// estimated from the structure of the function: a block in n loops runs
+// 10^n times, a conditional jump stays in its loop rather than leave it
+// (a back edge is likely), and does not take the way to a return when
+// the other exit does not return (Ball and Larus). The edges are then
+// taken from the heaviest one, and join the chain of blocks ending with
+// their origin to the chain starting with their target (Pettis and
+// Hansen): a while loop has its test at its bottom, the body falls
+// through to it and it jumps back to the body. The chain of the entry
+// comes first, then the chain the placed blocks jump to the most (the
+// cold blocks, such as a return, end up last). The first block of
+// every loop is aligned on 16 bytes (when it costs at most 10 bytes).
+// Every block must end with its terminator (see Optimizer): the order
+// of the blocks then does not change what the function computes.
+//
+//------------------------------------------------------------------------
+
+class BlockLayout
+{
+	public:
+
+		// Constructor
+		BlockLayout(CFG * cfg, string functionName);
+
+		// Order the blocks of the function
+		void run();
+
+	protected:
+
+		// Find the blocks only jumping to a return
+		void findReturnPaths(DominatorTree& tree);
+
+		// Probability that a block jumps to one of its successors
+		double probability(BasicBlock * bb, BasicBlock * successor, DominatorTree& tree);
+
+		// Whether an edge leaves a loop containing its origin
+		bool isLoopExit(BasicBlock * from, BasicBlock * to);
+
+		static const int LOOP_ITERATIONS = 10;		// Estimated number of iterations of a loop
+
+		CFG * cfg;												// CFG containing the function
+		string functionName;									// Name of the function
+		vector<BasicBlock*> blocks;								// Blocks of the function, in the order of the CFG
+		unordered_map<BasicBlock*, int> indexes;				// Index of every block in the order of the CFG
+		vector<loopStruct> loops;								// Natural loops of the function
+		unordered_set<BasicBlock*> returnPaths;					// Blocks only jumping to a return
+};
@@ -0,0 +1,107 @@
+/*************************************************************************
+                          PLD Compilateur: BranchFusion
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <BranchFusion> (file BranchFusion.cpp) -----/
+
+#include "BranchFusion.h"
+#include "Target.h"
+
+using namespace std;
+
+// Constructor
+BranchFusion::BranchFusion(CFG * cfg, SSA * ssa) : blocks(cfg->getFunctionBlocks(ssa->getFunctionName()))
+{
+}
+
+// Fuse the comparisons into the conditional jumps testing them
+void BranchFusion::run()
+{
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			for (int index : instr->getSourceIndexes())
+			{
+				nbUses[instr->getParameters().at(index)]++;
+			}
+		}
+	}
+
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		if (instructions.size() < 2 || instructions.back()->getOp() != IRInstr::conditional_jump || instructions.back()->getParameters().size() > 3)
+		{
+			continue;
+		}
+
+		IRInstr * jump = instructions.back();
+		string test = jump->getParameters().at(0);
+		string falseLabel = jump->getParameters().at(1);
+		string trueLabel = jump->getParameters().at(2);
+		list<IRInstr*>::iterator it = prev(instructions.end(), 2);
+		list<IRInstr*> removed;
+
+		// A ! of the test jumps to the other exit on its operand
+		while ((*it)->getOp() == IRInstr::op_not && (*it)->getDestination() == test && nbUses[test] == 1)
+		{
+			test = (*it)->getParameters().at(0);
+			swap(falseLabel, trueLabel);
+			removed.push_back(*it);
+
+			if (it == instructions.begin())
+			{
+				break;
+			}
+
+			--it;
+		}
+
+		// The comparison of the test (its operands are read in place, the immediate second)
+		IRInstr * comparison = *it;
+		vector<string> operands = comparison->getParameters();
+		bool isFused = isComparison(comparison) && comparison->getDestination() == test && nbUses[test] == 1 && !IRInstr::isImmediate(operands[0]);
+
+		if (isFused)
+		{
+			jump->setOperation(IRInstr::conditional_jump, {operands[0], falseLabel, trueLabel, operands[1], targetOperation(comparison->getOp()).name});
+			removed.push_back(comparison);
+		}
+		else if (!removed.empty())
+		{
+			jump->setOperation(IRInstr::conditional_jump, {test, falseLabel, trueLabel});
+		}
+
+		for (IRInstr * instr : removed)
+		{
+			instructions.remove(instr);
+			delete instr;
+		}
+
+		bb->setInstructionList(instructions);
+	}
+}
+
+// Whether an instruction computes a comparison
+bool BranchFusion::isComparison(IRInstr * instr)
+{
+	switch (instr->getOp())
+	{
+		case IRInstr::cmp_eq:
+		case IRInstr::cmp_neq:
+		case IRInstr::cmp_lt:
+		case IRInstr::cmp_gt:
+		case IRInstr::cmp_eqlt:
+		case IRInstr::cmp_eqgt:
+			return true;
+
+		default:
+			return false;
+	}
+}
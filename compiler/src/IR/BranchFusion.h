@@ -0,0 +1,57 @@
+/*************************************************************************
+                          PLD Compilateur: BranchFusion
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <BranchFusion> (file BranchFusion.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "CFG.h"
+#include "SSA.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <BranchFusion> :
+//
+// The BranchFusion merges the comparison computing the test of a
+// conditional jump into the jump, in a function in SSA form: the jump
+// compares the operands of the comparison itself and jumps on its
+// condition (cmpl then jl), instead of turning the flags into a boolean
+// (setl, movzbl, store) and comparing the boolean with 0. The two
+// instructions are adjacent, so the processor can fuse them into one.
+// A ! of the test (or of its ! ...) jumps to the other exit instead.
+// The comparison must be the instruction before the jump (or before its
+// !), and its result read by the jump only: the operands are then read
+// where they were, and live no longer. A fused jump keeps its exits in
+// its second and third parameters: {left, falseLabel, trueLabel, right,
+// comparison}.
+//
+//------------------------------------------------------------------------
+
+class BranchFusion
+{
+	public:
+
+		// Constructor
+		BranchFusion(CFG * cfg, SSA * ssa);
+
+		// Fuse the comparisons into the conditional jumps testing them
+		void run();
+
+	protected:
+
+		// Whether an instruction computes a comparison
+		static bool isComparison(IRInstr * instr);
+
+		vector<BasicBlock*> blocks;								// Blocks of the function
+		unordered_map<string, int> nbUses;						// Number of instructions reading every variable
+};
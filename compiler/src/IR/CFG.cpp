@@ -9,13 +9,15 @@
 //---- Implementation of class <CFG> (file CFG.cpp) -----/
 
 #include "CFG.h"
+#include "Peephole.h"
+#include "Optimizer.h"
 
 using namespace std;
 
 // Constructor
 CFG::CFG() 
 {
-	setCurrentBB(createBB());
+	// Every function gets its own entry block (see createFunctionBB)
 }
 
 // Destructor
@@ -43,10 +45,11 @@ void CFG::initStandardFunctions(SymbolTable * symbolTable)
 BasicBlock* CFG::createBB() 
 {
 	// Generate a unique name for the BasicBlock
-	string bbName = ".bb" + to_string(bbList.size());
+	string bbName = ".bb" + to_string(nbCreatedBB++);
 
 	// Create a new BasicBlock
-	BasicBlock * bb = new BasicBlock(this, bbName);
+	BasicBlock * bb = new BasicBlock(this, bbName, currentFunction);
+	bb->setSourceFile(currentSourceFile);
 
 	// Add the BasicBlock to the list of BasicBlocks
 	bbList.push_back(bb);
@@ -57,6 +60,54 @@ BasicBlock* CFG::createBB()
 	return bb;
 }
 
+// Method to create the entry BasicBlock of a new function and make it current
+BasicBlock* CFG::createFunctionBB(string functionName) 
+{
+	currentFunction = functionName;
+	return createBB();
+}
+
+// Method to create a new BasicBlock of the function of bb, generated right after it
+BasicBlock* CFG::createBBAfter(BasicBlock * bb) 
+{
+	BasicBlock * newBB = new BasicBlock(this, ".bb" + to_string(nbCreatedBB++), bb->getFunctionName());
+	newBB->setSourceFile(bb->getSourceFile());
+
+	// The blocks of a function stay contiguous
+	bbList.insert(find(bbList.begin(), bbList.end(), bb) + 1, newBB);
+
+	return newBB;
+}
+
+// Method to remove a BasicBlock from the CFG and delete it
+void CFG::removeBB(BasicBlock * bb) 
+{
+	bbList.erase(find(bbList.begin(), bbList.end(), bb));
+
+	if (currentBB == bb)
+	{
+		currentBB = nullptr;
+	}
+
+	delete bb;
+}
+
+// Method to remove several BasicBlocks from the CFG and delete them (in one pass over the list)
+void CFG::removeBBs(const unordered_set<BasicBlock*>& blocks) 
+{
+	bbList.erase(remove_if(bbList.begin(), bbList.end(), [&](BasicBlock * bb) { return blocks.count(bb) > 0; }), bbList.end());
+
+	if (blocks.count(currentBB) > 0)
+	{
+		currentBB = nullptr;
+	}
+
+	for (BasicBlock * bb : blocks)
+	{
+		delete bb;
+	}
+}
+
 // Method to generate Assembly code from the CFG
 void CFG::generateASM(ostream& o) 
 {
@@ -66,19 +117,113 @@ void CFG::generateASM(ostream& o)
 	// Generate standard library functions
 	generateStandardFunctions(o);
 
-	// Generate Assembly code for each BasicBlock in the CFG
-	for (BasicBlock * bb : bbList) 
+	// Generate Assembly code for each BasicBlock in the CFG, one function at a time
+	ostringstream functionCode;
+
+	for (size_t i = 0; i < bbList.size(); i++) 
 	{
-		bb->generateASM(o);
+		// The optimizer only changes the blocks of this function, and its entry stays first (at i)
+		bool isFirstOfFunction = i == 0 || bbList[i - 1]->getFunctionName() != bbList[i]->getFunctionName();
+
+		if (isFirstOfFunction && optimizer != nullptr) 
+		{
+			optimizer->optimizeFunction(bbList[i]->getFunctionName());
+		}
+
+		bbList[i]->generateASM(functionCode);
+
+		// Hand every finished function to the consumer (e.g. an assembler reading a pipe)
+		bool isLastOfFunction = i + 1 == bbList.size() || bbList[i + 1]->getFunctionName() != bbList[i]->getFunctionName();
+		
+		if (isLastOfFunction) 
+		{
+			generateFunctionEnd(functionCode, bbList[i]->getFunctionName());
+			o << (peephole != nullptr ? peephole->optimize(functionCode.str()) : functionCode.str());
+			o.flush();
+			functionCode.str("");
+		}
 	}
+
+	// Generate the Assembly epilogue
+	generateASMEpilogue(o);
 }
 
 // Method to generate the Assembly prologue
 void CFG::generateASMPrologue(ostream& o) 
 {
+	for (size_t i = 0; i < debugSourceFiles.size(); i++)
+	{
+		// Escape the path for the assembler string
+		string path = "";
+
+		for (char c : debugSourceFiles[i])
+		{
+			path += (c == '"' || c == '\\') ? string("\\") + c : string(1, c);
+		}
+
+		// The first file names the object, every file gets a number for the .loc directives
+		if (i == 0)
+		{
+			o << ".file\t \"" << path << "\"" << endl;
+		}
+
+		o << ".file\t " << i + 1 << " \"" << path << "\"" << endl;
+	}
+
 	o << ".text" << endl;
 }
 
+// Method to generate the Assembly epilogue
+void CFG::generateASMEpilogue(ostream& o) 
+{
+	// The generated code never needs an executable stack
+	o << ".section\t .note.GNU-stack,\"\",@progbits" << endl;
+}
+
+// Method to close the unwind information and give the size of a function
+void CFG::generateFunctionEnd(ostream& o, string functionName) 
+{
+	o << "\t.cfi_endproc" << endl;
+	o << ".size\t " << functionName << ", .-" << functionName << endl << endl;
+}
+
+// Getter for the BasicBlocks, in the order of the generated code
+vector<BasicBlock*>& CFG::getBasicBlocks() 
+{
+	return bbList;
+}
+
+// Getter for the BasicBlocks of a function, in the order of the generated code
+vector<BasicBlock*> CFG::getFunctionBlocks(string functionName) 
+{
+	vector<BasicBlock*> blocks;
+
+	for (BasicBlock * bb : bbList) 
+	{
+		if (bb->getFunctionName() == functionName) 
+		{
+			blocks.push_back(bb);
+		}
+	}
+
+	return blocks;
+}
+
+// Setter for the order of the BasicBlocks of a function in the generated code
+void CFG::setFunctionBlocks(string functionName, vector<BasicBlock*> blocks) 
+{
+	// The blocks take the places of the blocks of the function, in their new order
+	size_t next = 0;
+
+	for (size_t i = 0; i < bbList.size(); i++) 
+	{
+		if (bbList[i]->getFunctionName() == functionName) 
+		{
+			bbList[i] = blocks.at(next++);
+		}
+	}
+}
+
 // Getter for the current BasicBlock
 BasicBlock* CFG::getCurrentBB() 
 {
@@ -91,6 +236,48 @@ void CFG::setCurrentBB(BasicBlock * bb)
 	currentBB = bb;
 }
 
+// Getter for the source line of the instructions being created
+int CFG::getCurrentLine() 
+{
+	return currentLine;
+}
+
+// Setter for the source line of the instructions being created
+void CFG::setCurrentLine(int line) 
+{
+	currentLine = line;
+}
+
+// Enable the line tables (DWARF .file/.loc directives) for the source files
+void CFG::setDebugInfo(vector<string> sourceFiles) 
+{
+	debugSourceFiles = sourceFiles;
+}
+
+// Setter for the number of the source file of the BasicBlocks being created
+void CFG::setCurrentSourceFile(int file) 
+{
+	currentSourceFile = file;
+}
+
+// Whether the line tables are generated
+bool CFG::hasDebugInfo() 
+{
+	return !debugSourceFiles.empty();
+}
+
+// Setter for the peephole optimizer rewriting the assembly of every function
+void CFG::setPeephole(Peephole * peephole) 
+{
+	this->peephole = peephole;
+}
+
+// Setter for the optimizer run on every function right before its code is generated (none if nullptr)
+void CFG::setOptimizer(Optimizer * optimizer) 
+{
+	this->optimizer = optimizer;
+}
+
 // Method to generate standard library functions in the Assembly code
 void CFG::generateStandardFunctions(ostream& o) 
 {
@@ -110,9 +297,14 @@ void CFG::generateStandardFunctions(ostream& o)
 // Method to generate Assembly code for putchar function
 void CFG::generatePutchar(ostream& o) 
 {
+	o << ".type\t putchar, @function" << endl;
 	o << "putchar:" << endl;
+	o << "\t.cfi_startproc" << endl;
 	o << "\tpushq\t %rbp" << endl;
+	o << "\t.cfi_def_cfa_offset 16" << endl;
+	o << "\t.cfi_offset %rbp, -16" << endl;
 	o << "\tmovq\t %rsp, %rbp" << endl;
+	o << "\t.cfi_def_cfa_register %rbp" << endl;
 	o << "\tpushq\t	%rdi" << endl;
 	o << "\tmov\t $1, %rax" << endl;
 	o << "\tmov\t $1, %rdi" << endl;
@@ -122,15 +314,22 @@ void CFG::generatePutchar(ostream& o)
 	o << "\tadd\t $8, %rsp" << endl;
 	o << "\tmovl\t $1, %eax" << endl;
 	o << "\tleave" << endl;
-	o << "\tret" << endl << endl;
+	o << "\t.cfi_def_cfa %rsp, 8" << endl;
+	o << "\tret" << endl;
+	generateFunctionEnd(o, "putchar");
 }
 
 // Method to generate Assembly code for getchar function
 void CFG::generateGetchar(ostream& o) 
 {
+	o << ".type\t getchar, @function" << endl;
 	o << "getchar:" << endl;
+	o << "\t.cfi_startproc" << endl;
 	o << "\tpushq\t %rbp" << endl;
+	o << "\t.cfi_def_cfa_offset 16" << endl;
+	o << "\t.cfi_offset %rbp, -16" << endl;
 	o << "\tmovq\t %rsp, %rbp" << endl;
+	o << "\t.cfi_def_cfa_register %rbp" << endl;
 	o << "\txor\t %eax, %eax" << endl;
 	o << "\txor\t %edi, %edi" << endl;
 	o << "\tmovq\t 8(%rsp), %r8" << endl;
@@ -140,5 +339,7 @@ void CFG::generateGetchar(ostream& o)
 	o << "\tmovzbl\t 8(%rsp), %eax" << endl;
 	o << "\tmovq\t %r8, 8(%rsp)" << endl;
 	o << "\tleave" << endl;
-	o << "\tret" << endl << endl;
+	o << "\t.cfi_def_cfa %rsp, 8" << endl;
+	o << "\tret" << endl;
+	generateFunctionEnd(o, "getchar");
 }
\ No newline at end of file
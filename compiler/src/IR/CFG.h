@@ -15,15 +15,25 @@
 #include <iostream>
 #include <sstream>
 #include <stack>
+#include <unordered_set>
 #include <initializer_list>
 #include "BasicBlock.h"
 
+class Peephole;
+class Optimizer;
+
 //------------------------------------------------------------------------
 //
 // Goal of class <CFG> : 
 //
 // The CFG class represents the Control Flow Graph (CFG) of the program being compiled.
 // It is responsible for generating the Assembly code (ASM) from the CFG.
+// Every function is described by unwind directives (CFI), a type and a size;
+// with debug information, the instructions are also mapped to source lines.
+// The assembly of every function can go through a peephole optimizer
+// before it is written. A function can also be optimized right before
+// its code is generated: the code of the previous functions is then
+// consumed (e.g. by an assembler reading a pipe) while it is optimized.
 //
 //------------------------------------------------------------------------
 
@@ -42,16 +52,58 @@ class CFG
 
 		// Method to create a new BasicBlock and add it to the CFG
 		BasicBlock* createBB(); 
+
+		// Method to create the entry BasicBlock of a new function and make it current
+		BasicBlock* createFunctionBB(string functionName);
+
+		// Method to create a new BasicBlock of the function of bb, generated right after it (the current BasicBlock is unchanged)
+		BasicBlock* createBBAfter(BasicBlock * bb);
+
+		// Method to remove a BasicBlock from the CFG and delete it
+		void removeBB(BasicBlock * bb);
+
+		// Method to remove several BasicBlocks from the CFG and delete them (in one pass over the list)
+		void removeBBs(const unordered_set<BasicBlock*>& blocks);
 		
 		// Method to initialize standard library functions in the CFG
 		void initStandardFunctions(SymbolTable * symbolTable);
 
+		// Getter for the BasicBlocks, in the order of the generated code
+		vector<BasicBlock*>& getBasicBlocks();
+
+		// Getter for the BasicBlocks of a function, in the order of the generated code (the entry first)
+		vector<BasicBlock*> getFunctionBlocks(string functionName);
+
+		// Setter for the order of the BasicBlocks of a function in the generated code (the same blocks, the entry first)
+		void setFunctionBlocks(string functionName, vector<BasicBlock*> blocks);
+
 		// Getter for the current BasicBlock
 		BasicBlock* getCurrentBB();
 		
 		// Setter for the current BasicBlock
 		void setCurrentBB(BasicBlock * bb);
 
+		// Getter for the source line of the instructions being created
+		int getCurrentLine();
+
+		// Setter for the source line of the instructions being created
+		void setCurrentLine(int line);
+
+		// Enable the line tables (DWARF .file/.loc directives) for the source files (numbered from 1)
+		void setDebugInfo(vector<string> sourceFiles);
+
+		// Setter for the number of the source file of the BasicBlocks being created
+		void setCurrentSourceFile(int file);
+
+		// Whether the line tables are generated
+		bool hasDebugInfo();
+
+		// Setter for the peephole optimizer rewriting the assembly of every function (none if nullptr)
+		void setPeephole(Peephole * peephole);
+
+		// Setter for the optimizer run on every function right before its code is generated (none if nullptr)
+		void setOptimizer(Optimizer * optimizer);
+
 	protected:
 
 		// Method to generate standard library functions in the Assembly code
@@ -68,12 +120,36 @@ class CFG
 
 		// Method to generate the Assembly epilogue
 		void generateASMEpilogue(ostream& o);
+
+		// Method to close the unwind information and give the size of a function
+		void generateFunctionEnd(ostream& o, string functionName);
 		
 		// List of BasicBlocks in the CFG
 		vector<BasicBlock*> bbList; 
 
 		// Pointer to the current BasicBlock being processed
-		BasicBlock* currentBB;
+		BasicBlock* currentBB = nullptr;
+
+		// Number of BasicBlocks created (numbers the labels, even after removals)
+		int nbCreatedBB = 0;
+
+		// Name of the function whose BasicBlocks are being created
+		string currentFunction = "";
+
+		// Source line given to the instructions being created
+		int currentLine = 0;
+
+		// Source files of the line tables (empty without debug information)
+		vector<string> debugSourceFiles;
+
+		// Number of the source file given to the BasicBlocks being created
+		int currentSourceFile = 1;
+
+		// Peephole optimizer of the assembly of the functions (none if nullptr)
+		Peephole * peephole = nullptr;
+
+		// Optimizer of the functions whose code is generated (none if nullptr)
+		Optimizer * optimizer = nullptr;
 	
 	private:
 
@@ -0,0 +1,331 @@
+/*************************************************************************
+                          PLD Compilateur: CFGSimplification
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <CFGSimplification> (file CFGSimplification.cpp) -----/
+
+#include "CFGSimplification.h"
+#include "DominatorTree.h"
+#include <map>
+#include <algorithm>
+#include <unordered_set>
+
+using namespace std;
+
+// Constructor
+CFGSimplification::CFGSimplification(CFG * cfg, string functionName) : cfg(cfg), functionName(functionName)
+{
+}
+
+// Simplify the blocks of the function
+void CFGSimplification::run()
+{
+	blocks = cfg->getFunctionBlocks(functionName);
+
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		if (instructions.empty() || !instructions.back()->isTerminator())
+		{
+			return;
+		}
+	}
+
+	bool changed = true;
+
+	while (changed)
+	{
+		changed = threadJumps();
+		changed = removeUnreachableBlocks() || changed;
+		changed = mergeReturns() || changed;
+		changed = mergeBlocks() || changed;
+	}
+
+	updateExits();
+}
+
+// Make the jumps skip the blocks only jumping elsewhere
+bool CFGSimplification::threadJumps()
+{
+	bool changed = false;
+	threadedLabels.clear();
+
+	for (BasicBlock * bb : blocks)
+	{
+		IRInstr * terminator = bb->getLastInstruction();
+		vector<int> labelIndexes = terminator->getOp() == IRInstr::conditional_jump ? vector<int>({1, 2}) : terminator->getOp() == IRInstr::absolute_jump ? vector<int>({0}) : vector<int>();
+
+		for (int index : labelIndexes)
+		{
+			string label = terminator->getParameters().at(index);
+			string threaded = threadedLabel(terminator, index, label);
+
+			if (threaded != label)
+			{
+				terminator->setParameter(index, threaded);
+				changed = true;
+			}
+		}
+
+		// Both exits are the same block
+		vector<string> parameters = terminator->getParameters();
+
+		if (terminator->getOp() == IRInstr::conditional_jump && parameters[1] == parameters[2])
+		{
+			terminator->setOperation(IRInstr::absolute_jump, {parameters[1]});
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+// Label a jump of a terminator to a label ends up at
+string CFGSimplification::threadedLabel(IRInstr * terminator, int index, string label)
+{
+	// The labels of the walk all end at its result: it is kept for them, so that no chain is walked twice
+	vector<string> path;
+	unordered_set<string> visited = {label};
+
+	while (true)
+	{
+		unordered_map<string, string>::iterator known = threadedLabels.find(threadingKey(terminator, index, label));
+
+		if (known != threadedLabels.end())
+		{
+			label = known->second;
+			break;
+		}
+
+		BasicBlock * target = blockOf(label);
+
+		if (target == nullptr || target->getNbInstructions() != 1)
+		{
+			break;
+		}
+
+		// The target only jumps: elsewhere, or on the test that led to it (the same exit is taken again)
+		IRInstr * jump = target->getLastInstruction();
+		vector<string> parameters = jump->getParameters();
+		string next = label;
+
+		if (jump->getOp() == IRInstr::absolute_jump)
+		{
+			next = parameters[0];
+		}
+		else if (jump->getOp() == IRInstr::conditional_jump && terminator->getOp() == IRInstr::conditional_jump)
+		{
+			vector<string> test = terminator->getParameters();
+			bool isSameTest = test.size() == parameters.size() && test[0] == parameters[0] && (test.size() <= 3 || (test[3] == parameters[3] && test[4] == parameters[4]));
+
+			if (isSameTest)
+			{
+				next = parameters[index];
+			}
+		}
+
+		if (next == label)
+		{
+			break;
+		}
+
+		// A cycle of jumps: where the walk stops depends on the label it started from, nothing is kept
+		if (!visited.insert(next).second)
+		{
+			return label;
+		}
+
+		path.push_back(label);
+		label = next;
+	}
+
+	for (string& start : path)
+	{
+		threadedLabels[threadingKey(terminator, index, start)] = label;
+	}
+
+	return label;
+}
+
+// Key of the walks of threadedLabel that follow the same blocks from a label
+string CFGSimplification::threadingKey(IRInstr * terminator, int index, string label)
+{
+	// An absolute jump only follows absolute jumps, a conditional jump also follows the blocks testing the same condition
+	if (terminator->getOp() != IRInstr::conditional_jump)
+	{
+		return label;
+	}
+
+	vector<string> test = terminator->getParameters();
+	string key = label + " " + to_string(index) + " " + test[0];
+
+	if (test.size() > 3)
+	{
+		key += " " + test[3] + " " + test[4];
+	}
+
+	return key;
+}
+
+// Remove the blocks the entry does not reach
+bool CFGSimplification::removeUnreachableBlocks()
+{
+	DominatorTree tree(blocks);
+	vector<BasicBlock*> reachable;
+	unordered_set<BasicBlock*> unreachable;
+
+	for (BasicBlock * bb : blocks)
+	{
+		if (tree.isReachable(bb))
+		{
+			reachable.push_back(bb);
+		}
+		else
+		{
+			blocksByLabel.erase(bb->getLabel());
+			unreachable.insert(bb);
+		}
+	}
+
+	cfg->removeBBs(unreachable);
+	blocks = reachable;
+
+	return !unreachable.empty();
+}
+
+// Make the identical returns jump to the same return
+bool CFGSimplification::mergeReturns()
+{
+	// The first block holding only a return, for every returned value
+	map<vector<string>, BasicBlock*> returns;
+
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		if (instructions.size() == 1 && instructions.front()->getOp() == IRInstr::ret)
+		{
+			returns.emplace(instructions.front()->getParameters(), bb);
+		}
+	}
+
+	bool changed = false;
+
+	for (BasicBlock * bb : blocks)
+	{
+		IRInstr * terminator = bb->getInstructionList().back();
+
+		if (terminator->getOp() != IRInstr::ret)
+		{
+			continue;
+		}
+
+		map<vector<string>, BasicBlock*>::iterator it = returns.find(terminator->getParameters());
+
+		if (it != returns.end() && it->second != bb)
+		{
+			terminator->setOperation(IRInstr::absolute_jump, {it->second->getLabel()});
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+// Merge the blocks with the only block jumping to them
+bool CFGSimplification::mergeBlocks()
+{
+	DominatorTree tree(blocks);
+	unordered_set<BasicBlock*> removed;
+
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+		IRInstr * terminator = instructions.back();
+
+		if (removed.count(bb) > 0 || terminator->getOp() != IRInstr::absolute_jump)
+		{
+			continue;
+		}
+
+		// The line tables name one source file per block
+		BasicBlock * next = blockOf(terminator->getParameters().at(0));
+		bool isMerged = next != bb && next != blocks.front() && removed.count(next) == 0 && tree.getPredecessors(next).size() == 1 && next->getSourceFile() == bb->getSourceFile();
+
+		if (!isMerged)
+		{
+			continue;
+		}
+
+		instructions.pop_back();
+		delete terminator;
+
+		for (IRInstr * instr : next->getInstructionList())
+		{
+			instr->setBasicBlock(bb);
+			instructions.push_back(instr);
+		}
+
+		bb->setInstructionList(instructions);
+		next->setInstructionList({});
+		removed.insert(next);
+	}
+
+	for (BasicBlock * bb : removed)
+	{
+		blocksByLabel.erase(bb->getLabel());
+	}
+
+	blocks.erase(remove_if(blocks.begin(), blocks.end(), [&](BasicBlock * bb) { return removed.count(bb) > 0; }), blocks.end());
+	cfg->removeBBs(removed);
+
+	return !removed.empty();
+}
+
+// Set the exits of the blocks from their terminators
+void CFGSimplification::updateExits()
+{
+	for (BasicBlock * bb : blocks)
+	{
+		IRInstr * terminator = bb->getInstructionList().back();
+		vector<string> parameters = terminator->getParameters();
+
+		switch (terminator->getOp())
+		{
+			case IRInstr::conditional_jump:
+				bb->setExitTrue(blockOf(parameters.at(2)));
+				bb->setExitFalse(blockOf(parameters.at(1)));
+				break;
+
+			case IRInstr::absolute_jump:
+				bb->setExitTrue(blockOf(parameters.at(0)));
+				bb->setExitFalse(nullptr);
+				break;
+
+			default:
+				bb->setExitTrue(nullptr);
+				bb->setExitFalse(nullptr);
+				break;
+		}
+	}
+}
+
+// Block of a label
+BasicBlock* CFGSimplification::blockOf(string label)
+{
+	if (blocksByLabel.empty())
+	{
+		for (BasicBlock * bb : blocks)
+		{
+			blocksByLabel[bb->getLabel()] = bb;
+		}
+	}
+
+	unordered_map<string, BasicBlock*>::iterator it = blocksByLabel.find(label);
+	return it == blocksByLabel.end() ? nullptr : it->second;
+}
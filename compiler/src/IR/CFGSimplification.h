@@ -0,0 +1,83 @@
+/*************************************************************************
+                          PLD Compilateur: CFGSimplification
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <CFGSimplification> (file CFGSimplification.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "CFG.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <CFGSimplification> :
+//
+// The CFGSimplification removes the trivial blocks of a function (not in
+// SSA form: it has no phi), until nothing changes:
+// - a jump to a block only jumping elsewhere goes there directly, and a
+//   conditional jump to a block only testing the same condition goes to
+//   the exit that test takes (nothing changed the condition in between);
+//   a conditional jump whose two exits are the same block is absolute;
+// - the blocks the entry does not reach anymore are removed;
+// - a return identical to the return of a block holding only it jumps to
+//   that block instead (the epilogue is written once);
+// - a block jumping to a block that only it jumps to is merged with it.
+// The code generator creates such blocks for every if (its end) and
+// every while (the block before its test), and the optimizations add
+// some (a folded condition, an edge that needs no copy).
+// The exits of the blocks are then updated from their jumps.
+// Every block must end with its terminator (see Optimizer).
+//
+//------------------------------------------------------------------------
+
+class CFGSimplification
+{
+	public:
+
+		// Constructor
+		CFGSimplification(CFG * cfg, string functionName);
+
+		// Simplify the blocks of the function
+		void run();
+
+	protected:
+
+		// Make the jumps skip the blocks only jumping elsewhere (true if a jump changed)
+		bool threadJumps();
+
+		// Label a jump of a terminator to a label ends up at (index: the parameter of the label)
+		string threadedLabel(IRInstr * terminator, int index, string label);
+
+		// Key of the walks of threadedLabel that follow the same blocks from a label
+		string threadingKey(IRInstr * terminator, int index, string label);
+
+		// Remove the blocks the entry does not reach (true if one was removed)
+		bool removeUnreachableBlocks();
+
+		// Make the identical returns jump to the same return (true if a return changed)
+		bool mergeReturns();
+
+		// Merge the blocks with the only block jumping to them (true if one was merged)
+		bool mergeBlocks();
+
+		// Set the exits of the blocks from their terminators
+		void updateExits();
+
+		// Block of a label (nullptr if not in the function)
+		BasicBlock* blockOf(string label);
+
+		CFG * cfg;												// CFG containing the function
+		string functionName;									// Name of the function
+		vector<BasicBlock*> blocks;								// Blocks of the function, in the order of the CFG
+		unordered_map<string, BasicBlock*> blocksByLabel;		// Block of every label
+		unordered_map<string, string> threadedLabels;			// Label every walk of threadedLabel ended at, during one threadJumps
+};
@@ -0,0 +1,88 @@
+/*************************************************************************
+                          PLD Compilateur: CopyPropagation
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <CopyPropagation> (file CopyPropagation.cpp) -----/
+
+#include "CopyPropagation.h"
+#include "Liveness.h"
+
+using namespace std;
+
+// Constructor
+CopyPropagation::CopyPropagation(CFG * cfg, SSA * ssa) : blocks(cfg->getFunctionBlocks(ssa->getFunctionName()))
+{
+}
+
+// Remove the moves into the temporaries
+void CopyPropagation::run()
+{
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		for (list<IRInstr*>::iterator it = instructions.begin(); it != instructions.end(); )
+		{
+			IRInstr * instr = *it;
+			bool isMove = instr->getOp() == IRInstr::copy || instr->getOp() == IRInstr::aff;
+			varStruct * source = isMove ? Liveness::variableOf(instr, 0) : nullptr;
+			varStruct * destination = isMove ? Liveness::variableOf(instr, 1) : nullptr;
+
+			// Only the temporaries of the code generator (!tmp) are replaced by their source
+			bool isForwarded = source != nullptr && destination != nullptr && destination->variableName[0] == '!' && source->variableType == destination->variableType;
+
+			if (isForwarded)
+			{
+				sources[destination->variableName] = source->variableName;
+				delete instr;
+				it = instructions.erase(it);
+				continue;
+			}
+
+			++it;
+		}
+
+		bb->setInstructionList(instructions);
+	}
+
+	if (sources.empty())
+	{
+		return;
+	}
+
+	// The readers of a removed destination read its source (a move of a move reads the first source)
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			for (int index : instr->getSourceIndexes())
+			{
+				string name = instr->getParameters().at(index);
+				string source = sourceOf(name);
+
+				if (source != name)
+				{
+					instr->setParameter(index, source);
+				}
+			}
+		}
+	}
+}
+
+// Variable replacing a variable
+string CopyPropagation::sourceOf(string name)
+{
+	unordered_map<string, string>::iterator it = sources.find(name);
+
+	while (it != sources.end())
+	{
+		name = it->second;
+		it = sources.find(name);
+	}
+
+	return name;
+}
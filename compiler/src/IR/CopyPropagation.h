@@ -0,0 +1,59 @@
+/*************************************************************************
+                          PLD Compilateur: CopyPropagation
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <CopyPropagation> (file CopyPropagation.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "CFG.h"
+#include "SSA.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <CopyPropagation> :
+//
+// The CopyPropagation removes the moves (copy and aff) of a function in
+// SSA form into a temporary of the code generator (!tmp) from a variable
+// of the same type: the temporary is replaced by the source in every
+// instruction reading it. In SSA form the source is written once, before
+// the move, so it holds the same value wherever the temporary is read,
+// and the later optimizations see the variable itself (x / 10 is the
+// same value whether x went through a temporary or not).
+// A move into a variable of the source program is kept: forwarding it
+// would make the versions of its source live longer, and conflict with
+// their next versions. It is removed when SSA form is left instead, by
+// coalescing the two variables when their lives do not overlap (see
+// SSA), like the moves left by the phis. A move between two types (an
+// int stored into a char, or a char extended to an int) changes the
+// value: it is always kept.
+//
+//------------------------------------------------------------------------
+
+class CopyPropagation
+{
+	public:
+
+		// Constructor
+		CopyPropagation(CFG * cfg, SSA * ssa);
+
+		// Remove the moves into the temporaries
+		void run();
+
+	protected:
+
+		// Variable replacing a variable (itself if none)
+		string sourceOf(string name);
+
+		vector<BasicBlock*> blocks;								// Blocks of the function
+		unordered_map<string, string> sources;					// Source of every removed move, by destination
+};
@@ -0,0 +1,342 @@
+/*************************************************************************
+                          PLD Compilateur: CostModel
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <CostModel> (file CostModel.cpp) -----/
+
+#include "CostModel.h"
+
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <algorithm>
+
+using namespace std;
+
+// Latency of a load from the stack (store forwarding of a value just written)
+static const double LOAD_LATENCY = 5;
+
+// Reciprocal throughput of the memory accesses (two loads and one store per cycle)
+static const double LOAD_THROUGHPUT = 0.5;
+static const double STORE_THROUGHPUT = 1;
+
+// Stack used by the built-in functions: return address, %rbp and, for putchar, the character
+static const unordered_map<string, int> builtinStackDepths = {{"putchar", 24}, {"getchar", 16}};
+
+// Static initialization of the instruction costs (register operands)
+const unordered_map<string, instructionCostStruct> CostModel::instructionCosts = {
+	{"mov", {1, 0.25}}, {"movzb", {1, 0.25}}, {"movsb", {1, 0.25}},
+	{"add", {1, 0.25}}, {"sub", {1, 0.25}}, {"and", {1, 0.25}}, {"or", {1, 0.25}}, {"xor", {1, 0.25}},
+	{"cmp", {1, 0.25}}, {"test", {1, 0.25}}, {"neg", {1, 0.25}}, {"not", {1, 0.25}},
+	{"inc", {1, 0.25}}, {"dec", {1, 0.25}}, {"sal", {1, 0.5}}, {"shl", {1, 0.5}}, {"sar", {1, 0.5}}, {"shr", {1, 0.5}},
+	{"lea", {1, 0.5}}, {"imul", {3, 1}}, {"idiv", {26, 6}}, {"div", {26, 6}}, {"cltd", {1, 0.5}}, {"cqto", {1, 0.5}},
+	{"set", {1, 0.5}}, {"cmov", {1, 0.5}}, {"jcc", {1, 0.5}}, {"jmp", {1, 1}},
+	{"call", {3, 1}}, {"ret", {2, 1}}, {"push", {1, 1}}, {"pop", {1, 0.5}}, {"leave", {3, 1}},
+	{"syscall", {100, 100}}, {"nop", {0, 0.25}}
+};
+
+// Split the operands of an instruction on the commas outside parentheses
+static vector<string> splitOperands(string text)
+{
+	vector<string> operands;
+	string current = "";
+	int depth = 0;
+
+	for (char c : text)
+	{
+		depth += (c == '(') - (c == ')');
+
+		if (c == ',' && depth == 0)
+		{
+			operands.push_back(current);
+			current = "";
+		}
+		else if (c != ' ' && c != '\t')
+		{
+			current += c;
+		}
+	}
+
+	if (!current.empty())
+	{
+		operands.push_back(current);
+	}
+
+	return operands;
+}
+
+// Estimate the cost of one line of assembly (false if it is not an instruction)
+bool CostModel::estimateInstruction(string line, instructionCostStruct& cost)
+{
+	// Remove the comment and the label
+	line = line.substr(0, line.find('#'));
+	size_t colon = line.find(':');
+
+	if (colon != string::npos)
+	{
+		line = line.substr(colon + 1);
+	}
+
+	istringstream in(line);
+	string mnemonic, rest;
+	in >> mnemonic;
+	getline(in, rest);
+
+	if (mnemonic.empty() || mnemonic[0] == '.')
+	{
+		return false;
+	}
+
+	// Find the entry of the table: exact, without the size suffix, or by family
+	string key = mnemonic;
+
+	if (!instructionCosts.count(key) && string("bwlq").find(key.back()) != string::npos)
+	{
+		key = key.substr(0, key.size() - 1);
+	}
+
+	if (!instructionCosts.count(key))
+	{
+		if (mnemonic[0] == 'j')
+		{
+			key = "jcc";
+		}
+		else if (mnemonic.compare(0, 3, "set") == 0)
+		{
+			key = "set";
+		}
+		else if (mnemonic.compare(0, 4, "cmov") == 0)
+		{
+			key = "cmov";
+		}
+	}
+
+	auto entry = instructionCosts.find(key);
+	cost = entry != instructionCosts.end() ? entry->second : instructionCostStruct{1, 1};
+
+	// Memory operands: the reads add a load, the written destination a store
+	vector<string> operands = splitOperands(rest);
+	bool isMove = key == "mov" || key == "movzb" || key == "movsb" || key == "set";
+	bool isCompare = key == "cmp" || key == "test";
+	int loads = 0, stores = 0;
+
+	for (size_t i = 0; i < operands.size() && key != "lea"; i++)
+	{
+		if (operands[i].find('(') == string::npos)
+		{
+			continue;
+		}
+
+		// The destination is the last operand (single operands are read, e.g. idivl)
+		bool isDestination = i + 1 == operands.size() && (operands.size() > 1 || key == "set" || key == "neg" || key == "not");
+		loads += !isDestination || !isMove;
+		stores += isDestination && !isCompare;
+	}
+
+	// The stack itself is accessed by push (store), pop (load) and leave (load)
+	stores += (key == "push" || key == "call");
+	loads += (key == "pop" || key == "leave" || key == "ret");
+
+	cost.latency += loads * LOAD_LATENCY;
+	cost.throughput = max(cost.throughput, loads * LOAD_THROUGHPUT + stores * STORE_THROUGHPUT);
+
+	return true;
+}
+
+// Constructor: estimate the cost of every function of the CFG
+CostModel::CostModel(CFG * cfg)
+{
+	vector<BasicBlock*>& bbList = cfg->getBasicBlocks();
+	size_t first = 0;
+
+	// The basic blocks of a function are contiguous
+	for (size_t i = 0; i < bbList.size(); i++)
+	{
+		if (i + 1 == bbList.size() || bbList[i + 1]->getFunctionName() != bbList[i]->getFunctionName())
+		{
+			vector<BasicBlock*> blocks(bbList.begin() + first, bbList.begin() + i + 1);
+			analyseFunction(blocks);
+			first = i + 1;
+		}
+	}
+
+	// The calls with no code in this file are external (or built in)
+	for (functionCostStruct& function : functions)
+	{
+		for (callSiteStruct& call : function.calls)
+		{
+			if (!functionIndexes.count(call.callee) && !builtinStackDepths.count(call.callee))
+			{
+				externalFunctions.insert(call.callee);
+			}
+		}
+	}
+}
+
+// Estimate the cost of the basic blocks of one function
+void CostModel::analyseFunction(vector<BasicBlock*>& blocks)
+{
+	functionCostStruct function;
+	function.name = blocks[0]->getFunctionName();
+	function.localsSize = 0;
+	function.savedRegistersSize = 0;
+	function.frameSize = 0;
+
+	DominatorTree tree(blocks);
+	LoopNest nest(tree);
+
+	for (size_t b = 0; b < blocks.size(); b++)
+	{
+		blockCostStruct block = {blocks[b]->getLabel(), nest.getLoopDepth(blocks[b]), 0, 0, 0};
+
+		for (IRInstr * instr : blocks[b]->getInstructionList())
+		{
+			// The frame is the memory space of the function rounded like in the prologue (it ends with the saved registers)
+			if (instr->getOp() == IRInstr::prologue)
+			{
+				SymbolTable * frame = instr->getSymbolTable();
+				function.savedRegistersSize = 8 * frame->getRegisterSlots().size();
+				function.localsSize = frame->getMemorySpace() - function.savedRegistersSize;
+				function.frameSize = (frame->getMemorySpace() + 15) / 16 * 16;
+			}
+			else if (instr->getOp() == IRInstr::call)
+			{
+				int nbParams = stoi(instr->getParameters().at(2));
+				function.calls.push_back({instr->getParameters().at(0), max(nbParams - 6, 0) * 8});
+			}
+		}
+
+		// Price the instructions generated for the block
+		stringstream assembly;
+		blocks[b]->generateASM(assembly);
+		string line;
+
+		while (getline(assembly, line))
+		{
+			instructionCostStruct cost;
+
+			if (estimateInstruction(line, cost))
+			{
+				block.instructions++;
+				block.latency += cost.latency;
+				block.throughput += cost.throughput;
+			}
+		}
+
+		function.blocks.push_back(block);
+	}
+
+	functionIndexes[function.name] = functions.size();
+	functions.push_back(function);
+}
+
+// Worst-case stack depth of a function and its callees (-1 if unbounded)
+int CostModel::stackDepth(string name, map<string, int>& known, set<string>& active)
+{
+	if (known.count(name))
+	{
+		return known[name];
+	}
+
+	if (!functionIndexes.count(name))
+	{
+		// External functions are not counted
+		return builtinStackDepths.count(name) ? builtinStackDepths.at(name) : 0;
+	}
+
+	// Recursion: the depth depends on the values at run time
+	if (active.count(name))
+	{
+		return -1;
+	}
+
+	active.insert(name);
+
+	functionCostStruct& function = functions[functionIndexes[name]];
+	int deepestCall = 0;
+
+	for (callSiteStruct& call : function.calls)
+	{
+		int depth = stackDepth(call.callee, known, active);
+
+		if (depth < 0)
+		{
+			deepestCall = -1;
+			break;
+		}
+
+		deepestCall = max(deepestCall, call.pushedBytes + depth);
+	}
+
+	active.erase(name);
+
+	// Return address, saved %rbp and frame, then the deepest call
+	known[name] = deepestCall < 0 ? -1 : 16 + function.frameSize + deepestCall;
+
+	return known[name];
+}
+
+// Write the cost and stack usage report
+void CostModel::printReport(ostream& o)
+{
+	map<string, int> known;
+
+	o << "# static cost estimate: cycles per call (callees excluded), loops assumed to run "
+	  << LOOP_ITERATIONS << " times" << endl;
+	o << fixed << setprecision(1);
+
+	for (functionCostStruct& function : functions)
+	{
+		set<string> active;
+		int depth = stackDepth(function.name, known, active);
+		double latency = 0, throughput = 0;
+		int maxLoopDepth = 0;
+
+		for (blockCostStruct& block : function.blocks)
+		{
+			double weight = pow(LOOP_ITERATIONS, block.loopDepth);
+			latency += weight * block.latency;
+			throughput += weight * block.throughput;
+			maxLoopDepth = max(maxLoopDepth, block.loopDepth);
+		}
+
+		o << endl << "function " << function.name << endl;
+		o << "  frame:          " << function.frameSize << " bytes (" << function.localsSize << " bytes of variables, " << function.savedRegistersSize << " bytes of saved registers)" << endl;
+		o << "  stack depth:    " << (depth < 0 ? string("unbounded (recursive calls)") : to_string(depth) + " bytes") << endl;
+		o << "  loop depth:     " << maxLoopDepth << endl;
+		o << "  cycles:         " << latency << " (dependent), " << throughput << " (independent)" << endl;
+
+		if (!function.calls.empty())
+		{
+			set<string> callees;
+
+			for (callSiteStruct& call : function.calls)
+			{
+				callees.insert(call.callee);
+			}
+
+			o << "  calls:         ";
+
+			for (string callee : callees)
+			{
+				o << " " << callee << (externalFunctions.count(callee) ? " (external)" : "");
+			}
+
+			o << endl;
+		}
+
+		o << "  " << left << setw(10) << "block" << right << setw(6) << "depth" << setw(8) << "instrs"
+		  << setw(11) << "dependent" << setw(13) << "independent" << setw(11) << "weighted" << endl;
+
+		for (blockCostStruct& block : function.blocks)
+		{
+			o << "  " << left << setw(10) << block.label << right << setw(6) << block.loopDepth << setw(8) << block.instructions
+			  << setw(11) << block.latency << setw(13) << block.throughput
+			  << setw(11) << pow(LOOP_ITERATIONS, block.loopDepth) * block.latency << endl;
+		}
+	}
+}
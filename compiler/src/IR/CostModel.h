@@ -0,0 +1,105 @@
+/*************************************************************************
+                          PLD Compilateur: CostModel
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <CostModel> (file CostModel.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <iostream>
+#include <unordered_map>
+#include <map>
+#include <set>
+#include "CFG.h"
+#include "LoopNest.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Structure to represent the cost of an x86-64 instruction
+struct instructionCostStruct
+{
+	double latency;		// Cycles before the result can be used
+	double throughput;	// Reciprocal throughput: cycles between two independent instructions
+};
+
+// Structure to represent the estimated cost of a basic block
+struct blockCostStruct
+{
+	string label;		// Label of the basic block
+	int loopDepth;		// Number of loops containing the basic block
+	int instructions;	// Number of emitted instructions
+	double latency;		// Cycles of one execution if the instructions are dependent
+	double throughput;	// Cycles of one execution if they are independent
+};
+
+// Structure to represent a call of a function to another one
+struct callSiteStruct
+{
+	string callee;		// Name of the called function
+	int pushedBytes;	// Bytes of parameters pushed on the stack for the call
+};
+
+// Structure to represent the estimated cost of a function
+struct functionCostStruct
+{
+	string name;					// Name of the function
+	vector<blockCostStruct> blocks;	// Basic blocks, in the order of the generated code
+	vector<callSiteStruct> calls;	// Calls made by the function
+	int localsSize;					// Bytes of the local variables (SymbolTable::getMemorySpace, saved registers excluded)
+	int savedRegistersSize;			// Bytes of the callee-saved registers saved by the prologue
+	int frameSize;					// Bytes reserved by the prologue (return address and %rbp excluded)
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <CostModel> :
+//
+// The CostModel statically estimates the execution cost of the generated
+// code, without running it. Every basic block is generated, and each
+// emitted instruction is priced from a latency/throughput table (recent
+// Intel cores, memory operands hitting the L1 cache). The blocks are
+// weighted by their loop depth, given by the LoopNest of the function.
+// It also reports the frame of every function and the worst-case stack
+// depth over the call graph.
+//
+//------------------------------------------------------------------------
+
+class CostModel
+{
+	public:
+
+		// Constructor: estimate the cost of every function of the CFG
+		CostModel(CFG * cfg);
+
+		// Write the cost and stack usage report
+		void printReport(ostream& o);
+
+		// Estimate the cost of one line of assembly (false if it is not an instruction)
+		static bool estimateInstruction(string line, instructionCostStruct& cost);
+
+		// Assumed number of iterations of every loop
+		static const int LOOP_ITERATIONS = 10;
+
+	protected:
+
+		// Estimate the cost of the basic blocks of one function
+		void analyseFunction(vector<BasicBlock*>& blocks);
+
+		// Worst-case stack depth of a function and its callees (-1 if unbounded)
+		int stackDepth(string name, map<string, int>& known, set<string>& active);
+
+		vector<functionCostStruct> functions;			// Estimated functions, in the order of the code
+		unordered_map<string, int> functionIndexes;		// Index of every function in functions
+		set<string> externalFunctions;					// Called functions with no known code
+
+		// Cost of the instructions, by mnemonic without size suffix
+		static const unordered_map<string, instructionCostStruct> instructionCosts;
+};
@@ -0,0 +1,238 @@
+/*************************************************************************
+                          PLD Compilateur: DeadCodeElimination
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <DeadCodeElimination> (file DeadCodeElimination.cpp) -----/
+
+#include "DeadCodeElimination.h"
+#include "DominatorTree.h"
+#include "Liveness.h"
+#include <map>
+
+using namespace std;
+
+// Constructor
+DeadCodeElimination::DeadCodeElimination(CFG * cfg, SSA * ssa, set<string>& pureFunctions) : cfg(cfg), ssa(ssa), pureFunctions(pureFunctions), blocks(cfg->getFunctionBlocks(ssa->getFunctionName()))
+{
+}
+
+// Remove the instructions whose result is never used
+void DeadCodeElimination::run()
+{
+	for (BasicBlock * bb : blocks)
+	{
+		// The wparams between two calls write the arguments of the second one
+		vector<IRInstr*> arguments;
+
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			int destinationIndex = instr->getDestinationIndex();
+			varStruct * destination = destinationIndex >= 0 ? Liveness::variableOf(instr, destinationIndex) : nullptr;
+
+			if (destination != nullptr)
+			{
+				definitions[destination] = instr;
+			}
+
+			if (instr->getOp() == IRInstr::wparam)
+			{
+				arguments.push_back(instr);
+			}
+			else if (instr->getOp() == IRInstr::call)
+			{
+				callArguments[instr] = arguments;
+				arguments.clear();
+			}
+		}
+	}
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			if (hasEffect(instr))
+			{
+				markLive(instr);
+			}
+		}
+	}
+
+	propagate();
+	sweep();
+}
+
+// Names of the functions of the CFG without loop nor effect
+set<string> DeadCodeElimination::findPureFunctions(CFG * cfg)
+{
+	map<string, vector<BasicBlock*>> functions;
+
+	for (BasicBlock * bb : cfg->getBasicBlocks())
+	{
+		functions[bb->getFunctionName()].push_back(bb);
+	}
+
+	// A function with a loop may not end: it is never pure
+	set<string> candidates;
+
+	for (pair<const string, vector<BasicBlock*>>& function : functions)
+	{
+		DominatorTree tree(function.second);
+		vector<BasicBlock*>& order = tree.getReversePostOrder();
+		bool hasLoop = false;
+
+		for (size_t i = 0; i < order.size() && !hasLoop; i++)
+		{
+			for (BasicBlock * successor : tree.getSuccessors(order[i]))
+			{
+				hasLoop = hasLoop || find(order.begin(), order.begin() + i + 1, successor) != order.begin() + i + 1;
+			}
+		}
+
+		if (!hasLoop)
+		{
+			candidates.insert(function.first);
+		}
+	}
+
+	// A function is pure once all its callees are (a recursive function never is, nor a caller of putchar)
+	set<string> pureFunctions;
+	bool changed = true;
+
+	while (changed)
+	{
+		changed = false;
+
+		for (const string& name : candidates)
+		{
+			if (pureFunctions.count(name) > 0)
+			{
+				continue;
+			}
+
+			bool isPure = true;
+
+			for (BasicBlock * bb : functions[name])
+			{
+				for (IRInstr * instr : bb->getInstructionList())
+				{
+					isPure = isPure && (instr->getOp() != IRInstr::call || pureFunctions.count(instr->getParameters().at(0)) > 0);
+				}
+			}
+
+			if (isPure)
+			{
+				pureFunctions.insert(name);
+				changed = true;
+			}
+		}
+	}
+
+	return pureFunctions;
+}
+
+// Whether an instruction has an effect, and so is live whatever its result
+bool DeadCodeElimination::hasEffect(IRInstr * instr)
+{
+	switch (instr->getOp())
+	{
+		case IRInstr::ret:
+		case IRInstr::conditional_jump:
+		case IRInstr::absolute_jump:
+		case IRInstr::prologue:
+			return true;
+
+		// A wparam lives with its call
+		case IRInstr::call:
+			return pureFunctions.count(instr->getParameters().at(0)) == 0;
+
+		default:
+			return false;
+	}
+}
+
+// Mark an instruction live (the first time)
+void DeadCodeElimination::markLive(IRInstr * instr)
+{
+	if (liveInstructions.insert(instr).second)
+	{
+		worklist.push_back(instr);
+	}
+}
+
+// Mark live the instructions used by the live ones
+void DeadCodeElimination::propagate()
+{
+	while (!worklist.empty())
+	{
+		IRInstr * instr = worklist.back();
+		worklist.pop_back();
+
+		for (int index : instr->getSourceIndexes())
+		{
+			varStruct * variable = Liveness::variableOf(instr, index);
+
+			if (variable == nullptr)
+			{
+				continue;
+			}
+
+			readVariables.insert(variable);
+
+			// A variable read before any assignment has no definition
+			unordered_map<varStruct*, IRInstr*>::iterator definition = definitions.find(variable);
+
+			if (definition != definitions.end())
+			{
+				markLive(definition->second);
+			}
+		}
+
+		if (instr->getOp() == IRInstr::call)
+		{
+			for (IRInstr * argument : callArguments[instr])
+			{
+				markLive(argument);
+			}
+		}
+	}
+}
+
+// Remove the dead instructions, and the results of the calls that are not read
+void DeadCodeElimination::sweep()
+{
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		for (list<IRInstr*>::iterator it = instructions.begin(); it != instructions.end(); )
+		{
+			IRInstr * instr = *it;
+
+			if (liveInstructions.count(instr) == 0)
+			{
+				delete instr;
+				it = instructions.erase(it);
+				continue;
+			}
+
+			// The result of a call that is not read goes to a void temporary, which is not stored
+			if (instr->getOp() == IRInstr::call)
+			{
+				varStruct * result = Liveness::variableOf(instr, 1);
+
+				if (result != nullptr && result->variableType != TYPE_VOID && readVariables.count(result) == 0)
+				{
+					instr->setParameter(1, ssa->createVariable(TYPE_VOID, instr->getLine()));
+				}
+			}
+
+			++it;
+		}
+
+		bb->setInstructionList(instructions);
+	}
+}
@@ -0,0 +1,80 @@
+/*************************************************************************
+                          PLD Compilateur: DeadCodeElimination
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <DeadCodeElimination> (file DeadCodeElimination.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include "CFG.h"
+#include "SSA.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <DeadCodeElimination> :
+//
+// The DeadCodeElimination removes the instructions of a function in SSA
+// form whose result is never used. Every variable of the frame is
+// renamed into versions, so a store overwritten before any read, or the
+// temporary of an expression statement, is a version that nothing reads:
+// removing the dead definitions also removes the dead stores of the
+// frame slots.
+// The instructions with an effect are live (jumps, returns, and the
+// calls with their wparams), then every instruction defining a variable
+// read by a live instruction is live, back to the definitions. The other
+// instructions are removed, dead phis and cycles of phis of the loops
+// included. A call whose result is not read no longer stores it (it
+// writes a void temporary), and a call to a pure function (no loop, and
+// only calls to pure functions, so it ends and only computes its result)
+// is removed when its result is not read. The calls to putchar, getchar,
+// or to a function of another file are always kept.
+//
+//------------------------------------------------------------------------
+
+class DeadCodeElimination
+{
+	public:
+
+		// Constructor
+		DeadCodeElimination(CFG * cfg, SSA * ssa, set<string>& pureFunctions);
+
+		// Remove the instructions whose result is never used
+		void run();
+
+		// Names of the functions of the CFG without loop nor effect (the blocks must end with their terminator)
+		static set<string> findPureFunctions(CFG * cfg);
+
+	protected:
+
+		// Whether an instruction has an effect, and so is live whatever its result
+		bool hasEffect(IRInstr * instr);
+
+		// Mark an instruction live (the first time)
+		void markLive(IRInstr * instr);
+
+		// Mark live the instructions used by the live ones
+		void propagate();
+
+		// Remove the dead instructions, and the results of the calls that are not read
+		void sweep();
+
+		CFG * cfg;													// CFG holding the function
+		SSA * ssa;													// SSA form of the function
+		set<string>& pureFunctions;									// Functions whose calls can be removed
+		vector<BasicBlock*> blocks;									// Blocks of the function
+		unordered_map<varStruct*, IRInstr*> definitions;			// Instruction writing every variable
+		unordered_map<IRInstr*, vector<IRInstr*>> callArguments;	// wparam instructions of every call
+		unordered_set<varStruct*> readVariables;					// Variables read by a live instruction
+		unordered_set<IRInstr*> liveInstructions;					// Instructions kept
+		vector<IRInstr*> worklist;									// Live instructions whose operands are not marked yet
+};
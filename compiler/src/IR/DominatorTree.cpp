@@ -0,0 +1,297 @@
+/*************************************************************************
+                          PLD Compilateur: DominatorTree
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <DominatorTree> (file DominatorTree.cpp) -----/
+
+#include "DominatorTree.h"
+
+using namespace std;
+
+// Constructor: analyse the blocks of a function
+DominatorTree::DominatorTree(vector<BasicBlock*> blocks) : blocks(blocks)
+{
+	for (BasicBlock * bb : blocks)
+	{
+		blocksByLabel[bb->getLabel()] = bb;
+		successors[bb];
+		predecessors[bb];
+	}
+
+	// Edges of the control flow
+	for (BasicBlock * bb : blocks)
+	{
+		for (string label : successorLabels(bb))
+		{
+			BasicBlock * successor = getBlock(label);
+
+			if (successor != nullptr && find(successors[bb].begin(), successors[bb].end(), successor) == successors[bb].end())
+			{
+				successors[bb].push_back(successor);
+				predecessors[successor].push_back(bb);
+			}
+		}
+	}
+
+	if (blocks.empty())
+	{
+		return;
+	}
+
+	// Postorder of the reachable blocks (iterative depth first search)
+	vector<BasicBlock*> postOrder;
+	vector<pair<BasicBlock*, size_t>> toVisit = {{blocks.front(), 0}};
+	unordered_map<BasicBlock*, bool> visited = {{blocks.front(), true}};
+
+	while (!toVisit.empty())
+	{
+		BasicBlock * bb = toVisit.back().first;
+		size_t next = toVisit.back().second++;
+
+		if (next < successors[bb].size())
+		{
+			BasicBlock * successor = successors[bb][next];
+
+			if (!visited[successor])
+			{
+				visited[successor] = true;
+				toVisit.push_back({successor, 0});
+			}
+		}
+		else
+		{
+			postOrderNumbers[bb] = postOrder.size();
+			postOrder.push_back(bb);
+			toVisit.pop_back();
+		}
+	}
+
+	reversePostOrder.assign(postOrder.rbegin(), postOrder.rend());
+
+	// Immediate dominators: intersect the dominators of the processed predecessors until stable
+	BasicBlock * entry = blocks.front();
+	immediateDominators[entry] = entry;
+	bool changed = true;
+
+	while (changed)
+	{
+		changed = false;
+
+		for (BasicBlock * bb : reversePostOrder)
+		{
+			if (bb == entry)
+			{
+				continue;
+			}
+
+			BasicBlock * newDominator = nullptr;
+
+			for (BasicBlock * predecessor : predecessors[bb])
+			{
+				if (immediateDominators.count(predecessor) == 0)
+				{
+					continue;
+				}
+
+				if (newDominator == nullptr)
+				{
+					newDominator = predecessor;
+					continue;
+				}
+
+				// The entry dominates every block: walking up from the other predecessors would only find it again
+				if (newDominator == entry)
+				{
+					break;
+				}
+
+				// Walk up from both blocks until they meet
+				BasicBlock * a = predecessor;
+				BasicBlock * b = newDominator;
+
+				while (a != b)
+				{
+					while (postOrderNumbers[a] < postOrderNumbers[b])
+					{
+						a = immediateDominators[a];
+					}
+
+					while (postOrderNumbers[b] < postOrderNumbers[a])
+					{
+						b = immediateDominators[b];
+					}
+				}
+
+				newDominator = a;
+			}
+
+			if (immediateDominators.count(bb) == 0 || immediateDominators[bb] != newDominator)
+			{
+				immediateDominators[bb] = newDominator;
+				changed = true;
+			}
+		}
+	}
+
+	// Tree and frontiers
+	for (BasicBlock * bb : reversePostOrder)
+	{
+		if (bb != entry)
+		{
+			children[immediateDominators[bb]].push_back(bb);
+		}
+	}
+
+	for (BasicBlock * bb : reversePostOrder)
+	{
+		vector<BasicBlock*> reachablePredecessors;
+
+		for (BasicBlock * predecessor : predecessors[bb])
+		{
+			if (isReachable(predecessor))
+			{
+				reachablePredecessors.push_back(predecessor);
+			}
+		}
+
+		if (reachablePredecessors.size() < 2)
+		{
+			continue;
+		}
+
+		// bb is in the frontier of the blocks dominating a predecessor but not bb (a walk stops at a block
+		// an other predecessor already reached: the rest of its walk is the same)
+		BasicBlock * dominator = immediateDominators[bb];
+
+		for (BasicBlock * runner : reachablePredecessors)
+		{
+			while (runner != dominator && (frontiers[runner].empty() || frontiers[runner].back() != bb))
+			{
+				frontiers[runner].push_back(bb);
+				runner = immediateDominators[runner];
+			}
+		}
+	}
+
+	numberTree(entry);
+}
+
+// Labels of the blocks a block jumps to
+vector<string> DominatorTree::successorLabels(BasicBlock * bb)
+{
+	list<IRInstr*> instructions = bb->getInstructionList();
+
+	if (instructions.empty())
+	{
+		return {};
+	}
+
+	IRInstr * last = instructions.back();
+
+	switch (last->getOp())
+	{
+		case IRInstr::conditional_jump:
+			return {last->getParameters().at(1), last->getParameters().at(2)};
+
+		case IRInstr::absolute_jump:
+			return {last->getParameters().at(0)};
+
+		default:
+			return {};
+	}
+}
+
+// Successors of a block
+vector<BasicBlock*>& DominatorTree::getSuccessors(BasicBlock * bb)
+{
+	return successors[bb];
+}
+
+// Predecessors of a block
+vector<BasicBlock*>& DominatorTree::getPredecessors(BasicBlock * bb)
+{
+	return predecessors[bb];
+}
+
+// Reachable blocks in reverse postorder
+vector<BasicBlock*>& DominatorTree::getReversePostOrder()
+{
+	return reversePostOrder;
+}
+
+// Whether a block is reachable from the entry
+bool DominatorTree::isReachable(BasicBlock * bb)
+{
+	return postOrderNumbers.count(bb) > 0;
+}
+
+// Immediate dominator of a block
+BasicBlock* DominatorTree::getImmediateDominator(BasicBlock * bb)
+{
+	if (!isReachable(bb) || bb == blocks.front())
+	{
+		return nullptr;
+	}
+
+	return immediateDominators[bb];
+}
+
+// Blocks immediately dominated by a block
+vector<BasicBlock*>& DominatorTree::getChildren(BasicBlock * bb)
+{
+	return children[bb];
+}
+
+// Dominance frontier of a block
+vector<BasicBlock*>& DominatorTree::getFrontier(BasicBlock * bb)
+{
+	return frontiers[bb];
+}
+
+// Whether a dominates b: b is numbered inside the subtree of a
+bool DominatorTree::dominates(BasicBlock * a, BasicBlock * b)
+{
+	if (!isReachable(a) || !isReachable(b))
+	{
+		return false;
+	}
+
+	return treeNumbers[a].first <= treeNumbers[b].first && treeNumbers[b].second <= treeNumbers[a].second;
+}
+
+// Block of a label
+BasicBlock* DominatorTree::getBlock(string label)
+{
+	unordered_map<string, BasicBlock*>::iterator it = blocksByLabel.find(label);
+	return it == blocksByLabel.end() ? nullptr : it->second;
+}
+
+// Number the blocks of the dominator tree
+void DominatorTree::numberTree(BasicBlock * root)
+{
+	int counter = 0;
+	vector<pair<BasicBlock*, size_t>> toVisit = {{root, 0}};
+	treeNumbers[root].first = counter++;
+
+	while (!toVisit.empty())
+	{
+		BasicBlock * bb = toVisit.back().first;
+		size_t next = toVisit.back().second++;
+
+		if (next < children[bb].size())
+		{
+			BasicBlock * child = children[bb][next];
+			treeNumbers[child].first = counter++;
+			toVisit.push_back({child, 0});
+		}
+		else
+		{
+			treeNumbers[bb].second = counter++;
+			toVisit.pop_back();
+		}
+	}
+}
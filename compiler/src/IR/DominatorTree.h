@@ -0,0 +1,90 @@
+/*************************************************************************
+                          PLD Compilateur: DominatorTree
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <DominatorTree> (file DominatorTree.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "BasicBlock.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <DominatorTree> :
+//
+// The DominatorTree describes the control flow of one function: the
+// successors of every block (the targets of its terminator), its
+// predecessors, and the dominance relation. A block A dominates a block B
+// when every path from the entry to B goes through A. The immediate
+// dominators are computed with the iterative algorithm of Cooper, Harvey
+// and Kennedy over the reverse postorder, then the dominance frontiers
+// (where the definitions of a block stop dominating, so where SSA form
+// needs phi instructions).
+// The blocks must end with their terminator (see Optimizer): a block is
+// left by its last instruction only. The blocks unreachable from the
+// entry have no dominator.
+//
+//------------------------------------------------------------------------
+
+class DominatorTree
+{
+	public:
+
+		// Constructor: analyse the blocks of a function (the first one is its entry)
+		DominatorTree(vector<BasicBlock*> blocks);
+
+		// Labels of the blocks a block jumps to (from its last instruction)
+		static vector<string> successorLabels(BasicBlock * bb);
+
+		// Successors of a block (without duplicates)
+		vector<BasicBlock*>& getSuccessors(BasicBlock * bb);
+
+		// Predecessors of a block (without duplicates, unreachable ones included)
+		vector<BasicBlock*>& getPredecessors(BasicBlock * bb);
+
+		// Reachable blocks in reverse postorder (the entry first)
+		vector<BasicBlock*>& getReversePostOrder();
+
+		// Whether a block is reachable from the entry
+		bool isReachable(BasicBlock * bb);
+
+		// Immediate dominator of a block (nullptr for the entry and the unreachable blocks)
+		BasicBlock* getImmediateDominator(BasicBlock * bb);
+
+		// Blocks immediately dominated by a block
+		vector<BasicBlock*>& getChildren(BasicBlock * bb);
+
+		// Dominance frontier of a block
+		vector<BasicBlock*>& getFrontier(BasicBlock * bb);
+
+		// Whether a dominates b (a block dominates itself)
+		bool dominates(BasicBlock * a, BasicBlock * b);
+
+		// Block of a label (nullptr if not in the function)
+		BasicBlock* getBlock(string label);
+
+	protected:
+
+		// Number the blocks of the dominator tree (for dominates)
+		void numberTree(BasicBlock * root);
+
+		vector<BasicBlock*> blocks;										// Blocks of the function, in the order of the CFG
+		unordered_map<string, BasicBlock*> blocksByLabel;				// Block of every label
+		unordered_map<BasicBlock*, vector<BasicBlock*>> successors;		// Successors of every block
+		unordered_map<BasicBlock*, vector<BasicBlock*>> predecessors;	// Predecessors of every block
+		vector<BasicBlock*> reversePostOrder;							// Reachable blocks in reverse postorder
+		unordered_map<BasicBlock*, int> postOrderNumbers;				// Number of every reachable block in postorder
+		unordered_map<BasicBlock*, BasicBlock*> immediateDominators;	// Immediate dominator of every reachable block
+		unordered_map<BasicBlock*, vector<BasicBlock*>> children;		// Children of every block in the tree
+		unordered_map<BasicBlock*, vector<BasicBlock*>> frontiers;		// Dominance frontier of every block
+		unordered_map<BasicBlock*, pair<int, int>> treeNumbers;			// Preorder and postorder numbers in the tree
+};
@@ -0,0 +1,223 @@
+/*************************************************************************
+                          PLD Compilateur: GlobalValueNumbering
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <GlobalValueNumbering> (file GlobalValueNumbering.cpp) -----/
+
+#include "GlobalValueNumbering.h"
+#include "Liveness.h"
+#include "Target.h"
+#include <set>
+
+using namespace std;
+
+// Constructor
+GlobalValueNumbering::GlobalValueNumbering(CFG * cfg, SSA * ssa) : ssa(ssa), blocks(cfg->getFunctionBlocks(ssa->getFunctionName())), tree(blocks)
+{
+}
+
+// Remove the operations computing a value already computed
+void GlobalValueNumbering::run()
+{
+	numberBlock(blocks.front());
+	replaceUses();
+}
+
+// Number the operations of a block and of the blocks it dominates
+void GlobalValueNumbering::numberBlock(BasicBlock * bb)
+{
+	list<IRInstr*> instructions = bb->getInstructionList();
+	vector<string> keys;
+
+	for (list<IRInstr*>::iterator it = instructions.begin(); it != instructions.end(); )
+	{
+		IRInstr * instr = *it;
+		vector<string> parameters = instr->getParameters();
+
+		// A constant is not removed (its load is cheap), but the operations on it are numbered by its value
+		if (instr->getOp() == IRInstr::ldconst)
+		{
+			Type type = Liveness::variableOf(instr, 2)->variableType;
+			constants[parameters[2]] = "#" + typeName(type) + ":" + to_string(SymbolTable::getCast(type, stoi(parameters[1])));
+			++it;
+			continue;
+		}
+
+		// A phi choosing the same variable on every edge (or its own result) is this variable
+		if (instr->getOp() == IRInstr::phi)
+		{
+			set<string> operands;
+
+			for (size_t i = 1; i < parameters.size(); i += 2)
+			{
+				if (leaderOf(parameters[i]) != parameters[0])
+				{
+					operands.insert(leaderOf(parameters[i]));
+				}
+			}
+
+			if (operands.size() == 1)
+			{
+				leaders[parameters[0]] = *operands.begin();
+				delete instr;
+				it = instructions.erase(it);
+				continue;
+			}
+		}
+
+		string key = keyOf(instr);
+
+		if (key.empty())
+		{
+			++it;
+			continue;
+		}
+
+		string destination = parameters.at(instr->getDestinationIndex());
+		unordered_map<string, string>::iterator found = available.find(key);
+
+		// The value is computed by a dominating block: its variable replaces the result
+		if (found != available.end())
+		{
+			leaders[destination] = found->second;
+			delete instr;
+			it = instructions.erase(it);
+			continue;
+		}
+
+		available[key] = destination;
+		keys.push_back(key);
+		++it;
+	}
+
+	bb->setInstructionList(instructions);
+
+	for (BasicBlock * child : tree.getChildren(bb))
+	{
+		numberBlock(child);
+	}
+
+	// The values of the block are not available in the blocks it does not dominate
+	for (string& key : keys)
+	{
+		available.erase(key);
+	}
+}
+
+// Key of the value computed by an instruction
+string GlobalValueNumbering::keyOf(IRInstr * instr)
+{
+	IRInstr::Operation op = instr->getOp();
+	vector<string> values;
+
+	switch (op)
+	{
+		// Commutative operations: the order of the operands does not matter
+		case IRInstr::cmp_eq:
+		case IRInstr::cmp_neq:
+		case IRInstr::op_or:
+		case IRInstr::op_xor:
+		case IRInstr::op_and:
+		case IRInstr::op_add:
+		case IRInstr::op_mul:
+			values = {valueOf(instr, 0), valueOf(instr, 1)};
+			sort(values.begin(), values.end());
+			break;
+
+		case IRInstr::cmp_lt:
+		case IRInstr::cmp_gt:
+		case IRInstr::cmp_eqlt:
+		case IRInstr::cmp_eqgt:
+		case IRInstr::op_sub:
+		case IRInstr::op_div:
+		case IRInstr::op_mod:
+			values = {valueOf(instr, 0), valueOf(instr, 1)};
+			break;
+
+		case IRInstr::op_not:
+		case IRInstr::op_minus:
+			values = {valueOf(instr, 0)};
+			break;
+
+		// Two phis of the same block choosing the same variables on the same edges
+		case IRInstr::phi:
+		{
+			vector<string> parameters = instr->getParameters();
+			values = {instr->getBasicBlock()->getLabel()};
+
+			for (size_t i = 1; i + 1 < parameters.size(); i += 2)
+			{
+				values.push_back(leaderOf(parameters[i]));
+				values.push_back(parameters[i + 1]);
+			}
+
+			break;
+		}
+
+		// A call, a move or a jump is not numbered
+		default:
+			return "";
+	}
+
+	string key = targetOperation(op).name + string(" ") + typeName(Liveness::variableOf(instr, instr->getDestinationIndex())->variableType);
+
+	for (string& value : values)
+	{
+		key += " " + value;
+	}
+
+	return key;
+}
+
+// Value of a variable: its constant, or the variable replacing it
+string GlobalValueNumbering::valueOf(IRInstr * instr, int index)
+{
+	string leader = leaderOf(instr->getParameters().at(index));
+	unordered_map<string, string>::iterator constant = constants.find(leader);
+
+	return constant == constants.end() ? leader : constant->second;
+}
+
+// Variable replacing a variable
+string GlobalValueNumbering::leaderOf(string name)
+{
+	unordered_map<string, string>::iterator it = leaders.find(name);
+
+	while (it != leaders.end())
+	{
+		name = it->second;
+		it = leaders.find(name);
+	}
+
+	return name;
+}
+
+// Replace the removed results by their leaders in the remaining instructions
+void GlobalValueNumbering::replaceUses()
+{
+	if (leaders.empty())
+	{
+		return;
+	}
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			for (int index : instr->getSourceIndexes())
+			{
+				string name = instr->getParameters().at(index);
+				string leader = leaderOf(name);
+
+				if (leader != name)
+				{
+					instr->setParameter(index, leader);
+				}
+			}
+		}
+	}
+}
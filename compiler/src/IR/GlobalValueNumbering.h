@@ -0,0 +1,76 @@
+/*************************************************************************
+                          PLD Compilateur: GlobalValueNumbering
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <GlobalValueNumbering> (file GlobalValueNumbering.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "CFG.h"
+#include "SSA.h"
+#include "DominatorTree.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <GlobalValueNumbering> :
+//
+// The GlobalValueNumbering removes the operations of a function in SSA
+// form that compute again a value already computed (dominator-based
+// value numbering, Briggs, Cooper and Simpson). Every pure operation
+// (arithmetic, division included, comparison, bitwise or unary) gets a
+// key from its operation, the values of its operands and the type of its
+// result; the constants are numbered by their type and value, and the
+// operands of the commutative operations are sorted.
+// The dominator tree is walked from the entry with the keys computed by
+// the dominating blocks only: an operation whose key is known is removed,
+// and its result is replaced everywhere by the variable computed first,
+// which dominates all its uses. In SSA form a variable is written once,
+// so an assignment to a source variable creates a new version, and so a
+// new key: nothing has to be invalidated. A phi choosing the same value
+// on every edge (or its own result) is also replaced by this value.
+//
+//------------------------------------------------------------------------
+
+class GlobalValueNumbering
+{
+	public:
+
+		// Constructor
+		GlobalValueNumbering(CFG * cfg, SSA * ssa);
+
+		// Remove the operations computing a value already computed
+		void run();
+
+	protected:
+
+		// Number the operations of a block and of the blocks it dominates
+		void numberBlock(BasicBlock * bb);
+
+		// Key of the value computed by an instruction (empty if it cannot be reused)
+		string keyOf(IRInstr * instr);
+
+		// Value of a variable: its constant, or the variable replacing it
+		string valueOf(IRInstr * instr, int index);
+
+		// Variable replacing a variable (itself if none)
+		string leaderOf(string name);
+
+		// Replace the removed results by their leaders in the remaining instructions
+		void replaceUses();
+
+		SSA * ssa;												// SSA form of the function
+		vector<BasicBlock*> blocks;								// Blocks of the function
+		DominatorTree tree;										// Dominator tree of the function
+		unordered_map<string, string> available;				// Variable computing every key, in the dominating blocks
+		unordered_map<string, string> constants;				// Value of every variable loaded with a constant
+		unordered_map<string, string> leaders;					// Variable replacing every removed result
+};
@@ -9,764 +9,708 @@
 //---- Implementation of class <IRInstr> (file IRInstr.cpp) -----/
 
 #include "IRInstr.h"
+#include "Target.h"
+#include <cstdint>
+#include <algorithm>
 
 class BasicBlock;
 
 using namespace std;
 
-unordered_map<string, vector<string>> IRInstr::AMD86_paramRegisters = {{"int", {"%edi", "%esi", "%edx", "%ecx", "%r8d", "%r9d"}}, {"char", {"%dil", "%sil", "%dl", "%cl", "%r8b", "%r9b"}}};
-
 // Constructor for IR instruction
 IRInstr::IRInstr(BasicBlock * bb, IRInstr::Operation op, vector<string> parameters, SymbolTable * sT) : bb(bb), op(op), parameters(parameters), symbolTable(sT) {}
 
-// Generate assembly code for the IR instruction
-void IRInstr::generateASM(ostream &o)
+// Name of the variable written by the instruction
+string IRInstr::getDestination()
+{
+	int index = getDestinationIndex();
+	return index < 0 ? "" : parameters.at(index);
+}
+
+// Index of the parameter naming the variable written by the instruction
+int IRInstr::getDestinationIndex()
 {
 	switch (op)
 	{
-		// Load constant value into register
-		case IRInstr::ldconst:
-		{
-			// Get parameters
-			string constant = parameters.at(1);
-			string variableName = parameters.at(2);
-			string variableType = parameters.at(0);
-
-			// Get constant value
-			int constValue = stoi(constant);
-			string movInstr;
-
-			varStruct * variable = symbolTable->getVariable(variableName);
-			bool isChar = variableType == "char";
-			movInstr = isChar ? "movb" : "movl";
+		// Operations writing their last parameter
+		case ldconst:
+		case cmp_eq:
+		case cmp_neq:
+		case cmp_lt:
+		case cmp_gt:
+		case cmp_eqlt:
+		case cmp_eqgt:
+		case op_or:
+		case op_xor:
+		case op_and:
+		case op_add:
+		case op_sub:
+		case op_mul:
+		case op_div:
+		case op_mod:
+			return 2;
+
+		// Operations writing their second parameter
+		case copy:
+		case aff:
+		case op_not:
+		case op_minus:
+		case call:
+			return 1;
+
+		// Operations writing their first parameter
+		case rparam:
+		case op_plus_equal:
+		case op_sub_equal:
+		case op_mult_equal:
+		case op_div_equal:
+		case phi:
+			return 0;
+
+		default:
+			return -1;
+	}
+}
 
-			// Write ASM instructions
-			o << "\t" << movInstr << "\t $" << SymbolTable::getCast(variable->variableType, constValue) << ", " << variable->memoryOffset << "(%rbp)"
-			  << "\t\t# [ldconst] load " << constValue << " into " << variableName << endl;
+// Indexes of the parameters naming the variables read by the instruction
+vector<int> IRInstr::getSourceIndexes()
+{
+	vector<int> indexes;
 
+	switch (op)
+	{
+		// Operations reading their two first parameters (a compound assignment reads its destination)
+		case cmp_eq:
+		case cmp_neq:
+		case cmp_lt:
+		case cmp_gt:
+		case cmp_eqlt:
+		case cmp_eqgt:
+		case op_or:
+		case op_xor:
+		case op_and:
+		case op_add:
+		case op_sub:
+		case op_mul:
+		case op_div:
+		case op_mod:
+		case op_plus_equal:
+		case op_sub_equal:
+		case op_mult_equal:
+		case op_div_equal:
+			indexes = {0, 1};
 			break;
-		}
 
-		case IRInstr::aff: // Assign value to a variable
-		case IRInstr::copy: // Copy value from one register to another
-		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
+		// Operations reading their first parameter
+		case copy:
+		case aff:
+		case op_not:
+		case op_minus:
+		case wparam:
+			indexes = {0};
+			break;
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
+		// A jump reads its test, or the two operands of the comparison fused into it: {left, falseLabel, trueLabel, right, comparison}
+		case conditional_jump:
+			indexes = parameters.size() > 3 ? vector<int>({0, 3}) : vector<int>({0});
+			break;
 
-			string movInstr1, movInstr2;
-			string reg;
+		// A return reads a variable, or gives a constant
+		case ret:
+			indexes = parameters.empty() ? vector<int>() : vector<int>({0});
+			break;
 
-			if (variable2->variableType == "int" && variable1->variableType == "int")
-			{
-				// int = int : movl
-				movInstr1 = "movl";
-				movInstr2 = "movl";
-				reg = "eax";
-			}
-			else if (variable2->variableType == "char" && variable1->variableType == "char")
-			{
-				// char = char : movb
-				movInstr1 = "movb";
-				movInstr2 = "movb";
-				reg = "al";
-			}
-			else if (variable2->variableType == "char" && variable1->variableType == "int")
-			{
-				// char = int : movb
-				movInstr1 = "movb";
-				movInstr2 = "movb";
-				reg = "al";
-			}
-			else if (variable2->variableType == "int" && variable1->variableType == "char")
+		// A phi reads one variable per predecessor: {destination, variable, label, variable, label...}
+		case phi:
+		{
+			for (size_t i = 1; i < parameters.size(); i += 2)
 			{
-				// int = char : movzbl
-				movInstr1 = "movzbl";
-				movInstr2 = "movl";
-				reg = "eax";
+				indexes.push_back(i);
 			}
-			
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %" << reg
-			  << "\t\t# [copy/aff] load " << variableName1 << " into " << "%" << reg << endl;
-			o << "\t" << movInstr2 << "\t %" << reg << ", " << variable2->memoryOffset << "(%rbp)"
-			  << "\t\t# [copy/aff] load " << "%" << reg << " into " << variableName2 << endl;
 
 			break;
 		}
 
-		// Bitwise NOT operation
-		case IRInstr::op_not:
-		{
-			// Get parameters
-			string variableName = parameters.at(0);
-			string tmpName = parameters.at(1);
-
-			varStruct * variable = symbolTable->getVariable(variableName);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+		default:
+			break;
+	}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(tmp->variableType);
+	// An immediate ($value) names no variable
+	indexes.erase(remove_if(indexes.begin(), indexes.end(), [this](int index) { return isImmediate(parameters.at(index)); }), indexes.end());
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable->memoryOffset << "(%rbp), %eax"
-              << "\t\t# [op_not] load " << variable->variableName << " into " << "%eax" << endl;
-            o << "\tcmpl\t $0, %eax" << endl;
-            o << "\tsete\t %al" << endl;
-            o << "\tmovzbl\t %al, %eax" << endl;
-            o << "\t" << movInstr2 << "\t %eax, " << tmp->memoryOffset << "(%rbp)"
-        	  << "\t\t# [op_not] load " << "%eax" << " into " << tmp->variableName << endl;
+	return indexes;
+}
 
-			break;
-		}
+// Comparison fused into a conditional jump
+IRInstr::Operation IRInstr::getFusedComparison()
+{
+	if (op != conditional_jump || parameters.size() <= 3)
+	{
+		return op;
+	}
 
-		// Unary minus operation
-		case IRInstr::op_minus:
+	for (const targetOperationStruct& operation : targetOperations)
+	{
+		if (parameters.at(4) == operation.name)
 		{
-			// Get parameters
-			string variableName = parameters.at(0);
-			string tmpName = parameters.at(1);
+			return operation.op;
+		}
+	}
 
-			varStruct * variable = symbolTable->getVariable(variableName);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+	return op;
+}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(tmp->variableType);
+// Value of an operation on constant operands, as the generated code computes it
+bool IRInstr::evaluate(Operation op, Type leftType, int left, Type rightType, int right, int& result)
+{
+	// The operands are extended to 32 bits like the loads of the operation (a char is sign-extended by a division only)
+	bool isSigned = targetOperation(op).load == LOAD_SIGNED;
+	auto extend = [isSigned](Type type, int value) { return type != TYPE_CHAR ? value : isSigned ? (int) (signed char) value : (int) (unsigned char) value; };
+	int32_t a = extend(leftType, left);
+	int32_t b = extend(rightType, right);
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable->memoryOffset << "(%rbp), %eax"
-              << "\t\t# [op_minus] load " << variable->variableName << " into " << "%eax" << endl;
-            o << "\tnegl\t %eax" << endl;
-            o << "\t" << movInstr2 << "\t %eax, " << tmp->memoryOffset << "(%rbp)"
-        	  << "\t\t# [op_minus] load " << "%eax" << " into " << tmp->variableName << endl;
+	// The arithmetic wraps around like the 32-bit instructions
+	switch (op)
+	{
+		case cmp_eq:	result = a == b; return true;
+		case cmp_neq:	result = a != b; return true;
+		case cmp_lt:	result = a < b; return true;
+		case cmp_gt:	result = a > b; return true;
+		case cmp_eqlt:	result = a <= b; return true;
+		case cmp_eqgt:	result = a >= b; return true;
+		case op_or:		result = a | b; return true;
+		case op_xor:	result = a ^ b; return true;
+		case op_and:	result = a & b; return true;
+		case op_add:	result = (int32_t) ((uint32_t) a + (uint32_t) b); return true;
+		case op_sub:	result = (int32_t) ((uint32_t) a - (uint32_t) b); return true;
+		case op_mul:	result = (int32_t) ((uint32_t) a * (uint32_t) b); return true;
+		case op_not:	result = a == 0; return true;
+		case op_minus:	result = (int32_t) (0u - (uint32_t) a); return true;
+
+		// A move gives its operand as it is read
+		case copy:
+		case aff:
+		case ret:		result = a; return true;
+
+		// A division by zero or an overflowing division traps at runtime
+		case op_div:
+		case op_mod:
+		{
+			if (b == 0 || (a == INT32_MIN && b == -1))
+			{
+				return false;
+			}
 
-			break;
+			result = op == op_div ? a / b : a % b;
+			return true;
 		}
 
-		// Addition operation
-		case IRInstr::op_add:
-		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
-
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+		default:
+			return false;
+	}
+}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+// Operand of a variable: its stack slot, or its register accessed on size bytes
+string IRInstr::operand(varStruct * variable, int size)
+{
+	if (variable->registerIndex >= 0)
+	{
+		return targetRegisterName(variable->registerIndex, size > 0 ? size : targetType(variable->variableType).size);
+	}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax"
-			  << "\t\t# [op_add] load " << variableName1 << " into " << "%eax" << endl;
-			o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx"
-			  << "\t\t# [op_add] load " << variableName2 << " into " << "%edx" << endl;
-			o << "\t\taddl\t %edx, %eax" << endl;
-			o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)"
-			  << "\t\t# [op_add] load " << "%eax" << " into " << tmpName << endl;
+	return to_string(variable->memoryOffset) + "(%rbp)";
+}
 
-			break;
-		}
+// Size of the memory accessed by a move (movl, movq, or a byte for movb, movzbl and movsbl)
+static int accessSize(const char * move)
+{
+	string mnemonic = move;
+	return mnemonic == "movl" ? 4 : mnemonic == "movq" ? 8 : 1;
+}
 
-		// Subtraction operation
-		case IRInstr::op_sub:
-		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
+// Type of an operand
+Type IRInstr::typeOf(string name)
+{
+	return isImmediate(name) ? TYPE_INT : symbolTable->getVariable(name)->variableType;
+}
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+// Emit the load of a variable or an immediate into a register
+void IRInstr::emitLoad(ostream &o, string name, const char * move, const char * reg)
+{
+	// An immediate already holds the value as the load extends it
+	if (isImmediate(name))
+	{
+		o << "\tmovl\t " << name << ", " << reg << "\t\t# [" << targetOperation(op).name << "] load " << name.substr(1) << " into " << reg << endl;
+		return;
+	}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+	o << "\t" << move << "\t " << operand(symbolTable->getVariable(name), accessSize(move)) << ", " << reg
+	  << "\t\t# [" << targetOperation(op).name << "] load " << name << " into " << reg << endl;
+}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax"
-			  << "\t\t# [op_sub] load " << variableName1 << " into " << "%eax" << endl;
-			o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx"
-			  << "\t\t# [op_sub] load " << variableName2 << " into " << "%edx" << endl;
-			o << "\tsubl\t %edx, %eax" << endl;
-			o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)"
-			  << "\t\t# [op_sub] load " << "%eax" << " into " << tmpName << endl;
+// Emit the store of a register into a variable
+void IRInstr::emitStore(ostream &o, const char * move, const char * reg, string name)
+{
+	o << "\t" << move << "\t " << reg << ", " << operand(symbolTable->getVariable(name), accessSize(move))
+	  << "\t\t# [" << targetOperation(op).name << "] load " << reg << " into " << name << endl;
+}
 
-			break;
-		}
+// Magic number and shift of the signed division by a constant (|divisor| >= 2, Hacker's Delight 10-1)
+static void divisionMagic(int divisor, int& magic, int& shift)
+{
+	const uint32_t two31 = 0x80000000u;
+	uint32_t ad = divisor < 0 ? 0u - (uint32_t) divisor : (uint32_t) divisor;
+	uint32_t t = two31 + ((uint32_t) divisor >> 31);
+	uint32_t anc = t - 1 - t % ad;
+	uint32_t q1 = two31 / anc, r1 = two31 - q1 * anc;
+	uint32_t q2 = two31 / ad, r2 = two31 - q2 * ad;
+	uint32_t delta;
+	int p = 31;
+
+	do
+	{
+		p++;
+		q1 *= 2;
+		r1 *= 2;
 
-		// Multiplication operation
-		case IRInstr::op_mul:
+		if (r1 >= anc)
 		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
-
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
-
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+			q1++;
+			r1 -= anc;
+		}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax"
-              << "\t\t# [op_mul] load " << variableName1 << " into " << "%eax" << endl;
-            o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx"
-              << "\t\t# [op_mul] load " << variableName2 << " into " << "%edx" << endl;
-            o << "\timull\t %edx, %eax" << endl;
-            o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)"
-              << "\t\t# [op_mul] load " << "%eax" << " into " << tmpName << endl;
+		q2 *= 2;
+		r2 *= 2;
 
-			break;
+		if (r2 >= ad)
+		{
+			q2++;
+			r2 -= ad;
 		}
 
-		// Division operation
-		case IRInstr::op_div:
-		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
+		delta = ad - r2;
+	} while (q1 < delta || (q1 == delta && r1 == 0));
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+	magic = divisor < 0 ? (int) (0u - (q2 + 1)) : (int) (q2 + 1);
+	shift = p - 32;
+}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+// Emit a multiplication, a division or a modulo of %eax by a constant with cheaper instructions
+bool IRInstr::emitStrengthReduction(ostream &o, int constant)
+{
+	const targetOperationStruct& operation = targetOperation(op);
+	uint32_t magnitude = constant < 0 ? 0u - (uint32_t) constant : (uint32_t) constant;
+	// The constant is odd * 2^k
+	uint32_t odd = magnitude;
+	int k = 0;
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax"
-              << "\t\t# [op_div] load " << variableName1 << " into " << "%eax" << endl;
-            o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx"
-              << "\t\t# [op_div] load " << variableName2 << " into " << "%edx" << endl;
-            o << "\tcltd" << endl;
-            o << "\tidivl\t " << variable2->memoryOffset << "(%rbp)" << endl;
-            o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)"
-              << "\t\t# [op_div] load " << "%eax" << " into " << tmpName << endl;
+	while (odd != 0 && odd % 2 == 0)
+	{
+		odd /= 2;
+		k++;
+	}
 
-			break;
-		}
+	bool isPowerOfTwo = odd == 1;
 
-		// Modulo operation
-		case IRInstr::op_mod:
+	if (operation.shape != EMIT_DIVIDE)
+	{
+		// A multiplication by 2^k is a shift, by 3, 5 or 9 (times 2^k) a lea, a negative constant negates the product
+		if (magnitude == 0)
 		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
-
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
-
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
-
-			if(variable1->variableType == "char")
-			{
-				movInstr1 = "movsbl";
-			}
-
-			if(variable2->variableType == "char")
-			{
-				movInstr2 = "movsbl";
-			}
+			o << "\txorl\t %eax, %eax" << endl;
+			return true;
+		}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax"
-              << "\t\t# [op_mod] load " << variableName1 << " into " << "%eax" << endl;
-            o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %ebx"
-              << "\t\t# [op_mod] load " << variableName2 << " into " << "%ebx" << endl;
-            o << "\tcltd" << endl;
-            o << "\tidivl\t %ebx" << endl;
-            o << "\tmovl\t %edx, " << tmp->memoryOffset << "(%rbp)"
-              << "\t\t# [op_mod] load " << "%eax" << " into " << tmpName << endl;
+		if (odd != 1 && odd != 3 && odd != 5 && odd != 9)
+		{
+			return false;
+		}
 
-			break;
+		if (odd != 1)
+		{
+			o << "\tleal\t (%rax,%rax," << odd - 1 << "), %eax" << endl;
 		}
 
-		// Compare if two values are equal
-		case IRInstr::cmp_eq:
+		if (k > 0)
 		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
+			o << "\tsall\t $" << k << ", %eax" << endl;
+		}
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+		if (constant < 0)
+		{
+			o << "\tnegl\t %eax" << endl;
+		}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+		return true;
+	}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax" << endl;
-            o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx" << endl;
-            o << "\tcmpl\t %edx, %eax" << endl;
-            o << "\tsete\t %al" << endl;
-            o << "\tmovzbl\t %al, %eax" << endl;
-            o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)" << endl;
+	// A division by 0 or -1 may trap: idivl is kept
+	if (constant == 0 || constant == -1)
+	{
+		return false;
+	}
 
-			break;
+	if (constant == 1)
+	{
+		if (operation.remainder)
+		{
+			o << "\txorl\t %eax, %eax" << endl;
 		}
 
-		// Compare if two values are not equal
-		case IRInstr::cmp_neq:
-		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
+		return true;
+	}
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+	if (isPowerOfTwo)
+	{
+		// A negative dividend is biased by 2^k - 1 so that the shift truncates toward zero
+		o << "\tmovl\t %eax, %edx" << endl;
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+		if (k > 1)
+		{
+			o << "\tsarl\t $31, %edx" << endl;
+		}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax" << endl;
-		    o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx" << endl;
-		    o << "\tcmpl\t %edx, %eax" << endl;
-		    o << "\tsetne\t %al" << endl;
-		    o << "\tmovzbl\t %al, %eax" << endl;
-		    o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)" << endl;
+		o << "\tshrl\t $" << 32 - k << ", %edx" << endl;
+		o << "\taddl\t %edx, %eax" << endl;
 
-			break;
+		if (operation.remainder)
+		{
+			// The remainder has the sign of the dividend (whatever the sign of the divisor)
+			o << "\tandl\t $" << (magnitude - 1) << ", %eax" << endl;
+			o << "\tsubl\t %edx, %eax" << endl;
 		}
-
-		// Compare if one value is less than another
-		case IRInstr::cmp_lt:
+		else
 		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
-
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
-
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+			o << "\tsarl\t $" << k << ", %eax" << endl;
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax" << endl;
-		    o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx" << endl;
-		    o << "\tcmpl\t %edx, %eax" << endl;
-		    o << "\tsetl\t %al" << endl;
-		    o << "\tmovzbl\t %al, %eax" << endl;
-		    o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)" << endl;
-		
-			break;
+			if (constant < 0)
+			{
+				o << "\tnegl\t %eax" << endl;
+			}
 		}
 
-		// Compare if one value is greater than another
-		case IRInstr::cmp_gt:
-		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
+		return true;
+	}
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+	// The quotient is the high half of the product by the magic number, corrected toward zero
+	int magic, shift;
+	divisionMagic(constant, magic, shift);
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+	o << "\tmovl\t %eax, %ecx" << endl;
+	o << "\tmovl\t $" << magic << ", %edx" << endl;
+	o << "\timull\t %edx" << endl;
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax" << endl;
-		    o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx" << endl;
-		    o << "\tcmpl\t %edx, %eax" << endl;
-		    o << "\tsetg\t %al" << endl;
-		    o << "\tmovzbl\t %al, %eax" << endl;
-		    o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)" << endl;
-            
-			break;
-		}
+	if (constant > 0 && magic < 0)
+	{
+		o << "\taddl\t %ecx, %edx" << endl;
+	}
+	else if (constant < 0 && magic > 0)
+	{
+		o << "\tsubl\t %ecx, %edx" << endl;
+	}
 
-		// Compare if one value is equal to or less than another
-		case IRInstr::cmp_eqlt:
-		{
-			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
+	if (shift > 0)
+	{
+		o << "\tsarl\t $" << shift << ", %edx" << endl;
+	}
+
+	o << "\tmovl\t %edx, %eax" << endl;
+	o << "\tshrl\t $31, %eax" << endl;
+	o << "\taddl\t %edx, %eax" << endl;
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+	// The remainder is the dividend minus the product of the quotient by the divisor
+	if (operation.remainder)
+	{
+		o << "\timull\t $" << constant << ", %eax" << endl;
+		o << "\tnegl\t %eax" << endl;
+		o << "\taddl\t %ecx, %eax" << endl;
+	}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+	return true;
+}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax" << endl;
-		    o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx" << endl;
-		    o << "\tcmpl\t %edx, %eax" << endl;
-		    o << "\tsetle\t %al" << endl;
-		    o << "\tmovzbl\t %al, %eax" << endl;
-		    o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)" << endl;
-            
-			break;
-		}
+// Generate assembly code for the IR instruction, following its description in the target tables
+void IRInstr::generateASM(ostream &o)
+{
+	const targetOperationStruct& operation = targetOperation(op);
 
-		// Compare if one value is equal to or greater than another
-		case IRInstr::cmp_eqgt:
+	switch (operation.shape)
+	{
+		// Load constant value into a variable
+		case EMIT_LDCONST:
 		{
 			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
-
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
-
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+			int constValue = stoi(parameters.at(1));
+			string variableName = parameters.at(2);
+			varStruct * variable = symbolTable->getVariable(variableName);
 
 			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax" << endl;
-		    o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx" << endl;
-		    o << "\tcmpl\t %edx, %eax" << endl;
-		    o << "\tsetge\t %al" << endl;
-		    o << "\tmovzbl\t %al, %eax" << endl;
-		    o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)" << endl;
-            
+			o << "\t" << targetType(variable->variableType).move << "\t $" << SymbolTable::getCast(variable->variableType, constValue)
+			  << ", " << operand(variable) << "\t\t# [ldconst] load " << constValue << " into " << variableName << endl;
+
 			break;
 		}
 
-		// Bitwise AND operation
-		case IRInstr::op_and:
+		// Copy or assign a variable to another one
+		case EMIT_COPY:
 		{
 			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
+			string sourceName = parameters.at(0);
+			string destinationName = parameters.at(1);
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+			const targetTypeStruct& source = targetType(symbolTable->getVariable(sourceName)->variableType);
+			const targetTypeStruct& destination = targetType(symbolTable->getVariable(destinationName)->variableType);
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+			// A narrower source is extended, otherwise the value is moved at the size of the destination
+			bool extend = source.size < destination.size;
 
 			// Write ASM instructions
-			o << "\tmovl\t " << variable1->memoryOffset << "(%rbp), %eax"
-		 	  << "\t\t# [op_and] load " << variableName1 << " into " << "%eax" << endl;
-			o << "\tandl\t " << variable2->memoryOffset << "(%rbp), %eax"
-	     	  << "\t\t# [op_and] and(" << variableName2 << ", " << "%eax)" << endl;
-			o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)"
-		 	  << "\t\t# [op_and] load " << "%eax" << " into " << tmpName << endl;
-	
+			emitLoad(o, sourceName, extend ? source.load : destination.move, extend ? "%eax" : destination.accumulator);
+			emitStore(o, destination.move, destination.accumulator, destinationName);
+
 			break;
 		}
 
-		// Bitwise OR operation
-		case IRInstr::op_or:
+		// Unary operation on %eax (a condition compares %eax to 0)
+		case EMIT_UNARY:
 		{
 			// Get parameters
-			string variableName1 = parameters.at(0);
-			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
+			string variableName = parameters.at(0);
+			string tmpName = parameters.at(1);
+			const targetTypeStruct& tmp = targetType(symbolTable->getVariable(tmpName)->variableType);
 
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+			// Write ASM instructions
+			emitLoad(o, variableName, targetLoad(operation.load, symbolTable->getVariable(variableName)->variableType), "%eax");
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+			if (operation.condition != nullptr)
+			{
+				o << "\t" << operation.mnemonic << "\t $0, %eax" << endl;
+				o << "\t" << operation.condition << "\t %al" << endl;
+				o << "\tmovzbl\t %al, %eax" << endl;
+			}
+			else
+			{
+				o << "\t" << operation.mnemonic << "\t %eax" << endl;
+			}
+
+			emitStore(o, tmp.move, tmp.accumulator, tmpName);
 
-			// Write ASM instructions
-			o << "\tmovl\t " << variable1->memoryOffset << "(%rbp), %eax"
-			  << "\t\t# [op_or] load " << variableName1 << " into " << "%eax" << endl;
-			o << "\torl\t " << variable2->memoryOffset << "(%rbp), %eax"
-			  << "\t\t# [op_or] or(" << variableName2 << ", " << "%eax)" << endl;
-			o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)"
-			  << "\t\t# [op_or] load " << "%eax" << " into " << tmpName << endl;
-    
 			break;
 		}
 
-		// Bitwise XOR operation
-		case IRInstr::op_xor:
+		// Binary operation (comparisons and compound assignments included) and division
+		case EMIT_BINARY:
+		case EMIT_DIVIDE:
 		{
-			// Get parameters
+			// Get parameters: the result goes to a temporary, or back to the first operand
 			string variableName1 = parameters.at(0);
 			string variableName2 = parameters.at(1);
-			string tmpName = parameters.at(2);
-
-			varStruct * variable1 = symbolTable->getVariable(variableName1);
-			varStruct * variable2 = symbolTable->getVariable(variableName2);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+			string resultName = operation.compound ? variableName1 : parameters.at(2);
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable1->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(variable2->variableType);
+			const targetTypeStruct& result = targetType(symbolTable->getVariable(resultName)->variableType);
 
 			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable1->memoryOffset << "(%rbp), %eax"
-		 	  << "\t\t# [op_xor] load " << variableName1 << " into " << "%eax" << endl;
-			o << "\t" << movInstr2 << "\t " << variable2->memoryOffset << "(%rbp), %edx"
-			  << "\t\t# [op_xor] load " << variableName2  << " into " << "%edx" << endl;
-			o << "\txorl\t %edx, %eax" << endl;
-			o << "\tmovl\t %eax, " << tmp->memoryOffset << "(%rbp)"
-		 	  << "\t\t# [op_xor] load " << "%eax" << " into " << tmpName << endl;
-    
-			break;
-		}
+			emitLoad(o, variableName1, targetLoad(operation.load, typeOf(variableName1)), "%eax");
 
-		// Plus equal operation (e.g., a += b)
-		case IRInstr::op_plus_equal:
-		{
-			// Get parameters
-			string variableName = parameters.at(0);
-			string tmpName = parameters.at(1);
+			// A multiplication, a division or a modulo by a constant may need no imull or idivl (the result is in %eax)
+			bool isReducible = operation.mnemonic == string("imull") || operation.shape == EMIT_DIVIDE;
 
-			varStruct * variable = symbolTable->getVariable(variableName);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
-
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(tmp->variableType);
+			if (isReducible && isImmediate(variableName2) && emitStrengthReduction(o, stoi(variableName2.substr(1))))
+			{
+				emitStore(o, result.move, result.accumulator, resultName);
+				break;
+			}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable->memoryOffset << "(%rbp), %eax"
-			<< "\t\t# [op_plus_equal] load " << variableName << " into " << "%eax" << endl;
-			o << "\t" << movInstr2 << "\t " << tmp->memoryOffset << "(%rbp), %edx"
-			<< "\t\t# [op_plus_equal] load " << tmpName << " into " << "%edx" << endl;
-			o << "\taddl\t %edx, %eax" << endl;
-			o << "\t" << movInstr1 << "\t %eax, " << variable->memoryOffset << "(%rbp)"
-			<< "\t\t# [op_plus_equal] load %eax into " << variableName << endl;
+			string source;
 
-			break;
-		}
+			if (isImmediate(variableName2))
+			{
+				// The instruction reads an immediate in place, except idivl which reads it from %ecx
+				if (operation.shape == EMIT_DIVIDE)
+				{
+					emitLoad(o, variableName2, "movl", "%ecx");
+				}
 
-		// Minus equal operation (e.g., a -= b)
-		case IRInstr::op_sub_equal:
-		{
-			// Get parameters
-			string variableName = parameters.at(0);
-			string tmpName = parameters.at(1);
+				source = operation.shape == EMIT_DIVIDE ? "%ecx" : variableName2;
+			}
+			else
+			{
+				varStruct * variable2 = symbolTable->getVariable(variableName2);
 
-			varStruct * variable = symbolTable->getVariable(variableName);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+				if (operation.second != nullptr)
+				{
+					emitLoad(o, variableName2, targetLoad(operation.load, variable2->variableType), operation.second);
+				}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(tmp->variableType);
+				// A narrow operand cannot be read from memory: it is extended into %ecx
+				bool memorySource = operation.memorySource && targetType(variable2->variableType).size == 4;
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable->memoryOffset << "(%rbp), %eax"
-			<< "\t\t# [op_sub_equal] load " << variableName << " into " << "%eax" << endl;
-			o << "\t" << movInstr2 << "\t " << tmp->memoryOffset << "(%rbp), %edx"
-			<< "\t\t# [op_sub_equal] load " << tmpName << " into " << "%edx" << endl;
-			o << "\tsubl\t %edx, %eax" << endl;
-			o << "\t" << movInstr1 << "\t %eax, " << variable->memoryOffset << "(%rbp)"
-			<< "\t\t # [op_sub_equal] load %eax into " << variableName << endl;
-			break;
-		}
+				if (operation.memorySource && !memorySource)
+				{
+					emitLoad(o, variableName2, targetLoad(operation.load, variable2->variableType), "%ecx");
+				}
 
-		// Multiply equal operation (e.g., a *= b)
-		case IRInstr::op_mult_equal:
-		{
-			// Get parameters
-			string variableName = parameters.at(0);
-			string tmpName = parameters.at(1);
+				source = memorySource ? operand(variable2) : operation.memorySource ? "%ecx" : operation.second;
+			}
 
-			varStruct * variable = symbolTable->getVariable(variableName);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+			if (operation.shape == EMIT_DIVIDE)
+			{
+				o << "\tcltd" << endl;
+				o << "\t" << operation.mnemonic << "\t " << source << endl;
+			}
+			else
+			{
+				o << "\t" << operation.mnemonic << "\t " << source << ", %eax" << endl;
+			}
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(tmp->variableType);
+			if (operation.condition != nullptr)
+			{
+				o << "\t" << operation.condition << "\t %al" << endl;
+				o << "\tmovzbl\t %al, %eax" << endl;
+			}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable->memoryOffset << "(%rbp), %eax"
-			<< "\t\t# [op_mult_equal] load " << variableName << " into " << "%eax" << endl;
-			o << "\t" << movInstr2 << "\t " << tmp->memoryOffset << "(%rbp), %edx"
-			<< "\t\t# [op_mult_equal] load " << tmpName << " into " << "%edx" << endl;
-			o << "\timull\t %edx, %eax" << endl;
-			o << "\t" << movInstr1 << "\t %eax, " << variable->memoryOffset << "(%rbp)"
-			<< "\t\t# [op_mult_equal] load %eax into " << variableName << endl;
+			emitStore(o, result.move, operation.remainder ? result.remainder : result.accumulator, resultName);
 
 			break;
 		}
 
-		// Divide equal operation (e.g., a /= b)
-		case IRInstr::op_div_equal:
+		// Write parameter value into a register, or onto the stack
+		case EMIT_WPARAM:
 		{
-			// Get parameters
+			// Get params
 			string variableName = parameters.at(0);
-			string tmpName = parameters.at(1);
-
-			varStruct * variable = symbolTable->getVariable(variableName);
-			varStruct * tmp = symbolTable->getVariable(tmpName);
+			int nbParams = stoi(parameters.at(1));
 
-			string movInstr1 = SymbolTable::typeOpeMoves.at(variable->variableType);
-			string movInstr2 = SymbolTable::typeOpeMoves.at(tmp->variableType);
+			// An immediate is moved into the register, or pushed (sign extended to 8 bytes)
+			if (isImmediate(variableName))
+			{
+				if (nbParams < TARGET_PARAM_REGISTERS)
+				{
+					emitLoad(o, variableName, "movl", targetType(TYPE_INT).paramRegisters[nbParams]);
+				}
+				else
+				{
+					o << "\tpushq\t " << variableName << "\t\t# [wparam] push " << variableName.substr(1) << " onto the stack" << endl;
+				}
 
-			// Write ASM instructions
-			o << "\t" << movInstr1 << "\t " << variable->memoryOffset << "(%rbp), %eax"
-			<< "\t\t # [op_div_equal] load " << variableName << " into " << "%eax" << endl;
-			o << "\t" << movInstr2 << "\t " << tmp->memoryOffset << "(%rbp), %edx"
-			<< "\t\t # [op_div_equal] load " << tmpName << " into " << "%edx" << endl;
-			o << "\tcltd" << endl;
-			o << "\tidivl\t "	<< tmp->memoryOffset << "(%rbp)" << endl;
-			o << "\t" << movInstr1 << "\t %eax, " << variable->memoryOffset << "(%rbp)"
-			<< "\t\t # [op_div_equal] load %eax into " << variableName << endl;
-			
-			break;
-		}	
+				break;
+			}
 
-		// Conditional jump instruction
-		case IRInstr::conditional_jump:
-		{
-			// Get params
-			string testVariableName = parameters.at(0);
-			string falseExitBlockLabel = parameters.at(1);
-			string trueExitBlockLabel = parameters.at(2);
+			varStruct * variable = symbolTable->getVariable(variableName);
+			const targetTypeStruct& type = targetType(variable->variableType);
 
-			// Write ASM instructions
-			o << "\tcmpl\t $0, " << symbolTable->getVariable(testVariableName)->memoryOffset << "(%rbp)" << endl;
-			o << "\tje\t " << falseExitBlockLabel << endl;
-			o << "\tjmp\t " << trueExitBlockLabel << endl;
+			if (nbParams < TARGET_PARAM_REGISTERS && type.size < 4)  // Narrow values fill the whole register (the parameter may be an int)
+			{
+				emitLoad(o, variableName, type.load, targetType(TYPE_INT).paramRegisters[nbParams]);
+			}
+			else if (nbParams < TARGET_PARAM_REGISTERS)  // Use registers for the first parameters
+			{
+				emitLoad(o, variableName, type.move, type.paramRegisters[nbParams]);
+			}
+			else if (type.size < 4)  // Narrow values are extended before being pushed
+			{
+				emitLoad(o, variableName, type.load, "%eax");
+				o << "\tpushq\t %rax" << "\t\t# [wparam] push " << variableName << " onto the stack" << endl;
+			}
+			else
+			{
+				o << "\tpushq\t " << operand(variable, 8) << "\t\t# [wparam] push " << variableName << " onto the stack" << endl;
+			}
 
 			break;
 		}
 
-		// Unconditional jump instruction
-		case IRInstr::absolute_jump:
+		// Read parameter value from a register, or from the stack
+		case EMIT_RPARAM:
 		{
 			// Get params
-			string blockLabel = parameters.at(0);
+			string variableName = parameters.at(0);
+			int nbParams = stoi(parameters.at(1));
+			int offset = stoi(parameters.at(2));
+			const targetTypeStruct& type = targetType(symbolTable->getVariable(variableName)->variableType);
 
-			// Write ASM instructions
-			o << "\tjmp\t " << blockLabel << endl;
+			if (nbParams < TARGET_PARAM_REGISTERS)  // Use registers for the first parameters
+			{
+				emitStore(o, type.move, type.paramRegisters[nbParams], variableName);
+			}
+			else  // Load parameters from the stack of the caller
+			{
+				o << "\t" << type.move << "\t " << offset << "(%rbp), " << type.accumulator
+				  << "\t\t# [rparam] load param " << nbParams << " into " << type.accumulator << endl;
+				emitStore(o, type.move, type.accumulator, variableName);
+			}
 
 			break;
 		}
 
 		// Call a function
-		case IRInstr::call:
+		case EMIT_CALL:
 		{
 			// Get params
 			string label = parameters.at(0);
-			string tmp = parameters.at(1);
+			string tmpName = parameters.at(1);
 			int nbParams = stoi(parameters.at(2));
-			int sub = max((nbParams-6)*8, 0);
+			int sub = max((nbParams - TARGET_PARAM_REGISTERS) * 8, 0);
 
 			// Write ASM instructions
 			o << "\tcall\t " << label << endl;
 
+			// Pop the parameters pushed on the stack
 			if (sub > 0) 
 			{
-				o << "\tsubq\t $" << sub << ", %rsp" << endl;
+				o << "\taddq\t $" << sub << ", %rsp" << endl;
 			}
 
-			o << "\tmovl\t %eax, " << symbolTable->getVariable(tmp)->memoryOffset << "(%rbp)"
-			  << "\t\t# [call] load " << "%eax" << " into " << tmp << endl;
+			// A void function gives no value: its temporary has no storage
+			const targetTypeStruct& tmp = targetType(symbolTable->getVariable(tmpName)->variableType);
+
+			if (tmp.size > 0)
+			{
+				emitStore(o, tmp.move, tmp.accumulator, tmpName);
+			}
 
 			break;
 		}
 
-		// Write parameter value into stack
-		case IRInstr::wparam:
+		// Return from function
+		case EMIT_RET:
 		{
-			// Get params
-			string variableName = parameters.at(0);
-			int nbParams = stoi(parameters.at(1));
-			varStruct * variable = symbolTable->getVariable(variableName);
+			// Get parameters
+			string param = parameters.at(0);
 
-			if (nbParams < 6)  // Use registers for less than 6 parameters
+			if (symbolTable->hasVariable(param)) // If we're returning a var
 			{
-				// Get param register
-				string reg = IRInstr::AMD86_paramRegisters[variable->variableType][nbParams];
-				string movInstr = (variable->variableType == "char") ? "movb" : "movl";
-
-				// Write ASM instructions
-				o << "\t" << movInstr << "\t " << variable->memoryOffset << "(%rbp), " << reg \
-				  << "\t\t# [wparam] load " << variableName << " into " << reg << endl;
+				emitLoad(o, param, targetLoad(operation.load, symbolTable->getVariable(param)->variableType), "%eax");
 			}
-			else  // Pass parameters on the stack if more than 6 parameters
+			else // If we're returning a const
 			{
-				// Write ASM instructions
-				if (variable->variableType == "char") 
-				{ 
-					o << "\tmovzbl\t " << variable->memoryOffset << "(%rbp)" << ", %eax" << endl;
-					o << "\tpushq\t %rax" \
-					  << "\t\t# [wparam] push " << variableName << " onto the stack" << endl;
-				}
-				else 
-				{
-					o << "\tpushq\t " << variable->memoryOffset << "(%rbp)" \
-					  << "\t\t# [wparam] push " << variableName << " onto the stack" << endl;
-				}
-			}
-
-			break;	
-		}
-
-		// Read parameter value from stack
-		case IRInstr::rparam:
-		{
-			// Get params
-			string variableName = parameters.at(0);
-			int nbParams = stoi(parameters.at(1));
-			int offset = stoi(parameters.at(2));
-			varStruct * variable = symbolTable->getVariable(variableName);
-
-			if (nbParams < 6)  // Use registers for less than 6 parameters
-			{ 
-				// Get param register
-				string reg = IRInstr::AMD86_paramRegisters[variable->variableType][nbParams];
-				string movInstr = (variable->variableType == "char") ? "movb" : "movl";
+				int constValue = stoi(param.substr(1, param.size() - 1));
 
 				// Write ASM instructions
-				o << "\t" << movInstr << "\t " << reg << ", " << variable->memoryOffset << "(%rbp)"
-				  << "\t\t# [rparam] load " << reg << " into " << "°" + variableName << endl;
+				o << "\tmovl\t $" << constValue << ", %eax" << "\t\t# [ret] load " << constValue << " into %eax" << endl;
 			}
-			else // Load parameters from stack if more than 6 parameters 
-			{
-				string movInstr1, movInstr2;
-				string reg;
 
-				if (variable->variableType == "int")
-				{
-					// int = int : movl
-					movInstr1 = "movl";
-					movInstr2 = "movl";
-					reg = "eax";
-				}
-				else if (variable->variableType == "char")
-				{
-					// char = char : movb
-					movInstr1 = "movb";
-					movInstr2 = "movb";
-					reg = "al";
-				}
+			// The unwind state is restored after the ret: code may follow this epilogue
+			o << "\n\t# epilogue" << endl ;
+			o << "\t.cfi_remember_state" << endl;
 
-				// Write ASM instructions
-				o << "\t" << movInstr1 << "\t " << offset << "(%rbp), %" << reg
-				  << "\t\t# [rparam] load param " << nbParams << " into " << "%" << reg << endl;
-				o << "\t" << movInstr2 << "\t %" << reg << ", " << variable->memoryOffset << "(%rbp)"
-				  << "\t\t# [rparam] load " << "%" << reg << " into " << "°" + variableName << endl;
+			// Restore the callee-saved registers given to variables
+			for (pair<int, int> slot : symbolTable->getRegisterSlots())
+			{
+				o << "\tmovq\t " << slot.second << "(%rbp), " << targetRegisterName(slot.first, 8) << "\t\t# restore " << targetRegisterName(slot.first, 8) << endl;
 			}
 
+			o << "\tmovq\t %rbp, %rsp" << endl;
+			o << "\tpopq\t %rbp \t\t\t# restore %rbp from the stack" << endl;
+			o << "\t.cfi_def_cfa %rsp, 8" << endl;
+			o << "\tret \t\t\t\t# return to the caller" << endl;
+			o << "\t.cfi_restore_state" << endl << endl;
+
 			break;
 		}
 
 		// Prologue
-		case IRInstr::prologue:
+		case EMIT_PROLOGUE:
 		{
 			// Get parameters
 			string label = parameters.at(0);
@@ -775,52 +719,105 @@ void IRInstr::generateASM(ostream &o)
 			o << ".globl\t " << label << endl;
 			o << ".type\t " << label << ", @function" << endl;
 			o << label << ":" << endl;
+			o << "\t.cfi_startproc" << endl;
 
 			o << "\t# prologue\n";
     		o << "\tpushq\t %rbp \t\t\t# save %rbp on the stack\n";
+			o << "\t.cfi_def_cfa_offset 16" << endl;
+			o << "\t.cfi_offset %rbp, -16" << endl;
     		o << "\tmovq\t %rsp, %rbp \t\t# define %rbp for the current function\n";
+			o << "\t.cfi_def_cfa_register %rbp" << endl;
 
 			// Get the memory size needed to store the function's local variables (must be multiple of 16)
 			int memSize = symbolTable->getMemorySpace();
 			int remainder = memSize % 16;
 			memSize += (remainder > 0) ? 16 - remainder : 0;
 
-			o << "\tsubq\t $" << memSize << ", %rsp" << endl << endl;
+			// A function keeping nothing in memory leaves %rsp where it is
+			if (memSize > 0)
+			{
+				o << "\tsubq\t $" << memSize << ", %rsp" << endl;
+			}
+
+			// Save the callee-saved registers given to variables (the frame address is %rbp + 16)
+			for (pair<int, int> slot : symbolTable->getRegisterSlots())
+			{
+				o << "\tmovq\t " << targetRegisterName(slot.first, 8) << ", " << slot.second << "(%rbp)\t\t# save " << targetRegisterName(slot.first, 8) << endl;
+				o << "\t.cfi_offset " << targetRegisterName(slot.first, 8) << ", " << slot.second - 16 << endl;
+			}
+
+			o << endl;
 
 			break;
 		}
 
-		// Return from function
-		case IRInstr::ret:
+		// Conditional jump instruction: to the false exit if the test is 0
+		case EMIT_CONDITIONAL_JUMP:
 		{
-			// Get parameters
-			string param = parameters.at(0);
+			// Get params
+			string testVariableName = parameters.at(0);
+			string falseExitBlockLabel = parameters.at(1);
+			string trueExitBlockLabel = parameters.at(2);
 
-			if (symbolTable->hasVariable(param)) // If we're returning a var
+			// A fused comparison compares its operands, and jumps to the true exit on its condition (setl gives jl)
+			if (parameters.size() > 3)
 			{
-				varStruct * variable = symbolTable->getVariable(param);
+				const targetOperationStruct& comparison = targetOperation(getFusedComparison());
+				string rightName = parameters.at(3);
+				varStruct * left = symbolTable->getVariable(testVariableName);
+				varStruct * right = isImmediate(rightName) ? nullptr : symbolTable->getVariable(rightName);
 
-				// Write ASM instructions
-				o << "\tmovl\t " << variable->memoryOffset << "(%rbp), %eax"
-				<< "\t\t# [ret] load " << param << " into "
-				<< "%eax" << endl;
-			}
-			else // If we're returning a const
-			{
-				int constValue = stoi(param.substr(1, param.size() - 1));
+				// A 32-bit operand is read in place (but not both from memory), a narrow one is extended into %eax or %edx
+				string leftOperand = targetType(left->variableType).size == 4 ? operand(left) : "%eax";
+				string rightOperand = right == nullptr ? rightName : targetType(right->variableType).size == 4 ? operand(right) : "%edx";
 
-				// Write ASM instructions
-				o << "\tmovl\t $" << constValue << ", %eax"
-				  << "\t\t# [ret] load " << constValue << " into "
-				  << "%eax" << endl;
+				if (leftOperand[0] != '%' && rightOperand[0] != '%' && right != nullptr)
+				{
+					leftOperand = "%eax";
+				}
+
+				if (leftOperand == "%eax")
+				{
+					emitLoad(o, testVariableName, targetLoad(comparison.load, left->variableType), "%eax");
+				}
+
+				if (rightOperand == "%edx")
+				{
+					emitLoad(o, rightName, targetLoad(comparison.load, right->variableType), "%edx");
+				}
+
+				o << "\t" << comparison.mnemonic << "\t " << rightOperand << ", " << leftOperand << endl;
+				o << "\tj" << string(comparison.condition).substr(3) << "\t " << trueExitBlockLabel << endl;
+				o << "\tjmp\t " << falseExitBlockLabel << endl;
+
+				break;
 			}
 
-			o << "\n\t# epilogue" << endl ;
-			o << "\tmovq\t %rbp, %rsp" << endl;
-			o << "\tpopq\t %rbp \t\t\t# restore %rbp from the stack" << endl;
-			o << "\tret \t\t\t\t# return to the caller" << endl << endl;
+			// Write ASM instructions (a char test is compared on its byte)
+			varStruct * testVariable = symbolTable->getVariable(testVariableName);
+			o << "\t" << (targetType(testVariable->variableType).size < 4 ? "cmpb" : operation.mnemonic) << "\t $0, " << operand(testVariable) << endl;
+			o << "\t" << operation.condition << "\t " << falseExitBlockLabel << endl;
+			o << "\tjmp\t " << trueExitBlockLabel << endl;
+
+			break;
+		}
+
+		// Unconditional jump instruction
+		case EMIT_ABSOLUTE_JUMP:
+		{
+			// Get params
+			string blockLabel = parameters.at(0);
 
+			// Write ASM instructions
+			o << "\t" << operation.mnemonic << "\t " << blockLabel << endl;
+
+			break;
+		}
+
+		// Operations of the SSA form, replaced before the emission
+		case EMIT_NONE:
+		{
 			break;
 		}
 	}
-}
\ No newline at end of file
+}
@@ -7,6 +7,7 @@
 *************************************************************************/
 
 //------ Interface of class <IRInstr> (file IRInstr.h) -------/
+#pragma once
 
 //--------------------------------------------------- Called interfaces
 #include "../SymbolTable.h"
@@ -24,6 +25,10 @@ class BasicBlock;
 // This class represents individual instructions for the intermediate representation (IR).
 // It defines various operations that can be performed in the IR, such as arithmetic operations,
 // comparisons, control flow instructions, etc.
+// Once optimized, an operand of an arithmetic operation, a comparison, a
+// parameter or a return may be an immediate ($value) instead of a variable,
+// and a conditional jump may compare two operands itself instead of
+// testing a variable: {left, falseLabel, trueLabel, right, comparison}.
 //
 //------------------------------------------------------------------------
 
@@ -62,7 +67,8 @@ class IRInstr
                         ret,                // Return from function
                         prologue,           // Prologue
                         conditional_jump,   // Conditional jump instruction
-                        absolute_jump       // Unconditional jump instruction
+                        absolute_jump,      // Unconditional jump instruction
+                        phi                 // Value depending on the predecessor block (SSA form only)
                     } Operation;
 
 		// Constructor
@@ -89,13 +95,108 @@ class IRInstr
 			return parameters;
 		};
 
-		// Mapping of parameter registers for x86 architecture
-		static unordered_map<string, vector<string>> AMD86_paramRegisters;
+		// Getter for one parameter (without copying the others)
+		const string& getParameter(int index)
+		{
+			return parameters.at(index);
+		};
+
+		// Replace a parameter
+		void setParameter(int index, string value)
+		{
+			parameters.at(index) = value;
+		};
+
+		// Append a parameter (an operand of a phi)
+		void addParameter(string value)
+		{
+			parameters.push_back(value);
+		};
+
+		// Replace the operation and its parameters
+		void setOperation(Operation newOp, vector<string> newParameters)
+		{
+			op = newOp;
+			parameters = newParameters;
+		};
+
+		// Setter for the symbol table resolving the variables
+		void setSymbolTable(SymbolTable * sT)
+		{
+			symbolTable = sT;
+		};
+
+		// Getter for the BB this instruction belongs to
+		BasicBlock* getBasicBlock()
+		{
+			return bb;
+		};
+
+		// Setter for the BB this instruction belongs to (when moved)
+		void setBasicBlock(BasicBlock * newBB)
+		{
+			bb = newBB;
+		};
+
+		// Name of the variable written by the instruction (empty if none)
+		string getDestination();
+
+		// Index of the parameter naming the variable written by the instruction (-1 if none)
+		int getDestinationIndex();
+
+		// Indexes of the parameters naming the variables read by the instruction
+		vector<int> getSourceIndexes();
+
+		// Comparison fused into a conditional jump (the operation itself if none)
+		Operation getFusedComparison();
+
+		// Whether a parameter is an immediate ($value) instead of a variable
+		static bool isImmediate(string parameter)
+		{
+			return !parameter.empty() && parameter[0] == '$';
+		};
+
+		// Value of an operation or a move on constant operands, as the generated code computes it (false if it traps at runtime or is not computed)
+		static bool evaluate(Operation op, Type leftType, int left, Type rightType, int right, int& result);
+
+		// Whether the instruction ends its block (return or jump)
+		bool isTerminator()
+		{
+			return op == ret || op == conditional_jump || op == absolute_jump;
+		};
+
+		// Getter for the source line of the instruction (0 if unknown)
+		int getLine()
+		{
+			return line;
+		};
+
+		// Setter for the source line of the instruction
+		void setLine(int l)
+		{
+			line = l;
+		};
 
 	private:
 
+		// Operand of a variable: its stack slot, or its register accessed on size bytes (the size of its type if 0)
+		string operand(varStruct * variable, int size = 0);
+
+		// Type of an operand (an immediate is an int)
+		Type typeOf(string name);
+
+		// Emit the load of a variable or an immediate into a register
+		void emitLoad(ostream &o, string name, const char * move, const char * reg);
+
+		// Emit a multiplication, a division or a modulo of %eax by a constant with cheaper instructions (false if none, the result is in %eax)
+		bool emitStrengthReduction(ostream &o, int constant);
+
+		// Emit the store of a register into a variable
+		void emitStore(ostream &o, const char * move, const char * reg, string name);
+
 		BasicBlock* bb; 			// The BB this instruction belongs to, which provides a pointer to the CFG this instruction belong to
 		Operation op;				// Operator of the instruction
 		SymbolTable* symbolTable; 	// Associated symbol table
 		vector<string> parameters; 	// Parameters of the instructions (typically src, dest, tmpVar)
+		int line = 0;				// Line of the source code the instruction comes from
 };
\ No newline at end of file
@@ -0,0 +1,161 @@
+/*************************************************************************
+                          PLD Compilateur: ImmediateOperands
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <ImmediateOperands> (file ImmediateOperands.cpp) -----/
+
+#include "ImmediateOperands.h"
+#include "Liveness.h"
+#include "Target.h"
+
+using namespace std;
+
+// Operation computing the same value with its operands swapped
+static const unordered_map<int, IRInstr::Operation> swappedOperations = {
+	{IRInstr::op_add, IRInstr::op_add}, {IRInstr::op_mul, IRInstr::op_mul}, {IRInstr::op_and, IRInstr::op_and},
+	{IRInstr::op_or, IRInstr::op_or}, {IRInstr::op_xor, IRInstr::op_xor}, {IRInstr::cmp_eq, IRInstr::cmp_eq},
+	{IRInstr::cmp_neq, IRInstr::cmp_neq}, {IRInstr::cmp_lt, IRInstr::cmp_gt}, {IRInstr::cmp_gt, IRInstr::cmp_lt},
+	{IRInstr::cmp_eqlt, IRInstr::cmp_eqgt}, {IRInstr::cmp_eqgt, IRInstr::cmp_eqlt}
+};
+
+// Constructor
+ImmediateOperands::ImmediateOperands(CFG * cfg, SSA * ssa) : blocks(cfg->getFunctionBlocks(ssa->getFunctionName()))
+{
+}
+
+// Replace the operands loaded with a constant by immediates
+void ImmediateOperands::run()
+{
+	// In SSA form a variable loaded with a constant holds it everywhere, and a move of a constant loads it into its destination
+	bool changed = true;
+
+	while (changed)
+	{
+		changed = false;
+
+		for (BasicBlock * bb : blocks)
+		{
+			for (IRInstr * instr : bb->getInstructionList())
+			{
+				vector<string> parameters = instr->getParameters();
+				bool isMove = instr->getOp() == IRInstr::copy || instr->getOp() == IRInstr::aff;
+
+				if (isMove && constants.count(parameters[0]) > 0)
+				{
+					pair<Type, int> constant = constants[parameters[0]];
+					Type type = Liveness::variableOf(instr, 1)->variableType;
+					instr->setOperation(IRInstr::ldconst, {typeName(type), immediateOf(instr->getOp(), constant.first, constant.second).substr(1), parameters[1]});
+					changed = true;
+				}
+
+				if (instr->getOp() == IRInstr::ldconst)
+				{
+					constants[instr->getParameters().at(2)] = {Liveness::variableOf(instr, 2)->variableType, stoi(instr->getParameters().at(1))};
+				}
+			}
+		}
+	}
+
+	if (constants.empty())
+	{
+		return;
+	}
+
+	// The operands that can be immediates read the constant, the others still read its variable
+	unordered_map<string, int> nbUses;
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			vector<string> parameters = instr->getParameters();
+
+			for (int index : instr->getSourceIndexes())
+			{
+				string name = parameters[index];
+
+				if (constants.count(name) == 0)
+				{
+					continue;
+				}
+
+				if (acceptsImmediate(instr, index))
+				{
+					instr->setParameter(index, immediateOf(instr->getOp(), constants[name].first, constants[name].second));
+				}
+				else
+				{
+					nbUses[name]++;
+				}
+			}
+
+			// The immediate goes second, where the instruction reads it in place
+			parameters = instr->getParameters();
+			bool isSwapped = swappedOperations.count(instr->getOp()) > 0 && IRInstr::isImmediate(parameters[0]) && !IRInstr::isImmediate(parameters[1]);
+
+			if (isSwapped)
+			{
+				instr->setOperation(swappedOperations.at(instr->getOp()), {parameters[1], parameters[0], parameters[2]});
+			}
+		}
+	}
+
+	// The constants no instruction reads are not loaded
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		for (list<IRInstr*>::iterator it = instructions.begin(); it != instructions.end(); )
+		{
+			IRInstr * instr = *it;
+
+			if (instr->getOp() == IRInstr::ldconst && constants.count(instr->getParameters().at(2)) > 0 && nbUses[instr->getParameters().at(2)] == 0)
+			{
+				delete instr;
+				it = instructions.erase(it);
+				continue;
+			}
+
+			++it;
+		}
+
+		bb->setInstructionList(instructions);
+	}
+}
+
+// Whether an operand of an instruction can be an immediate
+bool ImmediateOperands::acceptsImmediate(IRInstr * instr, int index)
+{
+	const targetOperationStruct& operation = targetOperation(instr->getOp());
+
+	switch (operation.shape)
+	{
+		// The first operand of a compound assignment is also its destination
+		case EMIT_BINARY:
+		case EMIT_DIVIDE:
+			return index == 1 || !operation.compound;
+
+		case EMIT_WPARAM:
+		case EMIT_RET:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+// Immediate of a constant of a type read by an operation
+string ImmediateOperands::immediateOf(IRInstr::Operation op, Type type, int value)
+{
+	// A char is extended like the load of the operation extends it
+	if (type == TYPE_CHAR)
+	{
+		value = targetOperation(op).load == LOAD_SIGNED ? (int) (signed char) value : (int) (unsigned char) value;
+	}
+
+	return "$" + to_string(value);
+}
@@ -0,0 +1,60 @@
+/*************************************************************************
+                          PLD Compilateur: ImmediateOperands
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <ImmediateOperands> (file ImmediateOperands.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "CFG.h"
+#include "SSA.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <ImmediateOperands> :
+//
+// The ImmediateOperands gives the constants of a function in SSA form to
+// the instructions reading them as immediates ($value): the operands of
+// the arithmetic operations and the comparisons (addl $1, %eax), the
+// parameters of the calls (movl $1, %edi) and the returned values. An
+// immediate holds the value as the load of its operation would extend
+// it (a char constant is zero extended, or sign extended by a division).
+// A move of a constant becomes the load of the constant into its
+// destination, and the operands of a commutative operation (or of a
+// comparison, whose condition is mirrored) are swapped so that the
+// immediate comes second, where the instruction reads it in place.
+// A constant no instruction reads anymore is not loaded at all: its
+// temporary leaves the frame.
+//
+//------------------------------------------------------------------------
+
+class ImmediateOperands
+{
+	public:
+
+		// Constructor
+		ImmediateOperands(CFG * cfg, SSA * ssa);
+
+		// Replace the operands loaded with a constant by immediates
+		void run();
+
+	protected:
+
+		// Whether an operand of an instruction can be an immediate
+		static bool acceptsImmediate(IRInstr * instr, int index);
+
+		// Immediate of a constant of a type read by an operation
+		static string immediateOf(IRInstr::Operation op, Type type, int value);
+
+		vector<BasicBlock*> blocks;								// Blocks of the function
+		unordered_map<string, pair<Type, int>> constants;		// Type and value of every variable loaded with a constant
+};
@@ -0,0 +1,777 @@
+/*************************************************************************
+                          PLD Compilateur: Interpreter
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <Interpreter> (file Interpreter.cpp) -----/
+
+#include "Interpreter.h"
+#include "Target.h"
+
+#include <cstring>
+#include <climits>
+#include <csignal>
+#include <unistd.h>
+
+using namespace std;
+
+// Size of the emulated stack (the usual limit of a native process)
+static const uint64_t STACK_SIZE = 8 * 1024 * 1024;
+
+// Memory above the initial stack pointer (read by the prologue of main like the caller's frame)
+static const uint64_t STACK_TOP_MARGIN = 4096;
+
+// Return address pushed when main is called: returning to it ends the program
+static const uint64_t RETURN_TO_HOST = UINT64_MAX;
+
+// Static initialization of the registers used to pass the parameters (%edi, %esi, %edx, %ecx, %r8d, %r9d)
+const int Interpreter::parameterRegisters[6] = {RDI, RSI, RDX, RCX, R8, R9};
+
+// Load 4 bytes of the emulated memory
+static inline int32_t load32(const unsigned char * memory, uint64_t address)
+{
+	int32_t value;
+	memcpy(&value, memory + address, 4);
+	return value;
+}
+
+// Load an operand at a frame offset like movl ('l'), movzbl ('z') or movsbl ('s'), or give an immediate ('i')
+static inline int32_t loadOperand(const unsigned char * memory, uint64_t rbp, int operand, char kind)
+{
+	switch (kind)
+	{
+		case 'i': return operand;
+		case 'z': return memory[rbp + operand];
+		case 's': return (signed char) memory[rbp + operand];
+		default: return load32(memory, rbp + operand);
+	}
+}
+
+// Store the low size bytes of a value into the emulated memory
+static inline void store(unsigned char * memory, uint64_t address, int size, int32_t value)
+{
+	memcpy(memory + address, &value, size);
+}
+
+// Build a bytecode instruction
+static bytecodeInstr makeInstr(bytecodeOperation op, int a = 0, int b = 0, int c = 0, char loadA = 'l', char loadB = 'l', char storeSize = 4)
+{
+	return {nullptr, op, a, b, c, -1, loadA, loadB, storeSize, 0, false};
+}
+
+// Size of the frame of a function, rounded up to a multiple of 16 like in the assembly
+static int frameSize(SymbolTable * frame)
+{
+	int memSize = frame->getMemorySpace();
+	int remainder = memSize % 16;
+	return memSize + ((remainder > 0) ? 16 - remainder : 0);
+}
+
+// Constructor: decode the IR of the CFG into bytecode
+Interpreter::Interpreter(CFG * cfg)
+{
+	vector<BasicBlock*>& blocks = cfg->getBasicBlocks();
+
+	// The register file of a function lies under its frame
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			if (instr->getOp() == IRInstr::prologue)
+			{
+				frameSizes[bb->getFunctionName()] = frameSize(instr->getSymbolTable());
+			}
+		}
+	}
+
+	// Lay the blocks out like the assembly: a block without jump falls through into the next one
+	for (size_t bb = 0; bb < blocks.size() && valid; bb++)
+	{
+		labels[blocks[bb]->getLabel()] = code.size();
+		blockLabels.push_back(blocks[bb]->getLabel());
+		blockFunctions.push_back(blocks[bb]->getFunctionName());
+
+		for (IRInstr * instr : blocks[bb]->getInstructionList())
+		{
+			size_t first = code.size();
+
+			if (!decode(instr, bb))
+			{
+				break;
+			}
+
+			for (size_t i = first; i < code.size(); i++)
+			{
+				code[i].bb = bb;
+				code[i].isFirst = i == first;
+			}
+		}
+	}
+
+	// The prologues also reserve the register files
+	for (pair<const string, int>& registerFile : registerFileSizes)
+	{
+		if (functions.count(registerFile.first))
+		{
+			code[functions[registerFile.first]].a += registerFile.second;
+		}
+	}
+
+	// Running past the last block is an error
+	code.push_back(makeInstr(BC_END));
+	code.back().bb = blocks.empty() ? 0 : blocks.size() - 1;
+
+	// Resolve the branches
+	for (pair<size_t, string>& jump : jumps)
+	{
+		if (!labels.count(jump.second))
+		{
+			fail("undefined label '" + jump.second + "'");
+			continue;
+		}
+
+		code[jump.first].target = labels[jump.second];
+	}
+
+	// Resolve the calls, putchar and getchar are built in
+	for (pair<size_t, string>& call : calls)
+	{
+		if (functions.count(call.second))
+		{
+			code[call.first].target = functions[call.second];
+		}
+		else if (call.second == "putchar")
+		{
+			code[call.first].op = BC_PUTCHAR;
+		}
+		else if (call.second == "getchar")
+		{
+			code[call.first].op = BC_GETCHAR;
+		}
+		else
+		{
+			fail("undefined reference to '" + call.second + "'");
+		}
+	}
+
+	if (valid && !functions.count("main"))
+	{
+		fail("undefined reference to 'main'");
+	}
+
+	executions.assign(code.size(), 0);
+}
+
+// Signal a decoding error
+bool Interpreter::fail(string message)
+{
+	cerr << "error: interp: " << message << endl;
+	valid = false;
+	return false;
+}
+
+// Stop the program like the native code would (segmentation fault, division error...)
+void Interpreter::trap(int signalNumber, string message)
+{
+	cout.flush();
+	cerr << "error: interp: " << message << endl;
+	signal(signalNumber, SIG_DFL);
+	raise(signalNumber);
+}
+
+// Decode one IR instruction into bytecode
+bool Interpreter::decode(IRInstr * instr, int bb)
+{
+	SymbolTable * symbolTable = instr->getSymbolTable();
+	vector<string> parameters = instr->getParameters();
+
+	// Frame offset and load kind of a variable (an immediate gives its value, a register its slot in the register file)
+	auto offset = [&](string name)
+	{
+		if (IRInstr::isImmediate(name))
+		{
+			return stoi(name.substr(1));
+		}
+
+		varStruct * variable = symbolTable->getVariable(name);
+
+		if (variable->registerIndex < 0)
+		{
+			return variable->memoryOffset;
+		}
+
+		int& registerFileSize = registerFileSizes[blockFunctions[bb]];
+		registerFileSize = max(registerFileSize, 8 * (variable->registerIndex + 1));
+		return -(frameSizes[blockFunctions[bb]] + 8 * (variable->registerIndex + 1));
+	};
+	auto type = [&](string name) { return IRInstr::isImmediate(name) ? TYPE_INT : symbolTable->getVariable(name)->variableType; };
+	auto loadKind = [&](string name) { return IRInstr::isImmediate(name) ? 'i' : type(name) == TYPE_CHAR ? 'z' : 'l'; };
+	auto storeSize = [&](string name) { return (char) targetType(type(name)).size; };
+
+	switch (instr->getOp())
+	{
+		case IRInstr::ldconst:
+		{
+			int value = SymbolTable::getCast(type(parameters.at(2)), stoi(parameters.at(1)));
+			code.push_back(makeInstr(type(parameters.at(2)) == TYPE_CHAR ? BC_LDCONST_B : BC_LDCONST_L, offset(parameters.at(2)), value));
+			break;
+		}
+
+		case IRInstr::aff:
+		case IRInstr::copy:
+		{
+			string source = parameters.at(0);
+			string destination = parameters.at(1);
+			bytecodeOperation op = BC_COPY_L;
+
+			if (type(destination) == TYPE_CHAR)
+			{
+				op = BC_COPY_B;
+			}
+			else if (type(source) == TYPE_CHAR)
+			{
+				op = BC_COPY_ZBL;
+			}
+
+			code.push_back(makeInstr(op, offset(source), offset(destination)));
+			break;
+		}
+
+		case IRInstr::op_not:
+		case IRInstr::op_minus:
+		{
+			bytecodeOperation op = instr->getOp() == IRInstr::op_not ? BC_NOT : BC_MINUS;
+			code.push_back(makeInstr(op, offset(parameters.at(0)), offset(parameters.at(1)), 0, loadKind(parameters.at(0)), 'l', storeSize(parameters.at(1))));
+			break;
+		}
+
+		case IRInstr::op_add:
+		case IRInstr::op_sub:
+		case IRInstr::op_mul:
+		case IRInstr::op_div:
+		case IRInstr::op_mod:
+		case IRInstr::op_xor:
+		case IRInstr::op_and:
+		case IRInstr::op_or:
+		case IRInstr::cmp_eq:
+		case IRInstr::cmp_neq:
+		case IRInstr::cmp_lt:
+		case IRInstr::cmp_gt:
+		case IRInstr::cmp_eqlt:
+		case IRInstr::cmp_eqgt:
+		{
+			static const unordered_map<int, bytecodeOperation> operations = {
+				{IRInstr::op_add, BC_ADD}, {IRInstr::op_sub, BC_SUB}, {IRInstr::op_mul, BC_MUL}, {IRInstr::op_div, BC_DIV},
+				{IRInstr::op_mod, BC_MOD}, {IRInstr::op_xor, BC_XOR}, {IRInstr::op_and, BC_AND}, {IRInstr::op_or, BC_OR},
+				{IRInstr::cmp_eq, BC_CMP_EQ}, {IRInstr::cmp_neq, BC_CMP_NEQ}, {IRInstr::cmp_lt, BC_CMP_LT},
+				{IRInstr::cmp_gt, BC_CMP_GT}, {IRInstr::cmp_eqlt, BC_CMP_LE}, {IRInstr::cmp_eqgt, BC_CMP_GE}
+			};
+
+			bytecodeOperation op = operations.at(instr->getOp());
+			char loadA = loadKind(parameters.at(0));
+			char loadB = loadKind(parameters.at(1));
+
+			if (op == BC_MOD || op == BC_DIV) // op_div and op_mod sign extend their char operands
+			{
+				loadA = loadA == 'z' ? 's' : loadA;
+				loadB = loadB == 'z' ? 's' : loadB;
+			}
+
+			code.push_back(makeInstr(op, offset(parameters.at(0)), offset(parameters.at(1)), offset(parameters.at(2)), loadA, loadB, storeSize(parameters.at(2))));
+			break;
+		}
+
+		case IRInstr::op_plus_equal:
+		case IRInstr::op_sub_equal:
+		case IRInstr::op_mult_equal:
+		case IRInstr::op_div_equal:
+		{
+			static const unordered_map<int, bytecodeOperation> operations = {
+				{IRInstr::op_plus_equal, BC_PLUS_EQUAL}, {IRInstr::op_sub_equal, BC_SUB_EQUAL},
+				{IRInstr::op_mult_equal, BC_MULT_EQUAL}, {IRInstr::op_div_equal, BC_DIV_EQUAL}
+			};
+
+			bytecodeOperation op = operations.at(instr->getOp());
+			char loadA = loadKind(parameters.at(0));
+			char loadB = loadKind(parameters.at(1));
+
+			if (op == BC_DIV_EQUAL) // op_div_equal sign extends its char operands
+			{
+				loadA = loadA == 'z' ? 's' : loadA;
+				loadB = loadB == 'z' ? 's' : loadB;
+			}
+
+			code.push_back(makeInstr(op, offset(parameters.at(0)), offset(parameters.at(1)), 0, loadA, loadB, storeSize(parameters.at(0))));
+			break;
+		}
+
+		case IRInstr::conditional_jump:
+		{
+			// A fused comparison: cmpl of the operands + jcc to the true exit, then jmp to the false exit
+			if (parameters.size() > 3)
+			{
+				static const unordered_map<int, bytecodeOperation> operations = {
+					{IRInstr::cmp_eq, BC_JUMP_IF_EQ}, {IRInstr::cmp_neq, BC_JUMP_IF_NEQ}, {IRInstr::cmp_lt, BC_JUMP_IF_LT},
+					{IRInstr::cmp_gt, BC_JUMP_IF_GT}, {IRInstr::cmp_eqlt, BC_JUMP_IF_LE}, {IRInstr::cmp_eqgt, BC_JUMP_IF_GE}
+				};
+
+				string left = parameters.at(0);
+				string right = parameters.at(3);
+				code.push_back(makeInstr(operations.at(instr->getFusedComparison()), offset(left), offset(right), 0, loadKind(left), loadKind(right)));
+				jumps.push_back({code.size() - 1, parameters.at(2)});
+				code.push_back(makeInstr(BC_JUMP));
+				jumps.push_back({code.size() - 1, parameters.at(1)});
+				break;
+			}
+
+			// cmpl $0 + je to the false exit, then jmp to the true exit
+			code.push_back(makeInstr(BC_JUMP_IF_ZERO, offset(parameters.at(0)), 0, 0, loadKind(parameters.at(0))));
+			jumps.push_back({code.size() - 1, parameters.at(1)});
+			code.push_back(makeInstr(BC_JUMP));
+			jumps.push_back({code.size() - 1, parameters.at(2)});
+			break;
+		}
+
+		case IRInstr::absolute_jump:
+		{
+			code.push_back(makeInstr(BC_JUMP));
+			jumps.push_back({code.size() - 1, parameters.at(0)});
+			break;
+		}
+
+		case IRInstr::call:
+		{
+			// The call returns to the instruction storing %eax into the temporary
+			int nbParams = stoi(parameters.at(2));
+			code.push_back(makeInstr(BC_CALL));
+			calls.push_back({code.size() - 1, parameters.at(0)});
+			code.push_back(makeInstr(BC_CALL_RESULT, offset(parameters.at(1)), max((nbParams - 6) * 8, 0), 0, 'l', 'l', storeSize(parameters.at(1))));
+			break;
+		}
+
+		case IRInstr::wparam:
+		{
+			string name = parameters.at(0);
+			int index = stoi(parameters.at(1));
+			bool isChar = type(name) == TYPE_CHAR;
+
+			if (IRInstr::isImmediate(name))
+			{
+				code.push_back(index < 6 ? makeInstr(BC_WPARAM_REG_CONST, offset(name), parameterRegisters[index]) : makeInstr(BC_WPARAM_STACK_CONST, offset(name)));
+			}
+			else if (index < 6)
+			{
+				code.push_back(makeInstr(isChar ? BC_WPARAM_REG_B : BC_WPARAM_REG_L, offset(name), parameterRegisters[index]));
+			}
+			else
+			{
+				code.push_back(makeInstr(isChar ? BC_WPARAM_STACK_B : BC_WPARAM_STACK_L, offset(name)));
+			}
+
+			break;
+		}
+
+		case IRInstr::rparam:
+		{
+			string name = parameters.at(0);
+			int index = stoi(parameters.at(1));
+			bool isChar = type(name) == TYPE_CHAR;
+
+			if (index < 6)
+			{
+				code.push_back(makeInstr(isChar ? BC_RPARAM_REG_B : BC_RPARAM_REG_L, offset(name), parameterRegisters[index]));
+			}
+			else
+			{
+				code.push_back(makeInstr(isChar ? BC_RPARAM_STACK_B : BC_RPARAM_STACK_L, offset(name), stoi(parameters.at(2))));
+			}
+
+			break;
+		}
+
+		case IRInstr::prologue:
+		{
+			functions[parameters.at(0)] = code.size();
+			code.push_back(makeInstr(BC_PROLOGUE, frameSize(symbolTable)));
+			break;
+		}
+
+		case IRInstr::ret:
+		{
+			string param = parameters.at(0);
+
+			if (symbolTable->hasVariable(param))
+			{
+				code.push_back(makeInstr(BC_RET_VAR, offset(param), 0, 0, loadKind(param)));
+			}
+			else
+			{
+				code.push_back(makeInstr(BC_RET_CONST, stoi(param.substr(1, param.size() - 1))));
+			}
+
+			break;
+		}
+
+		default:
+		{
+			return fail("unsupported IR instruction in block " + blockLabels[bb]);
+		}
+	}
+
+	return true;
+}
+
+// Execute main with the arguments and return its exit status
+int Interpreter::run(vector<string> arguments)
+{
+	// Handlers of the operations, in the order of bytecodeOperation
+	static const void * const handlers[BC_COUNT] = {
+		&&do_ldconst_b, &&do_ldconst_l,
+		&&do_copy_l, &&do_copy_b, &&do_copy_zbl,
+		&&do_not, &&do_minus,
+		&&do_add, &&do_sub, &&do_mul, &&do_div, &&do_mod, &&do_xor, &&do_and, &&do_or,
+		&&do_cmp_eq, &&do_cmp_neq, &&do_cmp_lt, &&do_cmp_gt, &&do_cmp_le, &&do_cmp_ge,
+		&&do_plus_equal, &&do_sub_equal, &&do_mult_equal, &&do_div_equal,
+		&&do_jump_if_zero, &&do_jump,
+		&&do_jump_if_eq, &&do_jump_if_neq, &&do_jump_if_lt, &&do_jump_if_gt, &&do_jump_if_le, &&do_jump_if_ge,
+		&&do_call, &&do_putchar, &&do_getchar, &&do_call_result,
+		&&do_wparam_reg_b, &&do_wparam_reg_l, &&do_wparam_stack_b, &&do_wparam_stack_l,
+		&&do_wparam_reg_const, &&do_wparam_stack_const,
+		&&do_rparam_reg_b, &&do_rparam_reg_l, &&do_rparam_stack_b, &&do_rparam_stack_l,
+		&&do_prologue, &&do_ret_var, &&do_ret_const,
+		&&do_end
+	};
+
+	if (!valid)
+	{
+		return 1;
+	}
+
+	// Thread the code
+	for (bytecodeInstr& instr : code)
+	{
+		instr.handler = handlers[instr.op];
+	}
+
+	// Machine state
+	vector<unsigned char> stack(STACK_SIZE + STACK_TOP_MARGIN, 0);
+	unsigned char * memory = stack.data();
+	uint64_t reg[NB_REGISTERS] = {0};
+	uint64_t rsp = STACK_SIZE;
+	uint64_t rbp = 0;
+	uint64_t * counts = executions.data();
+	const bytecodeInstr * instrs = code.data();
+	const bytecodeInstr * i;
+	size_t pc;
+	int32_t x, y, result;
+
+	// main(argc, argv): argv itself is not addressable by the generated code
+	reg[RDI] = arguments.size();
+
+	// Push the return address of main and enter it
+	rsp -= 8;
+	memcpy(memory + rsp, &RETURN_TO_HOST, 8);
+	pc = functions["main"];
+
+	#define DISPATCH() { i = &instrs[pc]; counts[pc]++; goto *i->handler; }
+	#define NEXT() { pc++; DISPATCH(); }
+	#define SET_EAX(value) { reg[RAX] = (uint32_t) (value); }
+	#define SET_AL(value) { reg[RAX] = (reg[RAX] & ~0xFFULL) | (unsigned char) (value); }
+	#define PUSH(value) { if (rsp < 8) { trap(SIGSEGV, "stack overflow"); } rsp -= 8; uint64_t pushed = (value); memcpy(memory + rsp, &pushed, 8); }
+	#define POP(destination) { memcpy(&destination, memory + rsp, 8); rsp += 8; }
+	#define BINARY(expression) { x = loadOperand(memory, rbp, i->a, i->loadA); y = loadOperand(memory, rbp, i->b, i->loadB); \
+		reg[RDX] = (uint32_t) y; result = (expression); SET_EAX(result); store(memory, rbp + i->c, i->storeSize, result); NEXT(); }
+	#define COMPOUND(expression) { x = loadOperand(memory, rbp, i->a, i->loadA); y = loadOperand(memory, rbp, i->b, i->loadB); \
+		reg[RDX] = (uint32_t) y; result = (expression); SET_EAX(result); store(memory, rbp + i->a, i->storeSize, result); NEXT(); }
+	#define JUMP_IF(condition) { x = loadOperand(memory, rbp, i->a, i->loadA); y = loadOperand(memory, rbp, i->b, i->loadB); \
+		if (condition) { pc = i->target; DISPATCH(); } NEXT(); }
+	#define CHECK_DIVISION(dividend, divisor) { if ((divisor) == 0 || ((dividend) == INT_MIN && (divisor) == -1)) { trap(SIGFPE, "division error"); } }
+
+	DISPATCH();
+
+	do_ldconst_b:
+		store(memory, rbp + i->a, 1, i->b);
+		NEXT();
+
+	do_ldconst_l:
+		store(memory, rbp + i->a, 4, i->b);
+		NEXT();
+
+	do_copy_l:
+		x = load32(memory, rbp + i->a);
+		SET_EAX(x);
+		store(memory, rbp + i->b, 4, x);
+		NEXT();
+
+	do_copy_b:
+		SET_AL(memory[rbp + i->a]);
+		memory[rbp + i->b] = memory[rbp + i->a];
+		NEXT();
+
+	do_copy_zbl:
+		x = memory[rbp + i->a];
+		SET_EAX(x);
+		store(memory, rbp + i->b, 4, x);
+		NEXT();
+
+	do_not:
+		result = loadOperand(memory, rbp, i->a, i->loadA) == 0;
+		SET_EAX(result);
+		store(memory, rbp + i->b, i->storeSize, result);
+		NEXT();
+
+	do_minus:
+		result = (int32_t) (0U - (uint32_t) loadOperand(memory, rbp, i->a, i->loadA));
+		SET_EAX(result);
+		store(memory, rbp + i->b, i->storeSize, result);
+		NEXT();
+
+	do_add: BINARY((int32_t) ((uint32_t) x + (uint32_t) y));
+	do_sub: BINARY((int32_t) ((uint32_t) x - (uint32_t) y));
+	do_mul: BINARY((int32_t) ((uint32_t) x * (uint32_t) y));
+	do_xor: BINARY(x ^ y);
+	do_cmp_eq: BINARY(x == y);
+	do_cmp_neq: BINARY(x != y);
+	do_cmp_lt: BINARY(x < y);
+	do_cmp_gt: BINARY(x > y);
+	do_cmp_le: BINARY(x <= y);
+	do_cmp_ge: BINARY(x >= y);
+
+	do_div:
+		// cltd + idivl of the second operand (extended into %ecx if narrow)
+		x = loadOperand(memory, rbp, i->a, i->loadA);
+		y = loadOperand(memory, rbp, i->b, i->loadB);
+		CHECK_DIVISION(x, y);
+		SET_EAX(x / y);
+		reg[RDX] = (uint32_t) (x % y);
+		store(memory, rbp + i->c, i->storeSize, x / y);
+		NEXT();
+
+	do_mod:
+		// cltd + idivl %ecx, the remainder is in %edx
+		x = loadOperand(memory, rbp, i->a, i->loadA);
+		y = loadOperand(memory, rbp, i->b, i->loadB);
+		reg[RCX] = (uint32_t) y;
+		CHECK_DIVISION(x, y);
+		SET_EAX(x / y);
+		reg[RDX] = (uint32_t) (x % y);
+		store(memory, rbp + i->c, i->storeSize, x % y);
+		NEXT();
+
+	do_and:
+		result = loadOperand(memory, rbp, i->a, i->loadA) & loadOperand(memory, rbp, i->b, i->loadB);
+		SET_EAX(result);
+		store(memory, rbp + i->c, i->storeSize, result);
+		NEXT();
+
+	do_or:
+		result = loadOperand(memory, rbp, i->a, i->loadA) | loadOperand(memory, rbp, i->b, i->loadB);
+		SET_EAX(result);
+		store(memory, rbp + i->c, i->storeSize, result);
+		NEXT();
+
+	do_plus_equal: COMPOUND((int32_t) ((uint32_t) x + (uint32_t) y));
+	do_sub_equal: COMPOUND((int32_t) ((uint32_t) x - (uint32_t) y));
+	do_mult_equal: COMPOUND((int32_t) ((uint32_t) x * (uint32_t) y));
+
+	do_div_equal:
+		x = loadOperand(memory, rbp, i->a, i->loadA);
+		y = loadOperand(memory, rbp, i->b, i->loadB);
+		CHECK_DIVISION(x, y);
+		SET_EAX(x / y);
+		reg[RDX] = (uint32_t) (x % y);
+		store(memory, rbp + i->a, i->storeSize, x / y);
+		NEXT();
+
+	do_jump_if_zero:
+		if (loadOperand(memory, rbp, i->a, i->loadA) == 0)
+		{
+			pc = i->target;
+			DISPATCH();
+		}
+		NEXT();
+
+	do_jump:
+		pc = i->target;
+		DISPATCH();
+
+	do_jump_if_eq: JUMP_IF(x == y);
+	do_jump_if_neq: JUMP_IF(x != y);
+	do_jump_if_lt: JUMP_IF(x < y);
+	do_jump_if_gt: JUMP_IF(x > y);
+	do_jump_if_le: JUMP_IF(x <= y);
+	do_jump_if_ge: JUMP_IF(x >= y);
+
+	do_call:
+		PUSH(pc + 1);
+		pc = i->target;
+		DISPATCH();
+
+	do_putchar:
+	{
+		// write(1, &c, 1) then return 1
+		cout.put((char) reg[RDI]);
+		reg[RAX] = 1;
+		reg[RDI] = 1;
+		reg[RDX] = 1;
+		reg[RSI] = rsp - 24;
+		NEXT();
+	}
+
+	do_getchar:
+	{
+		// read(0, &c, 1), EOF is returned as -1
+		unsigned char c;
+		cout.flush();
+		SET_EAX(read(STDIN_FILENO, &c, 1) == 1 ? c : -1);
+		reg[RDI] = 0;
+		reg[RDX] = 1;
+		reg[RSI] = rsp;
+		NEXT();
+	}
+
+	do_call_result:
+		// The stack parameters are popped
+		rsp += i->b;
+
+		// The result of a void function is not stored
+		if (i->storeSize > 0)
+		{
+			store(memory, rbp + i->a, i->storeSize, (int32_t) reg[RAX]);
+		}
+
+		NEXT();
+
+	do_wparam_reg_b:
+		reg[i->b] = memory[rbp + i->a];
+		NEXT();
+
+	do_wparam_reg_l:
+		reg[i->b] = (uint32_t) load32(memory, rbp + i->a);
+		NEXT();
+
+	do_wparam_stack_b:
+		SET_EAX(memory[rbp + i->a]);
+		PUSH(reg[RAX]);
+		NEXT();
+
+	do_wparam_stack_l:
+	{
+		// pushq of the variable reads 8 bytes
+		uint64_t value;
+		memcpy(&value, memory + rbp + i->a, 8);
+		PUSH(value);
+		NEXT();
+	}
+
+	do_wparam_reg_const:
+		reg[i->b] = (uint32_t) i->a;
+		NEXT();
+
+	do_wparam_stack_const:
+		// pushq of an immediate sign extends it
+		PUSH((uint64_t) (int64_t) i->a);
+		NEXT();
+
+	do_rparam_reg_b:
+		memory[rbp + i->a] = (unsigned char) reg[i->b];
+		NEXT();
+
+	do_rparam_reg_l:
+		store(memory, rbp + i->a, 4, (int32_t) reg[i->b]);
+		NEXT();
+
+	do_rparam_stack_b:
+		SET_AL(memory[rbp + i->b]);
+		memory[rbp + i->a] = memory[rbp + i->b];
+		NEXT();
+
+	do_rparam_stack_l:
+		x = load32(memory, rbp + i->b);
+		SET_EAX(x);
+		store(memory, rbp + i->a, 4, x);
+		NEXT();
+
+	do_prologue:
+		PUSH(rbp);
+		rbp = rsp;
+
+		if (rsp < (uint64_t) i->a)
+		{
+			trap(SIGSEGV, "stack overflow");
+		}
+
+		rsp -= i->a;
+		NEXT();
+
+	do_ret_var:
+		SET_EAX(loadOperand(memory, rbp, i->a, i->loadA));
+		goto do_return;
+
+	do_ret_const:
+		SET_EAX(i->a);
+		goto do_return;
+
+	do_return:
+	{
+		// movq %rbp, %rsp; popq %rbp; ret
+		uint64_t returnAddress;
+		rsp = rbp;
+		POP(rbp);
+		POP(returnAddress);
+
+		if (returnAddress == RETURN_TO_HOST)
+		{
+			cout.flush();
+			return (int32_t) reg[RAX];
+		}
+
+		pc = returnAddress;
+		DISPATCH();
+	}
+
+	do_end:
+		cout.flush();
+		trap(SIGSEGV, "execution ran past the end of the code");
+		return 1;
+
+	#undef DISPATCH
+	#undef NEXT
+	#undef SET_EAX
+	#undef SET_AL
+	#undef PUSH
+	#undef POP
+	#undef BINARY
+	#undef COMPOUND
+	#undef JUMP_IF
+	#undef CHECK_DIVISION
+}
+
+// Write the number of executed instructions of every basic block
+void Interpreter::printProfile(ostream& o)
+{
+	vector<uint64_t> blockCounts(blockLabels.size(), 0);
+	uint64_t total = 0;
+
+	// Only the first bytecode of an IR instruction is counted
+	for (size_t pc = 0; pc < code.size(); pc++)
+	{
+		if (code[pc].isFirst && code[pc].bb < (int) blockCounts.size())
+		{
+			blockCounts[code[pc].bb] += executions[pc];
+			total += executions[pc];
+		}
+	}
+
+	o << "# profile: executed IR instructions per basic block" << endl;
+
+	for (size_t bb = 0; bb < blockLabels.size(); bb++)
+	{
+		o << blockFunctions[bb] << "\t" << blockLabels[bb] << "\t" << blockCounts[bb] << endl;
+	}
+
+	o << "# total: " << total << endl;
+}
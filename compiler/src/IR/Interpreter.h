@@ -0,0 +1,125 @@
+/*************************************************************************
+                          PLD Compilateur: Interpreter
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <Interpreter> (file Interpreter.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <iostream>
+#include <unordered_map>
+#include <cstdint>
+#include "CFG.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Operations of the bytecode (an IR instruction specialised for its operand types)
+enum bytecodeOperation
+{
+	BC_LDCONST_B, BC_LDCONST_L,
+	BC_COPY_L, BC_COPY_B, BC_COPY_ZBL,
+	BC_NOT, BC_MINUS,
+	BC_ADD, BC_SUB, BC_MUL, BC_DIV, BC_MOD, BC_XOR, BC_AND, BC_OR,
+	BC_CMP_EQ, BC_CMP_NEQ, BC_CMP_LT, BC_CMP_GT, BC_CMP_LE, BC_CMP_GE,
+	BC_PLUS_EQUAL, BC_SUB_EQUAL, BC_MULT_EQUAL, BC_DIV_EQUAL,
+	BC_JUMP_IF_ZERO, BC_JUMP,
+	BC_JUMP_IF_EQ, BC_JUMP_IF_NEQ, BC_JUMP_IF_LT, BC_JUMP_IF_GT, BC_JUMP_IF_LE, BC_JUMP_IF_GE,
+	BC_CALL, BC_PUTCHAR, BC_GETCHAR, BC_CALL_RESULT,
+	BC_WPARAM_REG_B, BC_WPARAM_REG_L, BC_WPARAM_STACK_B, BC_WPARAM_STACK_L,
+	BC_WPARAM_REG_CONST, BC_WPARAM_STACK_CONST,
+	BC_RPARAM_REG_B, BC_RPARAM_REG_L, BC_RPARAM_STACK_B, BC_RPARAM_STACK_L,
+	BC_PROLOGUE, BC_RET_VAR, BC_RET_CONST,
+	BC_END,
+	BC_COUNT
+};
+
+// Structure to represent a pre-decoded instruction (operands are resolved frame offsets)
+struct bytecodeInstr
+{
+	const void * handler;		// Address of the handler of the operation (threaded dispatch)
+	bytecodeOperation op;		// Operation
+	int a;						// First operand (frame offset, register, constant...)
+	int b;						// Second operand
+	int c;						// Third operand
+	int target;					// Index of the next instruction when the operation branches
+	char loadA;					// How the first operand is loaded: 'l' (movl), 'z' (movzbl), 's' (movsbl), 'i' (immediate)
+	char loadB;					// How the second operand is loaded
+	char storeSize;				// Size in bytes of the stored result
+	int bb;						// Index of the basic block of the instruction (profile)
+	bool isFirst;				// Whether the bytecode starts an IR instruction (profile)
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <Interpreter> :
+//
+// The Interpreter executes the IR of a CFG without any native toolchain.
+// The IR is first decoded into a compact bytecode whose variables are
+// resolved to their frame offsets, then executed with computed goto
+// dispatch on an emulated stack. Every operation reproduces the effect
+// of the assembly generated for it (operand sizes, extensions, registers
+// used for the parameters, stack layout), so the interpreter can serve as
+// an oracle for the code generator and the optimisation passes.
+// The variables held in registers are kept in a register file that the
+// prologue reserves under the frame of their function: the slot of a
+// register stands for it in every instruction.
+// The number of executed instructions of every basic block is recorded.
+//
+//------------------------------------------------------------------------
+
+class Interpreter
+{
+	public:
+
+		// Constructor: decode the IR of the CFG into bytecode
+		Interpreter(CFG * cfg);
+
+		// Execute main with the arguments and return its exit status
+		int run(vector<string> arguments);
+
+		// Write the number of executed instructions of every basic block
+		void printProfile(ostream& o);
+
+		// Whether the IR could be decoded
+		bool isValid()
+		{
+			return valid;
+		};
+
+	protected:
+
+		// Decode one IR instruction into bytecode
+		bool decode(IRInstr * instr, int bb);
+
+		// Signal a decoding error
+		bool fail(string message);
+
+		// Stop the program like the native code would (segmentation fault, division error...)
+		void trap(int signalNumber, string message);
+
+		// Registers of the emulated machine used by the generated code
+		enum { RAX, RCX, RDX, RBX, RSI, RDI, R8, R9, NB_REGISTERS };
+
+		vector<bytecodeInstr> code;						// Decoded instructions
+		vector<pair<size_t, string>> jumps;				// Branches to resolve (instruction, label)
+		vector<pair<size_t, string>> calls;				// Calls to resolve (instruction, function)
+		unordered_map<string, int> labels;				// Index of the first instruction of every label
+		unordered_map<string, int> functions;			// Index of the prologue of every function
+		unordered_map<string, int> frameSizes;			// Size of the frame of every function
+		unordered_map<string, int> registerFileSizes;	// Size of the register file of every function (under its frame)
+		vector<string> blockLabels;						// Label of every basic block
+		vector<string> blockFunctions;					// Function of every basic block
+		vector<uint64_t> executions;					// Number of executions of every instruction
+		bool valid = true;								// Whether the IR could be decoded
+
+		// Registers used to pass the first parameters
+		static const int parameterRegisters[6];
+};
@@ -0,0 +1,220 @@
+/*************************************************************************
+                          PLD Compilateur: Liveness
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <Liveness> (file Liveness.cpp) -----/
+
+#include "Liveness.h"
+
+using namespace std;
+
+// Constructor: solve the liveness of the blocks of a function
+Liveness::Liveness(vector<BasicBlock*> blocks, DominatorTree& tree)
+{
+	// Number the variables
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			for (int index : instr->getSourceIndexes())
+			{
+				addVariable(variableOf(instr, index));
+			}
+
+			if (instr->getDestinationIndex() >= 0)
+			{
+				addVariable(variableOf(instr, instr->getDestinationIndex()));
+			}
+		}
+	}
+
+	// Variables written by every block, with the blocks reading them before any write (at the entry) and the phi operands (at the exit of the predecessors)
+	int nbVariables = variables.size();
+	unordered_map<BasicBlock*, vector<bool>> definitions;
+	vector<pair<BasicBlock*, int>> entryReads;
+	vector<pair<BasicBlock*, int>> exitReads;
+
+	for (BasicBlock * bb : blocks)
+	{
+		definitions[bb].assign(nbVariables, false);
+		liveIn[bb].assign(nbVariables, false);
+		liveOut[bb].assign(nbVariables, false);
+		liveOutVariables[bb];
+	}
+
+	for (BasicBlock * bb : blocks)
+	{
+		vector<bool>& written = definitions[bb];
+
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			if (instr->getOp() == IRInstr::phi)
+			{
+				vector<string> parameters = instr->getParameters();
+
+				for (size_t i = 1; i + 1 < parameters.size(); i += 2)
+				{
+					BasicBlock * predecessor = tree.getBlock(parameters[i + 1]);
+					varStruct * variable = variableOf(instr, i);
+
+					if (predecessor != nullptr && variable != nullptr && definitions.count(predecessor) > 0)
+					{
+						exitReads.push_back({predecessor, indexes[variable]});
+					}
+				}
+			}
+			else
+			{
+				for (int index : instr->getSourceIndexes())
+				{
+					varStruct * variable = variableOf(instr, index);
+
+					if (variable != nullptr && !written[indexes[variable]])
+					{
+						entryReads.push_back({bb, indexes[variable]});
+					}
+				}
+			}
+
+			varStruct * destination = instr->getDestinationIndex() >= 0 ? variableOf(instr, instr->getDestinationIndex()) : nullptr;
+
+			if (destination != nullptr)
+			{
+				written[indexes[destination]] = true;
+			}
+		}
+	}
+
+	// Every read is propagated backward up to the blocks writing its variable: the work is the size of the live ranges, not blocks times variables
+	vector<pair<BasicBlock*, int>> worklist;
+
+	auto setLiveIn = [&](BasicBlock * bb, int variable)
+	{
+		vector<bool>& in = liveIn[bb];
+
+		if (!in[variable])
+		{
+			in[variable] = true;
+			worklist.push_back({bb, variable});
+		}
+	};
+
+	auto setLiveOut = [&](BasicBlock * bb, int variable)
+	{
+		vector<bool>& out = liveOut[bb];
+
+		if (!out[variable])
+		{
+			out[variable] = true;
+			liveOutVariables[bb].push_back(variable);
+
+			if (!definitions[bb][variable])
+			{
+				setLiveIn(bb, variable);
+			}
+		}
+	};
+
+	for (pair<BasicBlock*, int>& read : entryReads)
+	{
+		setLiveIn(read.first, read.second);
+	}
+
+	for (pair<BasicBlock*, int>& read : exitReads)
+	{
+		setLiveOut(read.first, read.second);
+	}
+
+	while (!worklist.empty())
+	{
+		pair<BasicBlock*, int> live = worklist.back();
+		worklist.pop_back();
+
+		for (BasicBlock * predecessor : tree.getPredecessors(live.first))
+		{
+			if (liveOut.count(predecessor) > 0)
+			{
+				setLiveOut(predecessor, live.second);
+			}
+		}
+	}
+}
+
+// Variable named by a parameter of an instruction
+varStruct * Liveness::variableOf(IRInstr * instr, int index)
+{
+	const string& name = instr->getParameter(index);
+	SymbolTable * symbolTable = instr->getSymbolTable();
+
+	if (!symbolTable->hasVariable(name) && !symbolTable->hasParameter(name))
+	{
+		return nullptr;
+	}
+
+	return symbolTable->getVariable(name);
+}
+
+// Number of a variable
+int Liveness::getIndex(varStruct * variable)
+{
+	unordered_map<varStruct*, int>::iterator it = indexes.find(variable);
+	return it == indexes.end() ? -1 : it->second;
+}
+
+// Variable of a number
+varStruct * Liveness::getVariable(int index)
+{
+	return variables.at(index);
+}
+
+// Number of variables of the function
+int Liveness::getNbVariables()
+{
+	return variables.size();
+}
+
+// Variables live at the entry of a block
+vector<bool>& Liveness::getLiveIn(BasicBlock * bb)
+{
+	return liveIn[bb];
+}
+
+// Variables live at the exit of a block
+vector<bool>& Liveness::getLiveOut(BasicBlock * bb)
+{
+	return liveOut[bb];
+}
+
+// Variables live at the exit of a block (their numbers)
+vector<int>& Liveness::getLiveOutVariables(BasicBlock * bb)
+{
+	return liveOutVariables[bb];
+}
+
+// Whether a variable is live at the exit of a block
+bool Liveness::isLiveOut(BasicBlock * bb, varStruct * variable)
+{
+	int index = getIndex(variable);
+	return index >= 0 && liveOut[bb][index];
+}
+
+// Number a variable
+int Liveness::addVariable(varStruct * variable)
+{
+	if (variable == nullptr)
+	{
+		return -1;
+	}
+
+	if (indexes.count(variable) == 0)
+	{
+		indexes[variable] = variables.size();
+		variables.push_back(variable);
+	}
+
+	return indexes[variable];
+}
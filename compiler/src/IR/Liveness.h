@@ -0,0 +1,75 @@
+/*************************************************************************
+                          PLD Compilateur: Liveness
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <Liveness> (file Liveness.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <unordered_map>
+#include "DominatorTree.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <Liveness> :
+//
+// The Liveness computes the variables live at the entry and at the exit
+// of every block of a function: those whose current value may still be
+// read. The variables are resolved by the symbol table of every
+// instruction (so two variables of the same name in different scopes are
+// different), and numbered to be stored as bit vectors.
+// In SSA form, a phi reads its operands at the end of the predecessors:
+// they are live at the exit of those blocks, and the variables defined by
+// the phis of a block are not live at its entry.
+//
+//------------------------------------------------------------------------
+
+class Liveness
+{
+	public:
+
+		// Constructor: solve the liveness of the blocks of a function
+		Liveness(vector<BasicBlock*> blocks, DominatorTree& tree);
+
+		// Variable named by a parameter of an instruction (nullptr if not a variable)
+		static varStruct * variableOf(IRInstr * instr, int index);
+
+		// Number of a variable (-1 if not used by the function)
+		int getIndex(varStruct * variable);
+
+		// Variable of a number
+		varStruct * getVariable(int index);
+
+		// Number of variables of the function
+		int getNbVariables();
+
+		// Variables live at the entry of a block (by number)
+		vector<bool>& getLiveIn(BasicBlock * bb);
+
+		// Variables live at the exit of a block (by number)
+		vector<bool>& getLiveOut(BasicBlock * bb);
+
+		// Variables live at the exit of a block (their numbers, in no particular order)
+		vector<int>& getLiveOutVariables(BasicBlock * bb);
+
+		// Whether a variable is live at the exit of a block
+		bool isLiveOut(BasicBlock * bb, varStruct * variable);
+
+	protected:
+
+		// Number a variable (the first time it is seen)
+		int addVariable(varStruct * variable);
+
+		vector<varStruct*> variables;								// Variables of the function, by number
+		unordered_map<varStruct*, int> indexes;						// Number of every variable
+		unordered_map<BasicBlock*, vector<bool>> liveIn;			// Live variables at the entry of every block
+		unordered_map<BasicBlock*, vector<bool>> liveOut;			// Live variables at the exit of every block
+		unordered_map<BasicBlock*, vector<int>> liveOutVariables;	// Numbers of the live variables at the exit of every block
+};
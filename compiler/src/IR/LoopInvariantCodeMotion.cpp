@@ -0,0 +1,379 @@
+/*************************************************************************
+                          PLD Compilateur: LoopInvariantCodeMotion
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <LoopInvariantCodeMotion> (file LoopInvariantCodeMotion.cpp) -----/
+
+#include "LoopInvariantCodeMotion.h"
+#include "Liveness.h"
+#include <climits>
+#include <algorithm>
+
+using namespace std;
+
+// Constructor
+LoopInvariantCodeMotion::LoopInvariantCodeMotion(CFG * cfg, SSA * ssa, set<string>& pureFunctions) : cfg(cfg), ssa(ssa), pureFunctions(pureFunctions)
+{
+}
+
+// Move the invariant operations of the loops to their preheaders
+void LoopInvariantCodeMotion::run()
+{
+	insertPreheaders();
+
+	// The preheaders change the control flow
+	vector<BasicBlock*> blocks = cfg->getFunctionBlocks(ssa->getFunctionName());
+	DominatorTree tree(blocks);
+	LoopNest nest(tree);
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			string destination = instr->getDestination();
+
+			if (!destination.empty())
+			{
+				definitions[destination] = bb;
+			}
+
+			if (instr->getOp() == IRInstr::ldconst)
+			{
+				constants[destination] = instr;
+			}
+
+			for (int index : instr->getSourceIndexes())
+			{
+				string operand = instr->getParameters().at(index);
+				nbUses[operand]++;
+
+				if (instr->getOp() == IRInstr::conditional_jump)
+				{
+					jumpTests.insert(operand);
+				}
+			}
+		}
+	}
+
+	// The inner loops first: their operations can then leave the outer loops too
+	vector<loopStruct>& loops = nest.getLoops();
+
+	for (vector<loopStruct>::reverse_iterator it = loops.rbegin(); it != loops.rend(); ++it)
+	{
+		BasicBlock * preheader = preheaderOf(*it, tree);
+
+		if (preheader != nullptr)
+		{
+			hoistInvariants(*it, preheader, tree);
+		}
+	}
+}
+
+// Give every loop a preheader
+void LoopInvariantCodeMotion::insertPreheaders()
+{
+	DominatorTree tree(cfg->getFunctionBlocks(ssa->getFunctionName()));
+	LoopNest nest(tree);
+
+	for (loopStruct& loop : nest.getLoops())
+	{
+		insertPreheader(loop, tree);
+	}
+}
+
+// Give a loop a preheader (the entering edges jump to it)
+void LoopInvariantCodeMotion::insertPreheader(loopStruct& loop, DominatorTree& tree)
+{
+	BasicBlock * header = loop.header;
+	vector<BasicBlock*> entering;
+
+	for (BasicBlock * predecessor : tree.getPredecessors(header))
+	{
+		if (tree.isReachable(predecessor) && loop.blocks.count(predecessor) == 0)
+		{
+			entering.push_back(predecessor);
+		}
+	}
+
+	// The block before the loop already is its preheader
+	if (entering.empty() || (entering.size() == 1 && tree.getSuccessors(entering.front()).size() == 1))
+	{
+		return;
+	}
+
+	IRInstr * terminator = entering.front()->getInstructionList().back();
+	BasicBlock * preheader = cfg->createBBAfter(entering.front());
+	IRInstr * jump = new IRInstr(preheader, IRInstr::absolute_jump, {header->getLabel()}, ssa->getSymbolTable());
+	jump->setLine(terminator->getLine());
+	list<IRInstr*> preheaderInstructions = {jump};
+
+	unordered_set<string> enteringLabels;
+
+	for (BasicBlock * predecessor : entering)
+	{
+		enteringLabels.insert(predecessor->getLabel());
+		IRInstr * exit = predecessor->getInstructionList().back();
+		vector<string> parameters = exit->getParameters();
+
+		for (size_t i = 0; i < parameters.size(); i++)
+		{
+			if (parameters[i] == header->getLabel())
+			{
+				exit->setParameter(i, preheader->getLabel());
+			}
+		}
+	}
+
+	// The phis of the header choose among the entering edges in the preheader
+	for (IRInstr * instr : header->getInstructionList())
+	{
+		if (instr->getOp() != IRInstr::phi)
+		{
+			continue;
+		}
+
+		vector<string> parameters = instr->getParameters();
+		vector<string> entries;
+		vector<string> kept = {parameters[0]};
+
+		for (size_t i = 1; i + 1 < parameters.size(); i += 2)
+		{
+			vector<string>& destination = enteringLabels.count(parameters[i + 1]) > 0 ? entries : kept;
+			destination.push_back(parameters[i]);
+			destination.push_back(parameters[i + 1]);
+		}
+
+		if (entries.empty())
+		{
+			continue;
+		}
+
+		string value = entries[0];
+
+		for (size_t i = 2; i < entries.size(); i += 2)
+		{
+			if (entries[i] != value)
+			{
+				value = ssa->createVariable(Liveness::variableOf(instr, 0)->variableType, instr->getLine());
+				entries.insert(entries.begin(), value);
+
+				IRInstr * preheaderPhi = new IRInstr(preheader, IRInstr::phi, entries, ssa->getSymbolTable());
+				preheaderPhi->setLine(instr->getLine());
+				preheaderInstructions.push_front(preheaderPhi);
+				break;
+			}
+		}
+
+		kept.push_back(value);
+		kept.push_back(preheader->getLabel());
+		instr->setOperation(IRInstr::phi, kept);
+	}
+
+	preheader->setInstructionList(preheaderInstructions);
+}
+
+// Preheader of a loop (nullptr if it has none)
+BasicBlock* LoopInvariantCodeMotion::preheaderOf(loopStruct& loop, DominatorTree& tree)
+{
+	BasicBlock * preheader = nullptr;
+
+	for (BasicBlock * predecessor : tree.getPredecessors(loop.header))
+	{
+		if (!tree.isReachable(predecessor) || loop.blocks.count(predecessor) > 0)
+		{
+			continue;
+		}
+
+		if (preheader != nullptr || tree.getSuccessors(predecessor).size() != 1)
+		{
+			return nullptr;
+		}
+
+		preheader = predecessor;
+	}
+
+	return preheader;
+}
+
+// Move the invariant operations of a loop to its preheader
+void LoopInvariantCodeMotion::hoistInvariants(loopStruct& loop, BasicBlock * preheader, DominatorTree& tree)
+{
+	// A value live across a call takes a callee-saved register, or memory
+	bool hasCalls = false;
+
+	for (BasicBlock * bb : loop.blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			hasCalls = hasCalls || instr->getOp() == IRInstr::call;
+		}
+	}
+
+	bool changed = true;
+
+	while (changed)
+	{
+		changed = false;
+
+		for (BasicBlock * bb : tree.getReversePostOrder())
+		{
+			if (loop.blocks.count(bb) == 0)
+			{
+				continue;
+			}
+
+			list<IRInstr*> instructions = bb->getInstructionList();
+
+			// The header runs at the first iteration, until a call with an effect
+			bool isFirst = bb == loop.header;
+			vector<IRInstr*> parameters;
+
+			for (IRInstr * instr : instructions)
+			{
+				if (instr->getOp() == IRInstr::wparam)
+				{
+					parameters.push_back(instr);
+					continue;
+				}
+
+				// The wparams of a call are just before it
+				int nbParameters = instr->getOp() == IRInstr::call ? stoi(instr->getParameters().at(2)) : 0;
+				bool hasParameters = (int) parameters.size() == nbParameters;
+				bool isMoved = hasParameters && isHoistable(instr, isFirst, hasCalls) && isInvariant(instr, loop);
+
+				for (IRInstr * parameter : parameters)
+				{
+					isMoved = isMoved && isInvariant(parameter, loop);
+				}
+
+				if (isMoved)
+				{
+					for (IRInstr * parameter : parameters)
+					{
+						moveToPreheader(parameter, loop, preheader);
+					}
+
+					moveToPreheader(instr, loop, preheader);
+					changed = true;
+				}
+				else if (instr->getOp() == IRInstr::call && pureFunctions.count(instr->getParameters().at(0)) == 0)
+				{
+					isFirst = false;
+				}
+
+				parameters.clear();
+			}
+		}
+	}
+}
+
+// Whether every variable read by an instruction is written outside a loop (or is a constant)
+bool LoopInvariantCodeMotion::isInvariant(IRInstr * instr, loopStruct& loop)
+{
+	vector<string> parameters = instr->getParameters();
+
+	for (int index : instr->getSourceIndexes())
+	{
+		string operand = parameters.at(index);
+		unordered_map<string, BasicBlock*>::iterator definition = definitions.find(operand);
+		bool isInside = definition != definitions.end() && loop.blocks.count(definition->second) > 0;
+
+		if (isInside && constants.count(operand) == 0 && !IRInstr::isImmediate(operand))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Move an instruction to the end of the preheader, before its jump
+void LoopInvariantCodeMotion::moveToPreheader(IRInstr * instr, loopStruct& loop, BasicBlock * preheader)
+{
+	// The constants it reads in the loop move with it (one written before the loop may be read on paths not crossing the preheader)
+	vector<string> parameters = instr->getParameters();
+
+	for (int index : instr->getSourceIndexes())
+	{
+		unordered_map<string, IRInstr*>::iterator constant = constants.find(parameters.at(index));
+
+		if (constant != constants.end() && loop.blocks.count(definitions[constant->first]) > 0)
+		{
+			moveToPreheader(constant->second, loop, preheader);
+		}
+	}
+
+	BasicBlock * bb = instr->getBasicBlock();
+	list<IRInstr*> instructions = bb->getInstructionList();
+	instructions.erase(find(instructions.begin(), instructions.end(), instr));
+	bb->setInstructionList(instructions);
+
+	list<IRInstr*> preheaderInstructions = preheader->getInstructionList();
+	preheaderInstructions.insert(prev(preheaderInstructions.end()), instr);
+	preheader->setInstructionList(preheaderInstructions);
+
+	instr->setBasicBlock(preheader);
+
+	string destination = instr->getDestination();
+
+	if (!destination.empty())
+	{
+		definitions[destination] = preheader;
+	}
+}
+
+// Whether an instruction can run before the loop (isFirst: it runs at the first iteration anyway, hasCalls: the loop calls a function)
+bool LoopInvariantCodeMotion::isHoistable(IRInstr * instr, bool isFirst, bool hasCalls)
+{
+	switch (instr->getOp())
+	{
+		// A comparison only tested by a jump is fused into it (see BranchFusion), and costs nothing more
+		case IRInstr::cmp_eq:
+		case IRInstr::cmp_neq:
+		case IRInstr::cmp_lt:
+		case IRInstr::cmp_gt:
+		case IRInstr::cmp_eqlt:
+		case IRInstr::cmp_eqgt:
+			return !hasCalls && (nbUses[instr->getDestination()] != 1 || jumpTests.count(instr->getDestination()) == 0);
+
+		// An operation of one instruction costs less than a register kept across the calls
+		case IRInstr::op_or:
+		case IRInstr::op_xor:
+		case IRInstr::op_and:
+		case IRInstr::op_add:
+		case IRInstr::op_sub:
+		case IRInstr::op_not:
+		case IRInstr::op_minus:
+			return !hasCalls;
+
+		case IRInstr::op_mul:
+			return true;
+
+		// A division traps on a zero divisor, and on INT_MIN / -1
+		case IRInstr::op_div:
+		case IRInstr::op_mod:
+		{
+			unordered_map<string, IRInstr*>::iterator divisor = constants.find(instr->getParameters().at(1));
+			int result;
+
+			if (isFirst || divisor == constants.end())
+			{
+				return isFirst;
+			}
+
+			Type type = Liveness::variableOf(divisor->second, 2)->variableType;
+			return IRInstr::evaluate(instr->getOp(), TYPE_INT, INT_MIN, type, stoi(divisor->second->getParameters().at(1)), result);
+		}
+
+		// A pure function may divide
+		case IRInstr::call:
+			return isFirst && pureFunctions.count(instr->getParameters().at(0)) > 0;
+
+		default:
+			return false;
+	}
+}
@@ -0,0 +1,101 @@
+/*************************************************************************
+                          PLD Compilateur: LoopInvariantCodeMotion
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <LoopInvariantCodeMotion> (file LoopInvariantCodeMotion.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "CFG.h"
+#include "SSA.h"
+#include "DominatorTree.h"
+#include "LoopNest.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <LoopInvariantCodeMotion> :
+//
+// The LoopInvariantCodeMotion moves out of the loops of a function in
+// SSA form the operations computing the same value at every iteration
+// (n * 2 in while (i < n * 2)): their operands are written outside the
+// loop, or by operations moved out already. Every loop first gets a
+// preheader, the only block jumping to its header from outside the loop:
+// the block before the loop if it only jumps to the header, else a new
+// block (a phi of the header choosing among several entering edges then
+// moves to it). The operations are then moved to the end of the
+// preheader, from the innermost loops (an operation of an inner loop can
+// then leave the outer one too), and run once per entry in the loop.
+// A constant written in the loop moves with the operations reading it
+// (alone, it would only hold a register during the whole loop); one
+// written before the loop stays, other paths may read it.
+// The arithmetic, bitwise, unary and comparison operations have no
+// effect (but a comparison only tested by a jump stays, to be fused into
+// it). A division or a modulo traps on a zero divisor (or INT_MIN /
+// -1), and a call to a pure function (see DeadCodeElimination) may
+// divide: they only move when they ran anyway at the first iteration
+// (in the header, after no call with an effect), or for a division when
+// its divisor is a constant it cannot trap on. A call moves with the
+// wparams before it. A move (copy, aff) stays: the SSA destruction
+// merges its variables, which would no longer be possible.
+// A value computed before the loop is live during the whole loop: in a
+// loop calling a function, it takes a callee-saved register (or memory)
+// from the variables of the loop, so only the operations costing more
+// than one instruction move (multiplication, division, call).
+// Every block must end with its terminator (see Optimizer).
+// It only runs with -O2: the values it keeps live during the loops add
+// more loads and stores than they save on the codegen bench.
+//
+//------------------------------------------------------------------------
+
+class LoopInvariantCodeMotion
+{
+	public:
+
+		// Constructor
+		LoopInvariantCodeMotion(CFG * cfg, SSA * ssa, set<string>& pureFunctions);
+
+		// Move the invariant operations of the loops to their preheaders
+		void run();
+
+	protected:
+
+		// Give every loop a preheader
+		void insertPreheaders();
+
+		// Give a loop a preheader (the entering edges jump to it)
+		void insertPreheader(loopStruct& loop, DominatorTree& tree);
+
+		// Preheader of a loop (nullptr if it has none)
+		static BasicBlock* preheaderOf(loopStruct& loop, DominatorTree& tree);
+
+		// Move the invariant operations of a loop to its preheader
+		void hoistInvariants(loopStruct& loop, BasicBlock * preheader, DominatorTree& tree);
+
+		// Whether every variable read by an instruction is written outside a loop (or is a constant)
+		bool isInvariant(IRInstr * instr, loopStruct& loop);
+
+		// Move an instruction to the end of the preheader, before its jump
+		void moveToPreheader(IRInstr * instr, loopStruct& loop, BasicBlock * preheader);
+
+		// Whether an instruction can run before the loop (isFirst: it runs at the first iteration anyway, hasCalls: the loop calls a function)
+		bool isHoistable(IRInstr * instr, bool isFirst, bool hasCalls);
+
+		CFG * cfg;												// CFG holding the function
+		SSA * ssa;												// SSA form of the function
+		set<string>& pureFunctions;								// Functions without effect
+		unordered_map<string, BasicBlock*> definitions;			// Block writing every variable
+		unordered_map<string, IRInstr*> constants;				// Constant load writing every constant variable
+		unordered_map<string, int> nbUses;						// Number of instructions reading every variable
+		unordered_set<string> jumpTests;						// Variables tested by a conditional jump
+};
@@ -0,0 +1,101 @@
+/*************************************************************************
+                          PLD Compilateur: LoopNest
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <LoopNest> (file LoopNest.cpp) -----/
+
+#include "LoopNest.h"
+#include <algorithm>
+
+using namespace std;
+
+// Constructor: find the loops of the function analysed by the tree
+LoopNest::LoopNest(DominatorTree& tree)
+{
+	unordered_map<BasicBlock*, int> loopOfHeader;
+
+	// A back edge jumps to a block dominating its origin: the loop is the blocks reaching the origin without the header
+	for (BasicBlock * bb : tree.getReversePostOrder())
+	{
+		for (BasicBlock * header : tree.getSuccessors(bb))
+		{
+			if (!tree.dominates(header, bb))
+			{
+				continue;
+			}
+
+			if (loopOfHeader.count(header) == 0)
+			{
+				loopOfHeader[header] = loops.size();
+				loops.push_back({header, {header}, -1, {}, 0});
+			}
+
+			unordered_set<BasicBlock*>& blocks = loops[loopOfHeader[header]].blocks;
+			vector<BasicBlock*> pending;
+
+			if (blocks.insert(bb).second)
+			{
+				pending.push_back(bb);
+			}
+
+			while (!pending.empty())
+			{
+				BasicBlock * block = pending.back();
+				pending.pop_back();
+
+				for (BasicBlock * predecessor : tree.getPredecessors(block))
+				{
+					if (tree.isReachable(predecessor) && blocks.insert(predecessor).second)
+					{
+						pending.push_back(predecessor);
+					}
+				}
+			}
+		}
+	}
+
+	// An outer loop is larger than its inner loops (the loops of the same size are disjoint, they keep their order)
+	stable_sort(loops.begin(), loops.end(), [](const loopStruct& a, const loopStruct& b) { return a.blocks.size() > b.blocks.size(); });
+
+	for (size_t i = 0; i < loops.size(); i++)
+	{
+		loopStruct& loop = loops[i];
+
+		for (int j = i - 1; j >= 0 && loop.parent < 0; j--)
+		{
+			if (loops[j].blocks.count(loop.header) > 0)
+			{
+				loop.parent = j;
+			}
+		}
+
+		loop.depth = loop.parent < 0 ? 1 : loops[loop.parent].depth + 1;
+
+		if (loop.parent >= 0)
+		{
+			loops[loop.parent].children.push_back(i);
+		}
+
+		for (BasicBlock * bb : loop.blocks)
+		{
+			innermostLoops[bb] = i;
+		}
+	}
+}
+
+// Loops of the function (an outer loop before its inner loops)
+vector<loopStruct>& LoopNest::getLoops()
+{
+	return loops;
+}
+
+// Number of loops containing a block
+int LoopNest::getLoopDepth(BasicBlock * bb)
+{
+	unordered_map<BasicBlock*, int>::iterator it = innermostLoops.find(bb);
+	return it == innermostLoops.end() ? 0 : loops[it->second].depth;
+}
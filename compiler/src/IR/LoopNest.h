@@ -0,0 +1,66 @@
+/*************************************************************************
+                          PLD Compilateur: LoopNest
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <LoopNest> (file LoopNest.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "BasicBlock.h"
+#include "DominatorTree.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Structure to represent a natural loop of a function, in the tree of the nested loops
+struct loopStruct
+{
+	BasicBlock * header;					// Block every edge entering the loop jumps to (the test of a while)
+	unordered_set<BasicBlock*> blocks;		// Blocks of the loop (its header and its inner loops included)
+	int parent;								// Index of the innermost loop containing it (-1 if none)
+	vector<int> children;					// Indexes of the loops immediately inside it
+	int depth;								// Number of loops containing it, itself included
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <LoopNest> :
+//
+// The LoopNest finds the natural loops of a function: a back edge jumps
+// to a block dominating its origin (the jump of a while body back to its
+// test), and its loop is the header and the blocks reaching the origin
+// without going through the header. The back edges to the same header
+// make one loop (both branches of an if ending a body jump back). Two
+// natural loops are either disjoint or nested (the language has no goto,
+// so every loop is reducible): the loops are ordered from the largest,
+// and the parent of a loop is the smallest loop before it containing its
+// header. An outer loop thus always comes before its inner loops.
+//
+//------------------------------------------------------------------------
+
+class LoopNest
+{
+	public:
+
+		// Constructor: find the loops of the function analysed by the tree
+		LoopNest(DominatorTree& tree);
+
+		// Loops of the function (an outer loop before its inner loops)
+		vector<loopStruct>& getLoops();
+
+		// Number of loops containing a block
+		int getLoopDepth(BasicBlock * bb);
+
+	protected:
+
+		vector<loopStruct> loops;								// Loops of the function
+		unordered_map<BasicBlock*, int> innermostLoops;			// Index of the innermost loop containing every block in a loop
+};
@@ -0,0 +1,148 @@
+/*************************************************************************
+                          PLD Compilateur: Optimizer
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <Optimizer> (file Optimizer.cpp) -----/
+
+#include "Optimizer.h"
+#include "DominatorTree.h"
+#include "SCCP.h"
+#include "CopyPropagation.h"
+#include "GlobalValueNumbering.h"
+#include "LoopInvariantCodeMotion.h"
+#include "DeadCodeElimination.h"
+#include "ImmediateOperands.h"
+#include "BranchFusion.h"
+#include "BlockLayout.h"
+#include "CFGSimplification.h"
+
+using namespace std;
+
+// Constructor
+Optimizer::Optimizer(CFG * cfg) : cfg(cfg)
+{
+}
+
+// Optimize every function of the CFG
+void Optimizer::optimize()
+{
+	prepare();
+
+	for (string functionName : functionNames())
+	{
+		optimizeFunction(functionName);
+	}
+}
+
+// Clean every function of the CFG and find the pure functions (before optimizeFunction)
+void Optimizer::prepare()
+{
+	for (string functionName : functionNames())
+	{
+		prepareFunction(functionName);
+		CFGSimplification(cfg, functionName).run();
+	}
+
+	// The calls to the pure functions can be removed from every function
+	pureFunctions = DeadCodeElimination::findPureFunctions(cfg);
+}
+
+// Optimize one function of the CFG (once prepared)
+void Optimizer::optimizeFunction(string functionName)
+{
+	SSA * ssa = new SSA(cfg, functionName);
+	functions.emplace_back(ssa);
+
+	ssa->construct();
+
+	SCCP(cfg, ssa).run();
+	CopyPropagation(cfg, ssa).run();
+	GlobalValueNumbering(cfg, ssa).run();
+
+	if (loopInvariantCodeMotion)
+	{
+		LoopInvariantCodeMotion(cfg, ssa, pureFunctions).run();
+	}
+
+	DeadCodeElimination(cfg, ssa, pureFunctions).run();
+	ImmediateOperands(cfg, ssa).run();
+	BranchFusion(cfg, ssa).run();
+
+	ssa->destruct();
+	CFGSimplification(cfg, functionName).run();
+	BlockLayout(cfg, functionName).run();
+}
+
+// Setter for the motion of the loop invariants out of the loops
+void Optimizer::setLoopInvariantCodeMotion(bool enabled)
+{
+	this->loopInvariantCodeMotion = enabled;
+}
+
+// Give every block of a function a single jump or return at its end, and remove the unreachable blocks
+void Optimizer::prepareFunction(string functionName)
+{
+	vector<BasicBlock*> blocks = cfg->getFunctionBlocks(functionName);
+	SymbolTable * frame = blocks.front()->getInstructionList().front()->getSymbolTable();
+
+	for (size_t i = 0; i < blocks.size(); i++)
+	{
+		BasicBlock * bb = blocks[i];
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		// Nothing runs after the first jump or return
+		list<IRInstr*>::iterator terminator = find_if(instructions.begin(), instructions.end(), [](IRInstr * instr) { return instr->isTerminator(); });
+
+		if (terminator != instructions.end())
+		{
+			for (list<IRInstr*>::iterator it = next(terminator); it != instructions.end(); ++it)
+			{
+				delete *it;
+			}
+
+			instructions.erase(next(terminator), instructions.end());
+		}
+		else if (i + 1 < blocks.size())
+		{
+			// A block falling through to the next one jumps to it
+			IRInstr * jump = new IRInstr(bb, IRInstr::absolute_jump, {blocks[i + 1]->getLabel()}, frame);
+			jump->setLine(instructions.empty() ? 0 : instructions.back()->getLine());
+			instructions.push_back(jump);
+		}
+
+		bb->setInstructionList(instructions);
+	}
+
+	DominatorTree tree(blocks);
+	unordered_set<BasicBlock*> unreachable;
+
+	for (BasicBlock * bb : blocks)
+	{
+		if (!tree.isReachable(bb))
+		{
+			unreachable.insert(bb);
+		}
+	}
+
+	cfg->removeBBs(unreachable);
+}
+
+// Names of the functions of the CFG, in the order of the CFG
+vector<string> Optimizer::functionNames()
+{
+	vector<string> names;
+
+	for (BasicBlock * bb : cfg->getBasicBlocks())
+	{
+		if (names.empty() || names.back() != bb->getFunctionName())
+		{
+			names.push_back(bb->getFunctionName());
+		}
+	}
+
+	return names;
+}
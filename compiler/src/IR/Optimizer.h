@@ -0,0 +1,80 @@
+/*************************************************************************
+                          PLD Compilateur: Optimizer
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <Optimizer> (file Optimizer.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <string>
+#include <vector>
+#include <set>
+#include <memory>
+#include "CFG.h"
+#include "SSA.h"
+
+using namespace std;
+
+//------------------------------------------------------------------------
+//
+// Goal of class <Optimizer> :
+//
+// The Optimizer runs the optimizations of every function of the CFG
+// (ifcc -O1, the default; -O0 disables them). A function is first
+// cleaned: the code after the first jump or return of a block is
+// removed, every block ends with a jump or a return, and the blocks the
+// entry cannot reach are removed (in every function first, so that the
+// pure functions are known), then its trivial blocks are simplified away
+// (see CFGSimplification). The function is then put in SSA form for
+// the optimizations (SCCP, copy propagation, global value numbering,
+// the motion of the loop invariants to the loop preheaders with -O2,
+// then the removal of the dead code, the selection of the immediate operands,
+// and the fusion of the comparisons into the conditional jumps testing
+// them), and taken back out of it, which also gives its variables
+// registers and lays out its stack frame.
+// Its blocks are finally simplified again (the optimizations leave empty
+// blocks behind) and ordered so that the likely jumps fall through.
+// Once every function is cleaned (prepare), the functions can also be
+// optimized one at a time (optimizeFunction), in the order of the CFG,
+// e.g. right before the code of each one is generated.
+// The Optimizer owns the SSA form of every function (and so the symbol
+// tables of their variables): it must live until the code is generated.
+//
+//------------------------------------------------------------------------
+
+class Optimizer
+{
+	public:
+
+		// Constructor
+		Optimizer(CFG * cfg);
+
+		// Optimize every function of the CFG
+		void optimize();
+
+		// Clean every function of the CFG and find the pure functions (before optimizeFunction)
+		void prepare();
+
+		// Optimize one function of the CFG (once prepared)
+		void optimizeFunction(string functionName);
+
+		// Setter for the motion of the loop invariants out of the loops (off by default)
+		void setLoopInvariantCodeMotion(bool enabled);
+
+	protected:
+
+		// Give every block of a function a single jump or return at its end, and remove the unreachable blocks
+		void prepareFunction(string functionName);
+
+		// Names of the functions of the CFG, in the order of the CFG
+		vector<string> functionNames();
+
+		CFG * cfg;								// CFG being optimized
+		vector<unique_ptr<SSA>> functions;		// SSA form of every optimized function
+		set<string> pureFunctions;				// Functions whose calls can be removed from every function
+		bool loopInvariantCodeMotion = false;	// Whether the loop invariants move to the loop preheaders
+};
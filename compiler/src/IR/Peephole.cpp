@@ -0,0 +1,479 @@
+/*************************************************************************
+                          PLD Compilateur: Peephole
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <Peephole> (file Peephole.cpp) -----/
+
+#include "Peephole.h"
+#include <sstream>
+#include <unordered_map>
+#include <algorithm>
+
+using namespace std;
+
+// Rules, tried in this order at every position
+const peepholeRuleStruct Peephole::rules[] = {
+	{"reload",				Peephole::removeReload},
+	{"store-forward",		Peephole::forwardStore},
+	{"self-move",			Peephole::removeSelfMove},
+	{"jump-to-next",		Peephole::removeJumpToNext},
+	{"branch-over-jump",	Peephole::invertBranchOverJump},
+	{"setcc-compare",		Peephole::removeCompareOfCondition},
+	{"zero-xor",			Peephole::zeroWithXor}
+};
+
+const int Peephole::NB_RULES = sizeof(Peephole::rules) / sizeof(Peephole::rules[0]);
+
+// Condition codes of jcc and setcc, with their opposite
+static const unordered_map<string, string> oppositeConditions = {
+	{"e", "ne"}, {"ne", "e"}, {"z", "nz"}, {"nz", "z"}, {"l", "ge"}, {"ge", "l"}, {"g", "le"}, {"le", "g"},
+	{"a", "be"}, {"be", "a"}, {"b", "ae"}, {"ae", "b"}, {"s", "ns"}, {"ns", "s"}, {"o", "no"}, {"no", "o"},
+	{"p", "np"}, {"np", "p"}, {"c", "nc"}, {"nc", "c"}, {"nge", "nl"}, {"nl", "nge"}, {"ng", "nle"}, {"nle", "ng"},
+	{"na", "nbe"}, {"nbe", "na"}, {"nae", "nb"}, {"nb", "nae"}
+};
+
+// Remove the blanks at both ends of a text
+static string trim(string text)
+{
+	size_t first = text.find_first_not_of(" \t");
+	size_t last = text.find_last_not_of(" \t");
+
+	return first == string::npos ? "" : text.substr(first, last - first + 1);
+}
+
+// Whether a mnemonic moves a value without extending it
+static bool isMove(string mnemonic)
+{
+	return mnemonic == "movl" || mnemonic == "movb" || mnemonic == "movw" || mnemonic == "movq";
+}
+
+// Whether an operand is a slot of the frame (the only memory the generated code addresses)
+static bool isFrameSlot(string operand)
+{
+	return operand.size() > 6 && operand.compare(operand.size() - 6, 6, "(%rbp)") == 0;
+}
+
+// Constructor
+Peephole::Peephole()
+{
+}
+
+// Rewrite the assembly of a function
+string Peephole::optimize(string assembly)
+{
+	vector<machineInstrStruct> code = parse(assembly);
+	bool changed = true;
+
+	// A rewrite can make another rule match before it: the rules are tried again until nothing changes
+	while (changed)
+	{
+		changed = false;
+
+		for (size_t i = 0; i < code.size(); i++)
+		{
+			for (int k = 0; k < NB_RULES && i < code.size(); k++)
+			{
+				if (!code[i].mnemonic.empty() && rules[k].apply(code, i))
+				{
+					rewrites[rules[k].name]++;
+					changed = true;
+				}
+			}
+		}
+	}
+
+	return print(code);
+}
+
+// Write the number of rewrites of every rule
+void Peephole::printStatistics(ostream& o)
+{
+	for (int k = 0; k < NB_RULES; k++)
+	{
+		o << "peephole." << rules[k].name << " " << rewrites[rules[k].name] << endl;
+	}
+}
+
+// Parse assembly into a list of machine instructions
+vector<machineInstrStruct> Peephole::parse(string assembly)
+{
+	vector<machineInstrStruct> code;
+	istringstream lines(assembly);
+	string line;
+
+	while (getline(lines, line))
+	{
+		machineInstrStruct instr = {line, "", "", {}, ""};
+		string text = trim(line);
+
+		// A label ends with a colon, a directive starts with a dot (and a label may too)
+		if (!text.empty() && text.back() == ':' && text.find_first_of(" \t") == string::npos)
+		{
+			instr.label = text.substr(0, text.size() - 1);
+		}
+		else if (!text.empty() && text[0] != '.' && text[0] != '#')
+		{
+			size_t commentStart = text.find('#');
+
+			if (commentStart != string::npos)
+			{
+				instr.comment = trim(text.substr(commentStart + 1));
+				text = trim(text.substr(0, commentStart));
+			}
+
+			size_t mnemonicEnd = text.find_first_of(" \t");
+			instr.mnemonic = text.substr(0, mnemonicEnd);
+			string operands = mnemonicEnd == string::npos ? "" : text.substr(mnemonicEnd);
+
+			// The operands are separated by the commas outside the parentheses of a memory operand
+			int depth = 0;
+			string operand = "";
+
+			for (char c : operands)
+			{
+				depth += c == '(' ? 1 : c == ')' ? -1 : 0;
+
+				if (c == ',' && depth == 0)
+				{
+					instr.operands.push_back(trim(operand));
+					operand = "";
+				}
+				else
+				{
+					operand += c;
+				}
+			}
+
+			if (!trim(operand).empty())
+			{
+				instr.operands.push_back(trim(operand));
+			}
+		}
+
+		code.push_back(instr);
+	}
+
+	return code;
+}
+
+// Write a list of machine instructions back as assembly
+string Peephole::print(vector<machineInstrStruct>& code)
+{
+	ostringstream o;
+
+	for (machineInstrStruct& instr : code)
+	{
+		if (instr.isRemoved)
+		{
+			continue;
+		}
+
+		if (!instr.text.empty() || instr.mnemonic.empty())
+		{
+			o << instr.text << endl;
+			continue;
+		}
+
+		// A rewritten instruction is written like the emitter writes it
+		o << "\t" << instr.mnemonic;
+
+		for (size_t k = 0; k < instr.operands.size(); k++)
+		{
+			o << (k == 0 ? "\t " : ", ") << instr.operands[k];
+		}
+
+		if (!instr.comment.empty())
+		{
+			o << "\t\t# " << instr.comment;
+		}
+
+		o << endl;
+	}
+
+	return o.str();
+}
+
+// Position of the next instruction after position i, or of a label before it
+size_t Peephole::next(vector<machineInstrStruct>& code, size_t i)
+{
+	size_t j = i + 1;
+
+	while (j < code.size() && code[j].mnemonic.empty() && code[j].label.empty())
+	{
+		j++;
+	}
+
+	return j;
+}
+
+// Whether the labels between position i and the next instruction define a label
+bool Peephole::isLabelBeforeNextInstruction(vector<machineInstrStruct>& code, size_t i, string label)
+{
+	for (size_t j = i + 1; j < code.size() && code[j].mnemonic.empty(); j++)
+	{
+		if (code[j].label == label)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Whether the flags are written before being read, after position i
+bool Peephole::areFlagsDead(vector<machineInstrStruct>& code, size_t i)
+{
+	static const vector<string> writers = {"cmp", "test", "add", "sub", "and", "or", "xor", "neg", "imul", "idiv", "call", "ret"};
+	static const vector<string> neutrals = {"mov", "lea", "push", "pop", "leave", "cltd", "cltq", "not", "inc", "dec", "sal", "sar", "shl", "shr"};
+
+	auto startsWith = [](string text, const vector<string>& prefixes)
+	{
+		return any_of(prefixes.begin(), prefixes.end(), [&text](const string& prefix) { return text.compare(0, prefix.size(), prefix) == 0; });
+	};
+
+	for (size_t j = next(code, i); j < code.size(); j = next(code, j))
+	{
+		string mnemonic = code[j].mnemonic;
+
+		// Another block may read the flags: a label or a jump ends the search
+		if (mnemonic.empty() || mnemonic == "jmp" || !conditionOf(mnemonic, "j").empty())
+		{
+			return false;
+		}
+
+		if (startsWith(mnemonic, writers))
+		{
+			return true;
+		}
+
+		if (!startsWith(mnemonic, neutrals) || !conditionOf(mnemonic, "set").empty() || !conditionOf(mnemonic, "cmov").empty())
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+// Condition code of a conditional jump or a setcc
+string Peephole::conditionOf(string mnemonic, string prefix)
+{
+	if (mnemonic.compare(0, prefix.size(), prefix) != 0)
+	{
+		return "";
+	}
+
+	string condition = mnemonic.substr(prefix.size());
+	return oppositeConditions.count(condition) > 0 ? condition : "";
+}
+
+// Opposite of a condition code
+string Peephole::invertCondition(string condition)
+{
+	return oppositeConditions.at(condition);
+}
+
+// Whether an operand is a register
+bool Peephole::isRegister(string operand)
+{
+	return !operand.empty() && operand[0] == '%';
+}
+
+// Replace an instruction
+void Peephole::rewrite(machineInstrStruct& instr, string mnemonic, vector<string> operands)
+{
+	instr.mnemonic = mnemonic;
+	instr.operands = operands;
+	instr.text = "";
+}
+
+// Remove the instruction at position i
+void Peephole::remove(vector<machineInstrStruct>& code, size_t i)
+{
+	code[i].mnemonic = "";
+	code[i].operands.clear();
+	code[i].isRemoved = true;
+}
+
+// Rule: mov A, B then mov B, A
+bool Peephole::removeReload(vector<machineInstrStruct>& code, size_t i)
+{
+	machineInstrStruct& first = code[i];
+
+	if (!isMove(first.mnemonic) || first.operands.size() != 2)
+	{
+		return false;
+	}
+
+	// A register and a slot, or two registers
+	bool isSupported = (isRegister(first.operands[0]) || isFrameSlot(first.operands[0])) && (isRegister(first.operands[1]) || isFrameSlot(first.operands[1]));
+	size_t j = next(code, i);
+
+	if (!isSupported || j >= code.size() || code[j].mnemonic != first.mnemonic)
+	{
+		return false;
+	}
+
+	if (code[j].operands != vector<string>({first.operands[1], first.operands[0]}))
+	{
+		return false;
+	}
+
+	remove(code, j);
+	return true;
+}
+
+// Rule: mov %r, M then mov M, %s
+bool Peephole::forwardStore(vector<machineInstrStruct>& code, size_t i)
+{
+	machineInstrStruct& store = code[i];
+
+	if (!isMove(store.mnemonic) || store.operands.size() != 2 || !isRegister(store.operands[0]) || !isFrameSlot(store.operands[1]))
+	{
+		return false;
+	}
+
+	size_t j = next(code, i);
+
+	if (j >= code.size() || code[j].operands.size() != 2 || code[j].operands[0] != store.operands[1] || !isRegister(code[j].operands[1]))
+	{
+		return false;
+	}
+
+	// A load of the same size, or an extension of the byte just stored
+	machineInstrStruct& load = code[j];
+	bool isSameSize = load.mnemonic == store.mnemonic;
+	bool isExtension = store.mnemonic == "movb" && (load.mnemonic == "movzbl" || load.mnemonic == "movsbl");
+
+	if (!isSameSize && !isExtension)
+	{
+		return false;
+	}
+
+	rewrite(load, load.mnemonic, {store.operands[0], load.operands[1]});
+	return true;
+}
+
+// Rule: mov %r, %r
+bool Peephole::removeSelfMove(vector<machineInstrStruct>& code, size_t i)
+{
+	machineInstrStruct& instr = code[i];
+
+	if (!isMove(instr.mnemonic) || instr.operands.size() != 2 || !isRegister(instr.operands[0]) || instr.operands[0] != instr.operands[1])
+	{
+		return false;
+	}
+
+	remove(code, i);
+	return true;
+}
+
+// Rule: jmp L where L is the next label
+bool Peephole::removeJumpToNext(vector<machineInstrStruct>& code, size_t i)
+{
+	machineInstrStruct& jump = code[i];
+
+	if (jump.mnemonic != "jmp" || jump.operands.size() != 1 || !isLabelBeforeNextInstruction(code, i, jump.operands[0]))
+	{
+		return false;
+	}
+
+	remove(code, i);
+	return true;
+}
+
+// Rule: jcc L1; jmp L2; L1: becomes jncc L2
+bool Peephole::invertBranchOverJump(vector<machineInstrStruct>& code, size_t i)
+{
+	machineInstrStruct& branch = code[i];
+	string condition = conditionOf(branch.mnemonic, "j");
+
+	if (condition.empty() || branch.operands.size() != 1)
+	{
+		return false;
+	}
+
+	size_t j = next(code, i);
+
+	if (j >= code.size() || code[j].mnemonic != "jmp" || code[j].operands.size() != 1 || !isLabelBeforeNextInstruction(code, j, branch.operands[0]))
+	{
+		return false;
+	}
+
+	rewrite(branch, "j" + invertCondition(condition), code[j].operands);
+	remove(code, j);
+	return true;
+}
+
+// Rule: setcc %al; movzbl %al, %eax; [mov %eax, X]; cmpl $0, X; je/jne L
+bool Peephole::removeCompareOfCondition(vector<machineInstrStruct>& code, size_t i)
+{
+	string condition = conditionOf(code[i].mnemonic, "set");
+
+	if (condition.empty() || code[i].operands != vector<string>({"%al"}))
+	{
+		return false;
+	}
+
+	size_t extension = next(code, i);
+
+	if (extension >= code.size() || code[extension].mnemonic != "movzbl" || code[extension].operands != vector<string>({"%al", "%eax"}))
+	{
+		return false;
+	}
+
+	// The condition may be stored before being compared (the setcc, the extension and the store keep the flags)
+	size_t compare = next(code, extension);
+	string value = "%eax";
+
+	if (compare < code.size() && code[compare].mnemonic == "movl" && code[compare].operands.size() == 2 && code[compare].operands[0] == "%eax")
+	{
+		value = code[compare].operands[1];
+		compare = next(code, compare);
+	}
+
+	if (compare >= code.size() || code[compare].mnemonic != "cmpl" || code[compare].operands.size() != 2 || code[compare].operands[0] != "$0")
+	{
+		return false;
+	}
+
+	if (code[compare].operands[1] != value && code[compare].operands[1] != "%eax")
+	{
+		return false;
+	}
+
+	size_t branch = next(code, compare);
+
+	if (branch >= code.size() || (code[branch].mnemonic != "je" && code[branch].mnemonic != "jne"))
+	{
+		return false;
+	}
+
+	// je jumps when the condition is false, jne when it is true
+	rewrite(code[branch], "j" + (code[branch].mnemonic == "je" ? invertCondition(condition) : condition), code[branch].operands);
+	remove(code, compare);
+	return true;
+}
+
+// Rule: movl $0, %r becomes xorl %r, %r
+bool Peephole::zeroWithXor(vector<machineInstrStruct>& code, size_t i)
+{
+	machineInstrStruct& instr = code[i];
+
+	if (instr.mnemonic != "movl" || instr.operands.size() != 2 || instr.operands[0] != "$0" || !isRegister(instr.operands[1]))
+	{
+		return false;
+	}
+
+	if (!areFlagsDead(code, i))
+	{
+		return false;
+	}
+
+	rewrite(instr, "xorl", {instr.operands[1], instr.operands[1]});
+	return true;
+}
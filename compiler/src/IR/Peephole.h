@@ -0,0 +1,129 @@
+/*************************************************************************
+                          PLD Compilateur: Peephole
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <Peephole> (file Peephole.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Structure to represent a line of assembly: an instruction, a label, or a line kept as it is (directive, comment)
+struct machineInstrStruct
+{
+	string text;				// Line as emitted (empty once the instruction is rewritten)
+	string label;				// Label defined by the line (empty if none)
+	string mnemonic;			// Mnemonic of an instruction (empty for the other lines)
+	vector<string> operands;	// Operands of the instruction, in AT&T order
+	string comment;				// Comment of the instruction (without #)
+	bool isRemoved = false;		// Whether a rule removed the line (it is not written back)
+};
+
+// Structure to represent a rule: it rewrites the code at a position when its pattern matches there
+struct peepholeRuleStruct
+{
+	const char * name;												// Name of the rule (in the statistics)
+	bool (*apply)(vector<machineInstrStruct>& code, size_t i);		// Rewrite the code from position i, and tell whether it matched
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <Peephole> :
+//
+// The Peephole rewrites the assembly of a function before it is written:
+// the lines are parsed into a list of machine instructions, and every
+// rule of the table is tried at every position until no rule matches.
+// A rule only looks at a few neighbouring instructions, and a label ends
+// its window (another block may jump there). The rules remove a reload
+// of the value just stored, forward a store to the load reading it, drop
+// the moves of a register to itself, the jumps to the next label and the
+// comparisons of a condition that was just computed by a setcc (the
+// flags of its comparison are still there), invert a conditional jump
+// over an absolute jump, and zero a register with xorl when the flags
+// are not read before being written again.
+// The number of rewrites of every rule is counted (ifcc --stats).
+//
+//------------------------------------------------------------------------
+
+class Peephole
+{
+	public:
+
+		// Constructor
+		Peephole();
+
+		// Rewrite the assembly of a function
+		string optimize(string assembly);
+
+		// Write the number of rewrites of every rule
+		void printStatistics(ostream& o);
+
+		// Parse assembly into a list of machine instructions
+		static vector<machineInstrStruct> parse(string assembly);
+
+		// Write a list of machine instructions back as assembly
+		static string print(vector<machineInstrStruct>& code);
+
+	protected:
+
+		// Position of the next instruction after position i, or of a label before it (code.size() if none)
+		static size_t next(vector<machineInstrStruct>& code, size_t i);
+
+		// Whether the labels between position i and the next instruction define a label
+		static bool isLabelBeforeNextInstruction(vector<machineInstrStruct>& code, size_t i, string label);
+
+		// Whether the flags are written before being read, after position i
+		static bool areFlagsDead(vector<machineInstrStruct>& code, size_t i);
+
+		// Condition code of a conditional jump or a setcc (empty if not one)
+		static string conditionOf(string mnemonic, string prefix);
+
+		// Opposite of a condition code
+		static string invertCondition(string condition);
+
+		// Whether an operand is a register
+		static bool isRegister(string operand);
+
+		// Replace an instruction
+		static void rewrite(machineInstrStruct& instr, string mnemonic, vector<string> operands);
+
+		// Remove the instruction at position i: it is only marked, erasing it would move all the code after it
+		static void remove(vector<machineInstrStruct>& code, size_t i);
+
+		// Rule: mov A, B then mov B, A (the second move changes nothing)
+		static bool removeReload(vector<machineInstrStruct>& code, size_t i);
+
+		// Rule: mov %r, M then mov M, %s (the load reads the register instead)
+		static bool forwardStore(vector<machineInstrStruct>& code, size_t i);
+
+		// Rule: mov %r, %r
+		static bool removeSelfMove(vector<machineInstrStruct>& code, size_t i);
+
+		// Rule: jmp L where L is the next label
+		static bool removeJumpToNext(vector<machineInstrStruct>& code, size_t i);
+
+		// Rule: jcc L1; jmp L2; L1: becomes jncc L2
+		static bool invertBranchOverJump(vector<machineInstrStruct>& code, size_t i);
+
+		// Rule: setcc %al; movzbl %al, %eax; [mov %eax, X]; cmpl $0, X; je/jne L jumps on the flags of the setcc
+		static bool removeCompareOfCondition(vector<machineInstrStruct>& code, size_t i);
+
+		// Rule: movl $0, %r becomes xorl %r, %r when the flags are dead
+		static bool zeroWithXor(vector<machineInstrStruct>& code, size_t i);
+
+		map<string, int> rewrites;		// Number of rewrites of every rule
+
+		static const peepholeRuleStruct rules[];		// Rules, tried in this order
+		static const int NB_RULES;						// Number of rules
+};
@@ -0,0 +1,319 @@
+/*************************************************************************
+                          PLD Compilateur: RegisterAllocator
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <RegisterAllocator> (file RegisterAllocator.cpp) -----/
+
+#include "RegisterAllocator.h"
+#include "DominatorTree.h"
+#include "Liveness.h"
+#include <climits>
+
+using namespace std;
+
+// Constructor
+RegisterAllocator::RegisterAllocator(vector<BasicBlock*> blocks, SymbolTable * frame) : blocks(blocks), frame(frame)
+{
+}
+
+// Give registers to the variables of the function, and lay out its stack frame
+void RegisterAllocator::allocate()
+{
+	buildIntervals();
+	linearScan();
+	layoutFrame();
+}
+
+// Compute the live interval of every variable, and the registers it cannot use
+void RegisterAllocator::buildIntervals()
+{
+	DominatorTree tree(blocks);
+	Liveness liveness(blocks, tree);
+	int nbVariables = liveness.getNbVariables();
+
+	for (int i = 0; i < nbVariables; i++)
+	{
+		intervalStruct interval = {liveness.getVariable(i), INT_MAX, -1, {}, -1};
+		intervals.push_back(interval);
+	}
+
+	auto extend = [&](int index, int position)
+	{
+		intervals[index].start = min(intervals[index].start, position);
+		intervals[index].end = max(intervals[index].end, position);
+	};
+
+	// The intervals cover the reads, the writes, and the blocks the variables are live through
+	vector<clobberStruct> clobbers;
+	int position = 0;
+
+	for (BasicBlock * bb : blocks)
+	{
+		int blockStart = position;
+		vector<size_t> pendingParameters;
+
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			for (int index : instr->getSourceIndexes())
+			{
+				varStruct * variable = Liveness::variableOf(instr, index);
+
+				if (variable != nullptr)
+				{
+					extend(liveness.getIndex(variable), position);
+				}
+			}
+
+			int destinationIndex = instr->getDestinationIndex();
+			varStruct * destination = destinationIndex >= 0 ? Liveness::variableOf(instr, destinationIndex) : nullptr;
+
+			if (destination != nullptr)
+			{
+				extend(liveness.getIndex(destination), position + 1);
+			}
+
+			vector<int> registers = clobberedRegisters(instr);
+
+			if (instr->getOp() == IRInstr::call)
+			{
+				// The parameter registers hold the arguments until the call
+				for (size_t pending : pendingParameters)
+				{
+					clobbers[pending].to = position;
+				}
+
+				pendingParameters.clear();
+				clobbers.push_back({position, position, registers});
+			}
+			else if (instr->getOp() == IRInstr::wparam && !registers.empty())
+			{
+				pendingParameters.push_back(clobbers.size());
+				clobbers.push_back({position, position, registers});
+			}
+			else if (instr->getOp() == IRInstr::rparam && !registers.empty())
+			{
+				// The parameter register holds the parameter from the entry of the function until it is read
+				clobbers.push_back({-1, position - 1, registers});
+			}
+
+			position += 2;
+		}
+
+		int blockEnd = max(position - 1, blockStart);
+
+		for (int i = 0; i < nbVariables; i++)
+		{
+			if (liveness.getLiveIn(bb)[i])
+			{
+				extend(i, blockStart);
+			}
+
+			if (liveness.getLiveOut(bb)[i])
+			{
+				extend(i, blockEnd);
+			}
+		}
+	}
+
+	// A variable live while a register must be kept cannot be in it
+	for (clobberStruct& clobber : clobbers)
+	{
+		for (intervalStruct& interval : intervals)
+		{
+			if (interval.start <= clobber.to && interval.end > clobber.from)
+			{
+				for (int reg : clobber.registers)
+				{
+					interval.forbidden[reg] = true;
+				}
+			}
+		}
+	}
+}
+
+// Give registers to the intervals, by start
+void RegisterAllocator::linearScan()
+{
+	vector<intervalStruct*> sorted;
+
+	for (intervalStruct& interval : intervals)
+	{
+		// A void value has no storage
+		if (targetType(interval.variable->variableType).size > 0)
+		{
+			sorted.push_back(&interval);
+		}
+	}
+
+	stable_sort(sorted.begin(), sorted.end(), [](intervalStruct * a, intervalStruct * b) { return a->start < b->start; });
+
+	vector<intervalStruct*> active;
+	intervalStruct * owners[TARGET_ALLOCATABLE_REGISTERS] = {};
+
+	for (intervalStruct * current : sorted)
+	{
+		// Free the registers of the intervals that ended
+		for (vector<intervalStruct*>::iterator it = active.begin(); it != active.end(); )
+		{
+			if ((*it)->end < current->start)
+			{
+				owners[(*it)->registerIndex] = nullptr;
+				it = active.erase(it);
+			}
+			else
+			{
+				++it;
+			}
+		}
+
+		// Take the first free register the interval can use
+		int chosen = -1;
+
+		for (int reg = 0; reg < TARGET_ALLOCATABLE_REGISTERS && chosen < 0; reg++)
+		{
+			if (owners[reg] == nullptr && !current->forbidden[reg])
+			{
+				chosen = reg;
+			}
+		}
+
+		// Otherwise spill the interval ending last (the current one, or one holding a register it can use)
+		if (chosen < 0)
+		{
+			intervalStruct * victim = nullptr;
+
+			for (intervalStruct * interval : active)
+			{
+				if (!current->forbidden[interval->registerIndex] && (victim == nullptr || interval->end > victim->end))
+				{
+					victim = interval;
+				}
+			}
+
+			if (victim == nullptr || victim->end <= current->end)
+			{
+				continue;
+			}
+
+			chosen = victim->registerIndex;
+			victim->registerIndex = -1;
+			active.erase(find(active.begin(), active.end(), victim));
+		}
+
+		current->registerIndex = chosen;
+		owners[chosen] = current;
+		active.push_back(current);
+	}
+}
+
+// Give stack slots to the spilled variables and to the callee-saved registers used
+void RegisterAllocator::layoutFrame()
+{
+	// Every spilled variable takes the first slot, aligned on its size, not overlapping the slot of an overlapping interval
+	vector<intervalStruct*> spilled;
+	vector<pair<int, int>> slots;
+	int stackSize = 0;
+
+	for (intervalStruct& interval : intervals)
+	{
+		int size = targetType(interval.variable->variableType).size;
+
+		if (interval.registerIndex >= 0 || size == 0)
+		{
+			continue;
+		}
+
+		int distance = 0;
+		bool isFree = false;
+
+		while (!isFree)
+		{
+			isFree = true;
+
+			for (size_t j = 0; j < spilled.size(); j++)
+			{
+				bool overlaps = distance < slots[j].first + slots[j].second && slots[j].first < distance + size;
+				bool isLive = interval.start <= spilled[j]->end && spilled[j]->start <= interval.end;
+
+				if (overlaps && isLive)
+				{
+					isFree = false;
+					distance += size;
+					break;
+				}
+			}
+		}
+
+		spilled.push_back(&interval);
+		slots.push_back({distance, size});
+		interval.variable->memoryOffset = -(distance + size);
+		interval.variable->registerIndex = -1;
+		stackSize = max(stackSize, distance + size);
+	}
+
+	// The save slots of the callee-saved registers used follow, aligned on 8 bytes
+	stackSize = (stackSize + 7) / 8 * 8;
+	vector<pair<int, int>> registerSlots;
+
+	for (int reg = 0; reg < TARGET_ALLOCATABLE_REGISTERS; reg++)
+	{
+		bool isUsed = any_of(intervals.begin(), intervals.end(), [reg](intervalStruct& interval) { return interval.registerIndex == reg; });
+
+		if (isUsed && targetRegisters[reg].calleeSaved)
+		{
+			registerSlots.push_back({reg, -(stackSize + 8 * ((int) registerSlots.size() + 1))});
+		}
+	}
+
+	for (intervalStruct& interval : intervals)
+	{
+		if (interval.registerIndex >= 0)
+		{
+			interval.variable->registerIndex = interval.registerIndex;
+		}
+	}
+
+	frame->setMemorySpace(stackSize + 8 * registerSlots.size());
+	frame->setRegisterSlots(registerSlots);
+}
+
+// Registers clobbered by an instruction (a call, or the register of the parameter of a wparam or an rparam)
+vector<int> RegisterAllocator::clobberedRegisters(IRInstr * instr)
+{
+	vector<int> registers;
+
+	for (int reg = 0; reg < TARGET_ALLOCATABLE_REGISTERS; reg++)
+	{
+		const targetRegisterStruct& target = targetRegisters[reg];
+		bool isClobbered = false;
+
+		switch (instr->getOp())
+		{
+			case IRInstr::call:
+				isClobbered = !target.calleeSaved;
+				break;
+
+			case IRInstr::wparam:
+				isClobbered = target.parameter >= 0 && target.parameter == stoi(instr->getParameters().at(1));
+				break;
+
+			case IRInstr::rparam:
+				isClobbered = target.parameter >= 0 && target.parameter == stoi(instr->getParameters().at(1));
+				break;
+
+			default:
+				break;
+		}
+
+		if (isClobbered)
+		{
+			registers.push_back(reg);
+		}
+	}
+
+	return registers;
+}
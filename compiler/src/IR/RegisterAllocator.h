@@ -0,0 +1,88 @@
+/*************************************************************************
+                          PLD Compilateur: RegisterAllocator
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <RegisterAllocator> (file RegisterAllocator.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include "CFG.h"
+#include "Target.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Structure to represent the live interval of a variable (positions: 2i reads instruction i, 2i+1 writes it)
+struct intervalStruct
+{
+	varStruct * variable;								// Variable of the interval
+	int start;											// First position where the variable is live
+	int end;											// Last position where the variable is live
+	bool forbidden[TARGET_ALLOCATABLE_REGISTERS];		// Registers clobbered while the variable is live
+	int registerIndex;									// Register given to the variable (-1 if spilled)
+};
+
+// Structure to represent the registers an instruction needs to keep from a position to another
+struct clobberStruct
+{
+	int from;					// Position after which the registers are needed
+	int to;						// Last position where the registers are needed
+	vector<int> registers;		// Registers needed
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <RegisterAllocator> :
+//
+// The RegisterAllocator gives registers to the variables of a function
+// out of SSA form, with a linear scan: the instructions are numbered in
+// the order of the code, every variable is live on one interval (from
+// the liveness of the blocks), and the intervals are visited by start,
+// taking a register freed by the intervals that ended. When no register
+// is free, the interval ending last is spilled: its variable stays in
+// memory.
+// A register clobbered while a variable is live cannot hold it: a call
+// clobbers the caller-saved registers, a wparam the register of its
+// parameter until the call, and the register of a parameter holds it
+// from the entry of the function until its rparam. The scratch registers
+// of the emitter (%eax, %ecx, %edx) are never given.
+// The spilled variables share stack slots when their intervals do not
+// overlap. Every callee-saved register used gets an 8-byte slot under
+// them, where the prologue saves it.
+//
+//------------------------------------------------------------------------
+
+class RegisterAllocator
+{
+	public:
+
+		// Constructor
+		RegisterAllocator(vector<BasicBlock*> blocks, SymbolTable * frame);
+
+		// Give registers to the variables of the function, and lay out its stack frame
+		void allocate();
+
+	protected:
+
+		// Compute the live interval of every variable, and the registers it cannot use
+		void buildIntervals();
+
+		// Give registers to the intervals, by start
+		void linearScan();
+
+		// Give stack slots to the spilled variables and to the callee-saved registers used
+		void layoutFrame();
+
+		// Registers clobbered by an instruction (a call, or the register of the parameter of a wparam or an rparam)
+		vector<int> clobberedRegisters(IRInstr * instr);
+
+		vector<BasicBlock*> blocks;				// Blocks of the function, in the order of the code
+		SymbolTable * frame;					// Symbol table of the variables of the function
+		vector<intervalStruct> intervals;		// Live interval of every variable
+};
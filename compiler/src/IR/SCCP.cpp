@@ -0,0 +1,379 @@
+/*************************************************************************
+                          PLD Compilateur: SCCP
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <SCCP> (file SCCP.cpp) -----/
+
+#include "SCCP.h"
+#include "Liveness.h"
+
+using namespace std;
+
+// Constructor
+SCCP::SCCP(CFG * cfg, SSA * ssa) : cfg(cfg), ssa(ssa), blocks(cfg->getFunctionBlocks(ssa->getFunctionName())), tree(blocks)
+{
+}
+
+// Propagate the constants of the function and remove the code that never runs
+void SCCP::run()
+{
+	// Only the variables written by an instruction can be constant (a variable read before any assignment varies)
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			instructionBlocks[instr] = bb;
+
+			// {destination, variable, label, variable, label...}
+			if (instr->getOp() == IRInstr::phi)
+			{
+				vector<string> parameters = instr->getParameters();
+				varStruct * destination = Liveness::variableOf(instr, 0);
+
+				for (size_t i = 1; i + 1 < parameters.size(); i += 2)
+				{
+					BasicBlock * predecessor = tree.getBlock(parameters[i + 1]);
+					varStruct * variable = Liveness::variableOf(instr, i);
+
+					if (predecessor == nullptr)
+					{
+						continue;
+					}
+
+					edgeOperands[{predecessor, bb}].push_back(phiOperands.size());
+
+					if (variable != nullptr)
+					{
+						phiUsers[variable].push_back(phiOperands.size());
+					}
+
+					phiOperands.push_back({destination, variable, {predecessor, bb}});
+				}
+			}
+			else
+			{
+				for (int index : instr->getSourceIndexes())
+				{
+					varStruct * variable = Liveness::variableOf(instr, index);
+
+					if (variable != nullptr)
+					{
+						users[variable].push_back(instr);
+					}
+				}
+			}
+
+			int destinationIndex = instr->getDestinationIndex();
+			varStruct * destination = destinationIndex >= 0 ? Liveness::variableOf(instr, destinationIndex) : nullptr;
+
+			if (destination != nullptr)
+			{
+				values[destination] = {LATTICE_UNKNOWN, 0};
+			}
+		}
+	}
+
+	propagate();
+	rewrite();
+}
+
+// Run the instructions of the blocks reached by the executable edges until nothing changes
+void SCCP::propagate()
+{
+	// The entry runs
+	edgeWorklist.push_back({nullptr, blocks.front()});
+
+	while (!edgeWorklist.empty() || !instructionWorklist.empty() || !phiOperandWorklist.empty())
+	{
+		if (!edgeWorklist.empty())
+		{
+			pair<BasicBlock*, BasicBlock*> edge = edgeWorklist.back();
+			edgeWorklist.pop_back();
+
+			if (!executableEdges.insert(edge).second)
+			{
+				continue;
+			}
+
+			// The phis see the operands of the new edge, and a block reached for the first time runs all its other instructions
+			map<pair<BasicBlock*, BasicBlock*>, vector<int>>::iterator operands = edgeOperands.find(edge);
+
+			if (operands != edgeOperands.end())
+			{
+				for (int operand : operands->second)
+				{
+					visitPhiOperand(phiOperands[operand]);
+				}
+			}
+
+			if (executableBlocks.insert(edge.second).second)
+			{
+				for (IRInstr * instr : edge.second->getInstructionList())
+				{
+					if (instr->getOp() != IRInstr::phi)
+					{
+						visitInstruction(instr);
+					}
+				}
+			}
+
+			continue;
+		}
+
+		if (!phiOperandWorklist.empty())
+		{
+			int operand = phiOperandWorklist.back();
+			phiOperandWorklist.pop_back();
+			visitPhiOperand(phiOperands[operand]);
+			continue;
+		}
+
+		IRInstr * instr = instructionWorklist.back();
+		instructionWorklist.pop_back();
+
+		if (executableBlocks.count(instructionBlocks[instr]) > 0)
+		{
+			visitInstruction(instr);
+		}
+	}
+}
+
+// Mark an edge as executable
+void SCCP::markEdge(BasicBlock * from, BasicBlock * to)
+{
+	if (to != nullptr && executableEdges.count({from, to}) == 0)
+	{
+		edgeWorklist.push_back({from, to});
+	}
+}
+
+// Compute the value written by an instruction, or the edges it makes executable
+void SCCP::visitInstruction(IRInstr * instr)
+{
+	BasicBlock * bb = instructionBlocks[instr];
+	vector<string> parameters = instr->getParameters();
+
+	switch (instr->getOp())
+	{
+		case IRInstr::absolute_jump:
+		{
+			markEdge(bb, tree.getBlock(parameters.at(0)));
+			return;
+		}
+
+		// {test, falseLabel, trueLabel}: a constant test only leads to one successor
+		case IRInstr::conditional_jump:
+		{
+			latticeStruct test = valueOf(instr, 0);
+
+			if (test.state == LATTICE_VARYING || (test.state == LATTICE_CONSTANT && test.value == 0))
+			{
+				markEdge(bb, tree.getBlock(parameters.at(1)));
+			}
+
+			if (test.state == LATTICE_VARYING || (test.state == LATTICE_CONSTANT && test.value != 0))
+			{
+				markEdge(bb, tree.getBlock(parameters.at(2)));
+			}
+
+			return;
+		}
+
+		default:
+			break;
+	}
+
+	int destinationIndex = instr->getDestinationIndex();
+	varStruct * destination = destinationIndex >= 0 ? Liveness::variableOf(instr, destinationIndex) : nullptr;
+
+	if (destination == nullptr)
+	{
+		return;
+	}
+
+	// A constant is stored in the type of its variable
+	if (instr->getOp() == IRInstr::ldconst)
+	{
+		setValue(destination, {LATTICE_CONSTANT, SymbolTable::getCast(destination->variableType, stoi(parameters.at(1)))});
+		return;
+	}
+
+	// An operation is constant when its operands are, and varies when one of them does
+	vector<int> sources = instr->getSourceIndexes();
+	vector<latticeStruct> operands;
+
+	for (int index : sources)
+	{
+		operands.push_back(valueOf(instr, index));
+	}
+
+	bool isVarying = sources.empty() || any_of(operands.begin(), operands.end(), [](latticeStruct& operand) { return operand.state == LATTICE_VARYING; });
+	bool isUnknown = any_of(operands.begin(), operands.end(), [](latticeStruct& operand) { return operand.state == LATTICE_UNKNOWN; });
+
+	if (isVarying)
+	{
+		setValue(destination, {LATTICE_VARYING, 0});
+		return;
+	}
+
+	if (isUnknown)
+	{
+		return;
+	}
+
+	Type leftType = Liveness::variableOf(instr, sources.at(0))->variableType;
+	Type rightType = sources.size() > 1 ? Liveness::variableOf(instr, sources.at(1))->variableType : TYPE_INT;
+	int right = sources.size() > 1 ? operands.at(1).value : 0;
+	int result;
+
+	// An operation that is not computed (a call) or that traps at runtime varies
+	if (!IRInstr::evaluate(instr->getOp(), leftType, operands.at(0).value, rightType, right, result))
+	{
+		setValue(destination, {LATTICE_VARYING, 0});
+		return;
+	}
+
+	setValue(destination, {LATTICE_CONSTANT, SymbolTable::getCast(destination->variableType, result)});
+}
+
+// Merge the value of an operand into its phi, if its edge runs
+void SCCP::visitPhiOperand(phiOperandStruct& operand)
+{
+	if (executableEdges.count(operand.edge) == 0)
+	{
+		return;
+	}
+
+	// Merging is lowering the value of the phi: it does not change with an unknown operand, and two different constants make it vary
+	unordered_map<varStruct*, latticeStruct>::iterator it = values.find(operand.variable);
+	setValue(operand.destination, it == values.end() ? latticeStruct({LATTICE_VARYING, 0}) : it->second);
+}
+
+// Lower the value of a variable, and revisit its users if it changed
+void SCCP::setValue(varStruct * variable, latticeStruct value)
+{
+	latticeStruct& current = values[variable];
+
+	if (value.state == LATTICE_UNKNOWN || current.state == LATTICE_VARYING)
+	{
+		return;
+	}
+
+	if (current.state == LATTICE_CONSTANT && value.state == LATTICE_CONSTANT && value.value == current.value)
+	{
+		return;
+	}
+
+	// Two different constants make a varying value
+	current = (current.state == LATTICE_CONSTANT && value.state == LATTICE_CONSTANT) ? latticeStruct({LATTICE_VARYING, 0}) : value;
+	instructionWorklist.insert(instructionWorklist.end(), users[variable].begin(), users[variable].end());
+	phiOperandWorklist.insert(phiOperandWorklist.end(), phiUsers[variable].begin(), phiUsers[variable].end());
+}
+
+// Value of the variable named by a parameter of an instruction
+latticeStruct SCCP::valueOf(IRInstr * instr, int index)
+{
+	varStruct * variable = Liveness::variableOf(instr, index);
+	unordered_map<varStruct*, latticeStruct>::iterator it = values.find(variable);
+
+	return it == values.end() ? latticeStruct({LATTICE_VARYING, 0}) : it->second;
+}
+
+// Replace the constants, the constant jumps, and remove the blocks that never run
+void SCCP::rewrite()
+{
+	for (BasicBlock * bb : blocks)
+	{
+		if (executableBlocks.count(bb) == 0)
+		{
+			continue;
+		}
+
+		list<IRInstr*> instructions = bb->getInstructionList();
+		list<IRInstr*> loads;
+
+		for (list<IRInstr*>::iterator it = instructions.begin(); it != instructions.end(); )
+		{
+			IRInstr * instr = *it;
+			vector<string> parameters = instr->getParameters();
+			int destinationIndex = instr->getDestinationIndex();
+			varStruct * destination = destinationIndex >= 0 ? Liveness::variableOf(instr, destinationIndex) : nullptr;
+			latticeStruct value = destination != nullptr ? values[destination] : latticeStruct({LATTICE_VARYING, 0});
+
+			// A constant variable is loaded with its value (after the phis, which run first)
+			if (value.state == LATTICE_CONSTANT && instr->getOp() != IRInstr::ldconst)
+			{
+				IRInstr * load = new IRInstr(bb, IRInstr::ldconst, {typeName(destination->variableType), to_string(value.value), destination->variableName}, instr->getSymbolTable());
+				load->setLine(instr->getLine());
+
+				if (instr->getOp() == IRInstr::phi)
+				{
+					loads.push_back(load);
+				}
+				else
+				{
+					instructions.insert(it, load);
+				}
+
+				delete instr;
+				it = instructions.erase(it);
+				continue;
+			}
+
+			// A phi forgets the edges that never run
+			if (instr->getOp() == IRInstr::phi)
+			{
+				vector<string> kept = {parameters[0]};
+
+				for (size_t i = 1; i + 1 < parameters.size(); i += 2)
+				{
+					if (executableEdges.count({tree.getBlock(parameters[i + 1]), bb}) > 0)
+					{
+						kept.push_back(parameters[i]);
+						kept.push_back(parameters[i + 1]);
+					}
+				}
+
+				instr->setOperation(IRInstr::phi, kept);
+			}
+
+			// A jump on a constant goes to its only successor
+			if (instr->getOp() == IRInstr::conditional_jump && valueOf(instr, 0).state == LATTICE_CONSTANT)
+			{
+				instr->setOperation(IRInstr::absolute_jump, {valueOf(instr, 0).value != 0 ? parameters.at(2) : parameters.at(1)});
+			}
+
+			// A returned constant becomes an immediate
+			if (instr->getOp() == IRInstr::ret && !instr->getSourceIndexes().empty() && valueOf(instr, 0).state == LATTICE_CONSTANT)
+			{
+				int returned;
+				IRInstr::evaluate(IRInstr::ret, Liveness::variableOf(instr, 0)->variableType, valueOf(instr, 0).value, TYPE_INT, 0, returned);
+				instr->setOperation(IRInstr::ret, {"$" + to_string(returned)});
+			}
+
+			++it;
+		}
+
+		// The loads replacing the phis follow the remaining phis
+		list<IRInstr*>::iterator firstInstruction = find_if(instructions.begin(), instructions.end(), [](IRInstr * instr) { return instr->getOp() != IRInstr::phi; });
+		instructions.splice(firstInstruction, loads);
+		bb->setInstructionList(instructions);
+	}
+
+	// The blocks that never run are removed
+	unordered_set<BasicBlock*> removed;
+
+	for (BasicBlock * bb : blocks)
+	{
+		if (executableBlocks.count(bb) == 0)
+		{
+			removed.insert(bb);
+		}
+	}
+
+	cfg->removeBBs(removed);
+}
@@ -0,0 +1,114 @@
+/*************************************************************************
+                          PLD Compilateur: SCCP
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <SCCP> (file SCCP.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include "CFG.h"
+#include "SSA.h"
+#include "DominatorTree.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// States of a variable during the propagation (a state only goes down)
+enum latticeState {LATTICE_UNKNOWN, LATTICE_CONSTANT, LATTICE_VARYING};
+
+// Structure to represent what is known of the value of a variable
+struct latticeStruct
+{
+	latticeState state;		// Whether the value is not computed yet, constant, or varying
+	int value;				// Value of a constant (as stored in the variable)
+};
+
+// Structure to represent an operand of a phi: the value of its variable flows into the phi once its edge runs
+struct phiOperandStruct
+{
+	varStruct * destination;					// Variable written by the phi
+	varStruct * variable;						// Variable read by the operand (nullptr if not a variable)
+	pair<BasicBlock*, BasicBlock*> edge;		// Edge the value comes through
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <SCCP> :
+//
+// The SCCP (sparse conditional constant propagation, Wegman and Zadeck)
+// finds the variables of a function in SSA form that always hold the
+// same constant, following only the edges of the CFG that can run: a
+// conditional jump on a constant only leads to one of its successors,
+// and a phi only merges the values coming from the edges that run.
+// A phi is not computed again from all its operands: the value of an
+// operand is merged into it when its edge starts to run and when the
+// value changes (the values only go down, so the merge is the same), so
+// that a block reached by thousands of edges stays linear.
+// The values are computed like the generated code (IRInstr::evaluate),
+// and an operation that traps at runtime (a division by zero) is varying.
+// Then every constant variable is loaded with its value, a conditional
+// jump on a constant becomes a jump, the returned constants become
+// immediates, and the blocks that never run are removed (a while(0) or
+// the dead branch of an if on a constant flag disappear).
+//
+//------------------------------------------------------------------------
+
+class SCCP
+{
+	public:
+
+		// Constructor
+		SCCP(CFG * cfg, SSA * ssa);
+
+		// Propagate the constants of the function and remove the code that never runs
+		void run();
+
+	protected:
+
+		// Run the instructions of the blocks reached by the executable edges until nothing changes
+		void propagate();
+
+		// Mark an edge as executable
+		void markEdge(BasicBlock * from, BasicBlock * to);
+
+		// Compute the value written by an instruction, or the edges it makes executable
+		void visitInstruction(IRInstr * instr);
+
+		// Merge the value of an operand into its phi, if its edge runs
+		void visitPhiOperand(phiOperandStruct& operand);
+
+		// Lower the value of a variable, and revisit its users if it changed
+		void setValue(varStruct * variable, latticeStruct value);
+
+		// Value of the variable named by a parameter of an instruction
+		latticeStruct valueOf(IRInstr * instr, int index);
+
+		// Replace the constants, the constant jumps, and remove the blocks that never run
+		void rewrite();
+
+		CFG * cfg;													// CFG holding the function
+		SSA * ssa;													// SSA form of the function
+		vector<BasicBlock*> blocks;									// Blocks of the function
+		DominatorTree tree;											// Successors and labels of the blocks
+		unordered_map<varStruct*, latticeStruct> values;			// Value of every variable written by an instruction
+		unordered_map<varStruct*, vector<IRInstr*>> users;			// Instructions reading every variable (but the phis)
+		vector<phiOperandStruct> phiOperands;						// Operands of the phis
+		unordered_map<varStruct*, vector<int>> phiUsers;			// Operands of the phis reading every variable
+		map<pair<BasicBlock*, BasicBlock*>, vector<int>> edgeOperands;	// Operands of the phis coming through every edge
+		unordered_map<IRInstr*, BasicBlock*> instructionBlocks;		// Block of every instruction
+		set<pair<BasicBlock*, BasicBlock*>> executableEdges;		// Edges that can run
+		unordered_set<BasicBlock*> executableBlocks;				// Blocks that can run
+		vector<pair<BasicBlock*, BasicBlock*>> edgeWorklist;		// Edges found executable, not visited yet
+		vector<IRInstr*> instructionWorklist;						// Instructions whose operands changed
+		vector<int> phiOperandWorklist;								// Operands of the phis whose value changed
+};
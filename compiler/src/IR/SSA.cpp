@@ -0,0 +1,896 @@
+/*************************************************************************
+                          PLD Compilateur: SSA
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <SSA> (file SSA.cpp) -----/
+
+#include "SSA.h"
+#include "RegisterAllocator.h"
+#include "Target.h"
+#include <set>
+#include <unordered_set>
+#include <map>
+
+using namespace std;
+
+// Constructor
+SSA::SSA(CFG * cfg, string functionName) : cfg(cfg), functionName(functionName)
+{
+}
+
+// Put the function in SSA form
+void SSA::construct()
+{
+	vector<BasicBlock*> blocks = cfg->getFunctionBlocks(functionName);
+	DominatorTree tree(blocks);
+
+	ssaSymbolTable.reset(new SymbolTable());
+
+	// A compound assignment reads and writes its variable: it becomes a binary operation
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			vector<string> parameters = instr->getParameters();
+
+			switch (instr->getOp())
+			{
+				case IRInstr::op_plus_equal:
+					instr->setOperation(IRInstr::op_add, {parameters[0], parameters[1], parameters[0]});
+					break;
+
+				case IRInstr::op_sub_equal:
+					instr->setOperation(IRInstr::op_sub, {parameters[0], parameters[1], parameters[0]});
+					break;
+
+				case IRInstr::op_mult_equal:
+					instr->setOperation(IRInstr::op_mul, {parameters[0], parameters[1], parameters[0]});
+					break;
+
+				case IRInstr::op_div_equal:
+					instr->setOperation(IRInstr::op_div, {parameters[0], parameters[1], parameters[0]});
+					break;
+
+				default:
+					break;
+			}
+		}
+	}
+
+	insertPhis(blocks, tree);
+	rename(blocks.front(), tree);
+	removeDeadPhis(blocks);
+}
+
+// Take the function out of SSA form and lay out its stack frame
+void SSA::destruct()
+{
+	unordered_map<string, string> classes = coalesceVersions();
+	insertCopies(classes);
+
+	layoutFrame();
+}
+
+// Create a new variable in SSA form, and give its name
+string SSA::createVariable(Type type, int line)
+{
+	ssaVariableStruct variable = {"!ssa" + to_string(++nbCreatedVariables), type, line, {}, {}, ""};
+	variables.push_back(variable);
+
+	string name = newVersion(variables.size() - 1);
+	variables.back().stack.clear();
+
+	return name;
+}
+
+// Symbol table of the variables of the function
+SymbolTable * SSA::getSymbolTable()
+{
+	return frameSymbolTable ? frameSymbolTable.get() : ssaSymbolTable.get();
+}
+
+// Name of the function
+string SSA::getFunctionName()
+{
+	return functionName;
+}
+
+// Give a number to the variable of an instruction of the source program
+int SSA::variableIndex(varStruct * variable)
+{
+	if (variable == nullptr)
+	{
+		return -1;
+	}
+
+	unordered_map<varStruct*, int>::iterator it = variableIndexes.find(variable);
+
+	if (it != variableIndexes.end())
+	{
+		return it->second;
+	}
+
+	// The versions are named after the variable (without the mark of the parameters), made unique in the function
+	string name = variable->variableName;
+	string parameterMark = "°";
+
+	if (name.compare(0, parameterMark.size(), parameterMark) == 0)
+	{
+		name = name.substr(parameterMark.size());
+	}
+
+	int nbHomonyms = ++nbBaseNames[name];
+	string baseName = nbHomonyms == 1 ? name : name + "#" + to_string(nbHomonyms);
+
+	ssaVariableStruct newVariable = {baseName, variable->variableType, variable->variableLine, {}, {}, ""};
+	variables.push_back(newVariable);
+	variableIndexes[variable] = variables.size() - 1;
+
+	return variables.size() - 1;
+}
+
+// Create the next version of a variable and make it current
+string SSA::newVersion(int variable)
+{
+	ssaVariableStruct& v = variables[variable];
+	string name = v.baseName + "." + to_string(v.versions.size() + 1);
+
+	ssaSymbolTable->addVariable(name, v.type, v.line);
+	versionVariables[name] = variable;
+	v.versions.push_back(name);
+	v.stack.push_back(name);
+
+	return name;
+}
+
+// Current version of a variable
+string SSA::currentVersion(int variable)
+{
+	ssaVariableStruct& v = variables[variable];
+
+	if (!v.stack.empty())
+	{
+		return v.stack.back();
+	}
+
+	// Read before any assignment: the version holds whatever the slot holds
+	if (v.undefinedVersion.empty())
+	{
+		v.undefinedVersion = v.baseName + ".0";
+		ssaSymbolTable->addVariable(v.undefinedVersion, v.type, v.line);
+		versionVariables[v.undefinedVersion] = variable;
+	}
+
+	return v.undefinedVersion;
+}
+
+// Insert the phis of the variables read in several blocks
+void SSA::insertPhis(vector<BasicBlock*>& blocks, DominatorTree& tree)
+{
+	// Blocks assigning every variable, and the variables read before being assigned in a block
+	unordered_map<int, vector<BasicBlock*>> definitionBlocks;
+	vector<bool> isGlobal;
+
+	for (BasicBlock * bb : blocks)
+	{
+		set<int> assigned;
+
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			for (int index : instr->getSourceIndexes())
+			{
+				int variable = variableIndex(Liveness::variableOf(instr, index));
+
+				if (variable >= 0 && assigned.count(variable) == 0)
+				{
+					isGlobal.resize(variables.size(), false);
+					isGlobal[variable] = true;
+				}
+			}
+
+			int destinationIndex = instr->getDestinationIndex();
+			int variable = destinationIndex >= 0 ? variableIndex(Liveness::variableOf(instr, destinationIndex)) : -1;
+
+			if (variable >= 0 && assigned.insert(variable).second)
+			{
+				definitionBlocks[variable].push_back(bb);
+			}
+		}
+	}
+
+	isGlobal.resize(variables.size(), false);
+
+	// Place the phis on the iterated dominance frontiers
+	for (size_t variable = 0; variable < variables.size(); variable++)
+	{
+		if (!isGlobal[variable])
+		{
+			continue;
+		}
+
+		set<BasicBlock*> hasPhi;
+		vector<BasicBlock*> toVisit = definitionBlocks[variable];
+		set<BasicBlock*> visited(toVisit.begin(), toVisit.end());
+
+		while (!toVisit.empty())
+		{
+			BasicBlock * bb = toVisit.back();
+			toVisit.pop_back();
+
+			for (BasicBlock * frontier : tree.getFrontier(bb))
+			{
+				if (!hasPhi.insert(frontier).second)
+				{
+					continue;
+				}
+
+				// The operands are added while renaming the predecessors
+				list<IRInstr*> instructions = frontier->getInstructionList();
+				IRInstr * phi = new IRInstr(frontier, IRInstr::phi, {variables[variable].baseName}, ssaSymbolTable.get());
+				phi->setLine(instructions.empty() ? 0 : instructions.front()->getLine());
+				instructions.push_front(phi);
+				frontier->setInstructionList(instructions);
+				phiVariables[phi] = variable;
+
+				if (visited.insert(frontier).second)
+				{
+					toVisit.push_back(frontier);
+				}
+			}
+		}
+	}
+}
+
+// Rename the variables of a block and of the blocks it dominates
+void SSA::rename(BasicBlock * bb, DominatorTree& tree)
+{
+	vector<int> pushed;
+
+	for (IRInstr * instr : bb->getInstructionList())
+	{
+		if (instr->getOp() == IRInstr::phi)
+		{
+			int variable = phiVariables[instr];
+			instr->setParameter(0, newVersion(variable));
+			pushed.push_back(variable);
+			continue;
+		}
+
+		// Resolve the variables in the scope of the instruction before renaming them
+		vector<int> sourceIndexes = instr->getSourceIndexes();
+		vector<int> sourceVariables;
+
+		for (int index : sourceIndexes)
+		{
+			sourceVariables.push_back(variableIndex(Liveness::variableOf(instr, index)));
+		}
+
+		int destinationIndex = instr->getDestinationIndex();
+		int destinationVariable = destinationIndex >= 0 ? variableIndex(Liveness::variableOf(instr, destinationIndex)) : -1;
+
+		for (size_t i = 0; i < sourceIndexes.size(); i++)
+		{
+			if (sourceVariables[i] >= 0)
+			{
+				instr->setParameter(sourceIndexes[i], currentVersion(sourceVariables[i]));
+			}
+		}
+
+		if (destinationVariable >= 0)
+		{
+			instr->setParameter(destinationIndex, newVersion(destinationVariable));
+			pushed.push_back(destinationVariable);
+		}
+
+		instr->setSymbolTable(ssaSymbolTable.get());
+	}
+
+	// Give the phis of the successors the versions leaving this block
+	for (BasicBlock * successor : tree.getSuccessors(bb))
+	{
+		for (IRInstr * instr : successor->getInstructionList())
+		{
+			if (instr->getOp() != IRInstr::phi)
+			{
+				break;
+			}
+
+			instr->addParameter(currentVersion(phiVariables[instr]));
+			instr->addParameter(bb->getLabel());
+		}
+	}
+
+	for (BasicBlock * child : tree.getChildren(bb))
+	{
+		rename(child, tree);
+	}
+
+	for (int variable : pushed)
+	{
+		variables[variable].stack.pop_back();
+	}
+}
+
+// Remove the phis whose result is never read
+void SSA::removeDeadPhis(vector<BasicBlock*>& blocks)
+{
+	unordered_map<string, int> nbUses;
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			for (int index : instr->getSourceIndexes())
+			{
+				nbUses[instr->getParameter(index)]++;
+			}
+		}
+	}
+
+	// Removing a phi may leave the phis it reads unused
+	bool changed = true;
+
+	while (changed)
+	{
+		changed = false;
+
+		for (BasicBlock * bb : blocks)
+		{
+			list<IRInstr*> instructions = bb->getInstructionList();
+
+			for (list<IRInstr*>::iterator it = instructions.begin(); it != instructions.end(); )
+			{
+				IRInstr * instr = *it;
+
+				// Only the phis reading their own result are unused otherwise
+				bool isDead = instr->getOp() == IRInstr::phi && nbUses[instr->getParameter(0)] == 0;
+
+				if (!isDead)
+				{
+					++it;
+					continue;
+				}
+
+				for (int index : instr->getSourceIndexes())
+				{
+					nbUses[instr->getParameter(index)]--;
+				}
+
+				phiVariables.erase(instr);
+				delete instr;
+				it = instructions.erase(it);
+				changed = true;
+			}
+
+			bb->setInstructionList(instructions);
+		}
+	}
+}
+
+// Block running the copies of an edge: the edge is split if its source has other successors
+BasicBlock * SSA::edgeBlock(BasicBlock * predecessor, BasicBlock * bb, DominatorTree& tree)
+{
+	if (tree.getSuccessors(predecessor).size() < 2)
+	{
+		return predecessor;
+	}
+
+	// A new block jumps from the predecessor to bb
+	IRInstr * terminator = predecessor->getInstructionList().back();
+	BasicBlock * edgeBB = cfg->createBBAfter(predecessor);
+	IRInstr * jump = new IRInstr(edgeBB, IRInstr::absolute_jump, {bb->getLabel()}, ssaSymbolTable.get());
+	jump->setLine(terminator->getLine());
+	edgeBB->setInstructionList({jump});
+
+	vector<string> parameters = terminator->getParameters();
+
+	for (size_t i = 0; i < parameters.size(); i++)
+	{
+		if (parameters[i] == bb->getLabel())
+		{
+			terminator->setParameter(i, edgeBB->getLabel());
+		}
+	}
+
+	return edgeBB;
+}
+
+// Give every version the variable it is merged into
+unordered_map<string, string> SSA::coalesceVersions()
+{
+	vector<BasicBlock*> blocks = cfg->getFunctionBlocks(functionName);
+	DominatorTree tree(blocks);
+	Liveness liveness(blocks, tree);
+
+	// Number the versions: the classes of merged versions are the sets of a union-find, named by their root
+	vector<string> versionNames;
+	vector<int> versionNumberVariables;
+	unordered_map<string, int> versionNumbers;
+
+	for (ssaVariableStruct& variable : variables)
+	{
+		vector<string> versions = variable.versions;
+
+		if (!variable.undefinedVersion.empty())
+		{
+			versions.insert(versions.begin(), variable.undefinedVersion);
+		}
+
+		for (string& version : versions)
+		{
+			versionNumbers[version] = versionNames.size();
+			versionNames.push_back(version);
+			versionNumberVariables.push_back(versionVariables[version]);
+		}
+	}
+
+	int nbVersions = versionNames.size();
+	vector<int> parents(nbVersions);
+	vector<string> classNames(versionNames);
+
+	for (int version = 0; version < nbVersions; version++)
+	{
+		parents[version] = version;
+	}
+
+	// Classes live at the same time, kept between roots only
+	vector<unordered_set<int>> conflicts(nbVersions);
+	unordered_map<varStruct*, int> livenessVersions;
+
+	for (int i = 0; i < liveness.getNbVariables(); i++)
+	{
+		unordered_map<string, int>::iterator version = versionNumbers.find(liveness.getVariable(i)->variableName);
+
+		if (version != versionNumbers.end())
+		{
+			livenessVersions[liveness.getVariable(i)] = version->second;
+		}
+	}
+
+	forEachInterference(blocks, tree, liveness, [&](varStruct * a, varStruct * b)
+	{
+		unordered_map<varStruct*, int>::iterator versionA = livenessVersions.find(a);
+		unordered_map<varStruct*, int>::iterator versionB = livenessVersions.find(b);
+
+		if (versionA != livenessVersions.end() && versionB != livenessVersions.end())
+		{
+			conflicts[versionA->second].insert(versionB->second);
+			conflicts[versionB->second].insert(versionA->second);
+		}
+	});
+
+	auto findClass = [&](int version)
+	{
+		while (parents[version] != version)
+		{
+			parents[version] = parents[parents[version]];
+			version = parents[version];
+		}
+
+		return version;
+	};
+
+	// Join two classes that do not conflict: the conflicts of the class with fewer of them move to the other one
+	auto unite = [&](int classA, int classB, string name)
+	{
+		if (conflicts[classA].size() < conflicts[classB].size())
+		{
+			swap(classA, classB);
+		}
+
+		parents[classB] = classA;
+
+		for (int other : conflicts[classB])
+		{
+			conflicts[other].erase(classB);
+			conflicts[other].insert(classA);
+			conflicts[classA].insert(other);
+		}
+
+		conflicts[classB].clear();
+		classNames[classA] = name;
+
+		return classA;
+	};
+
+	// Merge every version into the first group of versions of its variable it does not conflict with
+	int firstVersion = 0;
+
+	for (ssaVariableStruct& variable : variables)
+	{
+		int nbVariableVersions = variable.versions.size() + (variable.undefinedVersion.empty() ? 0 : 1);
+		vector<int> groups;
+
+		for (int version = firstVersion; version < firstVersion + nbVariableVersions; version++)
+		{
+			size_t group = 0;
+
+			while (group < groups.size() && conflicts[version].count(groups[group]) > 0)
+			{
+				group++;
+			}
+
+			if (group == groups.size())
+			{
+				groups.push_back(version);
+				classNames[version] = group == 0 ? variable.baseName : versionNames[version];
+			}
+			else
+			{
+				groups[group] = unite(groups[group], version, classNames[groups[group]]);
+			}
+		}
+
+		firstVersion += nbVariableVersions;
+	}
+
+	// Then the variables of a phi or of a move of the same type are merged when they are never live at the same time, so that the move disappears
+	auto merge = [&](const string& a, const string& b)
+	{
+		unordered_map<string, int>::iterator versionA = versionNumbers.find(a);
+		unordered_map<string, int>::iterator versionB = versionNumbers.find(b);
+
+		if (versionA == versionNumbers.end() || versionB == versionNumbers.end())
+		{
+			return;
+		}
+
+		int classA = findClass(versionA->second);
+		int classB = findClass(versionB->second);
+
+		if (classA == classB || variables[versionNumberVariables[classA]].type != variables[versionNumberVariables[classB]].type || conflicts[classA].count(classB) > 0)
+		{
+			return;
+		}
+
+		// The name of a variable of the source program is kept rather than the name of a temporary
+		string name = classNames[classA][0] == '!' && classNames[classB][0] != '!' ? classNames[classB] : classNames[classA];
+
+		unite(classA, classB, name);
+	};
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			vector<string> parameters = instr->getParameters();
+
+			if (instr->getOp() == IRInstr::phi)
+			{
+				for (size_t i = 1; i + 1 < parameters.size(); i += 2)
+				{
+					merge(parameters[0], parameters[i]);
+				}
+			}
+			else if ((instr->getOp() == IRInstr::copy || instr->getOp() == IRInstr::aff) && versionVariables.count(parameters[0]) > 0 && versionVariables.count(parameters[1]) > 0)
+			{
+				merge(parameters[1], parameters[0]);
+			}
+		}
+	}
+
+	unordered_map<string, string> classes;
+
+	for (int version = 0; version < nbVersions; version++)
+	{
+		classes[versionNames[version]] = classNames[findClass(version)];
+	}
+
+	return classes;
+}
+
+// Replace the phis by copies at the end of the predecessors
+void SSA::insertCopies(unordered_map<string, string>& classes)
+{
+	vector<BasicBlock*> blocks = cfg->getFunctionBlocks(functionName);
+	DominatorTree tree(blocks);
+
+	// Copies of every edge (predecessor and block, then destination and source), in parallel
+	map<pair<BasicBlock*, BasicBlock*>, vector<pair<string, string>>> copies;
+	vector<pair<BasicBlock*, BasicBlock*>> edges;
+
+	for (BasicBlock * bb : blocks)
+	{
+		list<IRInstr*> instructions = bb->getInstructionList();
+
+		for (list<IRInstr*>::iterator it = instructions.begin(); it != instructions.end(); )
+		{
+			IRInstr * instr = *it;
+
+			if (instr->getOp() == IRInstr::phi)
+			{
+				vector<string> parameters = instr->getParameters();
+
+				for (size_t i = 1; i + 1 < parameters.size(); i += 2)
+				{
+					string destination = classes[parameters[0]];
+					string source = classes[parameters[i]];
+
+					if (destination != source)
+					{
+						pair<BasicBlock*, BasicBlock*> edge = {tree.getBlock(parameters[i + 1]), bb};
+
+						if (copies.count(edge) == 0)
+						{
+							edges.push_back(edge);
+						}
+
+						copies[edge].push_back({destination, source});
+					}
+				}
+
+				delete instr;
+				it = instructions.erase(it);
+				continue;
+			}
+
+			// Every version is renamed into its variable
+			for (int index : instr->getSourceIndexes())
+			{
+				instr->setParameter(index, classes[instr->getParameter(index)]);
+			}
+
+			if (instr->getDestinationIndex() >= 0)
+			{
+				instr->setParameter(instr->getDestinationIndex(), classes[instr->getParameter(instr->getDestinationIndex())]);
+			}
+
+			// A copy of a variable to itself disappears
+			bool isSelfCopy = (instr->getOp() == IRInstr::copy || instr->getOp() == IRInstr::aff) && instr->getParameters().at(0) == instr->getParameters().at(1);
+
+			if (isSelfCopy)
+			{
+				delete instr;
+				it = instructions.erase(it);
+				continue;
+			}
+
+			++it;
+		}
+
+		bb->setInstructionList(instructions);
+	}
+
+	// Sequentialize the copies of every edge before its jump
+	for (pair<BasicBlock*, BasicBlock*> edge : edges)
+	{
+		BasicBlock * bb = edgeBlock(edge.first, edge.second, tree);
+		vector<pair<string, string>> pending = copies[edge];
+		list<IRInstr*> instructions = bb->getInstructionList();
+		IRInstr * terminator = instructions.back();
+		instructions.pop_back();
+
+		auto emitCopy = [&](string destination, string source)
+		{
+			IRInstr * copy = new IRInstr(bb, IRInstr::copy, {source, destination}, ssaSymbolTable.get());
+			copy->setLine(terminator->getLine());
+			instructions.push_back(copy);
+		};
+
+		while (!pending.empty())
+		{
+			// A copy whose destination is not read by another pending copy can be done
+			vector<pair<string, string>>::iterator ready = find_if(pending.begin(), pending.end(), [&](pair<string, string>& copy)
+			{
+				return none_of(pending.begin(), pending.end(), [&](pair<string, string>& other) { return other.second == copy.first; });
+			});
+
+			if (ready != pending.end())
+			{
+				emitCopy(ready->first, ready->second);
+				pending.erase(ready);
+				continue;
+			}
+
+			// Only cycles are left: save a destination to break its cycle
+			string destination = pending.front().first;
+			string temporary = "!swap" + to_string(copyTemporaries.size() + 1);
+			copyTemporaries[temporary] = variables[versionVariables.count(destination) ? versionVariables[destination] : 0].type;
+
+			for (ssaVariableStruct& variable : variables)
+			{
+				if (variable.baseName == destination || find(variable.versions.begin(), variable.versions.end(), destination) != variable.versions.end())
+				{
+					copyTemporaries[temporary] = variable.type;
+				}
+			}
+
+			emitCopy(temporary, destination);
+
+			for (pair<string, string>& copy : pending)
+			{
+				if (copy.second == destination)
+				{
+					copy.second = temporary;
+				}
+			}
+		}
+
+		instructions.push_back(terminator);
+		bb->setInstructionList(instructions);
+	}
+}
+
+// Give every variable a register or a stack slot
+void SSA::layoutFrame()
+{
+	vector<BasicBlock*> blocks = cfg->getFunctionBlocks(functionName);
+
+	// Type and line of every final variable
+	unordered_map<string, pair<Type, int>> finalVariables;
+
+	for (ssaVariableStruct& variable : variables)
+	{
+		finalVariables[variable.baseName] = {variable.type, variable.line};
+
+		for (string version : variable.versions)
+		{
+			finalVariables[version] = {variable.type, variable.line};
+		}
+
+		if (!variable.undefinedVersion.empty())
+		{
+			finalVariables[variable.undefinedVersion] = {variable.type, variable.line};
+		}
+	}
+
+	for (pair<const string, Type>& temporary : copyTemporaries)
+	{
+		finalVariables[temporary.first] = {temporary.second, 0};
+	}
+
+	// The frame holds the variables named by the instructions
+	frameSymbolTable.reset(new SymbolTable());
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			vector<int> indexes = instr->getSourceIndexes();
+
+			if (instr->getDestinationIndex() >= 0)
+			{
+				indexes.push_back(instr->getDestinationIndex());
+			}
+
+			for (int index : indexes)
+			{
+				string name = instr->getParameter(index);
+
+				if (finalVariables.count(name) > 0 && !frameSymbolTable->hasVariable(name))
+				{
+					frameSymbolTable->addVariable(name, finalVariables[name].first, finalVariables[name].second);
+				}
+			}
+
+			instr->setSymbolTable(frameSymbolTable.get());
+		}
+	}
+
+	// The variables get registers, the others share stack slots
+	RegisterAllocator allocator(blocks, frameSymbolTable.get());
+	allocator.allocate();
+}
+
+// Call f for every pair of variables live at the same time where one is written
+void SSA::forEachInterference(vector<BasicBlock*>& blocks, DominatorTree& tree, Liveness& liveness, function<void(varStruct*, varStruct*)> f)
+{
+	// The live variables of the walk are a sparse set: their numbers, and the position of every number among them (-1 if not live),
+	// so that a write visits the live variables only, not every variable of the function
+	vector<int> live;
+	vector<int> positions(liveness.getNbVariables(), -1);
+
+	auto setLive = [&](int variable, bool isLive)
+	{
+		if (isLive && positions[variable] < 0)
+		{
+			positions[variable] = live.size();
+			live.push_back(variable);
+		}
+		else if (!isLive && positions[variable] >= 0)
+		{
+			live[positions[variable]] = live.back();
+			positions[live.back()] = positions[variable];
+			live.pop_back();
+			positions[variable] = -1;
+		}
+	};
+
+	for (BasicBlock * bb : blocks)
+	{
+		for (int variable : live)
+		{
+			positions[variable] = -1;
+		}
+
+		live.clear();
+
+		for (int variable : liveness.getLiveOutVariables(bb))
+		{
+			setLive(variable, true);
+		}
+
+		list<IRInstr*> instructions = bb->getInstructionList();
+		vector<IRInstr*> phis;
+
+		// Walk the block backward: a written variable interferes with the variables live after it
+		for (list<IRInstr*>::reverse_iterator it = instructions.rbegin(); it != instructions.rend(); ++it)
+		{
+			IRInstr * instr = *it;
+
+			if (instr->getOp() == IRInstr::phi)
+			{
+				phis.push_back(instr);
+				continue;
+			}
+
+			int destinationIndex = instr->getDestinationIndex();
+			varStruct * destination = destinationIndex >= 0 ? Liveness::variableOf(instr, destinationIndex) : nullptr;
+
+			if (destination != nullptr)
+			{
+				int index = liveness.getIndex(destination);
+
+				for (int variable : live)
+				{
+					if (variable != index)
+					{
+						f(destination, liveness.getVariable(variable));
+					}
+				}
+
+				setLive(index, false);
+			}
+
+			for (int sourceIndex : instr->getSourceIndexes())
+			{
+				varStruct * source = Liveness::variableOf(instr, sourceIndex);
+
+				if (source != nullptr)
+				{
+					setLive(liveness.getIndex(source), true);
+				}
+			}
+		}
+
+		// The phis write at the start of the block, and at the end of the predecessors (except over the value they copy)
+		for (IRInstr * phi : phis)
+		{
+			varStruct * destination = Liveness::variableOf(phi, 0);
+			int index = liveness.getIndex(destination);
+
+			for (int variable : live)
+			{
+				if (variable != index)
+				{
+					f(destination, liveness.getVariable(variable));
+				}
+			}
+
+			vector<string> parameters = phi->getParameters();
+
+			for (size_t p = 1; p + 1 < parameters.size(); p += 2)
+			{
+				BasicBlock * predecessor = tree.getBlock(parameters[p + 1]);
+				int sourceIndex = liveness.getIndex(Liveness::variableOf(phi, p));
+
+				if (predecessor == nullptr)
+				{
+					continue;
+				}
+
+				for (int variable : liveness.getLiveOutVariables(predecessor))
+				{
+					if (variable != index && variable != sourceIndex)
+					{
+						f(destination, liveness.getVariable(variable));
+					}
+				}
+			}
+		}
+	}
+}
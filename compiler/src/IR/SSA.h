@@ -0,0 +1,135 @@
+/*************************************************************************
+                          PLD Compilateur: SSA
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <SSA> (file SSA.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include "CFG.h"
+#include "DominatorTree.h"
+#include "Liveness.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Structure to represent a variable of the function while it is renamed into versions
+struct ssaVariableStruct
+{
+	string baseName;			// Name of the variable in the function (unique, the versions add ".<number>")
+	Type type;					// Type of the variable (and of its versions)
+	int line;					// Line of the declaration
+	vector<string> versions;	// Versions of the variable, in the order of their creation
+	vector<string> stack;		// Versions reaching the instruction being renamed (the current one last)
+	string undefinedVersion;	// Version read before any assignment (empty if none)
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <SSA> :
+//
+// The SSA class puts a function in static single assignment form and
+// takes it back out before the emission. In SSA form, every variable
+// (local, parameter or temporary) is split into versions written by a
+// single instruction, and a phi chooses the version reaching a join
+// point from each predecessor. Every instruction then reads the value
+// of a known definition, which is what the dataflow optimizations need.
+// The phis are placed on the iterated dominance frontiers of the blocks
+// assigning a variable read in another block, and the versions are
+// given while walking the dominator tree. The compound assignments
+// (a += b) become binary operations (a.2 = a.1 + b), as they both read
+// and write their variable.
+// Leaving the SSA form, the versions of a variable whose lives do not
+// overlap are merged back into one variable, then the variables joined
+// by a phi or a move of the same type are merged the same way, so that
+// the move disappears (tmp <- x; y <- tmp becomes a single variable when
+// x is not read after). Each remaining phi becomes copies at the end of
+// its predecessors (the copies of an edge happen in parallel, so cycles
+// go through a temporary). An edge from a block with several successors
+// gets its own block for its copies.
+// Finally the RegisterAllocator gives every variable a register or a
+// stack slot, and lays out the frame.
+// The SSA owns the symbol tables of the versions and of the final frame:
+// it must live until the code is generated.
+//
+//------------------------------------------------------------------------
+
+class SSA
+{
+	public:
+
+		// Constructor
+		SSA(CFG * cfg, string functionName);
+
+		// Put the function in SSA form
+		void construct();
+
+		// Take the function out of SSA form and lay out its stack frame
+		void destruct();
+
+		// Create a new variable in SSA form (a temporary of an optimization), and give its name
+		string createVariable(Type type, int line);
+
+		// Symbol table of the variables of the function (the versions in SSA form, then the frame)
+		SymbolTable * getSymbolTable();
+
+		// Name of the function
+		string getFunctionName();
+
+	protected:
+
+		// Give a number to the variable of an instruction of the source program (-1 if not a variable)
+		int variableIndex(varStruct * variable);
+
+		// Create the next version of a variable and make it current
+		string newVersion(int variable);
+
+		// Current version of a variable (created undefined if the variable is read before any assignment)
+		string currentVersion(int variable);
+
+		// Insert the phis of the variables read in several blocks
+		void insertPhis(vector<BasicBlock*>& blocks, DominatorTree& tree);
+
+		// Rename the variables of a block and of the blocks it dominates
+		void rename(BasicBlock * bb, DominatorTree& tree);
+
+		// Remove the phis whose result is never read
+		void removeDeadPhis(vector<BasicBlock*>& blocks);
+
+		// Block running the copies of an edge: the edge is split if its source has other successors
+		BasicBlock * edgeBlock(BasicBlock * predecessor, BasicBlock * bb, DominatorTree& tree);
+
+		// Give every version the variable it is merged into
+		unordered_map<string, string> coalesceVersions();
+
+		// Replace the phis by copies at the end of the predecessors
+		void insertCopies(unordered_map<string, string>& classes);
+
+		// Give every variable a register or a stack slot
+		void layoutFrame();
+
+		// Call f for every pair of variables live at the same time where one is written (a phi writes at the start of its block)
+		static void forEachInterference(vector<BasicBlock*>& blocks, DominatorTree& tree, Liveness& liveness, function<void(varStruct*, varStruct*)> f);
+
+		CFG * cfg;											// CFG holding the function
+		string functionName;								// Name of the function
+		unique_ptr<SymbolTable> ssaSymbolTable;				// Versions of the variables, in SSA form
+		unique_ptr<SymbolTable> frameSymbolTable;			// Variables and slots of the final frame
+		vector<ssaVariableStruct> variables;				// Variables of the function
+		unordered_map<varStruct*, int> variableIndexes;		// Number of every variable of the source program
+		unordered_map<string, int> nbBaseNames;				// Number of variables of the source program sharing every name
+		unordered_map<string, int> versionVariables;		// Variable of every version
+		unordered_map<IRInstr*, int> phiVariables;			// Variable of every phi
+		unordered_map<string, Type> copyTemporaries;		// Temporaries breaking the cycles of parallel copies
+		int nbCreatedVariables = 0;							// Number of variables created by the optimizations
+};
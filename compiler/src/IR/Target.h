@@ -0,0 +1,181 @@
+/*************************************************************************
+                          PLD Compilateur: Target
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of the target description (file Target.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include "../Type.h"
+#include "IRInstr.h"
+
+//------------------------------------------------------------------ Types
+
+// Number of parameters passed in registers
+constexpr int TARGET_PARAM_REGISTERS = 6;
+
+// Structure to describe how a type is handled by the x86-64 target
+struct targetTypeStruct
+{
+	int size;										// Size in the stack frame, in bytes
+	const char * load;								// Load into a 32-bit register (zero extended)
+	const char * signedLoad;						// Load into a 32-bit register (sign extended)
+	const char * move;								// Move of the size of the type
+	const char * accumulator;						// %eax of the size of the type
+	const char * remainder;							// %edx of the size of the type
+	const char * paramRegisters[TARGET_PARAM_REGISTERS];	// Registers of the first parameters of a call
+};
+
+// Number of registers the allocator can give to variables
+constexpr int TARGET_ALLOCATABLE_REGISTERS = 11;
+
+// Structure to describe a register the allocator can give to variables
+struct targetRegisterStruct
+{
+	const char * names[3];		// Name of the register on 8, 4 and 1 bytes
+	bool calleeSaved;			// Whether a function must restore the register before returning
+	int parameter;				// Index of the parameter of a call passed in the register (-1 if none)
+};
+
+// Shapes of the code emitted for an operation
+enum emitShape {EMIT_LDCONST, EMIT_COPY, EMIT_UNARY, EMIT_BINARY, EMIT_DIVIDE, EMIT_WPARAM, EMIT_RPARAM, EMIT_CALL,
+				EMIT_RET, EMIT_PROLOGUE, EMIT_CONDITIONAL_JUMP, EMIT_ABSOLUTE_JUMP, EMIT_NONE};
+
+// Loads of the operands of an operation
+enum emitLoad {LOAD_TYPED, LOAD_SIGNED};
+
+// Structure to describe the code emitted for an operation of the IR
+struct targetOperationStruct
+{
+	IRInstr::Operation op;		// Operation described (the table follows the order of the enum)
+	emitShape shape;			// Shape of the emitted code
+	const char * name;			// Name of the operation in the comments
+	const char * mnemonic;		// Instruction computing the result into %eax
+	const char * condition;		// setcc turning the flags into the result (nullptr if none)
+	emitLoad load;				// Load of the operands (extended to 32 bits)
+	const char * second;		// Register the second operand is loaded into (nullptr if not loaded)
+	bool memorySource;			// Whether the instruction reads the second operand in place (if 32 bits wide)
+	bool remainder;				// Whether the result is in %edx instead of %eax
+	bool compound;				// Whether the result is stored into the first operand (a op= b)
+};
+
+//------------------------------------------------------------------------
+//
+// The target tables describe the x86-64 System V target and drive the
+// emitter of IRInstr. They are built at compile time and read by index
+// (a Type or an IRInstr::Operation), so the emission of an instruction
+// compares no strings. A void value (the result of a void call) has no
+// storage: it is never stored. A phi only exists in SSA form and emits
+// nothing. A variable lives in its stack slot, or in the register the
+// allocator gave it (named according to the size of the access).
+//
+//------------------------------------------------------------------------
+
+// Description of the types, in the order of the Type enum
+constexpr targetTypeStruct targetTypes[TYPE_COUNT] = {
+	// TYPE_INT
+	{4, "movl", "movl", "movl", "%eax", "%edx", {"%edi", "%esi", "%edx", "%ecx", "%r8d", "%r9d"}},
+	// TYPE_CHAR
+	{1, "movzbl", "movsbl", "movb", "%al", "%dl", {"%dil", "%sil", "%dl", "%cl", "%r8b", "%r9b"}},
+	// TYPE_VOID
+	{0, "movl", "movl", "movl", "%eax", "%edx", {"%edi", "%esi", "%edx", "%ecx", "%r8d", "%r9d"}}
+};
+
+// Description of the operations, in the order of the IRInstr::Operation enum
+constexpr targetOperationStruct targetOperations[] = {
+	// op						shape					name				mnemonic	condition	load			second		memory	remainder	compound
+	{IRInstr::ldconst,			EMIT_LDCONST,			"ldconst",			nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::copy,				EMIT_COPY,				"copy",				nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::aff,				EMIT_COPY,				"aff",				nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::wparam,			EMIT_WPARAM,			"wparam",			nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::rparam,			EMIT_RPARAM,			"rparam",			nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::call,				EMIT_CALL,				"call",				nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::cmp_eq,			EMIT_BINARY,			"cmp_eq",			"cmpl",		"sete",		LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::cmp_neq,			EMIT_BINARY,			"cmp_neq",			"cmpl",		"setne",	LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::cmp_lt,			EMIT_BINARY,			"cmp_lt",			"cmpl",		"setl",		LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::cmp_gt,			EMIT_BINARY,			"cmp_gt",			"cmpl",		"setg",		LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::cmp_eqlt,			EMIT_BINARY,			"cmp_eqlt",			"cmpl",		"setle",	LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::cmp_eqgt,			EMIT_BINARY,			"cmp_eqgt",			"cmpl",		"setge",	LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::op_or,			EMIT_BINARY,			"op_or",			"orl",		nullptr,	LOAD_TYPED,		nullptr,	true,	false,		false},
+	{IRInstr::op_xor,			EMIT_BINARY,			"op_xor",			"xorl",		nullptr,	LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::op_and,			EMIT_BINARY,			"op_and",			"andl",		nullptr,	LOAD_TYPED,		nullptr,	true,	false,		false},
+	{IRInstr::op_add,			EMIT_BINARY,			"op_add",			"addl",		nullptr,	LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::op_sub,			EMIT_BINARY,			"op_sub",			"subl",		nullptr,	LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::op_mul,			EMIT_BINARY,			"op_mul",			"imull",	nullptr,	LOAD_TYPED,		"%edx",		false,	false,		false},
+	{IRInstr::op_div,			EMIT_DIVIDE,			"op_div",			"idivl",	nullptr,	LOAD_SIGNED,	"%edx",		true,	false,		false},
+	{IRInstr::op_mod,			EMIT_DIVIDE,			"op_mod",			"idivl",	nullptr,	LOAD_SIGNED,	"%ecx",		false,	true,		false},
+	{IRInstr::op_not,			EMIT_UNARY,				"op_not",			"cmpl",		"sete",		LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::op_minus,			EMIT_UNARY,				"op_minus",			"negl",		nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::op_plus_equal,	EMIT_BINARY,			"op_plus_equal",	"addl",		nullptr,	LOAD_TYPED,		"%edx",		false,	false,		true},
+	{IRInstr::op_sub_equal,		EMIT_BINARY,			"op_sub_equal",		"subl",		nullptr,	LOAD_TYPED,		"%edx",		false,	false,		true},
+	{IRInstr::op_mult_equal,	EMIT_BINARY,			"op_mult_equal",	"imull",	nullptr,	LOAD_TYPED,		"%edx",		false,	false,		true},
+	{IRInstr::op_div_equal,		EMIT_DIVIDE,			"op_div_equal",		"idivl",	nullptr,	LOAD_SIGNED,	"%edx",		true,	false,		true},
+	{IRInstr::ret,				EMIT_RET,				"ret",				nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::prologue,			EMIT_PROLOGUE,			"prologue",			nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::conditional_jump,	EMIT_CONDITIONAL_JUMP,	"conditional_jump",	"cmpl",		"je",		LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::absolute_jump,	EMIT_ABSOLUTE_JUMP,		"absolute_jump",	"jmp",		nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false},
+	{IRInstr::phi,				EMIT_NONE,				"phi",				nullptr,	nullptr,	LOAD_TYPED,		nullptr,	false,	false,		false}
+};
+
+// Registers given to the variables, in the order of preference: the
+// scratch registers of the emitter (%eax, %ecx, %edx) are never given,
+// and the caller-saved registers come first as they cost no save
+constexpr targetRegisterStruct targetRegisters[TARGET_ALLOCATABLE_REGISTERS] = {
+	{{"%r10", "%r10d", "%r10b"}, false, -1},
+	{{"%r11", "%r11d", "%r11b"}, false, -1},
+	{{"%r9", "%r9d", "%r9b"}, false, 5},
+	{{"%r8", "%r8d", "%r8b"}, false, 4},
+	{{"%rsi", "%esi", "%sil"}, false, 1},
+	{{"%rdi", "%edi", "%dil"}, false, 0},
+	{{"%rbx", "%ebx", "%bl"}, true, -1},
+	{{"%r12", "%r12d", "%r12b"}, true, -1},
+	{{"%r13", "%r13d", "%r13b"}, true, -1},
+	{{"%r14", "%r14d", "%r14b"}, true, -1},
+	{{"%r15", "%r15d", "%r15b"}, true, -1}
+};
+
+// Check that every operation is described at the index of its value
+constexpr bool targetOperationsInOrder()
+{
+	int count = sizeof(targetOperations) / sizeof(targetOperations[0]);
+
+	for (int i = 0; i < count; i++)
+	{
+		if (targetOperations[i].op != i)
+		{
+			return false;
+		}
+	}
+
+	return count == IRInstr::phi + 1;
+}
+
+static_assert(targetOperationsInOrder(), "targetOperations must describe every IRInstr::Operation in order");
+
+// Description of a type
+constexpr const targetTypeStruct& targetType(Type type)
+{
+	return targetTypes[type];
+}
+
+// Description of an operation
+constexpr const targetOperationStruct& targetOperation(IRInstr::Operation op)
+{
+	return targetOperations[op];
+}
+
+// Name of an allocatable register accessed on size bytes
+constexpr const char * targetRegisterName(int reg, int size)
+{
+	return targetRegisters[reg].names[size == 8 ? 0 : size == 4 ? 1 : 2];
+}
+
+// Load of an operand of a type into a 32-bit register
+constexpr const char * targetLoad(emitLoad load, Type type)
+{
+	return load == LOAD_SIGNED ? targetTypes[type].signedLoad : targetTypes[type].load;
+}
@@ -0,0 +1,456 @@
+/*************************************************************************
+                          PLD Compilateur: WholeProgram
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <WholeProgram> (file WholeProgram.cpp) -----/
+
+#include "WholeProgram.h"
+#include "Target.h"
+
+using namespace std;
+
+// Constructor
+WholeProgram::WholeProgram(CFG * cfg, SymbolTable * globalSymbolTable) : cfg(cfg), globalSymbolTable(globalSymbolTable)
+{
+}
+
+// Run the whole program optimizations
+void WholeProgram::optimize()
+{
+	// Inlining first: the functions only called from inlined sites become unreachable
+	inlineCalls();
+	removeUnreachableFunctions();
+
+	// Only the calls of the remaining functions decide the constant parameters
+	propagateConstants();
+}
+
+// Inline the calls to the small functions
+void WholeProgram::inlineCalls()
+{
+	map<string, vector<BasicBlock*>> blocks = functionBlocks();
+
+	// An inlined function has no call, so the call sites found first stay valid
+	for (callInstrStruct& site : findCallSites())
+	{
+		string callee = site.call->getParameters().at(0);
+
+		if (!site.complete || blocks.count(callee) == 0 || !isInlinable(callee, blocks[callee]))
+		{
+			continue;
+		}
+
+		// Every parameter of the callee needs an argument
+		bool hasArguments = true;
+
+		for (IRInstr * instr : blocks[callee].front()->getInstructionList())
+		{
+			if (instr->getOp() == IRInstr::rparam && stoi(instr->getParameters().at(1)) >= (int) site.arguments.size())
+			{
+				hasArguments = false;
+			}
+		}
+
+		if (hasArguments)
+		{
+			// The prologue of the caller gives the symbol table of its whole frame
+			SymbolTable * frame = blocks[site.bb->getFunctionName()].front()->getInstructionList().front()->getSymbolTable();
+			inlineCall(site, blocks[callee].front(), frame);
+		}
+	}
+}
+
+// Remove the functions unreachable from main
+void WholeProgram::removeUnreachableFunctions()
+{
+	// Functions called by every function
+	map<string, set<string>> callees;
+
+	for (BasicBlock * bb : cfg->getBasicBlocks())
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			if (instr->getOp() == IRInstr::call)
+			{
+				callees[bb->getFunctionName()].insert(instr->getParameters().at(0));
+			}
+		}
+	}
+
+	if (functionBlocks().count("main") == 0)
+	{
+		return;
+	}
+
+	// Walk the call graph from main
+	set<string> reachable = {"main"};
+	vector<string> toVisit = {"main"};
+
+	while (!toVisit.empty())
+	{
+		string name = toVisit.back();
+		toVisit.pop_back();
+
+		for (string callee : callees[name])
+		{
+			if (reachable.insert(callee).second)
+			{
+				toVisit.push_back(callee);
+			}
+		}
+	}
+
+	// Delete the blocks of the other functions
+	vector<BasicBlock*>& bbList = cfg->getBasicBlocks();
+	vector<BasicBlock*> kept;
+
+	for (BasicBlock * bb : bbList)
+	{
+		if (reachable.count(bb->getFunctionName()) > 0)
+		{
+			kept.push_back(bb);
+		}
+		else
+		{
+			delete bb;
+		}
+	}
+
+	bbList = kept;
+
+	// The standard functions are only generated if a remaining function calls them
+	globalSymbolTable->getFunction("putchar")->isCalled = reachable.count("putchar") > 0;
+	globalSymbolTable->getFunction("getchar")->isCalled = reachable.count("getchar") > 0;
+}
+
+// Replace the parameters receiving the same constant from every call
+void WholeProgram::propagateConstants()
+{
+	// Instructions writing every variable (a temporary has a single one)
+	map<varStruct*, vector<IRInstr*>> definitions;
+
+	for (BasicBlock * bb : cfg->getBasicBlocks())
+	{
+		for (IRInstr * instr : bb->getInstructionList())
+		{
+			varStruct * variable = findVariable(instr->getSymbolTable(), instr->getDestination());
+
+			if (variable != nullptr)
+			{
+				definitions[variable].push_back(instr);
+			}
+		}
+	}
+
+	// Call sites of every function
+	map<string, vector<callInstrStruct>> callSites;
+
+	for (callInstrStruct& site : findCallSites())
+	{
+		callSites[site.call->getParameters().at(0)].push_back(site);
+	}
+
+	for (pair<const string, vector<BasicBlock*>>& function : functionBlocks())
+	{
+		// main is called by the system, with unknown arguments
+		if (function.first == "main" || callSites.count(function.first) == 0)
+		{
+			continue;
+		}
+
+		BasicBlock * entry = function.second.front();
+		list<IRInstr*> instructions = entry->getInstructionList();
+
+		for (IRInstr *& instr : instructions)
+		{
+			if (instr->getOp() != IRInstr::rparam)
+			{
+				continue;
+			}
+
+			// The parameter is constant if every argument is a temporary only loaded with the same constant
+			size_t index = stoi(instr->getParameters().at(1));
+			bool isConstant = true;
+			int value = 0;
+
+			for (size_t i = 0; i < callSites[function.first].size() && isConstant; i++)
+			{
+				callInstrStruct& site = callSites[function.first][i];
+
+				if (!site.complete || index >= site.arguments.size())
+				{
+					isConstant = false;
+					break;
+				}
+
+				IRInstr * argument = site.arguments[index];
+				varStruct * variable = findVariable(argument->getSymbolTable(), argument->getParameters().at(0));
+
+				if (variable == nullptr || definitions[variable].size() != 1 || definitions[variable].front()->getOp() != IRInstr::ldconst)
+				{
+					isConstant = false;
+					break;
+				}
+
+				int argumentValue = SymbolTable::getCast(variable->variableType, stoi(definitions[variable].front()->getParameters().at(1)));
+				isConstant = i == 0 || argumentValue == value;
+				value = argumentValue;
+			}
+
+			if (isConstant)
+			{
+				string parameterName = instr->getParameters().at(0);
+				varStruct * parameter = findVariable(instr->getSymbolTable(), parameterName);
+
+				IRInstr * constant = new IRInstr(entry, IRInstr::ldconst, {typeName(parameter->variableType), to_string(value), parameterName}, instr->getSymbolTable());
+				constant->setLine(instr->getLine());
+				delete instr;
+				instr = constant;
+			}
+		}
+
+		entry->setInstructionList(instructions);
+	}
+}
+
+// Find the calls of the program and the wparam instructions of their arguments
+vector<callInstrStruct> WholeProgram::findCallSites()
+{
+	vector<callInstrStruct> sites;
+
+	for (BasicBlock * bb : cfg->getBasicBlocks())
+	{
+		list<IRInstr*> instructionList = bb->getInstructionList();
+		vector<IRInstr*> instructions(instructionList.begin(), instructionList.end());
+
+		for (size_t i = 0; i < instructions.size(); i++)
+		{
+			if (instructions[i]->getOp() != IRInstr::call)
+			{
+				continue;
+			}
+
+			// The arguments are written just before the call
+			int nbArguments = max(stoi(instructions[i]->getParameters().at(2)), 0);
+			callInstrStruct site = {bb, instructions[i], vector<IRInstr*>(nbArguments, nullptr), true};
+
+			for (size_t j = i; j > 0 && instructions[j - 1]->getOp() == IRInstr::wparam; j--)
+			{
+				int index = stoi(instructions[j - 1]->getParameters().at(1));
+
+				if (index < nbArguments && site.arguments[index] == nullptr)
+				{
+					site.arguments[index] = instructions[j - 1];
+				}
+			}
+
+			for (IRInstr * argument : site.arguments)
+			{
+				site.complete = site.complete && argument != nullptr;
+			}
+
+			sites.push_back(site);
+		}
+	}
+
+	return sites;
+}
+
+// Blocks of every function, in the order of the CFG
+map<string, vector<BasicBlock*>> WholeProgram::functionBlocks()
+{
+	map<string, vector<BasicBlock*>> blocks;
+
+	for (BasicBlock * bb : cfg->getBasicBlocks())
+	{
+		blocks[bb->getFunctionName()].push_back(bb);
+	}
+
+	return blocks;
+}
+
+// Whether a function can be inlined (a single block, no call, few instructions)
+bool WholeProgram::isInlinable(string name, vector<BasicBlock*>& blocks)
+{
+	if (name == "main" || blocks.size() != 1)
+	{
+		return false;
+	}
+
+	list<IRInstr*> instructions = blocks.front()->getInstructionList();
+
+	// The prologue, the body and the final ret
+	if (instructions.size() < 2 || (int) instructions.size() > INLINE_MAX_INSTRUCTIONS + 2)
+	{
+		return false;
+	}
+
+	if (instructions.front()->getOp() != IRInstr::prologue || instructions.back()->getOp() != IRInstr::ret)
+	{
+		return false;
+	}
+
+	for (IRInstr * instr : instructions)
+	{
+		switch (instr->getOp())
+		{
+			case IRInstr::call:
+			case IRInstr::wparam:
+			case IRInstr::conditional_jump:
+			case IRInstr::absolute_jump:
+				return false;
+
+			case IRInstr::ret:
+			{
+				if (instr != instructions.back())
+				{
+					return false;
+				}
+
+				break;
+			}
+
+			case IRInstr::rparam:
+			{
+				// The parameters passed on the stack are not copied
+				if (stoi(instr->getParameters().at(1)) >= TARGET_PARAM_REGISTERS)
+				{
+					return false;
+				}
+
+				break;
+			}
+
+			default:
+				break;
+		}
+	}
+
+	return true;
+}
+
+// Replace a call site by a copy of the body of the callee
+void WholeProgram::inlineCall(callInstrStruct& site, BasicBlock * callee, SymbolTable * frame)
+{
+	inlinedCalls++;
+
+	// The variables of the body go below the whole frame of the caller, so they overwrite nothing
+	SymbolTable * symbolTable = new SymbolTable(-frame->getMemorySpace(), site.call->getSymbolTable());
+	inlineSymbolTables.push_back(unique_ptr<SymbolTable>(symbolTable));
+
+	string resultName = site.call->getParameters().at(1);
+	Type resultType = findVariable(site.call->getSymbolTable(), resultName)->variableType;
+	int line = site.call->getLine();
+
+	// Name of the copy of every variable of the callee
+	map<varStruct*, string> copies;
+
+	auto copyOf = [&](IRInstr * instr, string name)
+	{
+		varStruct * variable = findVariable(instr->getSymbolTable(), name);
+
+		if (variable == nullptr) // Constants and types are kept
+		{
+			return name;
+		}
+
+		if (copies.count(variable) == 0)
+		{
+			copies[variable] = "!inl" + to_string(inlinedCalls) + "_" + variable->variableName;
+			symbolTable->addVariable(copies[variable], variable->variableType, line);
+			symbolTable->getVariable(copies[variable])->isUsed = true;
+		}
+
+		return copies[variable];
+	};
+
+	// Copy the body: the parameters are read from the arguments, the returned value goes to the result of the call
+	list<IRInstr*> body;
+
+	for (IRInstr * instr : callee->getInstructionList())
+	{
+		vector<string> parameters = instr->getParameters();
+		IRInstr * copy = nullptr;
+
+		switch (instr->getOp())
+		{
+			case IRInstr::prologue:
+				break;
+
+			case IRInstr::rparam:
+			{
+				string argumentName = site.arguments[stoi(parameters.at(1))]->getParameters().at(0);
+				copy = new IRInstr(site.bb, IRInstr::copy, {argumentName, copyOf(instr, parameters.at(0))}, symbolTable);
+				break;
+			}
+
+			case IRInstr::ret:
+			{
+				// A void call has no result
+				if (resultType == TYPE_VOID)
+				{
+					break;
+				}
+
+				if (findVariable(instr->getSymbolTable(), parameters.at(0)) != nullptr)
+				{
+					copy = new IRInstr(site.bb, IRInstr::copy, {copyOf(instr, parameters.at(0)), resultName}, symbolTable);
+				}
+				else
+				{
+					copy = new IRInstr(site.bb, IRInstr::ldconst, {typeName(resultType), parameters.at(0).substr(1), resultName}, symbolTable);
+				}
+
+				break;
+			}
+
+			default:
+			{
+				for (string& parameter : parameters)
+				{
+					parameter = copyOf(instr, parameter);
+				}
+
+				copy = new IRInstr(site.bb, instr->getOp(), parameters, symbolTable);
+				break;
+			}
+		}
+
+		if (copy != nullptr)
+		{
+			copy->setLine(line);
+			body.push_back(copy);
+		}
+	}
+
+	// Replace the wparam instructions and the call by the body
+	list<IRInstr*> instructions = site.bb->getInstructionList();
+	list<IRInstr*>::iterator position = find(instructions.begin(), instructions.end(), site.call);
+	instructions.splice(position, body);
+
+	for (IRInstr * argument : site.arguments)
+	{
+		instructions.remove(argument);
+		delete argument;
+	}
+
+	instructions.remove(site.call);
+	delete site.call;
+
+	site.bb->setInstructionList(instructions);
+}
+
+// Variable named in a symbol table (nullptr if the name is not a variable)
+varStruct * WholeProgram::findVariable(SymbolTable * symbolTable, string name)
+{
+	if (name.empty() || (symbolTable->hasVariable(name) == 0 && symbolTable->hasParameter(name) == 0))
+	{
+		return nullptr;
+	}
+
+	return symbolTable->getVariable(name);
+}
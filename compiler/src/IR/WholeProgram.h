@@ -0,0 +1,89 @@
+/*************************************************************************
+                          PLD Compilateur: WholeProgram
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <WholeProgram> (file WholeProgram.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include "CFG.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Structure to represent a call site: the call and the instructions writing its arguments
+struct callInstrStruct
+{
+	BasicBlock * bb;				// Block holding the call
+	IRInstr * call;					// Call instruction
+	vector<IRInstr*> arguments;		// wparam instruction of every argument, by index (nullptr if not found)
+	bool complete;					// Whether the wparam of every argument was found
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <WholeProgram> :
+//
+// The WholeProgram optimizes the CFG of a whole program (ifcc
+// --whole-program): every caller of every function is known, whatever
+// its source file. It inlines the small functions without branches nor
+// calls at their call sites, removes the functions that main cannot reach
+// (so that the unused helpers of a library cost nothing), and replaces
+// a parameter by a constant when every call passes this constant.
+//
+//------------------------------------------------------------------------
+
+class WholeProgram
+{
+	public:
+
+		// Constructor
+		WholeProgram(CFG * cfg, SymbolTable * globalSymbolTable);
+
+		// Run the whole program optimizations
+		void optimize();
+
+	protected:
+
+		// Inline the calls to the small functions
+		void inlineCalls();
+
+		// Remove the functions unreachable from main
+		void removeUnreachableFunctions();
+
+		// Replace the parameters receiving the same constant from every call
+		void propagateConstants();
+
+		// Find the calls of the program and the wparam instructions of their arguments
+		vector<callInstrStruct> findCallSites();
+
+		// Blocks of every function, in the order of the CFG
+		map<string, vector<BasicBlock*>> functionBlocks();
+
+		// Whether a function can be inlined (a single block, no call, few instructions)
+		bool isInlinable(string name, vector<BasicBlock*>& blocks);
+
+		// Replace a call site by a copy of the body of the callee (its variables are added to the frame of the caller)
+		void inlineCall(callInstrStruct& site, BasicBlock * callee, SymbolTable * frame);
+
+		// Variable named in a symbol table (nullptr if the name is not a variable)
+		static varStruct * findVariable(SymbolTable * symbolTable, string name);
+
+		CFG * cfg;								// CFG of the whole program
+		SymbolTable * globalSymbolTable;		// Functions of the whole program
+		vector<unique_ptr<SymbolTable>> inlineSymbolTables;	// Variables of the inlined bodies
+		int inlinedCalls = 0;					// Number of inlined calls (names the copied variables)
+
+		// Maximum number of instructions of an inlined body
+		static const int INLINE_MAX_INSTRUCTIONS = 24;
+};
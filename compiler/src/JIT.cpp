@@ -0,0 +1,887 @@
+/*************************************************************************
+                          PLD Compilateur: JIT
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <JIT> (file JIT.cpp) -----/
+
+#include "JIT.h"
+
+#include <sstream>
+#include <unordered_set>
+#include <cstring>
+#include <climits>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Static initialization of the registers: name -> (number, size in bytes)
+unordered_map<string, pair<int, int>> JIT::registers = {
+	{"rax", {0, 8}}, {"rcx", {1, 8}}, {"rdx", {2, 8}}, {"rbx", {3, 8}}, {"rsp", {4, 8}}, {"rbp", {5, 8}}, {"rsi", {6, 8}}, {"rdi", {7, 8}},
+	{"r8", {8, 8}}, {"r9", {9, 8}}, {"r10", {10, 8}}, {"r11", {11, 8}}, {"r12", {12, 8}}, {"r13", {13, 8}}, {"r14", {14, 8}}, {"r15", {15, 8}},
+	{"eax", {0, 4}}, {"ecx", {1, 4}}, {"edx", {2, 4}}, {"ebx", {3, 4}}, {"esp", {4, 4}}, {"ebp", {5, 4}}, {"esi", {6, 4}}, {"edi", {7, 4}},
+	{"r8d", {8, 4}}, {"r9d", {9, 4}}, {"r10d", {10, 4}}, {"r11d", {11, 4}}, {"r12d", {12, 4}}, {"r13d", {13, 4}}, {"r14d", {14, 4}}, {"r15d", {15, 4}},
+	{"ax", {0, 2}}, {"cx", {1, 2}}, {"dx", {2, 2}}, {"bx", {3, 2}}, {"sp", {4, 2}}, {"bp", {5, 2}}, {"si", {6, 2}}, {"di", {7, 2}},
+	{"r8w", {8, 2}}, {"r9w", {9, 2}}, {"r10w", {10, 2}}, {"r11w", {11, 2}}, {"r12w", {12, 2}}, {"r13w", {13, 2}}, {"r14w", {14, 2}}, {"r15w", {15, 2}},
+	{"al", {0, 1}}, {"cl", {1, 1}}, {"dl", {2, 1}}, {"bl", {3, 1}}, {"spl", {4, 1}}, {"bpl", {5, 1}}, {"sil", {6, 1}}, {"dil", {7, 1}},
+	{"r8b", {8, 1}}, {"r9b", {9, 1}}, {"r10b", {10, 1}}, {"r11b", {11, 1}}, {"r12b", {12, 1}}, {"r13b", {13, 1}}, {"r14b", {14, 1}}, {"r15b", {15, 1}}
+};
+
+// Static initialization of the condition codes used by jcc, setcc and cmovcc
+unordered_map<string, int> JIT::conditionCodes = {
+	{"o", 0x0}, {"no", 0x1}, {"b", 0x2}, {"c", 0x2}, {"nae", 0x2}, {"ae", 0x3}, {"nb", 0x3}, {"nc", 0x3},
+	{"e", 0x4}, {"z", 0x4}, {"ne", 0x5}, {"nz", 0x5}, {"be", 0x6}, {"na", 0x6}, {"a", 0x7}, {"nbe", 0x7},
+	{"s", 0x8}, {"ns", 0x9}, {"p", 0xA}, {"pe", 0xA}, {"np", 0xB}, {"po", 0xB},
+	{"l", 0xC}, {"nge", 0xC}, {"ge", 0xD}, {"nl", 0xD}, {"le", 0xE}, {"ng", 0xE}, {"g", 0xF}, {"nle", 0xF}
+};
+
+// Opcode extensions of the arithmetic group (add, or, ..., cmp)
+static unordered_map<string, int> arithmeticOperations = {
+	{"add", 0}, {"or", 1}, {"adc", 2}, {"sbb", 3}, {"and", 4}, {"sub", 5}, {"xor", 6}, {"cmp", 7}
+};
+
+// Opcode extensions of the unary group (F6/F7)
+static unordered_map<string, int> unaryOperations = {
+	{"not", 2}, {"neg", 3}, {"mul", 4}, {"div", 6}, {"idiv", 7}
+};
+
+// Opcode extensions of the shift group
+static unordered_map<string, int> shiftOperations = {
+	{"rol", 0}, {"ror", 1}, {"shl", 4}, {"sal", 4}, {"shr", 5}, {"sar", 7}
+};
+
+// Mnemonics taking a size suffix (b, w, l, q)
+static unordered_set<string> sizedMnemonics = {
+	"add", "or", "adc", "sbb", "and", "sub", "xor", "cmp", "mov", "lea", "imul", "not", "neg", "mul", "div", "idiv",
+	"rol", "ror", "shl", "sal", "shr", "sar", "test", "push", "pop", "inc", "dec"
+};
+
+// Size in bytes associated with an AT&T size suffix
+static int suffixSize(char suffix)
+{
+	switch (suffix)
+	{
+		case 'b': return 1;
+		case 'w': return 2;
+		case 'l': return 4;
+		case 'q': return 8;
+	}
+
+	return 0;
+}
+
+// Remove the blanks at both ends of a string
+static string trim(string s)
+{
+	size_t begin = s.find_first_not_of(" \t\r\n");
+
+	if (begin == string::npos)
+	{
+		return "";
+	}
+
+	size_t end = s.find_last_not_of(" \t\r\n");
+	return s.substr(begin, end - begin + 1);
+}
+
+// Parse an integer written in decimal or hexadecimal
+static bool parseInteger(string text, long long& value)
+{
+	if (text.empty())
+	{
+		return false;
+	}
+
+	try
+	{
+		size_t end;
+		value = stoll(text, &end, 0);
+		return end == text.size();
+	}
+	catch (exception& e)
+	{
+		return false;
+	}
+}
+
+// Constructor
+JIT::JIT()
+{
+}
+
+// Destructor
+JIT::~JIT()
+{
+}
+
+// Signal an encoding error
+bool JIT::fail(string message)
+{
+	cerr << "error: jit: line " << lineNumber << " : " << message << endl;
+	return false;
+}
+
+// Encode the assembly text into machine code
+bool JIT::assemble(string assembly)
+{
+	istringstream in(assembly);
+	string line;
+
+	while (getline(in, line))
+	{
+		lineNumber++;
+
+		if (!assembleLine(line))
+		{
+			return false;
+		}
+	}
+
+	// Entry stub: like the C runtime, it does not rely on the callee-saved
+	// registers being preserved by main, so the host frame stays intact
+	static const vector<string> entryStub = {
+		".text", ".jit_entry:",
+		"pushq %rbp", "pushq %rbx", "pushq %r12", "pushq %r13", "pushq %r14", "pushq %r15", "subq $8, %rsp",
+		"call main",
+		"addq $8, %rsp", "popq %r15", "popq %r14", "popq %r13", "popq %r12", "popq %rbx", "popq %rbp", "ret"
+	};
+
+	for (const string& stubLine : entryStub)
+	{
+		if (!assembleLine(stubLine))
+		{
+			return false;
+		}
+	}
+
+	return resolveFixups();
+}
+
+// Encode one line of assembly (label, directive or instruction)
+bool JIT::assembleLine(string line)
+{
+	// Remove the comment
+	size_t comment = line.find('#');
+
+	if (comment != string::npos)
+	{
+		line = line.substr(0, comment);
+	}
+
+	line = trim(line);
+
+	// Label definitions
+	size_t colon = line.find(':');
+
+	while (colon != string::npos && line.find_first_of(" \t,\"") > colon)
+	{
+		string label = line.substr(0, colon);
+
+		if (labels.count(label))
+		{
+			return fail("label '" + label + "' is already defined");
+		}
+
+		labels[label] = code.size();
+		line = trim(line.substr(colon + 1));
+		colon = line.find(':');
+	}
+
+	if (line.empty())
+	{
+		return true;
+	}
+
+	// Split the mnemonic from the operands
+	size_t separator = line.find_first_of(" \t");
+	string mnemonic = line.substr(0, separator);
+	string rest = separator == string::npos ? "" : trim(line.substr(separator));
+
+	// Directives: only the section and the alignment matter for the code
+	if (mnemonic[0] == '.')
+	{
+		if (mnemonic == ".text")
+		{
+			inTextSection = true;
+		}
+		else if (mnemonic == ".section")
+		{
+			inTextSection = rest.compare(0, 5, ".text") == 0;
+		}
+		else if (inTextSection && (mnemonic == ".p2align" || mnemonic == ".align" || mnemonic == ".balign"))
+		{
+			long long alignment;
+
+			if (!parseInteger(trim(rest.substr(0, rest.find(','))), alignment))
+			{
+				return fail("bad alignment '" + rest + "'");
+			}
+
+			if (mnemonic == ".p2align")
+			{
+				alignment = 1LL << alignment;
+			}
+
+			while (alignment > 0 && code.size() % alignment != 0)
+			{
+				code.push_back(0x90);
+			}
+		}
+
+		return true;
+	}
+
+	if (!inTextSection)
+	{
+		return fail("instruction outside of the .text section");
+	}
+
+	// Split the operands on the commas which are not inside parentheses
+	vector<operandStruct> operands;
+	int depth = 0;
+	string current;
+
+	for (char c : rest)
+	{
+		if (c == '(')
+		{
+			depth++;
+		}
+		else if (c == ')')
+		{
+			depth--;
+		}
+
+		if (c == ',' && depth == 0)
+		{
+			operandStruct operand;
+
+			if (!parseOperand(trim(current), operand))
+			{
+				return false;
+			}
+
+			operands.push_back(operand);
+			current = "";
+		}
+		else
+		{
+			current += c;
+		}
+	}
+
+	if (!trim(current).empty())
+	{
+		operandStruct operand;
+
+		if (!parseOperand(trim(current), operand))
+		{
+			return false;
+		}
+
+		operands.push_back(operand);
+	}
+
+	return encodeInstruction(mnemonic, operands);
+}
+
+// Parse the text of an operand
+bool JIT::parseOperand(string text, operandStruct& operand)
+{
+	operand = {LABEL, -1, 0, 0, -1, -1, 1, ""};
+
+	if (text[0] == '%') // Register
+	{
+		auto it = registers.find(text.substr(1));
+
+		if (it == registers.end())
+		{
+			return fail("unknown register '" + text + "'");
+		}
+
+		operand.kind = REGISTER;
+		operand.reg = it->second.first;
+		operand.size = it->second.second;
+		return true;
+	}
+
+	if (text[0] == '$') // Immediate
+	{
+		operand.kind = IMMEDIATE;
+
+		if (!parseInteger(trim(text.substr(1)), operand.value))
+		{
+			return fail("unsupported immediate '" + text + "'");
+		}
+
+		return true;
+	}
+
+	size_t parenthesis = text.find('(');
+
+	if (parenthesis != string::npos) // Memory: displacement(base, index, scale)
+	{
+		operand.kind = MEMORY;
+		string displacement = trim(text.substr(0, parenthesis));
+
+		if (!displacement.empty() && !parseInteger(displacement, operand.value))
+		{
+			return fail("unsupported displacement '" + displacement + "'");
+		}
+
+		size_t closing = text.find(')', parenthesis);
+
+		if (closing == string::npos)
+		{
+			return fail("bad memory operand '" + text + "'");
+		}
+
+		vector<string> parts;
+		stringstream inside(text.substr(parenthesis + 1, closing - parenthesis - 1));
+		string part;
+
+		while (getline(inside, part, ','))
+		{
+			parts.push_back(trim(part));
+		}
+
+		for (size_t i = 0; i < parts.size() && i < 2; i++)
+		{
+			if (parts[i].empty())
+			{
+				continue;
+			}
+
+			auto it = registers.find(parts[i].substr(1));
+
+			if (parts[i][0] != '%' || it == registers.end() || it->second.second != 8)
+			{
+				return fail("bad address register '" + parts[i] + "'");
+			}
+
+			(i == 0 ? operand.base : operand.index) = it->second.first;
+		}
+
+		if (parts.size() > 2)
+		{
+			long long scale;
+
+			if (!parseInteger(parts[2], scale) || (scale != 1 && scale != 2 && scale != 4 && scale != 8))
+			{
+				return fail("bad scale '" + parts[2] + "'");
+			}
+
+			operand.scale = scale;
+		}
+
+		if (operand.base < 0 || operand.index == 4)
+		{
+			return fail("unsupported memory operand '" + text + "'");
+		}
+
+		return true;
+	}
+
+	// Label (branch and call targets)
+	operand.label = text;
+	return true;
+}
+
+// Emit an immediate value on size bytes
+void JIT::emitImmediate(long long value, int size)
+{
+	for (int i = 0; i < size; i++)
+	{
+		code.push_back((value >> (8 * i)) & 0xFF);
+	}
+}
+
+// Emit the prefixes, opcode and ModRM/SIB/displacement bytes of an instruction
+void JIT::encodeModRM(vector<unsigned char> opcode, int regField, int regFieldSize, operandStruct& rm, int operandSize)
+{
+	// REX prefix: W for 64 bits operations, R/X/B for the extended registers
+	int rex = (operandSize == 8) ? 0x8 : 0;
+	rex |= (regField & 8) ? 0x4 : 0;
+
+	if (rm.kind == MEMORY)
+	{
+		rex |= (rm.base & 8) ? 0x1 : 0;
+		rex |= (rm.index >= 0 && (rm.index & 8)) ? 0x2 : 0;
+	}
+	else
+	{
+		rex |= (rm.reg & 8) ? 0x1 : 0;
+	}
+
+	// %spl, %bpl, %sil and %dil are only reachable with a REX prefix
+	bool needsRex = (regFieldSize == 1 && regField >= 4 && regField <= 7) || (rm.kind == REGISTER && rm.size == 1 && rm.reg >= 4 && rm.reg <= 7);
+
+	if (operandSize == 2)
+	{
+		code.push_back(0x66);
+	}
+
+	if (rex != 0 || needsRex)
+	{
+		code.push_back(0x40 | rex);
+	}
+
+	code.insert(code.end(), opcode.begin(), opcode.end());
+
+	// Register operand
+	if (rm.kind == REGISTER)
+	{
+		code.push_back(0xC0 | ((regField & 7) << 3) | (rm.reg & 7));
+		return;
+	}
+
+	// Memory operand
+	bool needsSIB = rm.index >= 0 || (rm.base & 7) == 4;
+	int mod;
+
+	if (rm.value == 0 && (rm.base & 7) != 5)
+	{
+		mod = 0;
+	}
+	else if (rm.value >= -128 && rm.value <= 127)
+	{
+		mod = 1;
+	}
+	else
+	{
+		mod = 2;
+	}
+
+	code.push_back((mod << 6) | ((regField & 7) << 3) | (needsSIB ? 4 : (rm.base & 7)));
+
+	if (needsSIB)
+	{
+		int scaleBits = (rm.scale == 8) ? 3 : (rm.scale == 4) ? 2 : (rm.scale == 2) ? 1 : 0;
+		int index = rm.index >= 0 ? (rm.index & 7) : 4;
+		code.push_back((scaleBits << 6) | (index << 3) | (rm.base & 7));
+	}
+
+	if (mod == 1)
+	{
+		emitImmediate(rm.value, 1);
+	}
+	else if (mod == 2)
+	{
+		emitImmediate(rm.value, 4);
+	}
+}
+
+// Emit a branch to a label with a 32 bits displacement resolved later
+void JIT::emitBranch(vector<unsigned char> opcode, string label)
+{
+	code.insert(code.end(), opcode.begin(), opcode.end());
+	fixups.push_back({code.size(), label});
+	emitImmediate(0, 4);
+}
+
+// Encode an instruction given its mnemonic and its operands (AT&T order)
+bool JIT::encodeInstruction(string mnemonic, vector<operandStruct>& operands)
+{
+	int nbOperands = operands.size();
+
+	// Instructions without operands
+	static unordered_map<string, vector<unsigned char>> simpleInstructions = {
+		{"ret", {0xC3}}, {"retq", {0xC3}}, {"leave", {0xC9}}, {"leaveq", {0xC9}}, {"syscall", {0x0F, 0x05}}, {"nop", {0x90}},
+		{"cltd", {0x99}}, {"cdq", {0x99}}, {"cqto", {0x48, 0x99}}, {"cqo", {0x48, 0x99}}, {"cltq", {0x48, 0x98}}, {"cdqe", {0x48, 0x98}}
+	};
+
+	if (simpleInstructions.count(mnemonic) && nbOperands == 0)
+	{
+		vector<unsigned char>& bytes = simpleInstructions[mnemonic];
+		code.insert(code.end(), bytes.begin(), bytes.end());
+		return true;
+	}
+
+	// Branches and calls
+	if ((mnemonic == "jmp" || mnemonic == "call" || mnemonic == "callq") && nbOperands == 1 && operands[0].kind == LABEL)
+	{
+		emitBranch({(unsigned char) (mnemonic == "jmp" ? 0xE9 : 0xE8)}, operands[0].label);
+		return true;
+	}
+
+	if (mnemonic[0] == 'j' && conditionCodes.count(mnemonic.substr(1)) && nbOperands == 1 && operands[0].kind == LABEL)
+	{
+		emitBranch({0x0F, (unsigned char) (0x80 + conditionCodes[mnemonic.substr(1)])}, operands[0].label);
+		return true;
+	}
+
+	// setcc r/m8
+	if (mnemonic.compare(0, 3, "set") == 0 && conditionCodes.count(mnemonic.substr(3)) && nbOperands == 1)
+	{
+		encodeModRM({0x0F, (unsigned char) (0x90 + conditionCodes[mnemonic.substr(3)])}, 0, 0, operands[0], 1);
+		return true;
+	}
+
+	// Zero and sign extensions: movzbl, movsbl, movzwl, movslq...
+	if ((mnemonic.compare(0, 4, "movz") == 0 || mnemonic.compare(0, 4, "movs") == 0) && mnemonic.size() == 6 && nbOperands == 2 && operands[1].kind == REGISTER)
+	{
+		bool isSigned = mnemonic[3] == 's';
+		int sourceSize = suffixSize(mnemonic[4]);
+		int destinationSize = suffixSize(mnemonic[5]);
+		vector<unsigned char> opcode;
+
+		if (sourceSize == 1)
+		{
+			opcode = {0x0F, (unsigned char) (isSigned ? 0xBE : 0xB6)};
+		}
+		else if (sourceSize == 2)
+		{
+			opcode = {0x0F, (unsigned char) (isSigned ? 0xBF : 0xB7)};
+		}
+		else if (sourceSize == 4 && isSigned && destinationSize == 8)
+		{
+			opcode = {0x63};
+		}
+		else
+		{
+			return fail("unsupported instruction '" + mnemonic + "'");
+		}
+
+		encodeModRM(opcode, operands[1].reg, destinationSize, operands[0], destinationSize);
+		return true;
+	}
+
+	// cmovcc r/m, reg
+	if (mnemonic.compare(0, 4, "cmov") == 0 && nbOperands == 2 && operands[1].kind == REGISTER)
+	{
+		string condition = mnemonic.substr(4);
+
+		if (!conditionCodes.count(condition) && condition.size() > 1 && suffixSize(condition.back()))
+		{
+			condition.pop_back();
+		}
+
+		if (conditionCodes.count(condition))
+		{
+			encodeModRM({0x0F, (unsigned char) (0x40 + conditionCodes[condition])}, operands[1].reg, operands[1].size, operands[0], operands[1].size);
+			return true;
+		}
+	}
+
+	// Split the size suffix from the mnemonic
+	string base = mnemonic;
+	int size = 0;
+
+	if (!sizedMnemonics.count(base) && base.size() > 1 && suffixSize(base.back()) && sizedMnemonics.count(base.substr(0, base.size() - 1)))
+	{
+		size = suffixSize(base.back());
+		base.pop_back();
+	}
+
+	if (!sizedMnemonics.count(base))
+	{
+		return fail("unsupported instruction '" + mnemonic + "'");
+	}
+
+	// Without suffix, the size is the one of the register operands
+	if (size == 0)
+	{
+		for (operandStruct& operand : operands)
+		{
+			if (operand.kind == REGISTER)
+			{
+				size = operand.size;
+			}
+		}
+	}
+
+	if (base == "push" || base == "pop")
+	{
+		bool push = base == "push";
+
+		if (nbOperands != 1)
+		{
+			return fail("bad operands for '" + mnemonic + "'");
+		}
+
+		if (operands[0].kind == REGISTER)
+		{
+			if (operands[0].reg & 8)
+			{
+				code.push_back(0x41);
+			}
+
+			code.push_back((push ? 0x50 : 0x58) + (operands[0].reg & 7));
+		}
+		else if (operands[0].kind == MEMORY)
+		{
+			encodeModRM({(unsigned char) (push ? 0xFF : 0x8F)}, push ? 6 : 0, 0, operands[0], 4);
+		}
+		else if (operands[0].kind == IMMEDIATE && push)
+		{
+			code.push_back(0x68);
+			emitImmediate(operands[0].value, 4);
+		}
+		else
+		{
+			return fail("bad operands for '" + mnemonic + "'");
+		}
+
+		return true;
+	}
+
+	if (size == 0)
+	{
+		return fail("operand size of '" + mnemonic + "' is unknown");
+	}
+
+	int wide = (size == 1) ? 0 : 1;
+
+	// add, or, adc, sbb, and, sub, xor, cmp
+	if (arithmeticOperations.count(base) && nbOperands == 2)
+	{
+		int extension = arithmeticOperations[base];
+		operandStruct& source = operands[0];
+		operandStruct& destination = operands[1];
+
+		if (source.kind == IMMEDIATE)
+		{
+			if (size == 1)
+			{
+				encodeModRM({0x80}, extension, 0, destination, size);
+				emitImmediate(source.value, 1);
+			}
+			else if (source.value >= -128 && source.value <= 127)
+			{
+				encodeModRM({0x83}, extension, 0, destination, size);
+				emitImmediate(source.value, 1);
+			}
+			else
+			{
+				encodeModRM({0x81}, extension, 0, destination, size);
+				emitImmediate(source.value, size == 2 ? 2 : 4);
+			}
+		}
+		else if (source.kind == REGISTER)
+		{
+			encodeModRM({(unsigned char) ((extension << 3) + wide)}, source.reg, source.size, destination, size);
+		}
+		else if (source.kind == MEMORY && destination.kind == REGISTER)
+		{
+			encodeModRM({(unsigned char) ((extension << 3) + 2 + wide)}, destination.reg, destination.size, source, size);
+		}
+		else
+		{
+			return fail("bad operands for '" + mnemonic + "'");
+		}
+
+		return true;
+	}
+
+	if (base == "mov" && nbOperands == 2)
+	{
+		operandStruct& source = operands[0];
+		operandStruct& destination = operands[1];
+
+		if (source.kind == IMMEDIATE)
+		{
+			if (size == 8 && destination.kind == REGISTER && (source.value > INT_MAX || source.value < INT_MIN))
+			{
+				// movabs: 64 bits immediate
+				code.push_back(0x48 | ((destination.reg & 8) ? 0x1 : 0));
+				code.push_back(0xB8 + (destination.reg & 7));
+				emitImmediate(source.value, 8);
+			}
+			else
+			{
+				encodeModRM({(unsigned char) (0xC6 + wide)}, 0, 0, destination, size);
+				emitImmediate(source.value, size == 1 ? 1 : size == 2 ? 2 : 4);
+			}
+		}
+		else if (source.kind == REGISTER)
+		{
+			encodeModRM({(unsigned char) (0x88 + wide)}, source.reg, source.size, destination, size);
+		}
+		else if (source.kind == MEMORY && destination.kind == REGISTER)
+		{
+			encodeModRM({(unsigned char) (0x8A + wide)}, destination.reg, destination.size, source, size);
+		}
+		else
+		{
+			return fail("bad operands for '" + mnemonic + "'");
+		}
+
+		return true;
+	}
+
+	if (base == "lea" && nbOperands == 2 && operands[0].kind == MEMORY && operands[1].kind == REGISTER)
+	{
+		encodeModRM({0x8D}, operands[1].reg, operands[1].size, operands[0], size);
+		return true;
+	}
+
+	if (base == "test" && nbOperands == 2)
+	{
+		if (operands[0].kind == IMMEDIATE)
+		{
+			encodeModRM({(unsigned char) (0xF6 + wide)}, 0, 0, operands[1], size);
+			emitImmediate(operands[0].value, size == 1 ? 1 : size == 2 ? 2 : 4);
+		}
+		else if (operands[0].kind == REGISTER)
+		{
+			encodeModRM({(unsigned char) (0x84 + wide)}, operands[0].reg, operands[0].size, operands[1], size);
+		}
+		else
+		{
+			return fail("bad operands for '" + mnemonic + "'");
+		}
+
+		return true;
+	}
+
+	if (base == "imul" && nbOperands >= 2)
+	{
+		operandStruct& destination = operands[nbOperands - 1];
+
+		if (destination.kind != REGISTER)
+		{
+			return fail("bad operands for '" + mnemonic + "'");
+		}
+
+		if (operands[0].kind == IMMEDIATE)
+		{
+			// imul $imm, src, dst (with two operands, src is dst)
+			operandStruct& source = operands[1];
+			bool small = operands[0].value >= -128 && operands[0].value <= 127;
+			encodeModRM({(unsigned char) (small ? 0x6B : 0x69)}, destination.reg, destination.size, source, size);
+			emitImmediate(operands[0].value, small ? 1 : 4);
+		}
+		else
+		{
+			encodeModRM({0x0F, 0xAF}, destination.reg, destination.size, operands[0], size);
+		}
+
+		return true;
+	}
+
+	if ((unaryOperations.count(base) || base == "imul") && nbOperands == 1)
+	{
+		int extension = base == "imul" ? 5 : unaryOperations[base];
+		encodeModRM({(unsigned char) (0xF6 + wide)}, extension, 0, operands[0], size);
+		return true;
+	}
+
+	if ((base == "inc" || base == "dec") && nbOperands == 1)
+	{
+		encodeModRM({(unsigned char) (0xFE + wide)}, base == "inc" ? 0 : 1, 0, operands[0], size);
+		return true;
+	}
+
+	if (shiftOperations.count(base) && (nbOperands == 1 || nbOperands == 2))
+	{
+		int extension = shiftOperations[base];
+		operandStruct& destination = operands[nbOperands - 1];
+
+		if (nbOperands == 1 || (operands[0].kind == IMMEDIATE && operands[0].value == 1))
+		{
+			encodeModRM({(unsigned char) (0xD0 + wide)}, extension, 0, destination, size);
+		}
+		else if (operands[0].kind == IMMEDIATE)
+		{
+			encodeModRM({(unsigned char) (0xC0 + wide)}, extension, 0, destination, size);
+			emitImmediate(operands[0].value, 1);
+		}
+		else if (operands[0].kind == REGISTER && operands[0].reg == 1 && operands[0].size == 1)
+		{
+			encodeModRM({(unsigned char) (0xD2 + wide)}, extension, 0, destination, size);
+		}
+		else
+		{
+			return fail("bad operands for '" + mnemonic + "'");
+		}
+
+		return true;
+	}
+
+	return fail("unsupported instruction '" + mnemonic + "'");
+}
+
+// Patch the displacements of all the branches
+bool JIT::resolveFixups()
+{
+	for (pair<size_t, string>& fixup : fixups)
+	{
+		auto it = labels.find(fixup.second);
+
+		if (it == labels.end())
+		{
+			cerr << "error: jit: undefined reference to '" << fixup.second << "'" << endl;
+			return false;
+		}
+
+		long long displacement = (long long) it->second - (long long) (fixup.first + 4);
+
+		for (int i = 0; i < 4; i++)
+		{
+			code[fixup.first + i] = (displacement >> (8 * i)) & 0xFF;
+		}
+	}
+
+	return true;
+}
+
+// Map the machine code into executable memory and call main with the arguments
+int JIT::run(vector<string> arguments)
+{
+	if (!labels.count("main"))
+	{
+		cerr << "error: jit: undefined reference to 'main'" << endl;
+		return 1;
+	}
+
+	// Round the code size up to whole pages
+	size_t pageSize = sysconf(_SC_PAGESIZE);
+	size_t memorySize = ((code.size() + pageSize - 1) / pageSize) * pageSize;
+
+	if (memorySize == 0)
+	{
+		memorySize = pageSize;
+	}
+
+	// Write the code while the pages are writable...
+	void * memory = mmap(nullptr, memorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (memory == MAP_FAILED)
+	{
+		cerr << "error: jit: cannot allocate memory for the code" << endl;
+		return 1;
+	}
+
+	memcpy(memory, code.data(), code.size());
+
+	// ...then make them executable but no longer writable (W^X)
+	if (mprotect(memory, memorySize, PROT_READ | PROT_EXEC) != 0)
+	{
+		cerr << "error: jit: cannot make the code executable" << endl;
+		munmap(memory, memorySize);
+		return 1;
+	}
+
+	// Build argc/argv for the program
+	vector<char *> argv;
+
+	for (string& argument : arguments)
+	{
+		argv.push_back(&argument[0]);
+	}
+
+	argv.push_back(nullptr);
+
+	// Call main directly (through the entry stub, argc and argv are left in %edi and %rsi)
+	typedef int (*mainFunction)(int, char **);
+	mainFunction entry = (mainFunction) ((unsigned char *) memory + labels[".jit_entry"]);
+	int status = entry(arguments.size(), argv.data());
+
+	munmap(memory, memorySize);
+
+	return status;
+}
@@ -0,0 +1,103 @@
+/*************************************************************************
+                          PLD Compilateur: JIT
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <JIT> (file JIT.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Kinds of operands of an x86-64 instruction
+enum operandKind {REGISTER, IMMEDIATE, MEMORY, LABEL};
+
+// Structure to represent an operand of an AT&T assembly instruction
+struct operandStruct
+{
+	operandKind kind;		// Kind of the operand
+	int reg;				// Register number (REGISTER)
+	int size;				// Size in bytes of the register (REGISTER)
+	long long value;		// Immediate value (IMMEDIATE) or displacement (MEMORY)
+	int base;				// Base register number, -1 if none (MEMORY)
+	int index;				// Index register number, -1 if none (MEMORY)
+	int scale;				// Scale applied to the index register (MEMORY)
+	string label;			// Referenced label (LABEL)
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <JIT> :
+//
+// The JIT encodes the x86-64 assembly generated by the CFG into machine
+// code, maps it into executable memory (never writable and executable
+// at the same time) and calls main directly, without going through the
+// assembler, the linker and a new process.
+//
+//------------------------------------------------------------------------
+
+class JIT
+{
+	public:
+
+		// Constructor
+		JIT();
+
+		// Destructor
+		~JIT();
+
+		// Encode the assembly text into machine code
+		bool assemble(string assembly);
+
+		// Map the machine code into executable memory and call main with the arguments
+		int run(vector<string> arguments);
+
+	protected:
+
+		// Encode one line of assembly (label, directive or instruction)
+		bool assembleLine(string line);
+
+		// Parse the text of an operand
+		bool parseOperand(string text, operandStruct& operand);
+
+		// Encode an instruction given its mnemonic and its operands (AT&T order)
+		bool encodeInstruction(string mnemonic, vector<operandStruct>& operands);
+
+		// Emit the prefixes, opcode and ModRM/SIB/displacement bytes of an instruction
+		void encodeModRM(vector<unsigned char> opcode, int regField, int regFieldSize, operandStruct& rm, int operandSize);
+
+		// Emit an immediate value on size bytes
+		void emitImmediate(long long value, int size);
+
+		// Emit a branch to a label with a 32 bits displacement resolved later
+		void emitBranch(vector<unsigned char> opcode, string label);
+
+		// Patch the displacements of all the branches
+		bool resolveFixups();
+
+		// Signal an encoding error
+		bool fail(string message);
+
+		vector<unsigned char> code;						// Encoded machine code
+		unordered_map<string, size_t> labels;			// Offset of every label in the code
+		vector<pair<size_t, string>> fixups;			// Branch displacements to patch (offset, label)
+		bool inTextSection = true;						// Whether the current section is .text
+		int lineNumber = 0;								// Current line of the assembly text
+
+		// Mapping of register names to their number and size
+		static unordered_map<string, pair<int, int>> registers;
+
+		// Mapping of condition code suffixes to their encoding
+		static unordered_map<string, int> conditionCodes;
+};
@@ -0,0 +1,542 @@
+/*************************************************************************
+                          PLD Compilateur: Json
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <Json> (file Json.cpp) -----/
+
+#include "Json.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+
+using namespace std;
+
+const Json Json::null;
+
+// Constructor of null
+Json::Json()
+{
+}
+
+// Constructor of a boolean
+Json::Json(bool value) : type(JSON_BOOL), boolean(value)
+{
+}
+
+// Constructor of an integer
+Json::Json(int value) : type(JSON_NUMBER), number(value)
+{
+}
+
+// Constructor of a number
+Json::Json(double value) : type(JSON_NUMBER), number(value)
+{
+}
+
+// Constructor of a string
+Json::Json(string value) : type(JSON_STRING), text(value)
+{
+}
+
+// Constructor of a string from a literal
+Json::Json(const char * value) : type(JSON_STRING), text(value)
+{
+}
+
+// Build an empty array
+Json Json::array()
+{
+	Json value;
+	value.type = JSON_ARRAY;
+
+	return value;
+}
+
+// Build an empty object
+Json Json::object()
+{
+	Json value;
+	value.type = JSON_OBJECT;
+
+	return value;
+}
+
+// Parse a JSON text
+bool Json::parse(const string& text, Json& value)
+{
+	size_t pos = 0;
+
+	if (!parseValue(text, pos, value, 0))
+	{
+		return false;
+	}
+
+	// Nothing but blanks may follow the value
+	skipBlanks(text, pos);
+
+	return pos == text.size();
+}
+
+// Parse the value starting at pos
+bool Json::parseValue(const string& text, size_t& pos, Json& value, int depth)
+{
+	skipBlanks(text, pos);
+
+	if (pos >= text.size() || depth > MAX_DEPTH)
+	{
+		return false;
+	}
+
+	char c = text[pos];
+
+	if (c == '{')
+	{
+		value = object();
+		pos++;
+		skipBlanks(text, pos);
+
+		if (pos < text.size() && text[pos] == '}')
+		{
+			pos++;
+			return true;
+		}
+
+		while (true)
+		{
+			string key;
+			Json member;
+			skipBlanks(text, pos);
+
+			if (!parseString(text, pos, key))
+			{
+				return false;
+			}
+
+			skipBlanks(text, pos);
+
+			if (pos >= text.size() || text[pos] != ':')
+			{
+				return false;
+			}
+
+			pos++;
+
+			if (!parseValue(text, pos, member, depth + 1))
+			{
+				return false;
+			}
+
+			value.set(key, member);
+			skipBlanks(text, pos);
+
+			if (pos < text.size() && text[pos] == ',')
+			{
+				pos++;
+			}
+			else if (pos < text.size() && text[pos] == '}')
+			{
+				pos++;
+				return true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+	else if (c == '[')
+	{
+		value = array();
+		pos++;
+		skipBlanks(text, pos);
+
+		if (pos < text.size() && text[pos] == ']')
+		{
+			pos++;
+			return true;
+		}
+
+		while (true)
+		{
+			Json element;
+
+			if (!parseValue(text, pos, element, depth + 1))
+			{
+				return false;
+			}
+
+			value.push(element);
+			skipBlanks(text, pos);
+
+			if (pos < text.size() && text[pos] == ',')
+			{
+				pos++;
+			}
+			else if (pos < text.size() && text[pos] == ']')
+			{
+				pos++;
+				return true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+	}
+	else if (c == '"')
+	{
+		string s;
+
+		if (!parseString(text, pos, s))
+		{
+			return false;
+		}
+
+		value = Json(s);
+		return true;
+	}
+	else if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 5, "false") == 0)
+	{
+		value = Json(c == 't');
+		pos += c == 't' ? 4 : 5;
+		return true;
+	}
+	else if (text.compare(pos, 4, "null") == 0)
+	{
+		value = Json();
+		pos += 4;
+		return true;
+	}
+	else if (c == '-' || (c >= '0' && c <= '9'))
+	{
+		const char * start = text.c_str() + pos;
+		char * end;
+		double number = strtod(start, &end);
+
+		if (end == start)
+		{
+			return false;
+		}
+
+		value = Json(number);
+		pos += end - start;
+		return true;
+	}
+
+	return false;
+}
+
+// Parse the string literal starting at pos
+bool Json::parseString(const string& text, size_t& pos, string& value)
+{
+	if (pos >= text.size() || text[pos] != '"')
+	{
+		return false;
+	}
+
+	pos++;
+	value.clear();
+
+	while (pos < text.size() && text[pos] != '"')
+	{
+		char c = text[pos++];
+
+		if (c != '\\')
+		{
+			value += c;
+			continue;
+		}
+
+		if (pos >= text.size())
+		{
+			return false;
+		}
+
+		char escape = text[pos++];
+
+		switch (escape)
+		{
+			case 'b': value += '\b'; break;
+			case 'f': value += '\f'; break;
+			case 'n': value += '\n'; break;
+			case 'r': value += '\r'; break;
+			case 't': value += '\t'; break;
+			case 'u':
+			{
+				if (pos + 4 > text.size())
+				{
+					return false;
+				}
+
+				unsigned long codePoint = strtoul(text.substr(pos, 4).c_str(), nullptr, 16);
+				pos += 4;
+
+				// A surrogate pair encodes a code point above U+FFFF
+				if (codePoint >= 0xD800 && codePoint < 0xDC00 && text.compare(pos, 2, "\\u") == 0 && pos + 6 <= text.size())
+				{
+					unsigned long low = strtoul(text.substr(pos + 2, 4).c_str(), nullptr, 16);
+
+					if (low >= 0xDC00 && low < 0xE000)
+					{
+						codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+						pos += 6;
+					}
+				}
+
+				// Encode the code point in UTF-8
+				if (codePoint < 0x80)
+				{
+					value += (char) codePoint;
+				}
+				else if (codePoint < 0x800)
+				{
+					value += (char) (0xC0 | (codePoint >> 6));
+					value += (char) (0x80 | (codePoint & 0x3F));
+				}
+				else if (codePoint < 0x10000)
+				{
+					value += (char) (0xE0 | (codePoint >> 12));
+					value += (char) (0x80 | ((codePoint >> 6) & 0x3F));
+					value += (char) (0x80 | (codePoint & 0x3F));
+				}
+				else
+				{
+					value += (char) (0xF0 | (codePoint >> 18));
+					value += (char) (0x80 | ((codePoint >> 12) & 0x3F));
+					value += (char) (0x80 | ((codePoint >> 6) & 0x3F));
+					value += (char) (0x80 | (codePoint & 0x3F));
+				}
+
+				break;
+			}
+			default: value += escape; break; // '"', '\\' and '/'
+		}
+	}
+
+	if (pos >= text.size())
+	{
+		return false;
+	}
+
+	pos++;
+
+	return true;
+}
+
+// Skip the blanks starting at pos
+void Json::skipBlanks(const string& text, size_t& pos)
+{
+	while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+	{
+		pos++;
+	}
+}
+
+// Serialize the value to compact JSON text
+string Json::serialize() const
+{
+	string out;
+	write(out);
+
+	return out;
+}
+
+// Write the value at the end of out
+void Json::write(string& out) const
+{
+	switch (type)
+	{
+		case JSON_NULL:
+		{
+			out += "null";
+			break;
+		}
+		case JSON_BOOL:
+		{
+			out += boolean ? "true" : "false";
+			break;
+		}
+		case JSON_NUMBER:
+		{
+			char buffer[32];
+
+			// Integers are written without exponent nor decimals
+			if (number == floor(number) && fabs(number) < 1e15)
+			{
+				snprintf(buffer, sizeof(buffer), "%lld", (long long) number);
+			}
+			else
+			{
+				snprintf(buffer, sizeof(buffer), "%.17g", number);
+			}
+
+			out += buffer;
+			break;
+		}
+		case JSON_STRING:
+		{
+			writeString(out, text);
+			break;
+		}
+		case JSON_ARRAY:
+		{
+			out += '[';
+
+			for (size_t i = 0; i < elements.size(); i++)
+			{
+				if (i > 0)
+				{
+					out += ',';
+				}
+
+				elements[i].write(out);
+			}
+
+			out += ']';
+			break;
+		}
+		case JSON_OBJECT:
+		{
+			out += '{';
+
+			for (size_t i = 0; i < members.size(); i++)
+			{
+				if (i > 0)
+				{
+					out += ',';
+				}
+
+				writeString(out, members[i].first);
+				out += ':';
+				members[i].second.write(out);
+			}
+
+			out += '}';
+			break;
+		}
+	}
+}
+
+// Write a string literal at the end of out
+void Json::writeString(string& out, const string& value)
+{
+	out += '"';
+
+	for (char c : value)
+	{
+		switch (c)
+		{
+			case '"': out += "\\\""; break;
+			case '\\': out += "\\\\"; break;
+			case '\n': out += "\\n"; break;
+			case '\r': out += "\\r"; break;
+			case '\t': out += "\\t"; break;
+			default:
+			{
+				// The other control characters must be escaped
+				if ((unsigned char) c < 0x20)
+				{
+					char buffer[8];
+					snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+					out += buffer;
+				}
+				else
+				{
+					out += c;
+				}
+			}
+		}
+	}
+
+	out += '"';
+}
+
+// Getter for a boolean
+bool Json::asBool() const
+{
+	return type == JSON_BOOL ? boolean : false;
+}
+
+// Getter for a number
+double Json::asNumber() const
+{
+	return type == JSON_NUMBER ? number : 0;
+}
+
+// Getter for an integer
+int Json::asInt() const
+{
+	return type == JSON_NUMBER ? (int) number : 0;
+}
+
+// Getter for a string
+string Json::asString() const
+{
+	return type == JSON_STRING ? text : "";
+}
+
+// Number of elements of an array
+size_t Json::size() const
+{
+	return type == JSON_ARRAY ? elements.size() : 0;
+}
+
+// Element of an array
+const Json& Json::operator[](size_t index) const
+{
+	return index < size() ? elements[index] : null;
+}
+
+// Member of an object
+const Json& Json::operator[](string key) const
+{
+	for (const pair<string, Json>& member : members)
+	{
+		if (member.first == key)
+		{
+			return member.second;
+		}
+	}
+
+	return null;
+}
+
+// Check if an object has a member
+bool Json::has(string key) const
+{
+	for (const pair<string, Json>& member : members)
+	{
+		if (member.first == key)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Append an element to an array
+void Json::push(Json value)
+{
+	elements.push_back(value);
+}
+
+// Add or replace a member of an object
+void Json::set(string key, Json value)
+{
+	for (pair<string, Json>& member : members)
+	{
+		if (member.first == key)
+		{
+			member.second = value;
+			return;
+		}
+	}
+
+	members.push_back({key, value});
+}
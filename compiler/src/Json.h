@@ -0,0 +1,114 @@
+/*************************************************************************
+                          PLD Compilateur: Json
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <Json> (file Json.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <string>
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Kinds of JSON values
+enum jsonType {JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING, JSON_ARRAY, JSON_OBJECT};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <Json> :
+//
+// A Json is a JSON value (null, boolean, number, string, array or object)
+// that can be parsed from and serialized to text. It carries the messages
+// of the language server. The members of an object keep their order, and
+// a missing member reads as null, so optional fields need no special case.
+//
+//------------------------------------------------------------------------
+
+class Json
+{
+	public:
+
+		// Constructors of the scalar values
+		Json();
+		Json(bool value);
+		Json(int value);
+		Json(double value);
+		Json(string value);
+		Json(const char * value);
+
+		// Build an empty array or object
+		static Json array();
+		static Json object();
+
+		// Parse a JSON text (false if it is malformed)
+		static bool parse(const string& text, Json& value);
+
+		// Serialize the value to compact JSON text
+		string serialize() const;
+
+		// Getter for the kind of the value
+		jsonType getType() const
+		{
+			return type;
+		};
+
+		// Accessors of the scalar values (default value if the kind differs)
+		bool asBool() const;
+		double asNumber() const;
+		int asInt() const;
+		string asString() const;
+
+		// Number of elements of an array
+		size_t size() const;
+
+		// Element of an array (null if out of range)
+		const Json& operator[](size_t index) const;
+
+		// Member of an object (null if missing)
+		const Json& operator[](string key) const;
+
+		// Check if an object has a member
+		bool has(string key) const;
+
+		// Append an element to an array
+		void push(Json value);
+
+		// Add or replace a member of an object
+		void set(string key, Json value);
+
+	protected:
+
+		// Parse the value starting at pos
+		static bool parseValue(const string& text, size_t& pos, Json& value, int depth);
+
+		// Parse the string literal starting at pos
+		static bool parseString(const string& text, size_t& pos, string& value);
+
+		// Skip the blanks starting at pos
+		static void skipBlanks(const string& text, size_t& pos);
+
+		// Write a value, or a string literal, at the end of out
+		void write(string& out) const;
+		static void writeString(string& out, const string& value);
+
+		jsonType type = JSON_NULL;				// Kind of the value
+		bool boolean = false;					// Value of a boolean
+		double number = 0;						// Value of a number
+		string text;							// Value of a string
+		vector<Json> elements;					// Elements of an array
+		vector<pair<string, Json>> members;		// Members of an object, in order
+
+		// Value returned for the missing elements and members
+		static const Json null;
+
+		// Maximum nesting of the arrays and objects of a parsed text
+		static const int MAX_DEPTH = 256;
+};
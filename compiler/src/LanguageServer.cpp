@@ -0,0 +1,969 @@
+/*************************************************************************
+                          PLD Compilateur: LanguageServer
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <LanguageServer> (file LanguageServer.cpp) -----/
+
+#include "LanguageServer.h"
+
+#include <climits>
+#include <cstdlib>
+
+// Include ANTLR4 headers
+#include "antlr4-runtime.h"
+#include "../generated/ifccLexer.h"
+#include "../generated/ifccParser.h"
+
+// Include custom headers
+#include "CodeGenVisitor.h"
+#include "IR/CFG.h"
+
+using namespace antlr4;
+using namespace std;
+
+// What the splitter is reading
+enum splitMode {SPLIT_CODE, SPLIT_LINE_COMMENT, SPLIT_BLOCK_COMMENT, SPLIT_CHAR, SPLIT_STRING, SPLIT_DIRECTIVE};
+
+// Parse of a chunk (the tree belongs to the parser, which reads the tokens of the lexer)
+struct chunkParseStruct
+{
+	unique_ptr<ANTLRInputStream> input;
+	unique_ptr<ifccLexer> lexer;
+	unique_ptr<CommonTokenStream> tokens;
+	unique_ptr<ifccParser> parser;
+	ifccParser::AxiomContext * tree = nullptr;
+};
+
+// Listener keeping the syntax errors of a chunk as diagnostics
+class ChunkErrorListener : public BaseErrorListener
+{
+	public:
+
+		ChunkErrorListener(vector<chunkDiagnosticStruct>& diagnostics) : diagnostics(diagnostics)
+		{
+		}
+
+		void syntaxError(Recognizer *, Token * offendingSymbol, size_t line, size_t charPositionInLine, const string& msg, exception_ptr) override
+		{
+			// The range covers the offending token, or one character
+			int length = 1;
+
+			if (offendingSymbol != nullptr && offendingSymbol->getType() != Token::EOF)
+			{
+				length = max((int) offendingSymbol->getText().size(), 1);
+			}
+
+			diagnostics.push_back({ERROR, msg, (int) line - 1, (int) charPositionInLine, (int) charPositionInLine + length});
+		}
+
+	protected:
+
+		vector<chunkDiagnosticStruct>& diagnostics;
+};
+
+// Constructor
+LanguageServer::LanguageServer()
+{
+}
+
+// Serve the messages of in until exit
+int LanguageServer::run(istream& in, ostream& out)
+{
+	Json message;
+
+	while (readMessage(in, out, message))
+	{
+		if (message["method"].asString() == "exit")
+		{
+			return shutdownRequested ? 0 : 1;
+		}
+
+		handleMessage(message, out);
+	}
+
+	// The input was closed without exit
+	return 1;
+}
+
+// Read one message: headers, a blank line, then Content-Length bytes of JSON
+bool LanguageServer::readMessage(istream& in, ostream& out, Json& message)
+{
+	while (true)
+	{
+		string header;
+		long length = -1;
+
+		while (getline(in, header))
+		{
+			if (!header.empty() && header.back() == '\r')
+			{
+				header.pop_back();
+			}
+
+			if (header.empty())
+			{
+				break;
+			}
+
+			if (header.compare(0, 15, "Content-Length:") == 0)
+			{
+				length = atol(header.c_str() + 15);
+			}
+		}
+
+		if (!in)
+		{
+			return false;
+		}
+
+		if (length < 0)
+		{
+			continue;
+		}
+
+		string content(length, '\0');
+		in.read(&content[0], length);
+
+		if (!in)
+		{
+			return false;
+		}
+
+		if (Json::parse(content, message))
+		{
+			return true;
+		}
+
+		// Answer a malformed message with a parse error
+		Json error = Json::object();
+		error.set("code", -32700);
+		error.set("message", "Parse error");
+
+		Json response = Json::object();
+		response.set("jsonrpc", "2.0");
+		response.set("id", Json());
+		response.set("error", error);
+		writeMessage(out, response);
+	}
+}
+
+// Write one message
+void LanguageServer::writeMessage(ostream& out, Json message)
+{
+	string content = message.serialize();
+
+	out << "Content-Length: " << content.size() << "\r\n\r\n" << content;
+	out.flush();
+}
+
+// Answer a request or handle a notification
+void LanguageServer::handleMessage(Json& message, ostream& out)
+{
+	string method = message["method"].asString();
+	const Json& params = message["params"];
+	bool isRequest = message.has("id");
+
+	Json response = Json::object();
+	response.set("jsonrpc", "2.0");
+	response.set("id", message["id"]);
+
+	if (method == "initialize")
+	{
+		// The edits are sent as ranges (incremental synchronization)
+		Json synchronization = Json::object();
+		synchronization.set("openClose", true);
+		synchronization.set("change", 2);
+
+		Json capabilities = Json::object();
+		capabilities.set("textDocumentSync", synchronization);
+
+		Json serverInfo = Json::object();
+		serverInfo.set("name", "ifcc");
+
+		Json result = Json::object();
+		result.set("capabilities", capabilities);
+		result.set("serverInfo", serverInfo);
+
+		response.set("result", result);
+		writeMessage(out, response);
+	}
+	else if (method == "shutdown")
+	{
+		shutdownRequested = true;
+		response.set("result", Json());
+		writeMessage(out, response);
+	}
+	else if (method == "textDocument/didOpen")
+	{
+		string uri = params["textDocument"]["uri"].asString();
+		documentStruct& document = documents[uri];
+		document.version = params["textDocument"]["version"].asInt();
+		setText(document, params["textDocument"]["text"].asString());
+		publishDiagnostics(uri, document, out);
+	}
+	else if (method == "textDocument/didChange")
+	{
+		string uri = params["textDocument"]["uri"].asString();
+
+		if (documents.find(uri) == documents.end())
+		{
+			return;
+		}
+
+		documentStruct& document = documents[uri];
+		document.version = params["textDocument"]["version"].asInt();
+		const Json& changes = params["contentChanges"];
+
+		// The changes apply one after the other
+		for (size_t i = 0; i < changes.size(); i++)
+		{
+			const Json& change = changes[i];
+
+			if (change.has("range"))
+			{
+				const Json& start = change["range"]["start"];
+				const Json& end = change["range"]["end"];
+				applyEdit(document, start["line"].asInt(), start["character"].asInt(), end["line"].asInt(), end["character"].asInt(), change["text"].asString());
+			}
+			else
+			{
+				setText(document, change["text"].asString());
+			}
+		}
+
+		publishDiagnostics(uri, document, out);
+	}
+	else if (method == "textDocument/didClose")
+	{
+		string uri = params["textDocument"]["uri"].asString();
+		documents.erase(uri);
+
+		// Clear the diagnostics of the closed document
+		Json parameters = Json::object();
+		parameters.set("uri", uri);
+		parameters.set("diagnostics", Json::array());
+
+		Json notification = Json::object();
+		notification.set("jsonrpc", "2.0");
+		notification.set("method", "textDocument/publishDiagnostics");
+		notification.set("params", parameters);
+		writeMessage(out, notification);
+	}
+	else if (isRequest)
+	{
+		Json error = Json::object();
+		error.set("code", -32601);
+		error.set("message", "Method not found: " + method);
+
+		response.set("error", error);
+		writeMessage(out, response);
+	}
+
+	// The other notifications (initialized, didSave, ...) need no answer
+}
+
+// Replace the whole text of a document
+void LanguageServer::setText(documentStruct& document, string text)
+{
+	document.chunks.clear();
+	document.definitions.clear();
+	document.users.clear();
+	document.callers.clear();
+	document.unusedFunctions.clear();
+	applyEdit(document, 0, 0, 0, 0, text);
+}
+
+// Apply an edit of a range of lines
+void LanguageServer::applyEdit(documentStruct& document, int startLine, int startColumn, int endLine, int endColumn, string text)
+{
+	vector<shared_ptr<chunkStruct>>& chunks = document.chunks;
+
+	// Find the chunks holding the start and the end of the edit (a position is in the chunk of its line)
+	size_t first = chunks.size(), last = chunks.size();
+	int regionLine = 0, line = 0;
+
+	for (size_t i = 0; i < chunks.size(); i++)
+	{
+		bool isLast = i + 1 == chunks.size();
+
+		if (first == chunks.size() && (startLine < line + chunks[i]->lineBreaks || isLast))
+		{
+			first = i;
+			regionLine = line;
+		}
+
+		if (endLine < line + chunks[i]->lineBreaks || isLast)
+		{
+			last = i + 1;
+			break;
+		}
+
+		line += chunks[i]->lineBreaks;
+	}
+
+	if (chunks.empty())
+	{
+		first = last = 0;
+	}
+
+	// Edit the text of the damaged chunks
+	string region = "";
+
+	for (size_t i = first; i < last; i++)
+	{
+		region += chunks[i]->text;
+	}
+
+	size_t startOffset = offsetOf(region, startLine - regionLine, startColumn);
+	size_t endOffset = max(offsetOf(region, endLine - regionLine, endColumn), startOffset);
+	region.replace(startOffset, endOffset - startOffset, text);
+
+	// Split the region again, extending it while its end is not a chunk boundary (unbalanced braces)
+	splitterStruct splitter;
+	vector<size_t> ends;
+	size_t scanned = 0;
+
+	while (true)
+	{
+		splitChunks(region, scanned, splitter, ends);
+		scanned = region.size();
+
+		if ((ends.empty() ? 0 : ends.back()) == region.size() || last == chunks.size())
+		{
+			break;
+		}
+
+		region += chunks[last++]->text;
+	}
+
+	if (!region.empty() && (ends.empty() || ends.back() != region.size()))
+	{
+		ends.push_back(region.size());
+	}
+
+	// Build the new chunks, reusing those whose text did not change
+	vector<shared_ptr<chunkStruct>> replaced(chunks.begin() + first, chunks.begin() + last);
+	vector<shared_ptr<chunkStruct>> newChunks;
+	set<chunkStruct*> reused, fresh;
+	size_t searchFrom = 0, begin = 0;
+
+	for (size_t end : ends)
+	{
+		string chunkText = region.substr(begin, end - begin);
+		begin = end;
+		shared_ptr<chunkStruct> chunk = nullptr;
+
+		for (size_t k = searchFrom; k < replaced.size(); k++)
+		{
+			if (replaced[k]->text == chunkText)
+			{
+				chunk = replaced[k];
+				reused.insert(chunk.get());
+				searchFrom = k + 1;
+				break;
+			}
+		}
+
+		if (chunk == nullptr)
+		{
+			chunk = parseChunk(chunkText);
+			fresh.insert(chunk.get());
+		}
+
+		newChunks.push_back(chunk);
+	}
+
+	// Signatures that disappeared and appeared
+	map<string, multiset<string>> oldSignatures, newSignatures;
+	vector<shared_ptr<chunkStruct>> removed;
+
+	for (shared_ptr<chunkStruct>& chunk : replaced)
+	{
+		if (reused.count(chunk.get()) == 0)
+		{
+			removed.push_back(chunk);
+		}
+	}
+
+	// A function being typed keeps the signatures of the text it replaces until it parses again
+	if (fresh.size() == 1)
+	{
+		chunkStruct * chunk = *fresh.begin();
+
+		if (chunk->hasSyntaxError)
+		{
+			for (shared_ptr<chunkStruct>& old : removed)
+			{
+				chunk->signatures.insert(chunk->signatures.end(), old->signatures.begin(), old->signatures.end());
+				chunk->calledFunctions.insert(old->calledFunctions.begin(), old->calledFunctions.end());
+				chunk->declaredFunctions.insert(old->declaredFunctions.begin(), old->declaredFunctions.end());
+			}
+		}
+	}
+
+	for (shared_ptr<chunkStruct>& chunk : removed)
+	{
+		removeSummary(document, chunk.get());
+
+		for (funcStruct& function : chunk->signatures)
+		{
+			oldSignatures[function.functionName].insert(signatureKey(function));
+		}
+	}
+
+	for (shared_ptr<chunkStruct>& chunk : newChunks)
+	{
+		if (fresh.count(chunk.get()) != 0)
+		{
+			addSummary(document, chunk.get());
+
+			for (funcStruct& function : chunk->signatures)
+			{
+				newSignatures[function.functionName].insert(signatureKey(function));
+			}
+		}
+	}
+
+	set<string> changedFunctions;
+
+	for (auto& function : oldSignatures)
+	{
+		if (newSignatures[function.first] != function.second)
+		{
+			changedFunctions.insert(function.first);
+		}
+	}
+
+	for (auto& function : newSignatures)
+	{
+		if (oldSignatures[function.first] != function.second)
+		{
+			changedFunctions.insert(function.first);
+		}
+	}
+
+	// Put the new chunks in the document
+	chunks.erase(chunks.begin() + first, chunks.begin() + last);
+	chunks.insert(chunks.begin() + first, newChunks.begin(), newChunks.end());
+
+	for (size_t i = first; i < chunks.size(); i++)
+	{
+		chunks[i]->index = i;
+	}
+
+	// Check the new chunks, and the chunks using or redefining a changed function
+	set<chunkStruct*> affected = fresh;
+
+	for (const string& name : changedFunctions)
+	{
+		set<chunkStruct*>& users = document.users[name];
+		affected.insert(users.begin(), users.end());
+	}
+
+	for (chunkStruct * chunk : affected)
+	{
+		if (!chunk->hasSyntaxError)
+		{
+			checkChunk(document, chunk);
+		}
+	}
+}
+
+// Add the functions defined, used and called by a chunk to the summaries of the document
+void LanguageServer::addSummary(documentStruct& document, chunkStruct * chunk)
+{
+	for (funcStruct& function : chunk->signatures)
+	{
+		document.definitions[function.functionName].insert(chunk);
+	}
+
+	for (const string& name : chunk->declaredFunctions)
+	{
+		document.users[name].insert(chunk);
+	}
+
+	for (const string& name : chunk->referencedFunctions)
+	{
+		document.users[name].insert(chunk);
+	}
+
+	for (const string& name : chunk->calledFunctions)
+	{
+		document.callers[name]++;
+		updateUsage(document, name);
+	}
+
+	for (funcStruct& function : chunk->signatures)
+	{
+		updateUsage(document, function.functionName);
+	}
+}
+
+// Remove the functions defined, used and called by a chunk from the summaries of the document
+void LanguageServer::removeSummary(documentStruct& document, chunkStruct * chunk)
+{
+	for (funcStruct& function : chunk->signatures)
+	{
+		document.definitions[function.functionName].erase(chunk);
+	}
+
+	for (const string& name : chunk->declaredFunctions)
+	{
+		document.users[name].erase(chunk);
+	}
+
+	for (const string& name : chunk->referencedFunctions)
+	{
+		document.users[name].erase(chunk);
+	}
+
+	for (const string& name : chunk->calledFunctions)
+	{
+		document.callers[name]--;
+		updateUsage(document, name);
+	}
+
+	for (funcStruct& function : chunk->signatures)
+	{
+		updateUsage(document, function.functionName);
+	}
+}
+
+// Update whether a function is defined but never called
+void LanguageServer::updateUsage(documentStruct& document, const string& name)
+{
+	bool isEntryPoint = name == "main" || name == "putchar" || name == "getchar";
+
+	if (!isEntryPoint && document.callers[name] == 0 && !document.definitions[name].empty())
+	{
+		document.unusedFunctions.insert(name);
+	}
+	else
+	{
+		document.unusedFunctions.erase(name);
+	}
+}
+
+// First chunk defining a function, ignoring a chunk (and the chunks after it if onlyBefore)
+chunkStruct * LanguageServer::findDefinition(documentStruct& document, string name, chunkStruct * ignored, bool onlyBefore)
+{
+	chunkStruct * definition = nullptr;
+
+	for (chunkStruct * chunk : document.definitions[name])
+	{
+		if (chunk != ignored && (!onlyBefore || chunk->index < ignored->index) && (definition == nullptr || chunk->index < definition->index))
+		{
+			definition = chunk;
+		}
+	}
+
+	return definition;
+}
+
+// Build a chunk from its text: lex, parse and read the signatures
+shared_ptr<chunkStruct> LanguageServer::parseChunk(string text)
+{
+	shared_ptr<chunkStruct> chunk = make_shared<chunkStruct>();
+	chunk->text = text;
+	chunk->lineBreaks = 0;
+	chunk->lineLengths = {0};
+
+	for (char c : text)
+	{
+		if (c == '\n')
+		{
+			chunk->lineBreaks++;
+			chunk->lineLengths.push_back(0);
+		}
+		else if ((c & 0xC0) != 0x80)
+		{
+			chunk->lineLengths.back() += utf16Length(c);
+		}
+	}
+
+	// Lex and parse the chunk alone (its lines are counted from 1)
+	ChunkErrorListener listener(chunk->diagnostics);
+	shared_ptr<chunkParseStruct> parse = make_shared<chunkParseStruct>();
+	parse->input.reset(new ANTLRInputStream(text));
+	parse->lexer.reset(new ifccLexer(parse->input.get()));
+	parse->lexer->removeErrorListeners();
+	parse->lexer->addErrorListener(&listener);
+	parse->tokens.reset(new CommonTokenStream(parse->lexer.get()));
+	parse->tokens->fill();
+	parse->parser.reset(new ifccParser(parse->tokens.get()));
+	parse->parser->removeErrorListeners();
+	parse->parser->addErrorListener(&listener);
+	parse->tree = parse->parser->axiom();
+	chunk->parse = parse;
+	chunk->hasSyntaxError = !chunk->diagnostics.empty();
+
+	// Names followed by '(' may be calls of the functions of the other chunks
+	vector<Token*> tokens = parse->tokens->getTokens();
+
+	for (size_t i = 0; i + 1 < tokens.size(); i++)
+	{
+		if (tokens[i]->getType() == ifccLexer::VAR && tokens[i + 1]->getText() == "(")
+		{
+			chunk->referencedFunctions.insert(tokens[i]->getText());
+		}
+	}
+
+	if (chunk->hasSyntaxError)
+	{
+		return chunk;
+	}
+
+	// Read the signatures from the headers of the functions
+	ErrorHandler headerErrors;
+	headerErrors.setRecording(true);
+	CFG cfg;
+	CodeGenVisitor visitor(headerErrors, cfg);
+	ifccParser::ProgContext * prog = parse->tree->prog();
+
+	for (ifccParser::FuncDeclareContext * function : prog->funcDeclare())
+	{
+		visitor.visitFuncDeclareHeader(function);
+		chunk->declaredFunctions.insert(function->VAR(0)->getText());
+	}
+
+	if (prog->mainDeclare() != nullptr)
+	{
+		visitor.visit(prog->mainDeclare()->mainDeclareHeader());
+		chunk->declaredFunctions.insert("main");
+	}
+
+	for (const string& name : chunk->declaredFunctions)
+	{
+		chunk->signatures.push_back(*visitor.getGlobalSymbolTable()->getFunction(name));
+	}
+
+	return chunk;
+}
+
+// Check the semantics of a chunk against the signatures of the other ones
+void LanguageServer::checkChunk(documentStruct& document, chunkStruct * chunk)
+{
+	ErrorHandler errorHandler;
+	errorHandler.setRecording(true);
+	CFG cfg;
+	CodeGenVisitor visitor(errorHandler, cfg);
+	SymbolTable * globalSymbolTable = visitor.getGlobalSymbolTable();
+
+	// Declare the functions of the other chunks used here (before or after all the lines of the chunk)
+	set<string> names = chunk->referencedFunctions;
+	names.insert(chunk->declaredFunctions.begin(), chunk->declaredFunctions.end());
+	names.insert("main");
+
+	for (const string& name : names)
+	{
+		// The first definition wins: a later one is the duplicate
+		bool isDeclared = chunk->declaredFunctions.count(name) != 0;
+		chunkStruct * definition = findDefinition(document, name, chunk, isDeclared);
+
+		if (definition == nullptr || globalSymbolTable->hasFunction(name))
+		{
+			continue;
+		}
+
+		for (funcStruct& function : definition->signatures)
+		{
+			if (function.functionName == name)
+			{
+				globalSymbolTable->addFunction(name, function.returnType, function.nbParameters, function.parameterTypes, function.parameterNames, definition->index < chunk->index ? 0 : INT_MAX);
+				break;
+			}
+		}
+	}
+
+	// A missing main is reported once for the whole document
+	if (!globalSymbolTable->hasFunction("main") && chunk->declaredFunctions.count("main") == 0)
+	{
+		globalSymbolTable->addFunction("main", TYPE_INT, 0, {}, {}, 0);
+	}
+
+	visitor.visit(chunk->parse->tree);
+
+	chunk->diagnostics.clear();
+
+	for (diagnosticStruct& diagnostic : errorHandler.getDiagnostics())
+	{
+		int line = max(diagnostic.lineNumber - 1, 0);
+		int length = line < (int) chunk->lineLengths.size() ? chunk->lineLengths[line] : 0;
+		chunk->diagnostics.push_back({diagnostic.severity, diagnostic.message, line, 0, length});
+	}
+
+	// Update the calls of the chunk in the summaries
+	set<string> calledFunctions;
+
+	for (const string& name : chunk->referencedFunctions)
+	{
+		if (globalSymbolTable->hasFunction(name) && globalSymbolTable->getFunction(name)->isCalled)
+		{
+			calledFunctions.insert(name);
+		}
+	}
+
+	for (const string& name : chunk->calledFunctions)
+	{
+		document.callers[name]--;
+	}
+
+	for (const string& name : calledFunctions)
+	{
+		document.callers[name]++;
+	}
+
+	for (const string& name : chunk->calledFunctions)
+	{
+		updateUsage(document, name);
+	}
+
+	for (const string& name : calledFunctions)
+	{
+		updateUsage(document, name);
+	}
+
+	chunk->calledFunctions = calledFunctions;
+}
+
+// Send the diagnostics of a document
+void LanguageServer::publishDiagnostics(string uri, documentStruct& document, ostream& out)
+{
+	Json diagnostics = Json::array();
+	int line = 0;
+
+	for (shared_ptr<chunkStruct>& chunk : document.chunks)
+	{
+		chunk->firstLine = line;
+		line += chunk->lineBreaks;
+
+		for (chunkDiagnosticStruct& diagnostic : chunk->diagnostics)
+		{
+			diagnostics.push(diagnosticItem(chunk->firstLine + diagnostic.line, diagnostic.startColumn, diagnostic.endColumn, diagnostic.severity, diagnostic.message));
+		}
+	}
+
+	// Checks of the whole document, from the summaries of the chunks
+	chunkStruct * mainDefinition = findDefinition(document, "main", nullptr, false);
+
+	if (mainDefinition == nullptr)
+	{
+		diagnostics.push(diagnosticItem(0, 0, 0, ERROR, "No 'main' function defined"));
+	}
+
+	for (chunkStruct * chunk : document.definitions["main"])
+	{
+		if (chunk != mainDefinition)
+		{
+			diagnostics.push(functionDiagnostic(chunk, "main", ERROR, "Function 'main' has already been declared"));
+		}
+	}
+
+	for (const string& name : document.unusedFunctions)
+	{
+		for (chunkStruct * chunk : document.definitions[name])
+		{
+			diagnostics.push(functionDiagnostic(chunk, name, WARNING, "Function '" + name + "' is not used"));
+		}
+	}
+
+	Json parameters = Json::object();
+	parameters.set("uri", uri);
+	parameters.set("version", document.version);
+	parameters.set("diagnostics", diagnostics);
+
+	Json notification = Json::object();
+	notification.set("jsonrpc", "2.0");
+	notification.set("method", "textDocument/publishDiagnostics");
+	notification.set("params", parameters);
+	writeMessage(out, notification);
+}
+
+// Find the end offsets of the chunks in text: after the line break of a line closing a top-level '}'
+void LanguageServer::splitChunks(const string& text, size_t from, splitterStruct& state, vector<size_t>& ends)
+{
+	for (size_t i = from; i < text.size(); i++)
+	{
+		char c = text[i];
+		char next = i + 1 < text.size() ? text[i + 1] : '\0';
+
+		if (c == '\n')
+		{
+			// Only a block comment, or a directive ending with a backslash, goes on the next line
+			if (state.mode != SPLIT_BLOCK_COMMENT && !(state.mode == SPLIT_DIRECTIVE && state.escaped))
+			{
+				state.mode = SPLIT_CODE;
+			}
+
+			// A chunk ends after its last top-level '}', when no other brace was opened on the line
+			if (state.closed && state.depth == 0 && state.mode == SPLIT_CODE)
+			{
+				ends.push_back(i + 1);
+				state.closed = false;
+			}
+
+			state.lineStart = true;
+			state.escaped = false;
+			continue;
+		}
+
+		switch (state.mode)
+		{
+			case SPLIT_CODE:
+			{
+				if (c == '#' && state.lineStart)
+				{
+					state.mode = SPLIT_DIRECTIVE;
+				}
+				else if (c == '/' && next == '/')
+				{
+					state.mode = SPLIT_LINE_COMMENT;
+				}
+				else if (c == '/' && next == '*')
+				{
+					state.mode = SPLIT_BLOCK_COMMENT;
+					i++;
+				}
+				else if (c == '\'' || c == '"')
+				{
+					state.mode = c == '\'' ? SPLIT_CHAR : SPLIT_STRING;
+				}
+				else if (c == '{')
+				{
+					state.depth++;
+				}
+				else if (c == '}')
+				{
+					// An extra '}' also ends a chunk, so that its error stays local
+					state.depth = max(state.depth - 1, 0);
+					state.closed = state.closed || state.depth == 0;
+				}
+
+				break;
+			}
+			case SPLIT_BLOCK_COMMENT:
+			{
+				if (c == '*' && next == '/')
+				{
+					state.mode = SPLIT_CODE;
+					i++;
+				}
+
+				break;
+			}
+			case SPLIT_CHAR:
+			case SPLIT_STRING:
+			{
+				if (!state.escaped && c == (state.mode == SPLIT_CHAR ? '\'' : '"'))
+				{
+					state.mode = SPLIT_CODE;
+				}
+
+				break;
+			}
+			default: // The rest of a line comment or directive
+			{
+				break;
+			}
+		}
+
+		state.escaped = !state.escaped && c == '\\';
+
+		if (c != ' ' && c != '\t' && c != '\r')
+		{
+			state.lineStart = false;
+		}
+	}
+}
+
+// Convert a position to an offset in text
+size_t LanguageServer::offsetOf(const string& text, int line, int column)
+{
+	size_t offset = 0;
+
+	for (int i = 0; i < line && offset < text.size(); i++)
+	{
+		size_t lineBreak = text.find('\n', offset);
+		offset = lineBreak == string::npos ? text.size() : lineBreak + 1;
+	}
+
+	// The column counts UTF-16 code units, and cannot go past the end of the line
+	for (int units = 0; units < column && offset < text.size() && text[offset] != '\n'; units += utf16Length(text[offset]))
+	{
+		offset++;
+
+		while (offset < text.size() && (text[offset] & 0xC0) == 0x80)
+		{
+			offset++;
+		}
+	}
+
+	return offset;
+}
+
+// Number of UTF-16 code units of the character starting with a byte
+int LanguageServer::utf16Length(char c)
+{
+	// Only the characters of 4 bytes in UTF-8 need a surrogate pair
+	return (c & 0xF8) == 0xF0 ? 2 : 1;
+}
+
+// Key identifying a signature
+string LanguageServer::signatureKey(funcStruct& function)
+{
+	string key = typeName(function.returnType) + "(" + to_string(function.nbParameters);
+
+	for (Type type : function.parameterTypes)
+	{
+		key += "," + typeName(type);
+	}
+
+	return key + ")";
+}
+
+// Build the JSON diagnostic of the line defining a function
+Json LanguageServer::functionDiagnostic(chunkStruct * chunk, string name, int severity, string message)
+{
+	int line = 0;
+
+	for (funcStruct& function : chunk->signatures)
+	{
+		if (function.functionName == name)
+		{
+			line = max(function.functionLine - 1, 0);
+			break;
+		}
+	}
+
+	int length = line < (int) chunk->lineLengths.size() ? chunk->lineLengths[line] : 0;
+
+	return diagnosticItem(chunk->firstLine + line, 0, length, severity, message);
+}
+
+// Build the JSON diagnostic of a range of a line
+Json LanguageServer::diagnosticItem(int line, int startColumn, int endColumn, int severity, string message)
+{
+	Json start = Json::object();
+	start.set("line", line);
+	start.set("character", startColumn);
+
+	Json end = Json::object();
+	end.set("line", line);
+	end.set("character", endColumn);
+
+	Json range = Json::object();
+	range.set("start", start);
+	range.set("end", end);
+
+	Json item = Json::object();
+	item.set("range", range);
+	item.set("severity", severity == ERROR ? 1 : 2);
+	item.set("source", "ifcc");
+	item.set("message", message);
+
+	return item;
+}
@@ -0,0 +1,167 @@
+/*************************************************************************
+                          PLD Compilateur: LanguageServer
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <LanguageServer> (file LanguageServer.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <unordered_map>
+#include <memory>
+#include "Json.h"
+#include "SymbolTable.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Parse of a chunk: input, lexer, tokens, parser and tree (defined in LanguageServer.cpp)
+struct chunkParseStruct;
+
+// Structure to represent a diagnostic of a chunk
+struct chunkDiagnosticStruct
+{
+	int severity;		// ERROR or WARNING
+	string message;		// Text of the diagnostic
+	int line;			// Line in the chunk, from 0
+	int startColumn;	// First column of the range
+	int endColumn;		// Column after the range
+};
+
+// Structure to represent a chunk: whole lines of a document holding top-level functions
+struct chunkStruct
+{
+	size_t index;							// Position of the chunk in the document
+	int firstLine;							// First line of the chunk in the document (when published)
+	string text;							// Text of the lines (ends with a line break, except at the end of the document)
+	int lineBreaks;							// Number of line breaks of the text
+	vector<int> lineLengths;				// Length of every line of the text, in UTF-16 code units
+	shared_ptr<chunkParseStruct> parse;		// Tokens and parse tree, kept while the text does not change
+	bool hasSyntaxError;					// Whether the chunk could not be parsed
+	set<string> declaredFunctions;			// Functions defined in the chunk (main included)
+	set<string> referencedFunctions;		// Names followed by '(' in the chunk
+	vector<funcStruct> signatures;			// Signatures of the functions defined in the chunk
+	set<string> calledFunctions;			// Functions called from the chunk
+	vector<chunkDiagnosticStruct> diagnostics;	// Diagnostics of the last parse or check
+};
+
+// Structure to represent the state of the splitting of a text into chunks
+struct splitterStruct
+{
+	int depth = 0;				// Depth of the braces
+	int mode = 0;				// What is being read (SPLIT_CODE, SPLIT_BLOCK_COMMENT, ...)
+	bool lineStart = true;		// Whether only blanks were read since the last line break
+	bool closed = false;		// Whether a top-level '}' was read on the current line
+	bool escaped = false;		// Whether the previous character is a backslash
+};
+
+// Structure to represent an open document
+struct documentStruct
+{
+	int version;							// Version given by the client
+	vector<shared_ptr<chunkStruct>> chunks;	// Chunks of the document, in order
+	unordered_map<string, set<chunkStruct*>> definitions;	// Chunks defining every function
+	unordered_map<string, set<chunkStruct*>> users;		// Chunks defining or naming every function
+	unordered_map<string, int> callers;					// Number of chunks calling every function
+	set<string> unusedFunctions;						// Functions defined but never called
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <LanguageServer> :
+//
+// The LanguageServer implements the Language Server Protocol on the
+// standard input and output (ifcc --lsp): the editor sends the open
+// documents and their incremental edits, and receives the errors and
+// warnings of the compiler as diagnostics.
+// A document is kept as a list of chunks of whole lines, each ending with
+// the '}' closing a top-level function. Every chunk keeps its tokens, its
+// parse tree, the signatures of its functions and its diagnostics (on
+// lines relative to the chunk, so that inserting lines elsewhere changes
+// nothing). An edit only re-lexes, re-parses and re-checks the chunks it
+// touches (extended while the braces are not balanced), then re-checks
+// the other chunks using a function whose signature changed. The whole
+// document checks (main, unused functions) are computed from the
+// summaries of the chunks, so the work of an edit does not grow with the
+// size of the document.
+//
+//------------------------------------------------------------------------
+
+class LanguageServer
+{
+	public:
+
+		// Constructor
+		LanguageServer();
+
+		// Serve the messages of in until exit, writing to out (exit status)
+		int run(istream& in, ostream& out);
+
+	protected:
+
+		// Read one message, answering the malformed ones (false at the end of the input)
+		bool readMessage(istream& in, ostream& out, Json& message);
+
+		// Write one message
+		void writeMessage(ostream& out, Json message);
+
+		// Answer a request or handle a notification
+		void handleMessage(Json& message, ostream& out);
+
+		// Replace the whole text of a document
+		void setText(documentStruct& document, string text);
+
+		// Apply an edit of a range of lines (0-based positions)
+		void applyEdit(documentStruct& document, int startLine, int startColumn, int endLine, int endColumn, string text);
+
+		// Build a chunk from its text: lex, parse and read the signatures
+		shared_ptr<chunkStruct> parseChunk(string text);
+
+		// Check the semantics of a chunk against the signatures of the other ones
+		void checkChunk(documentStruct& document, chunkStruct * chunk);
+
+		// Add the functions defined, used and called by a chunk to the summaries of the document
+		void addSummary(documentStruct& document, chunkStruct * chunk);
+
+		// Remove them from the summaries of the document
+		void removeSummary(documentStruct& document, chunkStruct * chunk);
+
+		// Update whether a function is defined but never called
+		void updateUsage(documentStruct& document, const string& name);
+
+		// First chunk defining a function, ignoring a chunk (and the chunks after it if onlyBefore)
+		chunkStruct * findDefinition(documentStruct& document, string name, chunkStruct * ignored, bool onlyBefore);
+
+		// Send the diagnostics of a document
+		void publishDiagnostics(string uri, documentStruct& document, ostream& out);
+
+		// Find the end offsets of the chunks in text, from offset from (state kept between calls)
+		static void splitChunks(const string& text, size_t from, splitterStruct& state, vector<size_t>& ends);
+
+		// Convert a position (column in UTF-16 code units, as in the protocol) to an offset in text (clamped to the line)
+		static size_t offsetOf(const string& text, int line, int column);
+
+		// Number of UTF-16 code units of the character starting with a byte
+		static int utf16Length(char c);
+
+		// Key identifying a signature (type and parameters)
+		static string signatureKey(funcStruct& function);
+
+		// Build the JSON diagnostic of the line defining a function
+		static Json functionDiagnostic(chunkStruct * chunk, string name, int severity, string message);
+
+		// Build the JSON diagnostic of a range of a line
+		static Json diagnosticItem(int line, int startColumn, int endColumn, int severity, string message);
+
+		map<string, documentStruct> documents;	// Open documents, by URI
+		bool shutdownRequested = false;			// Whether shutdown was received before exit
+};
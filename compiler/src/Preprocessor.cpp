@@ -0,0 +1,1144 @@
+/*************************************************************************
+                          PLD Compilateur: Preprocessor
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Implementation of class <Preprocessor> (file Preprocessor.cpp) -----/
+
+#include "Preprocessor.h"
+
+#include <fstream>
+#include <sstream>
+#include <climits>
+#include <cstdlib>
+#include <sys/stat.h>
+
+using namespace std;
+
+// Punctuators of more than one character, longest first
+static const vector<string> multiCharPunctuators = {"...", "<<=", ">>=", "##", "==", "!=", "<=", ">=", "&&", "||",
+	"++", "--", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<", ">>", "->"};
+
+// Canonical path of a file (the path itself if it does not exist)
+static string canonicalPath(string path)
+{
+	char * resolved = realpath(path.c_str(), nullptr);
+
+	if (resolved == nullptr)
+	{
+		return path;
+	}
+
+	string result = resolved;
+	free(resolved);
+
+	return result;
+}
+
+// Directory of a file, with its trailing '/'
+static string directoryOf(string path)
+{
+	size_t slash = path.rfind('/');
+	return slash == string::npos ? "" : path.substr(0, slash + 1);
+}
+
+// Build a number token
+static ppToken numberToken(long long value, int line)
+{
+	return {PP_NUMBER, to_string(value), line, true, {}};
+}
+
+//------------------------------------------------------------------------
+// Evaluation of the integer constant expressions of #if (C precedence)
+
+class conditionParser
+{
+	public:
+
+		conditionParser(vector<ppToken>& tokens) : tokens(tokens) {}
+
+		// Evaluate the whole expression (false if it is malformed)
+		bool evaluate(long long& value)
+		{
+			value = conditional();
+			return valid && position == tokens.size();
+		}
+
+		string message = "invalid expression in #if";
+
+	protected:
+
+		// Whether the next token is op (consumed if so)
+		bool accept(string op)
+		{
+			if (position < tokens.size() && tokens[position].kind == PP_PUNCTUATOR && tokens[position].text == op)
+			{
+				position++;
+				return true;
+			}
+
+			return false;
+		}
+
+		long long conditional()
+		{
+			long long condition = binary(0);
+
+			if (accept("?"))
+			{
+				long long ifTrue = conditional();
+
+				if (!accept(":"))
+				{
+					valid = false;
+					return 0;
+				}
+
+				long long ifFalse = conditional();
+				return condition ? ifTrue : ifFalse;
+			}
+
+			return condition;
+		}
+
+		// Binary operators by increasing precedence level
+		long long binary(size_t level)
+		{
+			static const vector<vector<string>> levels = {{"||"}, {"&&"}, {"|"}, {"^"}, {"&"}, {"==", "!="},
+				{"<", ">", "<=", ">="}, {"<<", ">>"}, {"+", "-"}, {"*", "/", "%"}};
+
+			if (level == levels.size())
+			{
+				return unary();
+			}
+
+			long long left = binary(level + 1);
+
+			while (valid)
+			{
+				string op = "";
+
+				for (const string& candidate : levels[level])
+				{
+					if (accept(candidate))
+					{
+						op = candidate;
+						break;
+					}
+				}
+
+				if (op.empty())
+				{
+					break;
+				}
+
+				long long right = binary(level + 1);
+
+				if ((op == "/" || op == "%") && right == 0)
+				{
+					message = "division by zero in #if";
+					valid = false;
+					return 0;
+				}
+
+				if (op == "||") left = left || right;
+				else if (op == "&&") left = left && right;
+				else if (op == "|") left = left | right;
+				else if (op == "^") left = left ^ right;
+				else if (op == "&") left = left & right;
+				else if (op == "==") left = left == right;
+				else if (op == "!=") left = left != right;
+				else if (op == "<") left = left < right;
+				else if (op == ">") left = left > right;
+				else if (op == "<=") left = left <= right;
+				else if (op == ">=") left = left >= right;
+				else if (op == "<<") left = left << (right & 63);
+				else if (op == ">>") left = left >> (right & 63);
+				else if (op == "+") left = left + right;
+				else if (op == "-") left = left - right;
+				else if (op == "*") left = left * right;
+				else if (op == "/") left = (left == LLONG_MIN && right == -1) ? left : left / right;
+				else left = (right == -1) ? 0 : left % right;
+			}
+
+			return left;
+		}
+
+		long long unary()
+		{
+			if (accept("!")) return !unary();
+			if (accept("~")) return ~unary();
+			if (accept("-")) return -unary();
+			if (accept("+")) return unary();
+
+			if (accept("("))
+			{
+				long long value = conditional();
+				valid = valid && accept(")");
+				return value;
+			}
+
+			if (position >= tokens.size())
+			{
+				valid = false;
+				return 0;
+			}
+
+			ppToken& token = tokens[position++];
+
+			if (token.kind == PP_NUMBER)
+			{
+				// Integer suffixes (u, l) are ignored
+				char * end;
+				long long value = strtoll(token.text.c_str(), &end, 0);
+				valid = valid && string(end).find_first_not_of("uUlL") == string::npos;
+				return value;
+			}
+
+			if (token.kind == PP_CHAR && token.text.size() >= 3)
+			{
+				return token.text[1] == '\\' ? (token.text[2] == 'n' ? '\n' : token.text[2] == '0' ? 0 : token.text[2]) : token.text[1];
+			}
+
+			valid = false;
+			return 0;
+		}
+
+		vector<ppToken>& tokens;
+		size_t position = 0;
+		bool valid = true;
+};
+
+//------------------------------------------------------------------------
+
+// Constructor
+Preprocessor::Preprocessor()
+{
+}
+
+// Add a directory searched by #include
+void Preprocessor::addIncludePath(string path)
+{
+	if (!path.empty() && path.back() != '/')
+	{
+		path += '/';
+	}
+
+	includePaths.push_back(path);
+}
+
+// Define a macro for every source file ("NAME" or "NAME=VALUE", like -D)
+void Preprocessor::defineMacro(string definition)
+{
+	commandLineMacros.push_back(definition);
+}
+
+// Signal an error of a file
+bool Preprocessor::error(string message, string path, int line)
+{
+	// The lines of an included file are not those of the source file
+	if (path != sourcePath)
+	{
+		message += " (in '" + path + "')";
+	}
+
+	errorHandler->signal(ERROR, message, line);
+
+	return false;
+}
+
+// Preprocess a source file into output (false on error)
+bool Preprocessor::process(string sourceFile, string& result, ErrorHandler& eH)
+{
+	// Reset the state of the previous source file (the cache is kept)
+	errorHandler = &eH;
+	sourcePath = canonicalPath(sourceFile);
+	macros.clear();
+	onceFiles.clear();
+	output = "";
+	outputCurrentLine = 1;
+	includeDepth = 0;
+
+	if (loadFile(sourcePath) == nullptr)
+	{
+		cerr << "error: cannot read file: " << sourceFile << endl;
+		return false;
+	}
+
+	// Macros of the command line, as if they were defined by a first line
+	for (string definition : commandLineMacros)
+	{
+		size_t equal = definition.find('=');
+		string name = definition.substr(0, equal);
+		string value = equal == string::npos ? "1" : definition.substr(equal + 1);
+		vector<ppLineStruct> lines;
+		tokenize(name + " " + value, lines);
+
+		if (lines.empty() || lines[0].tokens[0].kind != PP_IDENTIFIER)
+		{
+			cerr << "error: invalid macro definition: " << definition << endl;
+			return false;
+		}
+
+		vector<ppToken>& tokens = lines[0].tokens;
+		macros[name] = {false, false, {}, vector<ppToken>(tokens.begin() + 1, tokens.end())};
+	}
+
+	if (!processFile(sourcePath, -1))
+	{
+		return false;
+	}
+
+	result = output + "\n";
+
+	return true;
+}
+
+// Get the tokenized lines of a file from the cache, reading it if needed (nullptr if unreadable)
+cachedFileStruct* Preprocessor::loadFile(string path)
+{
+	struct stat status;
+
+	if (stat(path.c_str(), &status) != 0 || !S_ISREG(status.st_mode))
+	{
+		return nullptr;
+	}
+
+	// An unmodified file costs a stat
+	auto cached = cache.find(path);
+
+	if (cached != cache.end() && cached->second.size == status.st_size
+		&& cached->second.mtime.tv_sec == status.st_mtim.tv_sec && cached->second.mtime.tv_nsec == status.st_mtim.tv_nsec)
+	{
+		cacheHits++;
+		return &cached->second;
+	}
+
+	ifstream file(path);
+
+	if (!file.good())
+	{
+		return nullptr;
+	}
+
+	stringstream content;
+	content << file.rdbuf();
+	size_t hash = std::hash<string>()(content.str());
+
+	// A file touched but not modified costs a read
+	if (cached != cache.end() && cached->second.hash == hash)
+	{
+		cached->second.mtime = status.st_mtim;
+		cached->second.size = status.st_size;
+		cacheHits++;
+		return &cached->second;
+	}
+
+	cachedFileStruct& entry = cache[path];
+	entry.mtime = status.st_mtim;
+	entry.size = status.st_size;
+	entry.hash = hash;
+	entry.lines.clear();
+	tokenize(content.str(), entry.lines);
+	entry.guard = findGuard(entry.lines);
+
+	return &entry;
+}
+
+// Split a file into logical lines of tokens
+void Preprocessor::tokenize(const string& s, vector<ppLineStruct>& lines)
+{
+	size_t i = 0;
+	int line = 1;
+
+	while (i < s.size())
+	{
+		ppLineStruct current = {line, false, {}};
+		bool atStart = true;
+		bool space = false;
+
+		while (i < s.size())
+		{
+			char c = s[i];
+
+			// Line continuation
+			if (c == '\\' && (s.compare(i, 2, "\\\n") == 0 || s.compare(i, 3, "\\\r\n") == 0))
+			{
+				i += s[i + 1] == '\r' ? 3 : 2;
+				line++;
+				space = true;
+				continue;
+			}
+
+			if (c == '\n')
+			{
+				i++;
+				line++;
+				break;
+			}
+
+			if (isspace((unsigned char) c))
+			{
+				i++;
+				space = true;
+				continue;
+			}
+
+			// Comments are blanks (a block comment may span lines)
+			if (s.compare(i, 2, "//") == 0)
+			{
+				while (i < s.size() && s[i] != '\n')
+				{
+					i++;
+				}
+
+				continue;
+			}
+
+			if (s.compare(i, 2, "/*") == 0)
+			{
+				size_t end = s.find("*/", i + 2);
+				end = end == string::npos ? s.size() : end + 2;
+
+				for (; i < end; i++)
+				{
+					line += s[i] == '\n';
+				}
+
+				space = true;
+				continue;
+			}
+
+			if (atStart && c == '#')
+			{
+				current.isDirective = true;
+				atStart = false;
+				i++;
+				continue;
+			}
+
+			atStart = false;
+
+			// Read a token
+			ppToken token = {PP_PUNCTUATOR, "", line, space, {}};
+			size_t start = i;
+
+			if (isalpha((unsigned char) c) || c == '_')
+			{
+				token.kind = PP_IDENTIFIER;
+
+				while (i < s.size() && (isalnum((unsigned char) s[i]) || s[i] == '_'))
+				{
+					i++;
+				}
+			}
+			else if (isdigit((unsigned char) c) || (c == '.' && i + 1 < s.size() && isdigit((unsigned char) s[i + 1])))
+			{
+				token.kind = PP_NUMBER;
+
+				while (i < s.size() && (isalnum((unsigned char) s[i]) || s[i] == '_' || s[i] == '.'))
+				{
+					i++;
+				}
+			}
+			else if (c == '\'' || c == '"')
+			{
+				token.kind = c == '\'' ? PP_CHAR : PP_STRING;
+				i++;
+
+				while (i < s.size() && s[i] != c && s[i] != '\n')
+				{
+					i += (s[i] == '\\' && i + 1 < s.size() && s[i + 1] != '\n') ? 2 : 1;
+				}
+
+				i += (i < s.size() && s[i] == c);
+			}
+			else
+			{
+				i++;
+
+				for (const string& punctuator : multiCharPunctuators)
+				{
+					if (s.compare(start, punctuator.size(), punctuator) == 0)
+					{
+						i = start + punctuator.size();
+						break;
+					}
+				}
+			}
+
+			token.text = s.substr(start, i - start);
+			current.tokens.push_back(token);
+			space = false;
+		}
+
+		if (current.isDirective || !current.tokens.empty())
+		{
+			lines.push_back(current);
+		}
+	}
+}
+
+// Find the macro of an include guard wrapping a whole file
+string Preprocessor::findGuard(vector<ppLineStruct>& lines)
+{
+	// #ifndef X / #define X ... #endif, with nothing outside
+	if (lines.size() < 3 || !lines[0].isDirective || !lines[1].isDirective
+		|| lines[0].tokens.size() != 2 || lines[0].tokens[0].text != "ifndef"
+		|| lines[1].tokens.size() < 2 || lines[1].tokens[0].text != "define" || lines[1].tokens[1].text != lines[0].tokens[1].text)
+	{
+		return "";
+	}
+
+	int depth = 0;
+
+	for (size_t i = 0; i < lines.size(); i++)
+	{
+		if (!lines[i].isDirective || lines[i].tokens.empty())
+		{
+			continue;
+		}
+
+		string name = lines[i].tokens[0].text;
+		depth += (name == "if" || name == "ifdef" || name == "ifndef");
+		depth -= (name == "endif");
+
+		// The #ifndef is closed before the end: the guard does not wrap everything
+		if (depth == 0 && i + 1 != lines.size())
+		{
+			return "";
+		}
+	}
+
+	return depth == 0 ? lines[0].tokens[1].text : "";
+}
+
+// Preprocess a file (outputLine: line of the source file receiving its code, -1 for the source file)
+bool Preprocessor::processFile(string path, int outputLine)
+{
+	cachedFileStruct * file = loadFile(path);
+
+	if (file == nullptr)
+	{
+		return error("cannot read file '" + path + "'", sourcePath, outputLine);
+	}
+
+	// The lines are copied: an #include may update the cache entry
+	vector<ppLineStruct> lines = file->lines;
+	vector<conditionalStruct> conditionals;
+	vector<ppToken> code;
+
+	for (ppLineStruct& line : lines)
+	{
+		bool active = conditionals.empty() || conditionals.back().active;
+
+		// Consecutive lines of code are expanded together (a macro invocation may span lines)
+		if (!line.isDirective)
+		{
+			if (active)
+			{
+				code.insert(code.end(), line.tokens.begin(), line.tokens.end());
+			}
+
+			continue;
+		}
+
+		vector<ppToken> expanded;
+
+		if (!expand(code, expanded, path))
+		{
+			return false;
+		}
+
+		emit(expanded, outputLine);
+		code.clear();
+
+		if (!processDirective(line, path, outputLine, conditionals))
+		{
+			return false;
+		}
+	}
+
+	if (!conditionals.empty())
+	{
+		return error("unterminated #if", path, conditionals.back().line);
+	}
+
+	vector<ppToken> expanded;
+
+	if (!expand(code, expanded, path))
+	{
+		return false;
+	}
+
+	emit(expanded, outputLine);
+
+	return true;
+}
+
+// Execute a directive of the current file
+bool Preprocessor::processDirective(ppLineStruct& directive, string path, int outputLine, vector<conditionalStruct>& conditionals)
+{
+	// The null directive
+	if (directive.tokens.empty())
+	{
+		return true;
+	}
+
+	string name = directive.tokens[0].text;
+	bool active = conditionals.empty() || conditionals.back().active;
+
+	// Conditional inclusion: followed even in the skipped code (for the nesting)
+	if (name == "if" || name == "ifdef" || name == "ifndef")
+	{
+		bool value = false;
+
+		if (active && name == "if" && !evaluateCondition(directive, path, value))
+		{
+			return false;
+		}
+
+		if (active && name != "if")
+		{
+			if (directive.tokens.size() < 2 || directive.tokens[1].kind != PP_IDENTIFIER)
+			{
+				return error("#" + name + " expects a macro name", path, directive.line);
+			}
+
+			value = macros.count(directive.tokens[1].text) == (name == "ifdef" ? 1u : 0u);
+		}
+
+		conditionals.push_back({active, active && value, active && value, false, directive.line});
+		return true;
+	}
+
+	if (name == "elif" || name == "else" || name == "endif")
+	{
+		if (conditionals.empty())
+		{
+			return error("#" + name + " without #if", path, directive.line);
+		}
+
+		conditionalStruct& conditional = conditionals.back();
+
+		if (name == "endif")
+		{
+			conditionals.pop_back();
+			return true;
+		}
+
+		if (conditional.seenElse)
+		{
+			return error("#" + name + " after #else", path, directive.line);
+		}
+
+		bool value = true;
+
+		if (name == "elif" && conditional.parentActive && !conditional.taken && !evaluateCondition(directive, path, value))
+		{
+			return false;
+		}
+
+		conditional.seenElse = name == "else";
+		conditional.active = conditional.parentActive && !conditional.taken && value;
+		conditional.taken = conditional.taken || conditional.active;
+
+		return true;
+	}
+
+	if (!active)
+	{
+		return true;
+	}
+
+	if (name == "define")
+	{
+		return processDefine(directive, path);
+	}
+
+	if (name == "undef")
+	{
+		if (directive.tokens.size() < 2 || directive.tokens[1].kind != PP_IDENTIFIER)
+		{
+			return error("#undef expects a macro name", path, directive.line);
+		}
+
+		macros.erase(directive.tokens[1].text);
+		return true;
+	}
+
+	if (name == "include")
+	{
+		return processInclude(directive, path, outputLine);
+	}
+
+	if (name == "pragma")
+	{
+		// The other pragmas are ignored
+		if (directive.tokens.size() >= 2 && directive.tokens[1].text == "once")
+		{
+			onceFiles.insert(path);
+		}
+
+		return true;
+	}
+
+	if (name == "error" || name == "warning")
+	{
+		string message = "#" + name;
+
+		for (size_t i = 1; i < directive.tokens.size(); i++)
+		{
+			message += " " + directive.tokens[i].text;
+		}
+
+		if (name == "error")
+		{
+			return error(message, path, directive.line);
+		}
+
+		errorHandler->signal(WARNING, message, directive.line);
+		return true;
+	}
+
+	// #line only renames the lines for the messages: ignored
+	if (name == "line")
+	{
+		return true;
+	}
+
+	return error("unknown directive '#" + name + "'", path, directive.line);
+}
+
+// Execute #include
+bool Preprocessor::processInclude(ppLineStruct& directive, string path, int outputLine)
+{
+	vector<ppToken>& tokens = directive.tokens;
+	string name = "";
+	bool isAngled = false;
+
+	if (tokens.size() == 2 && tokens[1].kind == PP_STRING && tokens[1].text.size() >= 2)
+	{
+		name = tokens[1].text.substr(1, tokens[1].text.size() - 2);
+	}
+	else if (tokens.size() >= 3 && tokens[1].text == "<" && tokens.back().text == ">")
+	{
+		isAngled = true;
+
+		for (size_t i = 2; i + 1 < tokens.size(); i++)
+		{
+			name += tokens[i].text;
+		}
+	}
+
+	if (name.empty())
+	{
+		return error("#include expects \"FILENAME\" or <FILENAME>", path, directive.line);
+	}
+
+	string includedPath = resolveInclude(name, isAngled, path);
+
+	if (includedPath.empty())
+	{
+		// The system headers are not needed: the standard functions are built in
+		if (isAngled)
+		{
+			return true;
+		}
+
+		return error("cannot find the included file '" + name + "'", path, directive.line);
+	}
+
+	// Files included once, or whose include guard is already defined, are skipped without being read
+	auto cached = cache.find(includedPath);
+
+	if (onceFiles.count(includedPath) || (cached != cache.end() && !cached->second.guard.empty() && macros.count(cached->second.guard)))
+	{
+		return true;
+	}
+
+	if (includeDepth >= MAX_INCLUDE_DEPTH)
+	{
+		return error("#include nested too deeply", path, directive.line);
+	}
+
+	// The included code is written on the line of the #include of the source file
+	includeDepth++;
+	bool success = processFile(includedPath, outputLine >= 0 ? outputLine : directive.line);
+	includeDepth--;
+
+	return success;
+}
+
+// Find the file of an #include (empty if not found)
+string Preprocessor::resolveInclude(string name, bool isAngled, string path)
+{
+	vector<string> directories;
+
+	// "..." is first searched next to the including file
+	if (!isAngled)
+	{
+		directories.push_back(directoryOf(path));
+	}
+
+	directories.insert(directories.end(), includePaths.begin(), includePaths.end());
+
+	for (string directory : directories)
+	{
+		string candidate = name[0] == '/' ? name : directory + name;
+		struct stat status;
+
+		if (stat(candidate.c_str(), &status) == 0 && S_ISREG(status.st_mode))
+		{
+			return canonicalPath(candidate);
+		}
+	}
+
+	return "";
+}
+
+// Execute #define
+bool Preprocessor::processDefine(ppLineStruct& directive, string path)
+{
+	vector<ppToken>& tokens = directive.tokens;
+
+	if (tokens.size() < 2 || tokens[1].kind != PP_IDENTIFIER)
+	{
+		return error("#define expects a macro name", path, directive.line);
+	}
+
+	string name = tokens[1].text;
+	macroStruct macro = {false, false, {}, {}};
+	size_t bodyStart = 2;
+
+	// A function-like macro has its '(' right after its name
+	if (tokens.size() > 2 && tokens[2].text == "(" && !tokens[2].spaceBefore)
+	{
+		macro.isFunction = true;
+		size_t i = 3;
+
+		while (i < tokens.size() && tokens[i].text != ")")
+		{
+			if (tokens[i].text == "...")
+			{
+				macro.isVariadic = true;
+				macro.parameters.push_back("__VA_ARGS__");
+			}
+			else if (tokens[i].kind == PP_IDENTIFIER && !macro.isVariadic)
+			{
+				macro.parameters.push_back(tokens[i].text);
+			}
+			else
+			{
+				return error("invalid parameter list of macro '" + name + "'", path, directive.line);
+			}
+
+			i++;
+
+			if (i < tokens.size() && tokens[i].text == ",")
+			{
+				i++;
+			}
+			else if (i < tokens.size() && tokens[i].text != ")")
+			{
+				return error("invalid parameter list of macro '" + name + "'", path, directive.line);
+			}
+		}
+
+		if (i == tokens.size())
+		{
+			return error("missing ')' in the parameters of macro '" + name + "'", path, directive.line);
+		}
+
+		bodyStart = i + 1;
+	}
+
+	macro.body.assign(tokens.begin() + bodyStart, tokens.end());
+
+	// A redefinition must have the same replacement
+	auto previous = macros.find(name);
+
+	if (previous != macros.end())
+	{
+		bool same = previous->second.isFunction == macro.isFunction && previous->second.parameters == macro.parameters
+			&& previous->second.body.size() == macro.body.size();
+
+		for (size_t i = 0; same && i < macro.body.size(); i++)
+		{
+			same = previous->second.body[i].text == macro.body[i].text;
+		}
+
+		if (!same)
+		{
+			errorHandler->signal(WARNING, "macro '" + name + "' redefined", directive.line);
+		}
+	}
+
+	macros[name] = macro;
+
+	return true;
+}
+
+// Expand the macros of a list of tokens
+bool Preprocessor::expand(vector<ppToken> tokens, vector<ppToken>& result, string path)
+{
+	// The next token is at the back: a replacement is pushed back and scanned again
+	vector<ppToken> pending(tokens.rbegin(), tokens.rend());
+
+	while (!pending.empty())
+	{
+		ppToken token = pending.back();
+		pending.pop_back();
+
+		if (token.kind != PP_IDENTIFIER || token.hideSet.count(token.text))
+		{
+			result.push_back(token);
+			continue;
+		}
+
+		if (token.text == "__LINE__")
+		{
+			result.push_back(numberToken(token.line, token.line));
+			continue;
+		}
+
+		auto found = macros.find(token.text);
+
+		// A function-like macro is only invoked by its name followed by '('
+		if (found == macros.end() || (found->second.isFunction && (pending.empty() || pending.back().text != "(")))
+		{
+			result.push_back(token);
+			continue;
+		}
+
+		macroStruct& macro = found->second;
+		vector<vector<ppToken>> arguments;
+
+		if (macro.isFunction)
+		{
+			// Split the arguments on the commas outside parentheses
+			pending.pop_back();
+			arguments.push_back({});
+			int depth = 1;
+
+			while (depth > 0)
+			{
+				if (pending.empty())
+				{
+					return error("unterminated invocation of macro '" + token.text + "'", path, token.line);
+				}
+
+				ppToken argumentToken = pending.back();
+				pending.pop_back();
+				depth += (argumentToken.text == "(") - (argumentToken.text == ")");
+
+				if (depth == 1 && argumentToken.text == "," && !(macro.isVariadic && arguments.size() == macro.parameters.size()))
+				{
+					arguments.push_back({});
+				}
+				else if (depth > 0)
+				{
+					arguments.back().push_back(argumentToken);
+				}
+			}
+
+			// "f()" has no argument, and the variadic arguments may be absent
+			if (macro.parameters.empty() && arguments.size() == 1 && arguments[0].empty())
+			{
+				arguments.clear();
+			}
+
+			if (macro.isVariadic && arguments.size() + 1 == macro.parameters.size())
+			{
+				arguments.push_back({});
+			}
+
+			if (arguments.size() != macro.parameters.size())
+			{
+				return error("macro '" + token.text + "' expects " + to_string(macro.parameters.size()) + " arguments, "
+							 + to_string(arguments.size()) + " given", path, token.line);
+			}
+		}
+
+		vector<ppToken> replacement;
+
+		if (!substitute(macro, arguments, replacement, path))
+		{
+			return false;
+		}
+
+		// The replacement comes from the line of the invocation, and must not expand the macro again
+		for (auto it = replacement.rbegin(); it != replacement.rend(); it++)
+		{
+			it->line = token.line;
+			it->hideSet.insert(token.hideSet.begin(), token.hideSet.end());
+			it->hideSet.insert(token.text);
+			pending.push_back(*it);
+		}
+	}
+
+	return true;
+}
+
+// Build the replacement of a macro invocation
+bool Preprocessor::substitute(macroStruct& macro, vector<vector<ppToken>>& arguments, vector<ppToken>& result, string path)
+{
+	vector<ppToken>& body = macro.body;
+
+	// Index of the parameter named by a token of the body (-1 if none)
+	auto parameterIndex = [&](const ppToken& token)
+	{
+		for (size_t p = 0; macro.isFunction && token.kind == PP_IDENTIFIER && p < macro.parameters.size(); p++)
+		{
+			if (macro.parameters[p] == token.text)
+			{
+				return (int) p;
+			}
+		}
+
+		return -1;
+	};
+
+	for (size_t i = 0; i < body.size(); i++)
+	{
+		const ppToken& token = body[i];
+		int p = parameterIndex(token);
+
+		// #parameter: the spelling of the argument as a string
+		if (token.text == "#" && macro.isFunction && i + 1 < body.size() && parameterIndex(body[i + 1]) >= 0)
+		{
+			string text = "";
+
+			for (ppToken& argumentToken : arguments[parameterIndex(body[++i])])
+			{
+				text += (text.empty() || !argumentToken.spaceBefore ? "" : " ");
+
+				for (char c : argumentToken.text)
+				{
+					text += (c == '"' || c == '\\') && argumentToken.kind != PP_PUNCTUATOR ? string("\\") + c : string(1, c);
+				}
+			}
+
+			result.push_back({PP_STRING, "\"" + text + "\"", token.line, token.spaceBefore, {}});
+			continue;
+		}
+
+		// left ## right: the two tokens are pasted (the arguments are not expanded)
+		if (token.text == "##" && !result.empty() && i + 1 < body.size())
+		{
+			const ppToken& next = body[++i];
+			int q = parameterIndex(next);
+			vector<ppToken> right = q >= 0 ? arguments[q] : vector<ppToken>{next};
+
+			if (!right.empty())
+			{
+				result.back().text += right[0].text;
+				result.back().kind = (isalpha((unsigned char) result.back().text[0]) || result.back().text[0] == '_') ? PP_IDENTIFIER : result.back().kind;
+				result.insert(result.end(), right.begin() + 1, right.end());
+			}
+
+			continue;
+		}
+
+		if (p >= 0)
+		{
+			// An argument is expanded before the substitution, unless it is pasted
+			if (i + 1 < body.size() && body[i + 1].text == "##")
+			{
+				result.insert(result.end(), arguments[p].begin(), arguments[p].end());
+			}
+			else if (!expand(arguments[p], result, path))
+			{
+				return false;
+			}
+
+			continue;
+		}
+
+		result.push_back(token);
+	}
+
+	return true;
+}
+
+// Evaluate the condition of #if or #elif
+bool Preprocessor::evaluateCondition(ppLineStruct& directive, string path, bool& value)
+{
+	vector<ppToken>& tokens = directive.tokens;
+	vector<ppToken> condition;
+
+	// defined X and defined(X) are replaced before the expansion
+	for (size_t i = 1; i < tokens.size(); i++)
+	{
+		if (tokens[i].text != "defined")
+		{
+			condition.push_back(tokens[i]);
+			continue;
+		}
+
+		bool hasParentheses = i + 1 < tokens.size() && tokens[i + 1].text == "(";
+		size_t nameIndex = i + (hasParentheses ? 2 : 1);
+
+		if (nameIndex >= tokens.size() || tokens[nameIndex].kind != PP_IDENTIFIER
+			|| (hasParentheses && (nameIndex + 1 >= tokens.size() || tokens[nameIndex + 1].text != ")")))
+		{
+			return error("'defined' expects a macro name", path, directive.line);
+		}
+
+		condition.push_back(numberToken(macros.count(tokens[nameIndex].text), directive.line));
+		i = nameIndex + hasParentheses;
+	}
+
+	vector<ppToken> expanded;
+
+	if (!expand(condition, expanded, path))
+	{
+		return false;
+	}
+
+	// The identifiers left are not macros: they are 0
+	for (ppToken& token : expanded)
+	{
+		if (token.kind == PP_IDENTIFIER)
+		{
+			token = numberToken(0, directive.line);
+		}
+	}
+
+	conditionParser parser(expanded);
+	long long result;
+
+	if (expanded.empty() || !parser.evaluate(result))
+	{
+		return error(expanded.empty() ? "#if with no expression" : parser.message, path, directive.line);
+	}
+
+	value = result != 0;
+
+	return true;
+}
+
+// Write tokens to the output on their line
+void Preprocessor::emit(vector<ppToken>& tokens, int outputLine)
+{
+	for (ppToken& token : tokens)
+	{
+		int line = outputLine >= 0 ? outputLine : token.line;
+
+		// Tokens are separated by a blank so that they are never pasted by the lexer
+		if (line > outputCurrentLine)
+		{
+			output.append(line - outputCurrentLine, '\n');
+			outputCurrentLine = line;
+		}
+		else if (!output.empty() && output.back() != '\n')
+		{
+			output += ' ';
+		}
+
+		output += token.text;
+	}
+}
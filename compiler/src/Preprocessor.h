@@ -0,0 +1,174 @@
+/*************************************************************************
+                          PLD Compilateur: Preprocessor
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of class <Preprocessor> (file Preprocessor.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <ctime>
+#include <sys/types.h>
+#include "ErrorHandler.h"
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Kinds of preprocessing tokens
+enum ppTokenKind {PP_IDENTIFIER, PP_NUMBER, PP_CHAR, PP_STRING, PP_PUNCTUATOR};
+
+// Structure to represent a preprocessing token
+struct ppToken
+{
+	ppTokenKind kind;		// Kind of the token
+	string text;			// Spelling of the token
+	int line;				// Line of the token in its file
+	bool spaceBefore;		// Whether the token follows a blank (distinguishes "f(" from "f (" in #define)
+	set<string> hideSet;	// Macros that must not be expanded again in this token
+};
+
+// Structure to represent a logical line (a directive or a line of code)
+struct ppLineStruct
+{
+	int line;				// Line where the logical line starts
+	bool isDirective;		// Whether the line starts with '#' (the '#' is not in the tokens)
+	vector<ppToken> tokens;	// Tokens of the line, without the comments
+};
+
+// Structure to represent a tokenized file of the cache
+struct cachedFileStruct
+{
+	struct timespec mtime;		// Modification time when the file was read
+	off_t size;					// Size when the file was read
+	size_t hash;				// Hash of the content (validates a file touched but not modified)
+	vector<ppLineStruct> lines;	// Logical lines of the file
+	string guard;				// Macro of the include guard wrapping the whole file ("" if none)
+};
+
+// Structure to represent a macro
+struct macroStruct
+{
+	bool isFunction;			// Whether the macro takes arguments
+	bool isVariadic;			// Whether the last parameter is "..." (__VA_ARGS__)
+	vector<string> parameters;	// Names of the parameters
+	vector<ppToken> body;		// Replacement list
+};
+
+// Structure to represent an open #if of the current file
+struct conditionalStruct
+{
+	bool parentActive;	// Whether the code around the #if is kept
+	bool active;		// Whether the current branch is kept
+	bool taken;			// Whether a branch has already been kept
+	bool seenElse;		// Whether #else was found
+	int line;			// Line of the #if (for the error messages)
+};
+
+//------------------------------------------------------------------------
+//
+// Goal of class <Preprocessor> :
+//
+// The Preprocessor expands the directives of a source file before it is
+// parsed: object-like and function-like macros (with #, ## and
+// __VA_ARGS__), #include "..." (and <...> within the include paths, the
+// other system headers being ignored since the standard functions are
+// built in), #if/#ifdef/#ifndef/#elif/#else/#endif, #pragma once and
+// include guards, #error and #warning.
+// The line numbers of the source file are kept: every line of code stays
+// on its line, and an included file is written on the line of its
+// #include, so the errors and the line tables refer to the source file.
+// The tokenized files are cached for the whole life of the preprocessor
+// (e.g. across the files of a batch), and validated by their modification
+// time, then by a hash of their content.
+//
+//------------------------------------------------------------------------
+
+class Preprocessor
+{
+	public:
+
+		// Constructor
+		Preprocessor();
+
+		// Preprocess a source file into output (false on error)
+		bool process(string sourceFile, string& output, ErrorHandler& eH);
+
+		// Add a directory searched by #include
+		void addIncludePath(string path);
+
+		// Define a macro for every source file ("NAME" or "NAME=VALUE", like -D)
+		void defineMacro(string definition);
+
+		// Number of files read from the cache without being tokenized again
+		int getCacheHits()
+		{
+			return cacheHits;
+		};
+
+	protected:
+
+		// Get the tokenized lines of a file from the cache, reading it if needed (nullptr if unreadable)
+		cachedFileStruct* loadFile(string path);
+
+		// Split a file into logical lines of tokens
+		static void tokenize(const string& content, vector<ppLineStruct>& lines);
+
+		// Find the macro of an include guard wrapping a whole file
+		static string findGuard(vector<ppLineStruct>& lines);
+
+		// Preprocess a file (outputLine: line of the source file receiving its code, -1 for the source file)
+		bool processFile(string path, int outputLine);
+
+		// Execute a directive of the current file
+		bool processDirective(ppLineStruct& directive, string path, int outputLine, vector<conditionalStruct>& conditionals);
+
+		// Execute #include
+		bool processInclude(ppLineStruct& directive, string path, int outputLine);
+
+		// Execute #define
+		bool processDefine(ppLineStruct& directive, string path);
+
+		// Expand the macros of a list of tokens
+		bool expand(vector<ppToken> tokens, vector<ppToken>& result, string path);
+
+		// Build the replacement of a macro invocation
+		bool substitute(macroStruct& macro, vector<vector<ppToken>>& arguments, vector<ppToken>& result, string path);
+
+		// Evaluate the condition of #if or #elif
+		bool evaluateCondition(ppLineStruct& directive, string path, bool& value);
+
+		// Write tokens to the output on their line
+		void emit(vector<ppToken>& tokens, int outputLine);
+
+		// Find the file of an #include (empty if not found)
+		string resolveInclude(string name, bool isAngled, string path);
+
+		// Signal an error of a file
+		bool error(string message, string path, int line);
+
+		unordered_map<string, cachedFileStruct> cache;		// Tokenized files, by canonical path
+		vector<string> includePaths;						// Directories searched by #include
+		vector<string> commandLineMacros;					// Macros defined for every source file
+		int cacheHits = 0;									// Number of files found valid in the cache
+
+		// State of the source file being preprocessed
+		unordered_map<string, macroStruct> macros;			// Defined macros
+		unordered_set<string> onceFiles;					// Files with #pragma once already included
+		ErrorHandler* errorHandler = nullptr;				// Where the errors are signaled
+		string sourcePath = "";								// Path of the source file
+		string output = "";									// Preprocessed text
+		int outputCurrentLine = 1;							// Line of the end of the output
+		int includeDepth = 0;								// Number of nested #include
+
+		// Maximum number of nested #include
+		static const int MAX_INCLUDE_DEPTH = 200;
+};
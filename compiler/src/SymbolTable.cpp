@@ -9,17 +9,12 @@
 //---- Implementation of class <SymbolTable> (file SymbolTable.cpp) -----/
 
 #include "SymbolTable.h"
+#include "IR/Target.h"
 
 using namespace std;
 
-// Static initialization of type sizes for known data types
-unordered_map<string, int> SymbolTable::typeSizes = {{"int" , 4}, {"char", 1}};
-
-// Static initialization of type operation moves for known data types
-unordered_map<string, string> SymbolTable::typeOpeMoves = {{"int", "movl"}, {"char", "movzbl"}};
-
 // Static initialization of a dummy variable structure for error handling
-varStruct SymbolTable::stupidVarStruct = {"", 0, "", 0, false, false};
+varStruct SymbolTable::stupidVarStruct = {"", 0, TYPE_INT, 0, false, false};
 
 // Check if a variable with a given name exists in the current symbol table or its parent tables
 int SymbolTable::hasVariable(string name) 
@@ -109,12 +104,18 @@ funcStruct* SymbolTable::getFunction(string name)
 // Compute the total memory space allocated for variables in the symbol table and its children
 int SymbolTable::getMemorySpace() 
 {
+	// A laid out frame knows its size (its variables may share slots)
+	if (fixedMemorySpace >= 0)
+	{
+		return fixedMemorySpace;
+	}
+
 	int memSize = 0;
 
 	// Compute memory size of own symbol table
 	for (auto variable : variableMap) 
 	{
-		memSize += typeSizes[variable.second.variableType];
+		memSize += targetType(variable.second.variableType).size;
 	}
 
 	// Add memory size of child symbol tables
@@ -126,11 +127,29 @@ int SymbolTable::getMemorySpace()
 	return memSize;
 }
 
+// Fix the memory space of the scope
+void SymbolTable::setMemorySpace(int size) 
+{
+	fixedMemorySpace = size;
+}
+
+// Get the callee-saved registers given to the variables of the function, with their save slots
+vector<pair<int, int>>& SymbolTable::getRegisterSlots() 
+{
+	return registerSlots;
+}
+
+// Set the callee-saved registers given to the variables of the function, with their save slots
+void SymbolTable::setRegisterSlots(vector<pair<int, int>> slots) 
+{
+	registerSlots = slots;
+}
+
 // Add a variable to the symbol table
-void SymbolTable::addVariable(string name, string variableType, int lineNumber) 
+void SymbolTable::addVariable(string name, Type variableType, int lineNumber) 
 {
 	// Decrement the stack pointer based on the size of the variable type
-	stackPointer -= typeSizes[variableType];
+	stackPointer -= targetType(variableType).size;
 
 	// Create a variable structure and add it to the map
 	struct varStruct s = {
@@ -146,7 +165,7 @@ void SymbolTable::addVariable(string name, string variableType, int lineNumber)
 }
 
 // Add a function to the symbol table
-void SymbolTable::addFunction(string name, string returnType, int nbParameters, vector<string> parametersType, vector<string> parametersNames, int functionLine) 
+void SymbolTable::addFunction(string name, Type returnType, int nbParameters, vector<Type> parametersType, vector<string> parametersNames, int functionLine) 
 {
 	// Create a function structure and add it to the map
 	struct funcStruct function = {
@@ -207,10 +226,10 @@ void SymbolTable::checkUsedVariables(ErrorHandler& errorHandler)
 			}
 			else 
 			{
-				message =  "Variable '" + variable.first + "' declared at line " + to_string(variable.second.variableLine) + " is not used";
+				message =  "Variable '" + variable.first + "' is not used";
 			}
 
-			errorHandler.signal(WARNING, message, -1);
+			errorHandler.signal(WARNING, message, variable.second.variableLine);
 		}
 	}
 }
@@ -232,26 +251,26 @@ void SymbolTable::checkUsedFunctions(ErrorHandler& errorHandler)
 		// Report if the function is not called
 		if (!variable.second.isCalled) 
 		{
-			string message =  "Function '" + variable.first + "' declared at line " + to_string(variable.second.functionLine) + " is not used";
-			errorHandler.signal(WARNING, message, -1);
+			string message =  "Function '" + variable.first + "' is not used";
+			errorHandler.signal(WARNING, message, variable.second.functionLine);
 		}
 	}
 }
 
 // Perform type casting for a given type and value
-int SymbolTable::getCast(string type, int value) 
+int SymbolTable::getCast(Type type, int value) 
 {
 	// Perform casting based on the provided type
-	if(!type.compare("int"))
-    {
-		return (int) value;
-	} 
-	else if (!type.compare("char"))
+	switch (type)
 	{
-		return (char) value;
-	} 
-    
-	// If the type is unknown, return the original value
-	return value;
-}
+		case TYPE_INT:
+			return (int) value;
 
+		case TYPE_CHAR:
+			return (char) value;
+
+		default:
+			// Other types keep the original value
+			return value;
+	}
+}
\ No newline at end of file
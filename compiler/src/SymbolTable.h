@@ -16,6 +16,7 @@
 #include <iostream>
 #include <unordered_set>
 #include "ErrorHandler.h"
+#include "Type.h"
 
 using namespace std;
 
@@ -26,19 +27,20 @@ struct varStruct
 {
 	string variableName; 			// Variable name
 	int memoryOffset;				// Offset (in memory) to the base pointer 
-	string variableType;			// Type of the variable
+	Type variableType;				// Type of the variable
 	int variableLine;				// Line of code where the variable is declared
 	bool isUsed;					// Whether the variable is used in the code
 	bool isCorrect; 				// False when a stupid struct is returned to avoid bad cast
+	int registerIndex = -1;			// Register holding the variable (index in targetRegisters, -1 if in memory)
 };
 
 // Structure to represent functions in the symbol table
 struct funcStruct 
 {
 	string functionName;			// Function
-	string returnType; 				// Return type 
+	Type returnType; 				// Return type 
 	int nbParameters;				// Number of input parameters
-	vector<string> parameterTypes;	// Type of every input parameter
+	vector<Type> parameterTypes;	// Type of every input parameter
 	vector<string> parameterNames; 	// Names of every parameter
 	int functionLine; 				// The line of code where the function is declared
 	bool isCalled;					// Whether the function is called or not
@@ -58,7 +60,7 @@ class SymbolTable
 	public:
 
 		// Constructor
-		SymbolTable(int sP = 0, SymbolTable* parent = nullptr) : stackPointer(sP), parentSymbolTable(parent) 
+		SymbolTable(int sP = 0, SymbolTable* parent = nullptr) : stackPointer(sP), hasReturnStatement(false), parentSymbolTable(parent) 
         {
 			if (parentSymbolTable != nullptr) 
 			{
@@ -82,10 +84,10 @@ class SymbolTable
 		funcStruct* getFunction(string name);
 		
 		// Add a variable to the symbol table
-		void addVariable(string name, string variableType, int lineNumber);
+		void addVariable(string name, Type variableType, int lineNumber);
 		
 		// Add a function to the symbol table
-		void addFunction(string name, string returnType, int nbParameters, vector<string> parametersTypes, vector<string> parametersNames, int functionLine);
+		void addFunction(string name, Type returnType, int nbParameters, vector<Type> parametersTypes, vector<string> parametersNames, int functionLine);
 		
 		// Get the parent symbol table
 		SymbolTable* getParent();
@@ -104,6 +106,15 @@ class SymbolTable
 
 		// Get the memory space allocated for variables in the current function scope
 		int getMemorySpace();
+
+		// Fix the memory space of the scope (when its variables share slots)
+		void setMemorySpace(int size);
+
+		// Get the callee-saved registers given to the variables of the function, with their save slots
+		vector<pair<int, int>>& getRegisterSlots();
+
+		// Set the callee-saved registers given to the variables of the function, with their save slots
+		void setRegisterSlots(vector<pair<int, int>> slots);
 		
 		// Check for unused variables and report errors using the provided error handler
 		void checkUsedVariables(ErrorHandler& errorHandler);
@@ -112,13 +123,7 @@ class SymbolTable
 		void checkUsedFunctions(ErrorHandler& errorHandler);
 
 		// Perform type casting for a given type and value
-		static int getCast(string type, int value);
-
-		// Static member to store type sizes
-		static unordered_map<string, int> typeSizes;
-
-		// Static member to store type operation moves
-		static unordered_map<string, string> typeOpeMoves;
+		static int getCast(Type type, int value);
 
 		// Static member representing a dummy variable structure used for error handling
 		static varStruct stupidVarStruct;
@@ -131,4 +136,6 @@ class SymbolTable
 		vector<SymbolTable*> childSymbolTables; 		// Vector storing children symbol tables
 		unordered_map<string, varStruct> variableMap; 	// Hashtable containing the encountered variable declarations
 		unordered_map<string, funcStruct> functionMap; 	// Hashtable containing the encountered function declarations
+		int fixedMemorySpace = -1;						// Memory space given by setMemorySpace (-1 if computed)
+		vector<pair<int, int>> registerSlots;			// Callee-saved registers of the variables and offsets of their save slots
 };
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*************************************************************************
+                          PLD Compilateur: Type
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//------ Interface of the types of the language (file Type.h) -------/
+#pragma once
+
+//--------------------------------------------------- Called interfaces
+#include <string>
+
+using namespace std;
+
+//------------------------------------------------------------------ Types
+
+// Types of the language, also indexes of the target tables (TYPE_COUNT stays last)
+enum Type : unsigned char {TYPE_INT, TYPE_CHAR, TYPE_VOID, TYPE_COUNT};
+
+// Names of the types in the source code
+constexpr const char * typeNames[TYPE_COUNT] = {"int", "char", "void"};
+
+//------------------------------------------------------------------------
+//
+// A Type is a small integer: it is compared without string comparisons
+// and indexes the tables describing the target (IR/Target.h). Adding a
+// type means adding a value before TYPE_COUNT, its name and its row in
+// the target tables.
+//
+//------------------------------------------------------------------------
+
+// Name of a type in the source code
+inline string typeName(Type type)
+{
+	return typeNames[type];
+}
+
+// Type of a name of the source code (TYPE_INT if unknown)
+inline Type typeFromName(const string& name)
+{
+	for (int type = 0; type < TYPE_COUNT; type++)
+	{
+		if (name == typeNames[type])
+		{
+			return (Type) type;
+		}
+	}
+
+	return TYPE_INT;
+}
@@ -9,99 +9,140 @@
 //---- Implementation of class <Main> (file main.cpp) -----/
 
 #include <iostream>
-#include <fstream>
-#include <sstream>
+#include <string>
+#include <vector>
 #include <cstdlib>
 
-// Include ANTLR4 headers
-#include "antlr4-runtime.h"
-#include "../generated/ifccLexer.h"
-#include "../generated/ifccParser.h"
-#include "../generated/ifccBaseVisitor.h"
-
 // Include custom headers
-#include "CodeGenVisitor.h"
-#include "IR/CFG.h"
+#include "Driver.h"
+#include "LanguageServer.h"
 
-using namespace antlr4;
 using namespace std;
 
+// Print the command line usage
+static void printUsage()
+{
+    cerr << "usage: ifcc [options] path/to/file.c" << endl;
+    cerr << "       ifcc [options] -o path/to/exe path/to/file.c [path/to/file.c ...]" << endl;
+    cerr << "       ifcc [options] --whole-program [-o path/to/exe] path/to/file.c [path/to/file.c ...]" << endl;
+    cerr << "       ifcc [options] --run path/to/file.c [arguments ...]" << endl;
+    cerr << "       ifcc [options] --interp [--profile] path/to/file.c [arguments ...]" << endl;
+    cerr << "       ifcc [options] --cost-report path/to/file.c" << endl;
+    cerr << "       ifcc --lsp (language server on the standard input and output)" << endl;
+    cerr << "options: -O0 (no optimization), -O1 (optimizations, the default), -O2 (-O1 and the motion of the loop invariants), --stats (number of rewrites of the optimizations), -g (line tables), -I directory (#include path), -D name[=value] (macro)" << endl;
+}
+
 // Main function
 int main(int argn, const char **argv)
 {
-    // String stream to hold input source code
-    stringstream in;
+    Driver driver;
+    vector<string> sourceFiles;
+    string outputFile = "";
+    bool wholeProgram = false;
 
-    // Check if the correct number of arguments is provided
-    if (argn==2)
+    // Parse the command line arguments
+    for (int i = 1; i < argn; i++)
     {
-        // Open the file for reading
-        ifstream lecture(argv[1]);
+        string argument = argv[i];
 
-        // Check if the file is opened successfully
-        if( !lecture.good() )
+        // Run mode: the arguments after the source file belong to the program
+        if (argument == "--run" && i + 1 < argn)
         {
-            cerr<<"error: cannot read file: " << argv[1] << endl ;
-            exit(1);
+            vector<string> arguments(argv + i + 2, argv + argn);
+            return driver.run(argv[i + 1], arguments);
         }
+        // Interpreter mode: same, the profile is written on the error output
+        else if (argument == "--interp" && i + 1 < argn)
+        {
+            bool profile = string(argv[i + 1]) == "--profile";
+            int sourceIndex = profile ? i + 2 : i + 1;
 
-        // Read the contents of the file into the stringstream
-        in << lecture.rdbuf();
+            if (sourceIndex >= argn)
+            {
+                printUsage();
+                exit(1);
+            }
+
+            vector<string> arguments(argv + sourceIndex + 1, argv + argn);
+            return driver.interpret(argv[sourceIndex], arguments, profile);
+        }
+        // Cost report mode: static estimate of the generated code
+        else if (argument == "--cost-report" && i + 1 < argn)
+        {
+            return driver.costReport(argv[i + 1], cout) ? 0 : 1;
+        }
+        // Language server mode: diagnostics of the documents open in an editor
+        else if (argument == "--lsp")
+        {
+            LanguageServer server;
+            return server.run(cin, cout);
+        }
+        else if (argument == "-o" && i + 1 < argn)
+        {
+            outputFile = argv[++i];
+        }
+        // Whole program mode: the files form one program, optimized as a whole
+        else if (argument == "--whole-program")
+        {
+            wholeProgram = true;
+            driver.setWholeProgram(true);
+        }
+        // Optimization level: -O0 generates the code of the IR as it is
+        else if (argument == "-O0" || argument == "-O1" || argument == "-O2")
+        {
+            driver.setOptimization(argument != "-O0");
+            driver.setLoopInvariantCodeMotion(argument == "-O2");
+        }
+        else if (argument == "--stats")
+        {
+            driver.setStatistics(true);
+        }
+        else if (argument == "-g")
+        {
+            driver.setDebugInfo(true);
+        }
+        // Preprocessor options, separate ("-I dir") or joined ("-Idir")
+        else if ((argument == "-I" || argument == "-D") && i + 1 < argn)
+        {
+            argument == "-I" ? driver.addIncludePath(argv[++i]) : driver.defineMacro(argv[++i]);
+        }
+        else if (argument.size() > 2 && (argument.compare(0, 2, "-I") == 0 || argument.compare(0, 2, "-D") == 0))
+        {
+            argument[1] == 'I' ? driver.addIncludePath(argument.substr(2)) : driver.defineMacro(argument.substr(2));
+        }
+        else if (argument.size() > 1 && argument[0] == '-')
+        {
+            cerr << "error: unknown option: " << argument << endl;
+            printUsage();
+            exit(1);
+        }
+        else
+        {
+            sourceFiles.push_back(argument);
+        }
     }
-    else
+
+    // Check if the correct number of arguments is provided
+    if (sourceFiles.empty() || (outputFile.empty() && sourceFiles.size() != 1 && !wholeProgram))
     {
-        cerr << "usage: ifcc path/to/file.c" << endl ;
+        printUsage();
         exit(1);
     }
 
-    // Parse and construct tree
-    ANTLRInputStream input(in.str());
-
-    // Create lexer and token stream
-    ifccLexer lexer(&input);
-    CommonTokenStream tokens(&lexer);
-    tokens.fill();
-
-    // Check the syntax by parsing
-    ifccParser parser(&tokens);
-    tree::ParseTree* tree = parser.axiom();
-
-    // Check for syntax errors
-    if(parser.getNumberOfSyntaxErrors() != 0)
+    // Executable mode: stream the assembly into the assembler and link
+    if (!outputFile.empty())
     {
-        cerr << "ERROR: syntax error during parsing" << endl;
-        cout.flush();
-        exit(1);
+        // Files of a multi-file program are compiled as separate translation units (unless compiled as a whole)
+        driver.setSeparateCompilation(sourceFiles.size() > 1 && !wholeProgram);
+        return driver.buildExecutable(sourceFiles, outputFile);
     }
 
-    // Create an error handler and a Control Flow Graph (CFG)
-    ErrorHandler errorHandler;
-    CFG cfg;
-
-    // Visit the parse tree and generate intermediate representation (IR) code
-    CodeGenVisitor v(errorHandler, cfg);
-    v.visit(tree);
-
-    // Perform static analysis on functions
-    v.getGlobalSymbolTable()->checkUsedFunctions(errorHandler);
-
-    // Check for errors and exit if present
-    bool hasErrors = errorHandler.hasError();
-    if (hasErrors)
+    // Assembly mode: output the generated assembly code
+    if (!driver.compileProgram(sourceFiles, cout))
     {
         cout.flush();
         exit(1);
     }
-
-    // Place standard functions in the code if needed
-    cfg.initStandardFunctions(v.getGlobalSymbolTable());
-
-    // Generate ASM instructions
-    stringstream out;
-    cfg.generateASM(out);
-    
-    // Output the generated assembly code
-    cout << out.str();
     
     return 0;
 }
\ No newline at end of file
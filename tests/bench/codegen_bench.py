@@ -0,0 +1,299 @@
+#!/usr/bin/env python3
+
+# This script measures the quality of the code generated by IFCC.
+#
+# input: the test-cases under tests/testfiles, plus a corpus of synthetic
+#        programs produced by a deterministic generator
+#
+# output: per-function metrics of the generated assembly, compared with
+#         the checked-in baseline (codegen_baseline.json)
+#
+# The script is divided in three distinct steps:
+# - in the CORPUS step, we collect the test-cases and generate the synthetic programs
+# - in the MEASURE step, we compile every program with IFCC and analyse its assembly
+# - in the COMPARE step, we report the deltas against the baseline (or update it)
+#
+
+import argparse
+import json
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR=os.path.dirname(os.path.realpath(__file__))
+METRICS=['instructions','loads','stores','frame','branches','calls']
+
+######################################################################################
+## ARGPARSE step: make sense of our command-line arguments
+
+argparser   = argparse.ArgumentParser(
+description = "Compile the test corpus with IFCC and compare per-function code metrics against a baseline.",
+epilog      = ""
+)
+
+argparser.add_argument('-c','--compiler',metavar='PATH',default=SCRIPT_DIR+'/../../compiler/ifcc',
+                       help='Path of the ifcc executable (default: compiler/ifcc)')
+argparser.add_argument('-b','--baseline',metavar='PATH',default=SCRIPT_DIR+'/codegen_baseline.json',
+                       help='Path of the JSON baseline (default: tests/bench/codegen_baseline.json)')
+argparser.add_argument('-u','--update',action="store_true",
+                       help='Write the current metrics as the new baseline instead of comparing')
+argparser.add_argument('-n','--synthetic',metavar='N',type=int,default=40,
+                       help='Number of synthetic programs to generate (default: 40)')
+argparser.add_argument('-f','--flags',metavar='FLAGS',default='',
+                       help='Extra options given to ifcc (e.g. "-O0")')
+argparser.add_argument('-v','--verbose',action="count",default=0,
+                       help='Increase verbosity level (list every function whose metrics changed)')
+
+args=argparser.parse_args()
+
+######################################################################################
+## Synthetic program generator (deterministic: the same seed always gives the same corpus)
+
+class ProgramGenerator:
+    """generate valid programs of the supported C subset: int/char variables, arithmetic,
+    comparisons, bitwise operators, if/else, bounded while loops, calls and putchar"""
+
+    BINARY_OPS=['+','-','*','&','|','^','<','>','==','!=','<=','>=']
+
+    def __init__(self, seed):
+        self.rng=random.Random(seed)
+
+    def expression(self, variables, functions, depth):
+        rng=self.rng
+        choice=rng.random()
+        if depth <= 0 or choice < 0.3:
+            if variables and rng.random() < 0.7:
+                return rng.choice(variables)
+            return str(rng.randint(0,100))
+        if choice < 0.75:
+            op=rng.choice(self.BINARY_OPS)
+            return '('+self.expression(variables,functions,depth-1)+' '+op+' '+self.expression(variables,functions,depth-1)+')'
+        if choice < 0.85:
+            # division and modulo by a non-zero constant
+            return '('+self.expression(variables,functions,depth-1)+' '+rng.choice(['/','%'])+' '+str(rng.randint(1,9))+')'
+        if choice < 0.9:
+            return '('+rng.choice(['-','!'])+self.expression(variables,functions,depth-1)+')'
+        if functions:
+            name,arity=rng.choice(functions)
+            return name+'('+', '.join(self.expression(variables,[],depth-1) for _ in range(arity))+')'
+        return self.expression(variables,functions,depth-1)
+
+    def statements(self, variables, functions, depth, indent):
+        rng=self.rng
+        lines=[]
+        for _ in range(rng.randint(2,5)):
+            kind=rng.random()
+            target=rng.choice(variables)
+            if kind < 0.5 or depth <= 0:
+                if rng.random() < 0.8:
+                    lines.append(indent+target+' = '+self.expression(variables,functions,3)+';')
+                else:
+                    target=rng.choice([v for v in variables if not v.startswith('c')])
+                    lines.append(indent+target+' '+rng.choice(['+=','-=','*='])+' '+self.expression(variables,functions,2)+';')
+            elif kind < 0.75:
+                lines.append(indent+'if ('+self.expression(variables,functions,2)+') {')
+                lines+=self.statements(variables,functions,depth-1,indent+'    ')
+                if rng.random() < 0.5:
+                    lines.append(indent+'} else {')
+                    lines+=self.statements(variables,functions,depth-1,indent+'    ')
+                lines.append(indent+'}')
+            else:
+                counter='i'+str(depth)
+                lines.append(indent+counter+' = 0;')
+                lines.append(indent+'while ('+counter+' < '+str(rng.randint(2,10))+') {')
+                lines+=self.statements(variables,functions,depth-1,indent+'    ')
+                lines.append(indent+'    '+counter+' = '+counter+' + 1;')
+                lines.append(indent+'}')
+        return lines
+
+    def function(self, name, arity, functions, isMain):
+        rng=self.rng
+        parameters=['p'+str(k) for k in range(arity)]
+        locals_=['v'+str(k) for k in range(rng.randint(1,4))]
+        chars=['c'+str(k) for k in range(rng.randint(0,1))]
+        counters=['i1','i2']
+        header='int main()' if isMain else 'int '+name+'('+', '.join('int '+p for p in parameters)+')'
+        lines=[header+' {']
+        for v in locals_:
+            lines.append('    int '+v+' = '+str(rng.randint(0,50))+';')
+        for c in chars:
+            lines.append("    char "+c+" = '"+rng.choice('abcxyz')+"';")
+        lines.append('    int '+', '.join(counters)+';')
+        variables=parameters+locals_+chars
+        lines+=self.statements(variables,functions,2,'    ')
+        if isMain:
+            lines.append('    putchar(65 + ((('+' + '.join(variables)+') % 26) + 26) % 26);')
+            lines.append('    putchar(10);')
+        lines.append('    return '+self.expression(variables,[],2)+';')
+        lines.append('}')
+        return lines
+
+    def program(self):
+        functions=[]
+        lines=[]
+        for k in range(self.rng.randint(1,3)):
+            name='f'+str(k)
+            arity=self.rng.randint(1,4)
+            lines+=self.function(name,arity,list(functions),False)
+            lines.append('')
+            functions.append((name,arity))
+        lines+=self.function('main',0,functions,True)
+        return '\n'.join(lines)+'\n'
+
+######################################################################################
+## Assembly analysis
+
+def splitOperands(text):
+    """split the operands of an instruction on the commas outside parentheses"""
+    operands=[]
+    depth=0
+    current=''
+    for c in text:
+        if c == '(':
+            depth+=1
+        elif c == ')':
+            depth-=1
+        if c == ',' and depth == 0:
+            operands.append(current.strip())
+            current=''
+        else:
+            current+=c
+    if current.strip():
+        operands.append(current.strip())
+    return operands
+
+def analyse(assembly):
+    """return {function: {metric: value}} for the assembly text"""
+    functions={}
+    current=None
+    for line in assembly.splitlines():
+        line=line.split('#')[0].strip()
+        if not line:
+            continue
+        if line.endswith(':'):
+            label=line[:-1]
+            if not label.startswith('.'):
+                current={m:0 for m in METRICS}
+                functions[label]=current
+            continue
+        if line.startswith('.') or current is None:
+            continue
+        parts=line.split(None,1)
+        mnemonic=parts[0]
+        operands=splitOperands(parts[1]) if len(parts) > 1 else []
+        memory=['(' in o for o in operands]
+        current['instructions']+=1
+
+        if mnemonic.startswith('j'):
+            current['branches']+=1
+        elif mnemonic.startswith('call'):
+            current['calls']+=1
+        elif mnemonic.startswith('push'):
+            current['stores']+=1
+            current['loads']+=memory[0] if memory else 0
+        elif mnemonic.startswith('pop'):
+            current['loads']+=1
+            current['stores']+=memory[0] if memory else 0
+        elif mnemonic.startswith('lea'):
+            pass
+        elif mnemonic.startswith('mov') or mnemonic.startswith('set'):
+            # plain data movement: the source is read, the destination is written
+            current['loads']+=sum(memory[:-1])
+            current['stores']+=memory[-1] if memory else 0
+        elif mnemonic.startswith('cmp') or mnemonic.startswith('test'):
+            current['loads']+=sum(memory)
+        elif operands:
+            # read-modify-write of the destination
+            current['loads']+=sum(memory)
+            current['stores']+=memory[-1] if len(operands) > 1 or mnemonic.startswith(('neg','not','inc','dec')) else 0
+
+        if mnemonic.startswith('sub') and len(operands) == 2 and operands[1] == '%rsp' and current['frame'] == 0:
+            current['frame']=int(operands[0].lstrip('$'),0)
+    return functions
+
+######################################################################################
+## CORPUS step: collect the test-cases and generate the synthetic programs
+
+corpus=[]
+testfiles=os.path.normpath(SCRIPT_DIR+'/../testfiles')
+for dirpath,dirnames,filenames in os.walk(testfiles):
+    for name in filenames:
+        if name.endswith('.c'):
+            path=os.path.join(dirpath,name)
+            corpus.append((os.path.relpath(path,testfiles),open(path).read(),path))
+
+generator=ProgramGenerator(2024)
+for k in range(args.synthetic):
+    corpus.append(('synthetic/prog_%03d.c' % k,generator.program(),None))
+
+corpus.sort()
+
+######################################################################################
+## MEASURE step: compile every program and analyse its assembly
+
+if not os.path.isfile(args.compiler):
+    print("error: cannot find the compiler: "+args.compiler)
+    sys.exit(1)
+
+current={}
+with tempfile.TemporaryDirectory(prefix='ifcc-bench-') as workdir:
+    for name,text,path in corpus:
+        # the test-cases are compiled in place (for their #include "...")
+        source=path or os.path.join(workdir,'input.c')
+        if path is None:
+            open(source,'w').write(text)
+        process=subprocess.run([args.compiler]+args.flags.split()+[source],stdin=subprocess.DEVNULL,
+                               stdout=subprocess.PIPE,stderr=subprocess.DEVNULL)
+        if process.returncode != 0:
+            if name.startswith('synthetic/'):
+                print("error: ifcc rejects the synthetic program "+name)
+                print(text)
+                sys.exit(1)
+            continue # invalid test-cases are expected to be rejected
+        for function,metrics in analyse(process.stdout.decode('latin1')).items():
+            current[name+'::'+function]=metrics
+
+######################################################################################
+## COMPARE step: report the deltas against the baseline
+
+if args.update:
+    # one function per line keeps the diffs of the baseline readable
+    with open(args.baseline,'w') as f:
+        f.write('{\n'+',\n'.join(' '+json.dumps(name)+': '+json.dumps(current[name],sort_keys=True) for name in sorted(current))+'\n}\n')
+    print("baseline updated: %d functions in %s" % (len(current),os.path.relpath(args.baseline)))
+    sys.exit(0)
+
+if not os.path.isfile(args.baseline):
+    print("error: no baseline, run with --update to create it")
+    sys.exit(1)
+
+baseline=json.load(open(args.baseline))
+common=sorted(set(baseline) & set(current))
+
+print("%-14s %12s %12s %10s %8s" % ('metric','baseline','current','delta','%'))
+for metric in METRICS:
+    before=sum(baseline[f][metric] for f in common)
+    after=sum(current[f][metric] for f in common)
+    percent=100.0*(after-before)/before if before else 0.0
+    print("%-14s %12d %12d %+10d %+7.1f%%" % (metric,before,after,after-before,percent))
+
+regressions=[f for f in common if any(current[f][m] > baseline[f][m] for m in METRICS)]
+improvements=[f for f in common if f not in regressions and any(current[f][m] < baseline[f][m] for m in METRICS)]
+
+print()
+print("functions: %d compared, %d improved, %d regressed, %d new, %d removed" %
+      (len(common),len(improvements),len(regressions),len(set(current)-set(baseline)),len(set(baseline)-set(current))))
+
+def describe(function):
+    return ', '.join('%s %d->%d' % (m,baseline[function][m],current[function][m])
+                     for m in METRICS if baseline[function][m] != current[function][m])
+
+for function in regressions:
+    print("REGRESSION "+function+": "+describe(function))
+if args.verbose:
+    for function in improvements:
+        print("improvement "+function+": "+describe(function))
+
+sys.exit(1 if regressions else 0)
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+
+# This script guards the compile time of IFCC on large functions.
+#
+# input: synthetic functions of a few shapes that stress the optimizations
+#        (a chain of ifs on the parameters, ifs on the same constant
+#        condition, straight-line code, a sequence of loops), generated at
+#        a base size and at twice that size
+#
+# output: for every shape, the compile time at -O0 and -O1 for both sizes,
+#         and the growth of the -O1 time when the function doubles
+#
+# The -O1 time of a linear pass doubles with the size of the function, a
+# quadratic one is multiplied by four: the script fails when the growth of
+# a shape is above --max-growth (the ratio does not depend on the speed of
+# the machine, unlike a time limit).
+#
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+SCRIPT_DIR=os.path.dirname(os.path.realpath(__file__))
+
+######################################################################################
+## ARGPARSE step: make sense of our command-line arguments
+
+argparser   = argparse.ArgumentParser(
+description = "Time IFCC on large synthetic functions and check that the -O1 compile time grows linearly with their size.",
+epilog      = ""
+)
+
+argparser.add_argument('-c','--compiler',metavar='PATH',default=SCRIPT_DIR+'/../../compiler/ifcc',
+                       help='Path of the ifcc executable (default: compiler/ifcc)')
+argparser.add_argument('-n','--size',metavar='N',type=int,default=1000,
+                       help='Number of statements of the smaller functions (default: 1000)')
+argparser.add_argument('-g','--max-growth',metavar='RATIO',type=float,default=3.0,
+                       help='Largest accepted ratio of the -O1 times of the two sizes (default: 3.0)')
+argparser.add_argument('-r','--runs',metavar='R',type=int,default=3,
+                       help='Number of runs of every compilation, the fastest one is kept (default: 3)')
+
+args=argparser.parse_args()
+
+######################################################################################
+## Synthetic functions: every shape gives the source of a program for a size
+
+def ifsOnParameters(n):
+    lines=['int f(int a, int b) {']
+    for k in range(n):
+        lines.append('    if (a > %d) { a = a - 1; } else { b = b + 1; }' % k)
+    lines+=['    return a + b;','}','','int main() {','    return f(3, 4) & 127;','}']
+    return lines
+
+def ifsOnConstant(n):
+    lines=['int main() {','    int a = 1;','    int c = 1;']
+    for k in range(n):
+        lines.append('    if (c) { a = a + %d; }' % k)
+    lines+=['    return a & 127;','}']
+    return lines
+
+def straightLine(n):
+    lines=['int main() {','    int a = 1;','    int b = 2;']
+    for k in range(n):
+        lines.append('    a = a + %d * b;' % k)
+    lines+=['    return a & 127;','}']
+    return lines
+
+def loops(n):
+    lines=['int main() {','    int a = 1;','    int i;']
+    for k in range(n//4):
+        lines+=['    i = 0;','    while (i < 3) {','        a = a + i * %d;' % k,'        i = i + 1;','    }']
+    lines+=['    return a & 127;','}']
+    return lines
+
+SHAPES=[('ifs on parameters',ifsOnParameters),('ifs on a constant',ifsOnConstant),
+        ('straight line',straightLine),('loops',loops)]
+
+######################################################################################
+## MEASURE step: compile every shape at both sizes
+
+if not os.path.isfile(args.compiler):
+    print("error: cannot find the compiler: "+args.compiler)
+    sys.exit(1)
+
+def compileTime(source, level):
+    """fastest of several compilations, in seconds"""
+    best=None
+    for _ in range(args.runs):
+        start=time.perf_counter()
+        process=subprocess.run([args.compiler,level,source],stdin=subprocess.DEVNULL,
+                               stdout=subprocess.DEVNULL,stderr=subprocess.DEVNULL)
+        elapsed=time.perf_counter()-start
+        if process.returncode != 0:
+            print("error: ifcc %s rejects %s" % (level,source))
+            sys.exit(1)
+        best=elapsed if best is None else min(best,elapsed)
+    return best
+
+print("%-20s %8s %10s %10s %10s %10s %8s" % ('shape','size','-O0 (s)','-O1 (s)','2x -O0','2x -O1','growth'))
+
+failures=[]
+with tempfile.TemporaryDirectory(prefix='ifcc-compile-') as workdir:
+    for name,shape in SHAPES:
+        times={}
+        for size in [args.size,2*args.size]:
+            source=os.path.join(workdir,'input.c')
+            open(source,'w').write('\n'.join(shape(size))+'\n')
+            times[size]=(compileTime(source,'-O0'),compileTime(source,'-O1'))
+        growth=times[2*args.size][1]/times[args.size][1]
+        print("%-20s %8d %10.3f %10.3f %10.3f %10.3f %8.2f" % (name,args.size,times[args.size][0],times[args.size][1],
+                                                               times[2*args.size][0],times[2*args.size][1],growth))
+        if growth > args.max_growth:
+            failures.append(name)
+
+print()
+for name in failures:
+    print("SUPERLINEAR "+name+": the -O1 time grows more than %.1fx when the function doubles" % args.max_growth)
+
+sys.exit(1 if failures else 0)
@@ -0,0 +1,201 @@
+/*************************************************************************
+                          PLD Compilateur: perf_runner
+                          ---------------------------
+    start   : 26/03/2024
+    authors : ANDRIANARISOLO Elie, FARHAT Widad,
+			  SARR Seynabou, TONG An Jun
+*************************************************************************/
+
+//---- Benchmark runner (file perf_runner.cpp) -----/
+//
+// usage: perf_runner RUNS path/to/program [arguments ...]
+//
+// Runs the program RUNS times and writes on the standard output a JSON
+// object holding the median of every measure: wall-clock time (always),
+// and cycles, instructions, branch misses and L1 data cache read misses
+// when the hardware counters are available through perf_event_open.
+// The counters only count the user-space execution of the program:
+// they are enabled when the program is exec'd.
+//
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+using namespace std;
+
+// Structure to represent a hardware event to count
+struct eventStruct
+{
+	string name;		// Name of the measure in the report
+	uint32_t type;		// perf_event_attr.type
+	uint64_t config;	// perf_event_attr.config
+};
+
+static const vector<eventStruct> events = {
+	{"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+	{"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+	{"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+	{"l1d_misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}
+};
+
+// Open a counter of the event for the process pid, enabled when it calls exec
+static int openCounter(const eventStruct& event, pid_t pid)
+{
+	struct perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = event.type;
+	attr.config = event.config;
+	attr.disabled = 1;
+	attr.enable_on_exec = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	return syscall(SYS_perf_event_open, &attr, pid, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+// Read a counter, scaled when the kernel had to multiplex the counters
+static double readCounter(int fd)
+{
+	uint64_t values[3];
+
+	if (read(fd, values, sizeof(values)) != sizeof(values) || values[2] == 0)
+	{
+		return -1;
+	}
+
+	return (double) values[0] * ((double) values[1] / (double) values[2]);
+}
+
+// Median of a list of measures
+static double median(vector<double> values)
+{
+	sort(values.begin(), values.end());
+	size_t n = values.size();
+	return (n % 2) ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+// Main function
+int main(int argn, char **argv)
+{
+	if (argn < 3 || atoi(argv[1]) <= 0)
+	{
+		cerr << "usage: perf_runner RUNS path/to/program [arguments ...]" << endl;
+		return 1;
+	}
+
+	int runs = atoi(argv[1]);
+	vector<vector<double>> measures(events.size());
+	vector<double> times;
+	vector<bool> available(events.size(), true);
+	int status = 0;
+
+	for (int run = 0; run < runs; run++)
+	{
+		// The program waits on a pipe until its counters are opened
+		int go[2];
+
+		if (pipe(go) < 0)
+		{
+			cerr << "error: cannot create a pipe" << endl;
+			return 1;
+		}
+
+		pid_t pid = fork();
+
+		if (pid < 0)
+		{
+			cerr << "error: cannot fork" << endl;
+			return 1;
+		}
+
+		if (pid == 0) // Program process
+		{
+			char c;
+			close(go[1]);
+			int devNull = open("/dev/null", O_RDWR);
+			dup2(devNull, STDIN_FILENO);
+			dup2(devNull, STDOUT_FILENO);
+
+			if (read(go[0], &c, 1) != 1)
+			{
+				_exit(127);
+			}
+
+			execv(argv[2], argv + 2);
+			_exit(127);
+		}
+
+		close(go[0]);
+
+		vector<int> fds;
+
+		for (size_t e = 0; e < events.size(); e++)
+		{
+			fds.push_back(available[e] ? openCounter(events[e], pid) : -1);
+			available[e] = fds.back() >= 0;
+		}
+
+		// Start the program and measure its wall-clock time
+		struct timespec start, end;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		if (write(go[1], "x", 1) != 1)
+		{
+			cerr << "error: cannot start the program" << endl;
+			return 1;
+		}
+
+		close(go[1]);
+		int waitStatus;
+		waitpid(pid, &waitStatus, 0);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		status = WIFEXITED(waitStatus) ? WEXITSTATUS(waitStatus) : 128 + WTERMSIG(waitStatus);
+		times.push_back((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec));
+
+		for (size_t e = 0; e < events.size(); e++)
+		{
+			if (fds[e] >= 0)
+			{
+				double value = readCounter(fds[e]);
+				available[e] = available[e] && value >= 0;
+				measures[e].push_back(value);
+				close(fds[e]);
+			}
+		}
+	}
+
+	// Report the medians (null for the unavailable counters)
+	cout << "{\"runs\": " << runs << ", \"status\": " << status << ", \"time_ns\": " << (uint64_t) median(times);
+
+	for (size_t e = 0; e < events.size(); e++)
+	{
+		cout << ", \"" << events[e].name << "\": ";
+
+		if (available[e] && measures[e].size() == (size_t) runs)
+		{
+			cout << (uint64_t) median(measures[e]);
+		}
+		else
+		{
+			cout << "null";
+		}
+	}
+
+	cout << "}" << endl;
+
+	return 0;
+}
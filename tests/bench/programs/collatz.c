@@ -0,0 +1,21 @@
+// Data-dependent branches: total length of the Collatz sequences below 100000
+int main()
+{
+    int total = 0;
+    int n = 1;
+    while (n < 100000) {
+        int x = n;
+        while (x != 1) {
+            if (x % 2 == 0) {
+                x = x / 2;
+            } else {
+                x = 3 * x + 1;
+            }
+            total = total + 1;
+        }
+        n = n + 1;
+    }
+    putchar('0' + total % 10);
+    putchar(10);
+    return total % 256;
+}
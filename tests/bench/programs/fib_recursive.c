@@ -0,0 +1,29 @@
+// Recursive calls: fibo(27) makes about 600000 calls
+int fibo(int n)
+{
+    if (n < 2) {
+        return n;
+    }
+    return fibo(n - 1) + fibo(n - 2);
+}
+
+int printInt(int x)
+{
+    int d = 1;
+    while (x / d >= 10) {
+        d = d * 10;
+    }
+    while (d > 0) {
+        putchar('0' + (x / d) % 10);
+        d = d / 10;
+    }
+    putchar(10);
+    return 0;
+}
+
+int main()
+{
+    int r = fibo(27);
+    printInt(r);
+    return r % 256;
+}
@@ -0,0 +1,27 @@
+// Euclid's algorithm in a double loop: modulo and calls
+int gcd(int a, int b)
+{
+    while (b != 0) {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+int main()
+{
+    int sum = 0;
+    int i = 1;
+    while (i < 800) {
+        int j = 1;
+        while (j < 800) {
+            sum = sum + gcd(i, j);
+            j = j + 1;
+        }
+        i = i + 1;
+    }
+    putchar('0' + sum % 10);
+    putchar(10);
+    return sum % 256;
+}
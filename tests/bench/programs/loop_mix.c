@@ -0,0 +1,16 @@
+// Straight-line arithmetic in a long loop: loads, stores and ALU operations
+int main()
+{
+    int i = 0;
+    int s = 0;
+    int t = 7;
+    while (i < 20000000) {
+        s = s + (i % 7) * 3 - (i & 5);
+        t = (t ^ s) | (i + 1);
+        i = i + 1;
+    }
+    putchar('A' + (s & 15));
+    putchar('A' + (t & 15));
+    putchar(10);
+    return (s + t) & 255;
+}
@@ -0,0 +1,41 @@
+// Trial division: divisions and nested loops
+int isPrime(int n)
+{
+    int d = 2;
+    if (n < 2) {
+        return 0;
+    }
+    while (d * d <= n) {
+        if (n % d == 0) {
+            return 0;
+        }
+        d = d + 1;
+    }
+    return 1;
+}
+
+int printInt(int x)
+{
+    int d = 1;
+    while (x / d >= 10) {
+        d = d * 10;
+    }
+    while (d > 0) {
+        putchar('0' + (x / d) % 10);
+        d = d / 10;
+    }
+    putchar(10);
+    return 0;
+}
+
+int main()
+{
+    int count = 0;
+    int n = 0;
+    while (n < 200000) {
+        count = count + isPrime(n);
+        n = n + 1;
+    }
+    printInt(count);
+    return count % 256;
+}
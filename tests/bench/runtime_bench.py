@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+
+# This script measures the execution speed of the code generated by IFCC
+# against the code generated by GCC at -O0 and -O2.
+#
+# input: compute-heavy programs of the supported C subset (by default the
+#        complete programs of tests/testfiles/12_complete_program and the
+#        longer loops of tests/bench/programs)
+#
+# output: for every program and every compiler, the median over several
+#         runs of the wall-clock time and, when the hardware counters are
+#         available, of the cycles, instructions, branch misses and L1 data
+#         cache misses (measured by perf_runner with perf_event_open)
+#
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR=os.path.dirname(os.path.realpath(__file__))
+MEASURES=[('time_ns','time (ms)',1e-6),('cycles','cycles (M)',1e-6),('instructions','instrs (M)',1e-6),
+          ('branch_misses','br-miss (K)',1e-3),('l1d_misses','L1-miss (K)',1e-3)]
+
+######################################################################################
+## ARGPARSE step: make sense of our command-line arguments
+
+argparser   = argparse.ArgumentParser(
+description = "Build programs with IFCC, gcc -O0 and gcc -O2 and compare their execution.",
+epilog      = ""
+)
+
+argparser.add_argument('input',metavar='PATH',nargs='*',
+                       help='Programs to measure (default: 12_complete_program and tests/bench/programs)')
+argparser.add_argument('-c','--compiler',metavar='PATH',default=SCRIPT_DIR+'/../../compiler/ifcc',
+                       help='Path of the ifcc executable (default: compiler/ifcc)')
+argparser.add_argument('-r','--runs',metavar='N',type=int,default=5,
+                       help='Number of runs of every program (default: 5)')
+argparser.add_argument('-f','--flags',metavar='FLAGS',default='',
+                       help='Extra options given to ifcc (e.g. "-O0")')
+argparser.add_argument('-j','--json',metavar='PATH',
+                       help='Also write the raw results to a JSON file')
+
+args=argparser.parse_args()
+
+programs=args.input or sorted(glob.glob(SCRIPT_DIR+'/../testfiles/12_complete_program/*.c')
+                               +glob.glob(SCRIPT_DIR+'/programs/*.c'))
+
+def build(command):
+    """run a build command, return whether it succeeded"""
+    return subprocess.run(command,stdin=subprocess.DEVNULL,stdout=subprocess.DEVNULL,stderr=subprocess.DEVNULL).returncode == 0
+
+def execute(executable):
+    """run a program once, return its output and exit status"""
+    process=subprocess.run([executable],stdin=subprocess.DEVNULL,stdout=subprocess.PIPE,stderr=subprocess.DEVNULL)
+    return process.stdout,process.returncode
+
+def formatMeasure(value,scale):
+    return '-' if value is None else '%.2f' % (value*scale)
+
+results={}
+with tempfile.TemporaryDirectory(prefix='ifcc-runtime-') as workdir:
+    runner=os.path.join(workdir,'perf_runner')
+    if not build(['g++','-O2','-o',runner,SCRIPT_DIR+'/perf_runner.cpp']):
+        print("error: cannot build perf_runner")
+        sys.exit(1)
+
+    # gcc -O0 comes first: its behaviour is the reference
+    compilers=[('gcc -O0',lambda source,exe: ['gcc','-w','-O0','-o',exe,source]),
+               ('gcc -O2',lambda source,exe: ['gcc','-w','-O2','-o',exe,source]),
+               ('ifcc',lambda source,exe: [args.compiler]+args.flags.split()+['-o',exe,source])]
+
+    header='%-28s %-8s' % ('program','compiler')+''.join(' %12s' % title for _,title,_ in MEASURES)
+    print(header)
+    print('-'*len(header))
+
+    for source in programs:
+        name=os.path.basename(source)[:-2]
+        results[name]={}
+        reference=None
+        for compiler,command in compilers:
+            exe=os.path.join(workdir,name+'-'+compiler.replace(' ','').replace('-',''))
+            if not build(command(source,exe)):
+                print('%-28s %-8s build failed' % (name,compiler))
+                continue
+
+            # every build must behave like the reference for the numbers to be comparable
+            behaviour=execute(exe)
+            if reference is None:
+                reference=behaviour
+
+            process=subprocess.run([runner,str(args.runs),exe],stdout=subprocess.PIPE,stderr=subprocess.DEVNULL)
+            measure=json.loads(process.stdout)
+            measure['output_matches']=behaviour == reference
+            results[name][compiler]=measure
+
+            print('%-28s %-8s' % (name,compiler)
+                  +''.join(' %12s' % formatMeasure(measure.get(key),scale) for key,_,scale in MEASURES)
+                  +('' if measure['output_matches'] else '  (different output)'))
+
+        # how far we are from gcc -O2
+        if 'ifcc' in results[name] and 'gcc -O2' in results[name]:
+            ours=results[name]['ifcc']
+            theirs=results[name]['gcc -O2']
+            ratios=['%s x%.2f' % (key.split('_')[0],ours[key]/theirs[key])
+                    for key in ('time_ns','cycles','instructions') if ours.get(key) and theirs.get(key)]
+            print('%-28s %-8s %s' % ('','ifcc/O2',', '.join(ratios)))
+
+if args.json:
+    with open(args.json,'w') as f:
+        json.dump(results,f,indent=1,sort_keys=True)
+        f.write('\n')
@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+
+# This script runs IFCC on each golden test-case and compares its output
+# with the checked-in expected output.
+#
+# input: the test-cases are the directories holding a `command` file, given
+#        either as individual command-line arguments or as part of a
+#        directory tree (default: tests/golden). A test-case directory holds:
+#        - command: the arguments of ifcc, on one line (run in the directory)
+#        - messages.jsonl (optional): JSON-RPC messages, one per line, sent
+#          on the standard input with their Content-Length header (--lsp);
+#          the lines starting with # are comments
+#        - expected: the expected standard output (the messages answered by
+#          the language server are written one per line, without header)
+#        - expected-stderr (optional): the expected standard error (e.g. the
+#          counters of --stats); it is only compared when the file exists
+#
+# output: the list of the test-cases whose output differs from the
+#         expected one (and the difference with -v)
+#
+# The script is divided in two distinct steps:
+# - in the ARGPARSE step, we understand the command-line arguments
+# - in the TEST step, we run IFCC on each test-case and compare (or update) its output
+#
+
+import argparse
+import difflib
+import os
+import subprocess
+import sys
+
+SCRIPT_DIR=os.path.dirname(os.path.realpath(__file__))
+
+######################################################################################
+## ARGPARSE step: make sense of our command-line arguments
+
+argparser   = argparse.ArgumentParser(
+description = "Run IFCC on golden test-cases and compare its output with the expected one.",
+epilog      = ""
+)
+
+argparser.add_argument('input',metavar='PATH',nargs='*',default=[SCRIPT_DIR+'/golden'],
+                       help='Test-case directories, or trees of test-cases (default: tests/golden)')
+argparser.add_argument('-c','--compiler',metavar='PATH',default=SCRIPT_DIR+'/../compiler/ifcc',
+                       help='Path of the ifcc executable (default: compiler/ifcc)')
+argparser.add_argument('-u','--update',action="store_true",
+                       help='Write the current outputs as the new expected outputs instead of comparing')
+argparser.add_argument('-v','--verbose',action="count",default=0,
+                       help='Increase verbosity level (show the difference of every failing test-case)')
+
+args=argparser.parse_args()
+
+if not os.path.isfile(args.compiler):
+    print("error: cannot find the compiler: "+args.compiler)
+    sys.exit(1)
+
+compiler=os.path.realpath(args.compiler)
+
+## the test-cases are the directories holding a command file
+jobs=[]
+for path in args.input:
+    path=os.path.normpath(path)
+    if not os.path.isdir(path):
+        print("error: cannot read input directory `"+path+"'")
+        sys.exit(1)
+    for dirpath,dirnames,filenames in os.walk(path):
+        if 'command' in filenames:
+            jobs.append(dirpath)
+
+if len(jobs) == 0:
+    print("error: found no test-case in: "+" ".join(args.input))
+    sys.exit(1)
+
+######################################################################################
+## JSON-RPC framing of the language server messages
+
+def frameMessages(lines):
+    """messages of a transcript, each one preceded by its Content-Length header"""
+    data=b''
+    for line in lines:
+        if line.strip() == '' or line.startswith('#'):
+            continue
+        content=line.strip().encode('utf-8')
+        data+=b'Content-Length: '+str(len(content)).encode()+b'\r\n\r\n'+content
+    return data
+
+def unframeMessages(data):
+    """content of the messages written by the server, one per line"""
+    messages=[]
+    while data:
+        headerEnd=data.find(b'\r\n\r\n')
+        if headerEnd < 0:
+            messages.append('<truncated header> '+data.decode('utf-8','replace'))
+            break
+        length=0
+        for header in data[:headerEnd].split(b'\r\n'):
+            if header.startswith(b'Content-Length:'):
+                length=int(header.split(b':')[1])
+        messages.append(data[headerEnd+4:headerEnd+4+length].decode('utf-8','replace'))
+        data=data[headerEnd+4+length:]
+    return ''.join(message+'\n' for message in messages)
+
+######################################################################################
+## TEST step: run IFCC on each test-case and compare its output
+
+failures=[]
+for jobname in sorted(jobs):
+    name=os.path.relpath(jobname,SCRIPT_DIR)
+    arguments=open(os.path.join(jobname,'command')).read().split()
+    transcript=os.path.join(jobname,'messages.jsonl')
+    stdin=frameMessages(open(transcript).readlines()) if os.path.isfile(transcript) else b''
+
+    try:
+        process=subprocess.run([compiler]+arguments,cwd=jobname,input=stdin,
+                               stdout=subprocess.PIPE,stderr=subprocess.PIPE,timeout=60)
+    except subprocess.TimeoutExpired:
+        print("TEST FAIL (timeout): "+name)
+        failures.append(name)
+        continue
+
+    output=unframeMessages(process.stdout) if os.path.isfile(transcript) else process.stdout.decode('utf-8','replace')
+    if process.returncode != 0:
+        output+='[exit status %d]\n' % process.returncode
+
+    expectedfile=os.path.join(jobname,'expected')
+    errorfile=os.path.join(jobname,'expected-stderr')
+    error=process.stderr.decode('utf-8','replace')
+    if args.update:
+        open(expectedfile,'w').write(output)
+        if os.path.isfile(errorfile):
+            open(errorfile,'w').write(error)
+        print("UPDATED: "+name)
+        continue
+
+    expected=open(expectedfile).read() if os.path.isfile(expectedfile) else ''
+    if output != expected:
+        print("TEST FAIL (different output): "+name)
+        failures.append(name)
+        if args.verbose:
+            sys.stdout.writelines(difflib.unified_diff(expected.splitlines(True),output.splitlines(True),'expected','ifcc'))
+        continue
+
+    expectederror=open(errorfile).read() if os.path.isfile(errorfile) else error
+    if error != expectederror:
+        print("TEST FAIL (different standard error): "+name)
+        failures.append(name)
+        if args.verbose:
+            sys.stdout.writelines(difflib.unified_diff(expectederror.splitlines(True),error.splitlines(True),'expected-stderr','ifcc'))
+        continue
+
+    print("TEST OK: "+name)
+
+if not args.update:
+    print()
+    print("%d test-cases, %d failures" % (len(jobs),len(failures)))
+
+sys.exit(1 if failures else 0)
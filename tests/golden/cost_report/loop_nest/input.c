@@ -0,0 +1,24 @@
+int sum(int n)
+{
+    int total = 0;
+    int i = 0;
+    while (i < n)
+    {
+        int j = 0;
+        while (j < i)
+        {
+            total = total + i / (j + 1);
+            j = j + 1;
+        }
+        i = i + 1;
+    }
+    return total;
+}
+
+int main()
+{
+    int s = sum(10);
+    putchar('0' + s % 10);
+    putchar(10);
+    return 0;
+}
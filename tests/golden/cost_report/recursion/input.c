@@ -0,0 +1,41 @@
+int fact(int n)
+{
+    if (n <= 1)
+    {
+        return 1;
+    }
+    return n * fact(n - 1);
+}
+
+int isEven(int n)
+{
+    if (n == 0)
+    {
+        return 1;
+    }
+    return isOdd(n - 1);
+}
+
+int isOdd(int n)
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+    return isEven(n - 1);
+}
+
+int add8(int a, int b, int c, int d, int e, int f, int g, int h)
+{
+    return a + b + c + d + e + f + g + h;
+}
+
+int twice(int x)
+{
+    return add8(x, x, 0, 0, 0, 0, 0, 0);
+}
+
+int main()
+{
+    return fact(5) + twice(3) + isEven(4);
+}
@@ -0,0 +1,30 @@
+int f0(int p0, int p1, int p2, char p3, char p4, char p5, int p6, int p7, int p8)
+{
+    return p4;
+}
+
+int g(int v0)
+{
+    char v1 = '0';
+    int total = 0;
+    if (v0 > 5)
+    {
+        total = total + 1;
+    }
+    else
+    {
+        int j = 0;
+        while (j < f0(1, 2, 3, 'x', v1, 'y', 4, 5, 6))
+        {
+            total = total + 1;
+            j = j + 16;
+        }
+        v1 = v0;
+    }
+    return total + v1;
+}
+
+int main()
+{
+    return g(3) + g(8);
+}
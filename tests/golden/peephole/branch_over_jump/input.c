@@ -0,0 +1,21 @@
+// The test of the if jumps over the jump to the join, to the label of its body: it becomes a jle to
+// the join. The test of the loop jumps back to the body, not to the next label: the jl is kept
+int clamp(int x)
+{
+    int n;
+    n = 0;
+    if (x > 10)
+    {
+        x = 10;
+    }
+    while (n < x)
+    {
+        n = n + 3;
+    }
+    return n;
+}
+
+int main()
+{
+    return clamp(20);
+}
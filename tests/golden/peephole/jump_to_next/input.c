@@ -0,0 +1,17 @@
+// The jumps from the end of the body to the test and from the test to the exit go to the next label
+// and are removed, the jump from the entry to the test skips the label of the body and is kept
+int count(int n)
+{
+    int i;
+    i = 0;
+    while (i < n)
+    {
+        i = i + 1;
+    }
+    return i;
+}
+
+int main()
+{
+    return count(3);
+}
@@ -0,0 +1,27 @@
+int id(int x)
+{
+    return x;
+}
+
+// The result of the call is moved back into %eax just after being moved out of it
+int reload()
+{
+    return id(1);
+}
+
+// a is moved back into %eax after the label of the join: another block jumps there, the move is kept
+int acrossLabel(int x)
+{
+    int a;
+    a = 0;
+    if (x > 0)
+    {
+        a = x + 1;
+    }
+    return a;
+}
+
+int main()
+{
+    return reload() + acrossLabel(2);
+}
@@ -0,0 +1,16 @@
+// a and b are kept in the registers they are passed in (%edi and %esi): their moves are removed
+int sum6(int a, int b, int c, int d, int e, char f)
+{
+    return a + b + c + d + e + f;
+}
+
+// movzbl %al, %eax extends the result of setl into its register: it is not a move, it is kept
+int less(int a, int b)
+{
+    return a < b;
+}
+
+int main()
+{
+    return sum6(1, 2, 3, 4, 5, 6) + less(1, 2);
+}
@@ -0,0 +1,28 @@
+// c is tested just after being computed by setl: the branch jumps on the flags of its comparison
+int cond(int a, int b)
+{
+    int c;
+    c = a < b;
+    if (c)
+    {
+        return 1;
+    }
+    return 2;
+}
+
+// c is tested after the label of the loop: the flags may come from the body, the comparison is kept
+int loopCond(int a, int b)
+{
+    int c;
+    c = a < b;
+    while (c)
+    {
+        c = c - 1;
+    }
+    return c;
+}
+
+int main()
+{
+    return cond(1, 2) + loopCond(1, 2);
+}
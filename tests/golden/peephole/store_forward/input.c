@@ -0,0 +1,33 @@
+int id(int x)
+{
+    return x;
+}
+
+// t is spilled (a to e are live across the call): it is passed from the register just stored instead of its slot
+int forward(int a, int b, int c, int d, int e)
+{
+    int t;
+    int s;
+    t = a * 3;
+    s = id(t);
+    return s + a + b + c + d + e + t;
+}
+
+// t is read after the label of the join: the slot may hold the value stored by either block, the load is kept
+int join(int a, int b, int c, int d, int e)
+{
+    int t;
+    int s;
+    t = a;
+    if (b > 0)
+    {
+        t = a * 3;
+    }
+    s = id(t);
+    return s + a + b + c + d + e + t;
+}
+
+int main()
+{
+    return forward(1, 2, 3, 4, 5) + join(1, 2, 3, 4, 5);
+}
@@ -0,0 +1,25 @@
+// n = 0 is followed by the comparison of x, and return 0 by ret: the flags are written before
+// being read, 0 is loaded with xorl. i = 0 is followed by the jump to the test of the loop: the
+// flags may be read there, 0 is loaded with movl
+int zero(int x)
+{
+    int n;
+    int i;
+    n = 0;
+    if (x > 10)
+    {
+        i = 0;
+        while (i < x)
+        {
+            n = n + i;
+            i = i + 1;
+        }
+        return n;
+    }
+    return 0;
+}
+
+int main()
+{
+    return zero(20);
+}
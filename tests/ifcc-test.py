@@ -60,6 +60,10 @@ argparser.add_argument('-v','--verbose',action="count",default=0,
                        help='Increase verbosity level. You can use this option multiple times.')
 argparser.add_argument('-w','--wrapper',metavar='PATH',
                        help='Invoke your compiler through the shell script at PATH. (default: `ifcc-wrapper.sh`)')
+argparser.add_argument('-j','--jit',action="store_true",
+                       help='Execute the programs in memory with `ifcc --run` instead of assembling and linking them.')
+argparser.add_argument('-i','--interp',action="store_true",
+                       help='Execute the programs with the IR interpreter (`ifcc --interp`) instead of assembling and linking them.')
 
 args=argparser.parse_args()
 
@@ -144,6 +148,9 @@ for inputfilename in inputfilenames:
     subdir='ifcc-test-output/'+inputfilename.strip("./")[:-2].replace('/','-')
     os.mkdir(subdir)
     shutil.copyfile(inputfilename, subdir+'/input.c')
+    ## the headers next to the test-case go with it (for its #include "...")
+    for header in glob.glob(os.path.join(os.path.dirname(inputfilename),'*.h')):
+        shutil.copyfile(header, subdir+'/'+os.path.basename(header))
     jobs.append(subdir)
 
 ## eliminate duplicate paths from the 'jobs' list
@@ -196,6 +203,9 @@ for jobname in jobs:
         if args.verbose:
             dumpfile("ifcc-compile.txt")
         continue
+    elif args.jit or args.interp:
+        ## ifcc accepts to compile valid program -> it runs it without linking
+        pass
     else:
         ## ifcc accepts to compile valid program -> let's link it
         ldstatus=command("gcc -o exe-ifcc asm-ifcc.s", "ifcc-link.txt")
@@ -208,7 +218,12 @@ for jobname in jobs:
     ## both compilers  did produce an  executable, so now we  run both
     ## these executables and compare the results.
         
-    command("./exe-ifcc","ifcc-execute.txt")
+    if args.interp:
+        command("("+os.path.dirname(wrapper)+"/../compiler/ifcc --interp input.c 2>/dev/null)","ifcc-execute.txt")
+    elif args.jit:
+        command("("+os.path.dirname(wrapper)+"/../compiler/ifcc --run input.c 2>/dev/null)","ifcc-execute.txt")
+    else:
+        command("./exe-ifcc","ifcc-execute.txt")
     if open("gcc-execute.txt").read() != open("ifcc-execute.txt").read() :
         print("TEST FAIL (different results at execution)")
         if args.verbose:
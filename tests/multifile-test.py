@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+
+# This script builds each multi-file test-case with GCC as well as with
+# the executable mode of IFCC (ifcc -o exe a.c b.c, separately or as a
+# whole program), runs both executables, and compares the results.
+#
+# input: the test-cases are the directories holding several .c files,
+#        given either as individual command-line arguments or as part of
+#        a directory tree (default: tests/multifile). A test-case may also
+#        hold a whole-program.checks file, checked on the assembly of
+#        ifcc --whole-program (one check per line, # starts a comment):
+#        - defined NAME / not-defined NAME: the function NAME is generated
+#        - called NAME / not-called NAME: a call to NAME is generated
+#        - reads NAME REGISTER / not-reads NAME REGISTER: the code of the
+#          function NAME uses REGISTER (e.g. the register of a parameter)
+#
+# output: for every test-case and every mode of IFCC, whether the output
+#         and the exit status of its executable are those of GCC's, and
+#         whether the checks hold
+#
+# The script is divided in two distinct steps:
+# - in the ARGPARSE step, we understand the command-line arguments
+# - in the TEST step, we build and run every test-case with both compilers
+#
+
+import argparse
+import glob
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+SCRIPT_DIR=os.path.dirname(os.path.realpath(__file__))
+
+## modes of IFCC: the options given before the source files
+MODES=[('separate',['-o','exe-ifcc']),
+       ('separate -O0',['-O0','-o','exe-ifcc']),
+       ('whole program',['--whole-program','-o','exe-ifcc']),
+       ('whole program -O0',['-O0','--whole-program','-o','exe-ifcc'])]
+
+######################################################################################
+## ARGPARSE step: make sense of our command-line arguments
+
+argparser   = argparse.ArgumentParser(
+description = "Build multi-file programs with both GCC and IFCC, run them, and compare the results.",
+epilog      = ""
+)
+
+argparser.add_argument('input',metavar='PATH',nargs='*',default=[SCRIPT_DIR+'/multifile'],
+                       help='Test-case directories, or trees of test-cases (default: tests/multifile)')
+argparser.add_argument('-c','--compiler',metavar='PATH',default=SCRIPT_DIR+'/../compiler/ifcc',
+                       help='Path of the ifcc executable (default: compiler/ifcc)')
+argparser.add_argument('-v','--verbose',action="count",default=0,
+                       help='Increase verbosity level (show the outputs of the failing test-cases)')
+
+args=argparser.parse_args()
+
+if not os.path.isfile(args.compiler):
+    print("error: cannot find the compiler: "+args.compiler)
+    sys.exit(1)
+
+compiler=os.path.realpath(args.compiler)
+
+## the test-cases are the directories holding several source files
+jobs=[]
+for path in args.input:
+    path=os.path.normpath(path)
+    if not os.path.isdir(path):
+        print("error: cannot read input directory `"+path+"'")
+        sys.exit(1)
+    for dirpath,dirnames,filenames in os.walk(path):
+        if len([name for name in filenames if name[-2:] == '.c']) > 1:
+            jobs.append(dirpath)
+
+if len(jobs) == 0:
+    print("error: found no test-case in: "+" ".join(args.input))
+    sys.exit(1)
+
+######################################################################################
+## TEST step: build and run every test-case with both compilers
+
+def execute(command, workdir):
+    """exit status and output of a command (the status of a timeout is None)"""
+    try:
+        process=subprocess.run(command,cwd=workdir,stdin=subprocess.DEVNULL,
+                               stdout=subprocess.PIPE,stderr=subprocess.STDOUT,timeout=60)
+    except subprocess.TimeoutExpired:
+        return None,''
+    return process.returncode,process.stdout.decode('utf-8','replace')
+
+def functionCode(assembly, name):
+    """lines of the code of a function, from its label to the end of its unwind information"""
+    lines=assembly.splitlines()
+    if name+':' not in lines:
+        return []
+    start=lines.index(name+':')
+    end=start
+    while end < len(lines) and lines[end].strip() != '.cfi_endproc':
+        end+=1
+    return lines[start:end]
+
+def checkAssembly(assembly, check):
+    """whether a check of whole-program.checks holds on the assembly"""
+    words=check.split()
+    negated=words[0].startswith('not-')
+    kind=words[0][4:] if negated else words[0]
+    if kind == 'defined':
+        holds=words[1]+':' in assembly.splitlines()
+    elif kind == 'called':
+        holds=any(line.split() == ['call',words[1]] for line in assembly.splitlines())
+    elif kind == 'reads':
+        holds=any(words[2] in line.split('#')[0] for line in functionCode(assembly,words[1]))
+    else:
+        print("error: unknown check: "+check)
+        sys.exit(1)
+    return holds != negated
+
+failures=[]
+for jobname in sorted(jobs):
+    name=os.path.relpath(jobname,SCRIPT_DIR)
+    with tempfile.TemporaryDirectory(prefix='ifcc-multifile-') as workdir:
+        sources=sorted(os.path.basename(source) for source in glob.glob(os.path.join(jobname,'*.c')))
+        for source in sources:
+            shutil.copyfile(os.path.join(jobname,source),os.path.join(workdir,source))
+
+        ## Reference compiler = GCC
+        status,output=execute(['gcc','-w','-o','exe-gcc']+sources,workdir)
+        if status != 0:
+            print("TEST FAIL (gcc rejects the program): "+name)
+            failures.append(name)
+            continue
+        expected=execute(['./exe-gcc'],workdir)
+
+        ## IFCC compiler, in every mode
+        for mode,options in MODES:
+            testname=name+' ('+mode+')'
+            status,output=execute([compiler]+options+sources,workdir)
+            if status != 0:
+                print("TEST FAIL (your compiler rejects a valid program): "+testname)
+                failures.append(testname)
+                if args.verbose:
+                    print(output)
+                continue
+
+            result=execute(['./exe-ifcc'],workdir)
+            if result != expected:
+                print("TEST FAIL (different results at execution): "+testname)
+                failures.append(testname)
+                if args.verbose:
+                    print("GCC (exit status %s):" % expected[0])
+                    print(expected[1])
+                    print("you (exit status %s):" % result[0])
+                    print(result[1])
+                continue
+
+            print("TEST OK: "+testname)
+
+        ## Checks of the whole program optimizations
+        checksfile=os.path.join(jobname,'whole-program.checks')
+        if os.path.isfile(checksfile):
+            testname=name+' (whole program checks)'
+            status,assembly=execute([compiler,'--whole-program']+sources,workdir)
+            checks=[line.strip() for line in open(checksfile) if line.strip() != '' and not line.startswith('#')]
+            failed=[check for check in checks if not checkAssembly(assembly,check)]
+            if failed:
+                print("TEST FAIL (the assembly does not pass every check): "+testname)
+                failures.append(testname)
+                for check in failed:
+                    print("  failed: "+check)
+                continue
+
+            print("TEST OK: "+testname)
+
+print()
+print("%d test-cases, %d failures" % (len(jobs),len(failures)))
+
+sys.exit(1 if failures else 0)
@@ -0,0 +1,19 @@
+int show(int n)
+{
+    int digit = n % 10;
+    if (n >= 10)
+    {
+        show(n / 10);
+    }
+    putchar('0' + digit);
+    return n;
+}
+
+int main()
+{
+    show(sumSquares(10));
+    putchar(32);
+    show(sumConstant(5, 7));
+    putchar(10);
+    return sumSquares(3);
+}
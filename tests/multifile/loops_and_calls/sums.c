@@ -0,0 +1,28 @@
+int square(int x)
+{
+    return x * x;
+}
+
+int sumSquares(int n)
+{
+    int total = 0;
+    int i = 1;
+    while (i <= n)
+    {
+        total = total + square(i);
+        i = i + 1;
+    }
+    return total;
+}
+
+int sumConstant(int n, int k)
+{
+    int total = 0;
+    int i = 0;
+    while (i < n)
+    {
+        total = total + square(k) + k / 3;
+        i = i + 1;
+    }
+    return total;
+}
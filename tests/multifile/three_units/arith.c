@@ -0,0 +1,22 @@
+int mulAdd(int a, int b, int c, int d, int e, int f, int g, int h)
+{
+    return a * b + c * d + e * f + g * h;
+}
+
+int fact(int n)
+{
+    if (n <= 1)
+    {
+        return 1;
+    }
+    return n * fact(n - 1);
+}
+
+int isEven(int n)
+{
+    if (n == 0)
+    {
+        return 1;
+    }
+    return isOdd(n - 1);
+}
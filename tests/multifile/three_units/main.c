@@ -0,0 +1,8 @@
+int main()
+{
+    printNumber(mulAdd(1, 2, 3, 4, 5, 6, 7, 8));
+    printNumber(fact(6));
+    printNumber(isEven(7));
+    printNumber(isEven(10));
+    return fact(4) + isOdd(3);
+}
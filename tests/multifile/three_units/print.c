@@ -0,0 +1,25 @@
+int isOdd(int n)
+{
+    if (n == 0)
+    {
+        return 0;
+    }
+    return isEven(n - 1);
+}
+
+int printDigits(int n)
+{
+    if (n >= 10)
+    {
+        printDigits(n / 10);
+    }
+    putchar('0' + n % 10);
+    return 0;
+}
+
+int printNumber(int n)
+{
+    printDigits(n);
+    putchar(10);
+    return 0;
+}
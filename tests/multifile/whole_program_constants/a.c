@@ -0,0 +1,31 @@
+int offsetBy(int x, int delta)
+{
+    if (x < 0)
+    {
+        return x - delta;
+    }
+    return x + delta;
+}
+
+int mixed(int x, int k)
+{
+    if (x > k)
+    {
+        return x * k;
+    }
+    return x + k;
+}
+
+int low(char c)
+{
+    if (c > 100)
+    {
+        return c - 100;
+    }
+    return c;
+}
+
+int fromA(int n)
+{
+    return offsetBy(n, 10) + mixed(n, 2) + low(300);
+}
@@ -0,0 +1,36 @@
+int halfConstant(int x, int k)
+{
+    if (x > k)
+    {
+        return x - k;
+    }
+    return k - x;
+}
+
+int countDown(int n, int step)
+{
+    if (n <= 0)
+    {
+        return 0;
+    }
+    return 1 + countDown(n - step, step);
+}
+
+int fromB(int n)
+{
+    return mixed(n, 5) + halfConstant(n, n + 1) + countDown(n, 1);
+}
+
+int unusedA(int x)
+{
+    if (x > 0)
+    {
+        return unusedB(x - 1);
+    }
+    return 0;
+}
+
+int unusedB(int x)
+{
+    return unusedA(x) + 1;
+}
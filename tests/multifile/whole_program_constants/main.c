@@ -0,0 +1,12 @@
+int main()
+{
+    int total = offsetBy(1, 10) + offsetBy(2, 10);
+    int n = 4;
+    putchar('0' + total % 10);
+    putchar('0' + mixed(3, 2) % 10);
+    putchar('0' + halfConstant(9, 7) % 10);
+    putchar('0' + countDown(6, 2));
+    putchar('0' + low(300) % 10);
+    putchar(10);
+    return fromA(n) + fromB(n) + total;
+}
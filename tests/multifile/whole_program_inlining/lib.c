@@ -0,0 +1,41 @@
+int scale(int x, int k)
+{
+    x = x * k;
+    return x + 1;
+}
+
+int mix(int a, int b)
+{
+    int x = a - b;
+    int k = a + b;
+    return x * k;
+}
+
+int printNumber(int n)
+{
+    if (n < 0)
+    {
+        putchar('-');
+        n = 0 - n;
+    }
+    if (n >= 10)
+    {
+        printNumber(n / 10);
+    }
+    putchar('0' + n % 10);
+    return 0;
+}
+
+int unusedHelper(int x)
+{
+    return unusedLoop(x) * 42;
+}
+
+int unusedLoop(int x)
+{
+    while (x > 0)
+    {
+        x = unusedHelper(x - 1);
+    }
+    return getchar();
+}
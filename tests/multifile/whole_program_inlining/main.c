@@ -0,0 +1,27 @@
+int main()
+{
+    int x = 5;
+    int k = 3;
+    int a = scale(x, k);
+    int b = scale(a, x);
+    int sum = 0;
+    int i = 0;
+    while (i < 4)
+    {
+        sum = sum + scale(i, i) + mix(k, i);
+        i = i + 1;
+    }
+    printNumber(x);
+    putchar(32);
+    printNumber(k);
+    putchar(32);
+    printNumber(a);
+    putchar(32);
+    printNumber(b);
+    putchar(32);
+    printNumber(sum);
+    putchar(32);
+    printNumber(mix(x, a));
+    putchar(10);
+    return scale(k, k);
+}
@@ -0,0 +1,28 @@
+int digits(int x)
+{
+    int sum = 0;
+    while (x != 0)
+    {
+        sum = sum + x % 10;
+        x = x / 10;
+    }
+    return sum;
+}
+
+int mix(int x)
+{
+    int a = x / 8 + x % 8;
+    int b = x / -4 + x % -16;
+    int c = x / 7 - x % 7 + x / -3;
+    int d = x * 8 + x * 9 - x * 12 + x * -5;
+    int e = x;
+    e /= 100;
+    return a + b + c + d + e;
+}
+
+int main()
+{
+    int t = digits(12345) + digits(-9876) + digits(2147483647);
+    t = t + mix(1000) + mix(-1000) + mix(-7) + mix(13) + mix(-214748);
+    return t % 256;
+}
@@ -0,0 +1,12 @@
+int main()
+{
+    int a = 2 * 3 + 1;
+    int b = 2147483647 + 1;
+    int c = -7 / 2 + -7 % 2;
+    char d = 'a' + 200;
+    int e = ('z' > 'a') + (3 <= 3) + (4 != 4) + !0 + !'x';
+    int f = (5 ^ 3 | 8 & 12) - -(65536 * 65536);
+    int g = b / 2;
+    char h = 300;
+    return (a + c + d + e + f + g + h) & 255;
+}
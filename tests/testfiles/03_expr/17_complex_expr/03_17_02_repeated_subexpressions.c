@@ -0,0 +1,25 @@
+int mix(int x, int y)
+{
+    int a = (x * 3 + y) / 7;
+    int b = 0;
+    if ((x * 3 + y) / 7 > 10)
+    {
+        b = (y + x * 3) % 5 - (x * 3 + y) / 7;
+        x = x + 1;
+    }
+    else
+    {
+        b = (x * 3 + y) / 7 + (x * 3 + y) % 5;
+    }
+    while (x * 3 + y < 100)
+    {
+        b = b + (x * 3 + y) / 7;
+        x = x + 4;
+    }
+    return a * 100 + b + (x * 3 + y) / 7;
+}
+
+int main()
+{
+    return (mix(2, 5) + mix(30, -4) + mix(-9, 1)) % 256;
+}
@@ -0,0 +1,22 @@
+int many(int a, int b, int c, int d, int e, int f, int g, char h)
+{
+    return a + b * 2 + c * 3 - d + e / 2 + f % 7 + g * 11 + h;
+}
+
+int main()
+{
+    char c = 100;
+    int x = 17;
+    int t = 0;
+    t = t + many(1, -2, 3, 4, 5, 6, -7, 'z');
+    t = t + many(x, x, x, 9, 10, 11, -12, 120);
+    t = t + (c > 50) + (50 < c) + (x / 3) + (x % 5) + (3 - x) + (-100 / x) + (c / 3) + (c % 7);
+    t = t + (x & 12) + (5 | x) + (x ^ 255) + 7 * x;
+    if (5 <= x)
+        t = t + 1;
+    if (c == 100)
+        t = t + 100;
+    putchar('0' + t % 10);
+    putchar(10);
+    return t % 256;
+}
@@ -0,0 +1,8 @@
+int main() {
+    char d = -100;
+    int a = 1000;
+    char c = -3;
+    int q = a / c;
+    int r = d / 7;
+    return q + r + 60;
+}
@@ -0,0 +1,12 @@
+int main() {
+    int a = 256;
+    char c = 0;
+    int n = 0;
+    if (c) {
+        n = 1;
+    }
+    if (!c) {
+        n = n + 2;
+    }
+    return n + a / 256;
+}
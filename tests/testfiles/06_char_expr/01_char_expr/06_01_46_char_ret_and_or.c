@@ -0,0 +1,12 @@
+int widen(int x) {
+    char c = x;
+    return c;
+}
+
+int main() {
+    int a = 1000;
+    char c = 'A';
+    int m = c & a;
+    int o = c | 2;
+    return widen(300) / 16 + m + o - 70;
+}
@@ -0,0 +1,32 @@
+int id(int x) {
+    return x;
+}
+
+int main() {
+    char a = '1';
+    char b = '2';
+    char c = '3';
+    char d = '4';
+    char e = '5';
+    char f = '6';
+    char g = '7';
+    char h = '8';
+    a += id(1);
+    b += id(1);
+    c += id(1);
+    d += id(1);
+    e += id(1);
+    f += id(1);
+    g += id(1);
+    h += id(1);
+    putchar(a);
+    putchar(b);
+    putchar(c);
+    putchar(d);
+    putchar(e);
+    putchar(f);
+    putchar(g);
+    putchar(h);
+    putchar(10);
+    return 0;
+}
@@ -0,0 +1,8 @@
+int digits(int a, int b, int c, int d, int e, int f, int g, int h, int i) {
+    return g*100 + h*10 + i - a - b - c - d - e - f;
+}
+
+int main() {
+    int x = 2;
+    return digits(0, 0, 0, 0, 0, 0, 1, x, 3) - 100;
+}
@@ -0,0 +1,10 @@
+void f() {
+    int y = 0;
+    y = y + 1;
+}
+
+int main() {
+    int x = 5;
+    f();
+    return x;
+}
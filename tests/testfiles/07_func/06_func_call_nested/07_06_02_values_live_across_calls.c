@@ -0,0 +1,36 @@
+int mix(int a, int b, char c, int d, int e, int f, char g, int h)
+{
+    return a - b + c * 2 - d + e * 3 - f + g - h * 5;
+}
+
+int twice(int x)
+{
+    return x + x;
+}
+
+int main()
+{
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int d = 4;
+    int e = 5;
+    int f = 6;
+    int g = 7;
+    int h = 8;
+    int i = 9;
+    int j = 10;
+    int k = 11;
+    int l = 12;
+    int m = 13;
+    int n = 0;
+    while (n < 4)
+    {
+        a = a + twice(b);
+        b = mix(c, d, e, f, g, h, i, j) % 7;
+        c = (c + k * l - m) % 100;
+        k = twice(twice(k)) % 13 + mix(a, b, c, d, e, f, g, h) % 3;
+        n = n + 1;
+    }
+    return (a + b + c + d + e + f + g + h + i + j + k + l + m) % 256;
+}
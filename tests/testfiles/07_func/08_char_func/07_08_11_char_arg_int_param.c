@@ -0,0 +1,11 @@
+int add(int a, int b) {
+    return a + b;
+}
+
+int main() {
+    int big = 100000;
+    char c = 'A';
+    int r = add(big, big);
+    r = add(c, c);
+    return r;
+}
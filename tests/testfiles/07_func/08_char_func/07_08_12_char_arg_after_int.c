@@ -0,0 +1,11 @@
+int high(int a) {
+    return a / 256;
+}
+
+int main() {
+    int big = 100000;
+    char c = 'A';
+    int r = high(big);
+    r = r + high(c);
+    return r;
+}
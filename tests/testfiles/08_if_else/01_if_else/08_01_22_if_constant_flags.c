@@ -0,0 +1,46 @@
+int trace(int x)
+{
+    putchar(x);
+    return x;
+}
+
+int main()
+{
+    int debug = 0;
+    int level = 3;
+    int result = 1;
+
+    if (debug)
+    {
+        result = trace('D');
+    }
+
+    while (0)
+    {
+        result = trace('W');
+    }
+
+    if (level * 2 == 6)
+    {
+        result = result + level;
+    }
+    else
+    {
+        result = trace('E');
+    }
+
+    int i = 0;
+    int step = 2;
+
+    while (i < 5)
+    {
+        if (step != 2)
+        {
+            step = trace('S');
+        }
+        result = result * step;
+        i = i + 1;
+    }
+
+    return result;
+}
@@ -0,0 +1,46 @@
+int classify(int a, int b)
+{
+    int r = 0;
+    if (a < b)
+        r = 1;
+    else
+    {
+        if (a == b)
+            r = 2;
+        else
+            r = 3;
+    }
+    if (!(a >= 0))
+        r = r + 10;
+    int zero = 0;
+    while (a != zero)
+    {
+        if (a > 0)
+            a = a - 1;
+        else
+            a = a + 1;
+        r = r + 2;
+    }
+    return r;
+}
+
+int lower(int c)
+{
+    char x = c;
+    if (x >= 'A')
+    {
+        if (x <= 'Z')
+            x = x + 32;
+    }
+    return x;
+}
+
+int main()
+{
+    int total = classify(1, 2) + classify(3, 3) + classify(-4, 2) + classify(5, -1);
+    putchar(lower('Q'));
+    putchar(lower('q'));
+    putchar(lower('0'));
+    putchar(10);
+    return total;
+}
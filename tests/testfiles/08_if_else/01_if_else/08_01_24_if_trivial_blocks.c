@@ -0,0 +1,57 @@
+int classify(int x)
+{
+    if (x < 0)
+    {
+        return 0;
+    }
+    if (x == 0)
+    {
+    }
+    else
+    {
+        if (x > 100)
+        {
+            return 0;
+        }
+    }
+    int y = x;
+    if (x)
+    {
+        if (x)
+        {
+            y = y + 3;
+        }
+    }
+    else
+    {
+        if (x)
+        {
+            y = y - 100;
+        }
+        else
+        {
+            y = y + 1;
+        }
+    }
+    while (y > 50)
+    {
+        y = y - 7;
+    }
+    if (1)
+    {
+        return y;
+    }
+    return 0;
+}
+
+int main()
+{
+    int total = 0;
+    int i = -5;
+    while (i < 130)
+    {
+        total = total + classify(i);
+        i = i + 9;
+    }
+    return total % 256;
+}
@@ -0,0 +1,15 @@
+int main() {
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int i = 0;
+    int t;
+    while (i < 5) {
+        t = a;
+        a = b;
+        b = c;
+        c = t;
+        i = i + 1;
+    }
+    return a * 100 + b * 10 + c;
+}
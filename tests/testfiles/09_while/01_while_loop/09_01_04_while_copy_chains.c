@@ -0,0 +1,28 @@
+int main()
+{
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int t;
+    int u;
+    char d = 'a';
+    int i = 0;
+    while (i < 10)
+    {
+        t = a;
+        a = b;
+        b = c;
+        c = t;
+        u = (a);
+        if (u > 1)
+        {
+            t = b;
+            b = a;
+            a = t;
+        }
+        d = d + a;
+        i = i + 1;
+    }
+    u = d;
+    return a * 100 + b * 10 + c + u;
+}
@@ -0,0 +1,83 @@
+int scale(int a, int b)
+{
+    return a * 3 + b / 2;
+}
+
+int quotient(int a, int d)
+{
+    return a / d;
+}
+
+int bounded(int n, int d)
+{
+    int total = 0;
+    int i = 0;
+    while (i < n * 2)
+    {
+        total = total + (n - 1) * i;
+        if (d != 0)
+        {
+            total = total + 1000 / d;
+        }
+        total = total + n % 7;
+        i = i + 1;
+    }
+    return total;
+}
+
+int guarded(int n, int d)
+{
+    int total = 0;
+    while (n > 0)
+    {
+        if (d)
+        {
+            total = total + quotient(100, d);
+        }
+        total = total + scale(n, d) - scale(d, d);
+        n = n - 1;
+    }
+    return total;
+}
+
+int nested(int n, int m)
+{
+    int total = 0;
+    int i = 0;
+    while (i < n)
+    {
+        int j = 0;
+        while (j < m + n)
+        {
+            total = total + (i * m) + (n * m) - j;
+            j = j + 1;
+        }
+        i = i + 1;
+    }
+    return total;
+}
+
+int tested(int n, int d)
+{
+    int count = 0;
+    while (n / d > count)
+    {
+        putchar('a' + count);
+        count = count + 1;
+    }
+    putchar(10);
+    while (count < quotient(n, d) + scale(n, d))
+    {
+        count = count + 2;
+    }
+    return count;
+}
+
+int main()
+{
+    int a = bounded(10, 3) + bounded(5, 0) + bounded(0, 0);
+    int b = guarded(8, 4) + guarded(6, 0) + guarded(0, 0);
+    int c = nested(4, 5) + nested(0, 3) + nested(3, -5);
+    int d = tested(20, 4) + tested(9, 2);
+    return (a + b + c + d) % 256;
+}
@@ -0,0 +1,48 @@
+int find(int target, int limit)
+{
+    int i = 0;
+    while (i < limit)
+    {
+        int j = 0;
+        while (j < i)
+        {
+            if (i * j == target)
+            {
+                return i * 100 + j;
+            }
+            j = j + 1;
+        }
+        if (i == 50)
+        {
+            return -1;
+        }
+        i = i + 1;
+    }
+    return 0;
+}
+
+int sum(int n)
+{
+    int total = 0;
+    while (n > 0)
+    {
+        if (n % 2)
+        {
+            total = total + n;
+        }
+        else
+        {
+            total = total - 1;
+        }
+        n = n - 1;
+    }
+    return total;
+}
+
+int main()
+{
+    int a = find(42, 20);
+    int b = find(1000, 60);
+    int c = find(7, 3);
+    return (a + b + c + sum(15)) % 256;
+}
@@ -0,0 +1,41 @@
+int mix() {
+    char p2 = 64;
+    int a = 1;
+    int b = 2;
+    int c = 3;
+    int d = 4;
+    int e = 5;
+    int f = 6;
+    int g = 7;
+    int h = 8;
+    int k = 9;
+    int m = 10;
+    int i = 0;
+    while (i < 3) {
+        int j = 0;
+        while (j < 3) {
+            a = a + b;
+            b = b + c;
+            c = c + d;
+            d = d + e;
+            e = e + f;
+            f = f + g;
+            g = g + h;
+            h = h + k;
+            k = k + m;
+            m = m + a;
+            j = j + 1;
+        }
+        p2 /= 2;
+        i = i + 1;
+    }
+    return (a + b + c + d + e + f + g + h + k + m + p2) % 100;
+}
+
+int main() {
+    int result = mix();
+    putchar('0' + result / 10);
+    putchar('0' + result % 10);
+    putchar(10);
+    return 0;
+}
@@ -0,0 +1,46 @@
+int count(int n, char limit)
+{
+    int i = 0;
+    int total = 0;
+    char c = 'a';
+    while (i < n)
+    {
+        if (!(i % 3 == 0))
+        {
+            total = total + i;
+        }
+        if (!!(c >= limit))
+        {
+            total = total + 100;
+        }
+        if (!(n - i > 4))
+        {
+            total = total - 1;
+        }
+        int flag = i != 7;
+        if (flag)
+        {
+            total = total + flag;
+        }
+        if (!total)
+        {
+            total = 5;
+        }
+        c = c + 1;
+        i = i + 1;
+    }
+    if (n < 1)
+    {
+        n = 1;
+    }
+    while (n <= total)
+    {
+        n = n * 2;
+    }
+    return total + n;
+}
+
+int main()
+{
+    return (count(10, 'e') + count(0, 'a') + count(-3, 'z')) % 256;
+}
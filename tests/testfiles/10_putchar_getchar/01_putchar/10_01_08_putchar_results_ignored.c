@@ -0,0 +1,42 @@
+int show(int c)
+{
+    putchar(c);
+    return c + 1;
+}
+
+int square(int x)
+{
+    return x * x;
+}
+
+int count(int n)
+{
+    int total = 0;
+    while (n > 0)
+    {
+        total = total + square(n);
+        n = n - 1;
+    }
+    return total;
+}
+
+int main()
+{
+    int a = 5;
+    int b;
+    a = square(a);
+    a = 65;
+    b = a * 3;
+    b = show(a);
+    show(b);
+    square(b);
+    count(b);
+    a + b;
+    putchar(10);
+    {
+        return show(b + 1) + count(3);
+        putchar(33);
+        a = 7;
+    }
+    return a;
+}
@@ -0,0 +1,12 @@
+#define SIZE 6
+#define OFFSET (SIZE + 1)
+#define NEWLINE putchar(10)
+
+int main()
+{
+    int a = SIZE * OFFSET;
+    putchar(48 + a / 10);
+    putchar(48 + a % 10);
+    NEWLINE;
+    return a;
+}
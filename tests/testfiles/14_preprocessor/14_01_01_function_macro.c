@@ -0,0 +1,15 @@
+#define SQUARE(x) ((x) * (x))
+#define ADD(a, b) ((a) + (b))
+#define CAT(a, b) a ## b
+#define APPLY(f, x) f(x)
+
+int main()
+{
+    int CAT(res, ult) = SQUARE(1 + 2);
+    result = ADD(result,
+                 APPLY(SQUARE, 3));
+    putchar(48 + result / 10);
+    putchar(48 + result % 10);
+    putchar(10);
+    return ADD(SQUARE(2), result);
+}
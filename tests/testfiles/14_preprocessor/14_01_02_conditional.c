@@ -0,0 +1,24 @@
+#define LEVEL 3
+#define FEATURE
+
+int main()
+{
+    int a = 0;
+#if LEVEL > 5
+    a = 1;
+#elif LEVEL * 2 == 6 && defined(FEATURE)
+    a = 2;
+#else
+    a = 3;
+#endif
+#ifdef UNDEFINED_MACRO
+    a = a + 100;
+#endif
+#ifndef UNDEFINED_MACRO
+    a = a + 10;
+#endif
+#if 0
+    this is not even C code
+#endif
+    return a;
+}
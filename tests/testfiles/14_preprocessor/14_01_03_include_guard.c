@@ -0,0 +1,11 @@
+#include "14_defs.h"
+#include "14_defs.h"
+
+int main()
+{
+    int a = triple(SQUARE(2));
+    putchar(BASE + a / 10);
+    putchar(BASE + a % 10);
+    putchar(10);
+    return a;
+}
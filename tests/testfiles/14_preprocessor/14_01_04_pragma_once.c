@@ -0,0 +1,7 @@
+#include "14_once.h"
+#include "14_once.h"
+
+int main()
+{
+    return twice(21);
+}
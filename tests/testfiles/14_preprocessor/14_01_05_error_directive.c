@@ -0,0 +1,10 @@
+#define VERSION 1
+
+#if VERSION < 2
+#error version 2 is required
+#endif
+
+int main()
+{
+    return 0;
+}
@@ -0,0 +1,6 @@
+#ifdef SOMETHING
+
+int main()
+{
+    return 0;
+}
@@ -0,0 +1,12 @@
+#define VALUE 7
+#undef VALUE
+#define VALUE 8
+
+int main()
+{
+#ifdef VALUE
+    return VALUE;
+#else
+    return 0;
+#endif
+}
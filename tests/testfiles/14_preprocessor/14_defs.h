@@ -0,0 +1,12 @@
+#ifndef DEFS_H
+#define DEFS_H
+
+#define BASE 48
+#define SQUARE(x) ((x) * (x))
+
+int triple(int x)
+{
+    return 3 * x;
+}
+
+#endif
@@ -0,0 +1,6 @@
+#pragma once
+
+int twice(int x)
+{
+    return x + x;
+}